@@ -3,6 +3,8 @@
 #include "logger.hh"
 #include "radioinfo.hh"
 #include "usbdevice.hh"
+#include "usbdeviceregistry.hh"
+#include "simulateddevice.hh"
 
 QVariant
 parseDeviceHandle(const QString &device) {
@@ -30,6 +32,10 @@ printDevices(QTextStream &out, const QList<USBDeviceDescriptor> &devices) {
     }
     out << " Type:        " << device.description() << "\n";
     out << " Description: " << device.longDescription() << "\n";
+    if (USBDeviceRegistry::instance()->isIdentified(device)) {
+      RadioInfo radio = USBDeviceRegistry::instance()->identification(device);
+      out << " Radio:       " << radio.manufacturer() << " " << radio.name() << "\n";
+    }
   }
 }
 
@@ -39,6 +45,20 @@ autoDetect(QCommandLineParser &parser, QCoreApplication &app, const ErrorStack &
 
   logDebug() << "Autodetect radios.";
 
+  // Simulated devices are not enumerated, the specification is the device
+  if (parser.isSet("device") && SimulatedDevice::isSpecification(parser.value("device"))) {
+    USBDeviceDescriptor device = SimulatedDevice::descriptor(parser.value("device"), err);
+    if (! device.isValid())
+      return nullptr;
+    logDebug() << "Using " << device.description() << ".";
+    Radio *rad = Radio::detect(device, RadioInfo(), err);
+    if (nullptr == rad) {
+      errMsg(err) << "Cannot connect to " << device.description() << ".";
+      return nullptr;
+    }
+    return rad;
+  }
+
   QList<USBDeviceDescriptor> interfaces = USBDeviceDescriptor::detect();
   if (interfaces.isEmpty())
     interfaces = USBDeviceDescriptor::detect(false);
@@ -46,6 +46,8 @@ bool decode(Config &config, const QString &filename, QCommandLineParser &parser,
     errMsg(err) << "Cannot decode binary codeplug file '" << filename << "'.";
     return false;
   }
+  // Decoded eagerly, the complete config gets serialized right away. Hence, the lazy decoding
+  // would only postpone the work.
   if (! codeplug.decode(&config, err)) {
     errMsg(err) << "Cannot decode binary codeplug file '" << filename << "'.";
     return false;
@@ -186,6 +188,19 @@ decodeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
                    << err.format(" ");
       }
       outfile.close();
+    } else if ("qdmr" == info.suffix()) {
+      QFile outfile(info.filePath());
+      if (! outfile.open(QIODevice::WriteOnly)) {
+        logError() << "Cannot write binary config file '" << outfile.fileName()
+                   << "':\n" << outfile.errorString();
+        return -1;
+      }
+      if (! config.toBinary(outfile, err)) {
+        logError() << "Cannot serialize codeplug into binary config:\n"
+                   << err.format(" ");
+        return -1;
+      }
+      outfile.close();
     } else {
       logError() << "Cannot determine codeplug output file format. Consider using --csv or --yaml.";
       return -1;
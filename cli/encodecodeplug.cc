@@ -23,6 +23,7 @@
 #include "dmr6x2uv_codeplug.hh"
 #include "dr1801uv_codeplug.hh"
 #include "crc32.hh"
+#include "codeplugcache.hh"
 
 
 template <class T>
@@ -30,6 +31,33 @@ bool encode(Config &config, Codeplug::Flags flags, QCommandLineParser &parser) {
   ErrorStack err;
   T codeplug;
 
+  // If enabled, try to get the encoded codeplug from the cache
+  CodeplugCache cache;
+  QByteArray key;
+  if ((parser.isSet("cache") || parser.isSet("verify-cache")) && (! CodeplugCache::isCacheable(flags))) {
+    logWarn() << "Updated codeplugs cannot be cached, encode it.";
+  } else if (parser.isSet("cache") || parser.isSet("verify-cache")) {
+    key = CodeplugCache::key(&config, parser.value("radio"), flags, err);
+    if (key.isEmpty()) {
+      logError() << "Cannot compute cache key: " << err.format();
+      return false;
+    }
+  }
+
+  if (parser.isSet("cache") && (! parser.isSet("verify-cache")) && cache.contains(key)) {
+    DFUFile cached;
+    if (cache.load(key, flags, cached, err)) {
+      logDebug() << "Use cached codeplug '" << cache.filename(key) << "'.";
+      if (! cached.write(parser.positionalArguments().at(2), err)) {
+        logError() << "Cannot write output codeplug file '" << parser.positionalArguments().at(2)
+                   << "': " << err.format();
+        return false;
+      }
+      return true;
+    }
+    logWarn() << "Cannot load cached codeplug, encode it: " << err.format();
+  }
+
   Config *intermediate = codeplug.preprocess(&config, err);
   if (nullptr == intermediate) {
     logError() << "Cannot pre-process codeplug: " << err.format();
@@ -44,6 +72,20 @@ bool encode(Config &config, Codeplug::Flags flags, QCommandLineParser &parser) {
   delete intermediate;
 
   codeplug.image(0).sort();
+
+  // An empty key means, the cache is disabled or the codeplug is not cacheable
+  if ((! key.isEmpty()) && parser.isSet("verify-cache") && cache.contains(key)) {
+    if (! cache.verify(key, codeplug, err)) {
+      logError() << "Encoded codeplug does not match cached one '" << cache.filename(key)
+                 << "': " << err.format();
+      return false;
+    }
+    logDebug() << "Encoded codeplug matches cached one.";
+  } else if (! key.isEmpty()) {
+    if (! cache.store(key, flags, codeplug, err))
+      logWarn() << "Cannot cache encoded codeplug: " << err.format();
+  }
+
   if (! codeplug.write(parser.positionalArguments().at(2), err)) {
     logError() << "Cannot write output codeplug file '" << parser.positionalArguments().at(1)
                << "': " << err.format();
@@ -106,6 +148,12 @@ int encodeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
                  << "':\n" << err.format(" ");
       return -1;
     }
+  } else if ("qdmr" == fileinfo.suffix()) {
+    if (! config.readBinary(fileinfo.canonicalFilePath(), err)) {
+      logError() << "Cannot read binary config '" << fileinfo.fileName()
+                 << "':\n" << err.format(" ");
+      return -1;
+    }
   } else {
     logError() << "Cannot determine input file type, consider using --csv or --yaml.";
     return -1;
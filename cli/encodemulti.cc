@@ -0,0 +1,305 @@
+#include "encodemulti.hh"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+
+#include "logger.hh"
+#include "config.hh"
+#include "radioinfo.hh"
+#include "radiolimits.hh"
+#include "codeplug.hh"
+#include "rd5r.hh"
+#include "gd73.hh"
+#include "gd77.hh"
+#include "opengd77.hh"
+#include "openrtx.hh"
+#include "md390.hh"
+#include "uv390.hh"
+#include "md2017.hh"
+#include "dm1701.hh"
+#include "d868uv.hh"
+#include "d878uv.hh"
+#include "d878uv2.hh"
+#include "d578uv.hh"
+#include "dmr6x2uv.hh"
+#include "dr1801uv.hh"
+
+
+/** The result of encoding the codeplug for a single radio model. */
+struct EncodeResult {
+  /** The radio model. */
+  RadioInfo info;
+  /** The output file. */
+  QString filename;
+  /** If @c true, the codeplug was verified, encoded and written. */
+  bool success;
+  /** Time spent in ms. */
+  qint64 duration;
+  /** The error message, if the encoding failed. */
+  QString error;
+  /** The verification issues. */
+  QList<RadioLimitIssue> issues;
+};
+
+
+/** Creates a radio object without a device for the given model. */
+static Radio *
+createRadio(RadioInfo::Radio radio) {
+  switch (radio) {
+  case RadioInfo::RD5R: return new RD5R();
+  case RadioInfo::GD73: return new GD73();
+  case RadioInfo::GD77: return new GD77();
+  case RadioInfo::OpenGD77: return new OpenGD77();
+  case RadioInfo::OpenRTX: return new OpenRTX();
+  case RadioInfo::MD390: return new MD390();
+  case RadioInfo::UV390: return new UV390();
+  case RadioInfo::MD2017: return new MD2017();
+  case RadioInfo::DM1701: return new DM1701();
+  case RadioInfo::D868UVE: return new D868UV();
+  case RadioInfo::D878UV: return new D878UV();
+  case RadioInfo::D878UVII: return new D878UV2();
+  case RadioInfo::D578UV: return new D578UV();
+  case RadioInfo::DMR6X2UV: return new DMR6X2UV();
+  case RadioInfo::DR1801UV: return new DR1801UV();
+  }
+  return nullptr;
+}
+
+
+/** Pre-processes, verifies, encodes and writes the codeplug for a single radio model. All objects
+ * are created and destroyed within the calling thread, the config is only read. */
+static bool
+encodeModel(Config *config, const Codeplug::Flags &flags, bool ignoreLimits, EncodeResult &result) {
+  ErrorStack err;
+  Radio *radio = createRadio(result.info.id());
+  if (nullptr == radio) {
+    result.error = "Radio is not supported.";
+    return false;
+  }
+
+  // Each model works on its own snapshot of the config, created by pre-processing
+  Config *intermediate = radio->codeplug().preprocess(config, err);
+  if (nullptr == intermediate) {
+    result.error = QString("Cannot pre-process codeplug: %1").arg(err.format());
+    delete radio;
+    return false;
+  }
+
+  RadioLimitContext ctx(ignoreLimits);
+  radio->limits().verifyConfig(intermediate, ctx);
+  for (int i=0; i<ctx.count(); i++)
+    result.issues.append(ctx.message(i));
+  if (RadioLimitIssue::Critical == ctx.maxSeverity()) {
+    result.error = "Codeplug cannot be verified with radio.";
+    delete intermediate;
+    delete radio;
+    return false;
+  }
+
+  if (! radio->codeplug().encode(intermediate, flags, err)) {
+    result.error = QString("Cannot encode codeplug: %1").arg(err.format());
+    delete intermediate;
+    delete radio;
+    return false;
+  }
+  delete intermediate;
+
+  radio->codeplug().image(0).sort();
+  if (! radio->codeplug().write(result.filename, err)) {
+    result.error = QString("Cannot write codeplug file '%1': %2").arg(result.filename, err.format());
+    delete radio;
+    return false;
+  }
+
+  delete radio;
+  return true;
+}
+
+
+/** Internal used task, encoding the codeplug for a single radio model. */
+class EncodeModelTask: public QRunnable
+{
+public:
+  /** Constructs a task encoding the given config. */
+  EncodeModelTask(Config *config, const Codeplug::Flags &flags, bool ignoreLimits, EncodeResult &result)
+    : QRunnable(), _config(config), _flags(flags), _ignoreLimits(ignoreLimits), _result(result)
+  {
+    // pass...
+  }
+
+  void run() {
+    QElapsedTimer timer; timer.start();
+    _result.success = encodeModel(_config, _flags, _ignoreLimits, _result);
+    _result.duration = timer.elapsed();
+  }
+
+protected:
+  /** The config to encode. */
+  Config *_config;
+  /** The encoding flags. */
+  Codeplug::Flags _flags;
+  /** If @c true, frequency limits are ignored. */
+  bool _ignoreLimits;
+  /** The result. */
+  EncodeResult &_result;
+};
+
+
+static QString
+severityName(RadioLimitIssue::Severity severity) {
+  switch (severity) {
+  case RadioLimitIssue::Silent: return "silent";
+  case RadioLimitIssue::Hint: return "hint";
+  case RadioLimitIssue::Warning: return "warning";
+  case RadioLimitIssue::Critical: return "critical";
+  }
+  return "unknown";
+}
+
+
+/** Writes the combined verification report of all models. */
+static bool
+writeReport(const QString &filename, const QString &config, const QList<EncodeResult> &results) {
+  QJsonArray radios;
+  foreach (const EncodeResult &result, results) {
+    QJsonArray issues;
+    foreach (const RadioLimitIssue &issue, result.issues) {
+      QJsonObject obj;
+      obj.insert("severity", severityName(issue.severity()));
+      obj.insert("message", issue.format());
+      issues.append(obj);
+    }
+    QJsonObject radio;
+    radio.insert("radio", result.info.key());
+    radio.insert("name", result.info.name());
+    radio.insert("status", result.success ? "ok" : "error");
+    if (result.success)
+      radio.insert("file", result.filename);
+    else
+      radio.insert("error", result.error);
+    radio.insert("duration", result.duration);
+    radio.insert("issues", issues);
+    radios.append(radio);
+  }
+
+  QJsonObject report;
+  report.insert("config", config);
+  report.insert("radios", radios);
+
+  QFile file(filename);
+  if (! file.open(QIODevice::WriteOnly)) {
+    logError() << "Cannot write report to '" << filename << "': " << file.errorString();
+    return false;
+  }
+  file.write(QJsonDocument(report).toJson());
+  file.close();
+  return true;
+}
+
+
+int encodeMulti(QCommandLineParser &parser, QCoreApplication &app) {
+  Q_UNUSED(app);
+
+  if (3 > parser.positionalArguments().size())
+    parser.showHelp(-1);
+
+  QFileInfo fileinfo(parser.positionalArguments().at(1));
+  QDir outdir(parser.positionalArguments().at(2));
+
+  if (! parser.isSet("radio")) {
+    logError() << "You have to specify the radios using the --radio option.";
+    parser.showHelp(-1);
+    return -1;
+  }
+
+  // Collect radios, each may be given as a comma-separated list too
+  QList<EncodeResult> results;
+  foreach (QString keys, parser.values("radio")) {
+    foreach (QString key, keys.split(",", Qt::SkipEmptyParts)) {
+      key = key.trimmed().toLower();
+      if (! RadioInfo::hasRadioKey(key)) {
+        QStringList radios;
+        foreach (RadioInfo info, RadioInfo::allRadios())
+          radios.append(info.key());
+        logError() << "Unknown radio '" << key << ".";
+        logError() << "Known radios " << radios.join(", ") << ".";
+        return -1;
+      }
+      EncodeResult result;
+      result.info = RadioInfo::byKey(key);
+      result.filename = outdir.filePath(result.info.key() + ".dfu");
+      result.success = false;
+      result.duration = 0;
+      results.append(result);
+    }
+  }
+
+  if ((! outdir.exists()) && (! outdir.mkpath("."))) {
+    logError() << "Cannot create output directory '" << outdir.path() << "'.";
+    return -1;
+  }
+
+  // Read config once
+  Config config;
+  ErrorStack err;
+  if (parser.isSet("yaml") || ("yaml" == fileinfo.suffix())) {
+    if (! config.readYAML(fileinfo.canonicalFilePath(), err)) {
+      logError() << "Cannot parse YAML codeplug '" << fileinfo.fileName()
+                 << "':\n" << err.format(" ");
+      return -1;
+    }
+  } else {
+    logError() << "Cannot determine input file type, consider using --yaml.";
+    return -1;
+  }
+
+  Codeplug::Flags flags;
+  flags.updateCodePlug = false;
+  if (parser.isSet("auto-enable-gps"))
+    flags.autoEnableGPS = true;
+  if (parser.isSet("auto-enable-roaming"))
+    flags.autoEnableRoaming = true;
+
+  // Create the singletons referenced by configs before any worker does
+  SelectedChannel::get(); DefaultRadioID::get(); DefaultRoamingZone::get();
+
+  // The config is only read by the workers, each one creates its own snapshot
+  QThreadPool pool;
+  pool.setMaxThreadCount(std::min(QThread::idealThreadCount(), results.size()));
+  for (int i=0; i<results.size(); i++)
+    pool.start(new EncodeModelTask(&config, flags, parser.isSet("ignore-limits"), results[i]));
+  pool.waitForDone();
+
+  bool success = true;
+  foreach (const EncodeResult &result, results) {
+    foreach (const RadioLimitIssue &issue, result.issues) {
+      if (RadioLimitIssue::Warning == issue.severity())
+        logWarn() << result.info.name() << ": Verification Issue: " << issue.format();
+      else if (RadioLimitIssue::Critical == issue.severity())
+        logError() << result.info.name() << ": Verification Issue: " << issue.format();
+    }
+    if (result.success) {
+      logInfo() << result.info.name() << ": Encoded into '" << result.filename << "' in "
+                << result.duration << "ms.";
+    } else {
+      logError() << result.info.name() << ": " << result.error;
+      success = false;
+    }
+  }
+
+  if (! writeReport(outdir.filePath("report.json"), fileinfo.filePath(), results))
+    return -1;
+
+  return (success ? 0 : -1);
+}
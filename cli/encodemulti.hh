@@ -0,0 +1,12 @@
+#ifndef ENCODEMULTI_HH
+#define ENCODEMULTI_HH
+
+class QCoreApplication;
+class QCommandLineParser;
+
+/** Encodes a codeplug for several radio models concurrently. The config is read once, the
+ * radios are given by passing the --radio option several times. Writes one binary codeplug per
+ * radio and a JSON report of all verification issues into the output directory. */
+int encodeMulti(QCommandLineParser &parser, QCoreApplication &app);
+
+#endif // ENCODEMULTI_HH
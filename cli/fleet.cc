@@ -0,0 +1,462 @@
+#include "fleet.hh"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QThread>
+#include <functional>
+#include <iostream>
+
+#include "logger.hh"
+#include "radio.hh"
+#include "config.hh"
+#include "configcopyvisitor.hh"
+#include "userdatabase.hh"
+#include "callsigndb.hh"
+#include "autodetect.hh"
+#include "radiolimits.hh"
+#include "usbdevice.hh"
+#include "simulateddevice.hh"
+#include "transferstatistics.hh"
+
+
+/** Number of attempts to reconnect to a radio after it rebooted. */
+#define RECONNECT_ATTEMPTS 10
+
+/** Collects the state of a single radio of the fleet. */
+struct FleetDevice {
+  /** The USB device of the radio. */
+  USBDeviceDescriptor descriptor;
+  /** The radio object, may be @c nullptr. */
+  Radio *radio;
+  /** A label for the radio used in the progress and report. */
+  QString label;
+  /** The progress of the current task in percent. */
+  int progress;
+  /** If @c true, the current task is running. */
+  bool running;
+  /** If @c true, a task failed for this radio. No further tasks are performed. */
+  bool failed;
+  /** Result of the codeplug upload. */
+  QString codeplugResult;
+  /** Result of the call-sign DB upload. */
+  QString callsignResult;
+  /** Total time spent on this radio in ms. */
+  qint64 duration;
+  /** Bytes transferred to and from the radio. */
+  quint64 bytes;
+  /** The error stack for this radio. */
+  ErrorStack err;
+};
+
+
+static void
+showFleetProgress(const QList<FleetDevice *> &devices, bool redraw) {
+  if (redraw) {
+    for (int i=0; i<devices.size(); i++)
+      std::cerr << "\033[1A\033[K";
+  }
+  foreach (FleetDevice *dev, devices) {
+    int percent = dev->failed ? 0 : dev->progress;
+    std::cerr << "[";
+    for (int i=0; i<25; i++)
+      std::cerr << ((percent/4 > i) ? "=" : " ");
+    std::cerr << "] ";
+    if (dev->failed)
+      std::cerr << "FAIL ";
+    else
+      std::cerr << QString("%1% ").arg(percent, 3).toStdString();
+    std::cerr << dev->label.toStdString() << std::endl;
+  }
+}
+
+
+static Radio *
+connectRadio(QCommandLineParser &parser, const USBDeviceDescriptor &device, const ErrorStack &err) {
+  RadioInfo info;
+  if (parser.isSet("radio")) {
+    info = RadioInfo::byKey(parser.value("radio").toLower());
+    if (! info.isValid()) {
+      errMsg(err) << "Unknown radio '" << parser.value("radio").toLower() << "'.";
+      return nullptr;
+    }
+  } else if (! device.isSave()) {
+    errMsg(err) << "It is not save to identify the radio connected to the device '"
+                << device.deviceHandle() << "'. Use the --radio option to specify the radio.";
+    return nullptr;
+  }
+
+  return Radio::detect(device, info, err);
+}
+
+
+static QList<USBDeviceDescriptor>
+fleetDevices(QCommandLineParser &parser, const ErrorStack &err) {
+  QList<USBDeviceDescriptor> devices;
+
+  QStringList handles = parser.values("device");
+  QList<USBDeviceDescriptor> interfaces;
+  bool onlySimulated = true;
+  foreach (QString handle, handles)
+    onlySimulated &= SimulatedDevice::isSpecification(handle);
+  if (handles.isEmpty() || (! onlySimulated)) {
+    interfaces = USBDeviceDescriptor::detect();
+    if (interfaces.isEmpty() || parser.isSet("radio"))
+      interfaces = USBDeviceDescriptor::detect(false);
+  }
+
+  // If no devices are given explicitly, use all detected devices
+  if (handles.isEmpty())
+    return interfaces;
+
+  foreach (QString handle, handles) {
+    if (SimulatedDevice::isSpecification(handle)) {
+      USBDeviceDescriptor device = SimulatedDevice::descriptor(handle, err);
+      if (! device.isValid())
+        return QList<USBDeviceDescriptor>();
+      devices.append(device);
+      continue;
+    }
+
+    QVariant devHandle = parseDeviceHandle(handle);
+    USBDeviceDescriptor device;
+    foreach (USBDeviceDescriptor dev, interfaces) {
+      if (dev.device() == devHandle) {
+        device = dev;
+        break;
+      }
+    }
+    if (! device.isValid()) {
+      ErrorStack::MessageStream msg(err, __FILE__, __LINE__);
+      msg << "Device handle '" << handle << "' not found in:\n";
+      printDevices(msg, interfaces);
+      return QList<USBDeviceDescriptor>();
+    }
+    devices.append(device);
+  }
+
+  return devices;
+}
+
+
+/** Starts the given task on all radios that have not failed yet and waits for all of them to
+ * finish. */
+static void
+runFleet(QList<FleetDevice *> &devices, std::function<bool(FleetDevice *)> start) {
+  QEventLoop loop;
+  unsigned running = 0;
+  QElapsedTimer timer;
+
+  auto finished = [&loop, &running, &devices, &timer](FleetDevice *dev, bool success) {
+    if (! dev->running)
+      return;
+    dev->running = false;
+    dev->duration += timer.elapsed();
+    dev->failed = (! success);
+    dev->progress = 100;
+    showFleetProgress(devices, true);
+    if (0 == (--running))
+      loop.quit();
+  };
+
+  foreach (FleetDevice *dev, devices)
+    dev->progress = 0;
+  showFleetProgress(devices, false);
+
+  timer.start();
+  foreach (FleetDevice *dev, devices) {
+    if (dev->failed || (nullptr == dev->radio))
+      continue;
+
+    QObject::connect(dev->radio, &Radio::uploadProgress, &loop, [dev, &devices](int percent) {
+      if (dev->progress == percent)
+        return;
+      dev->progress = percent;
+      showFleetProgress(devices, true);
+    });
+    QObject::connect(dev->radio, &Radio::uploadComplete, &loop, [dev, finished](Radio *) {
+      finished(dev, true);
+    });
+    QObject::connect(dev->radio, &Radio::uploadError, &loop, [dev, finished](Radio *) {
+      finished(dev, false);
+    });
+
+    dev->running = true; running++;
+    if (! start(dev)) {
+      dev->radio->disconnect(&loop);
+      dev->running = false; running--;
+      dev->failed = true;
+    }
+  }
+
+  if (running)
+    loop.exec();
+
+  foreach (FleetDevice *dev, devices) {
+    if (nullptr == dev->radio)
+      continue;
+    dev->radio->wait();
+    dev->radio->disconnect(&loop);
+    if (const TransferStatistics *stats = dev->radio->statistics())
+      dev->bytes += stats->bytesSent() + stats->bytesReceived();
+    if (Radio::StatusError == dev->radio->status())
+      dev->failed = true;
+  }
+}
+
+
+static bool
+readFleetConfig(QCommandLineParser &parser, const QString &filename, Config &config) {
+  QFileInfo fileinfo(filename);
+  QString errorMessage;
+  if (parser.isSet("csv") || ("csv" == fileinfo.suffix()) || ("conf"==fileinfo.suffix())) {
+    if (! config.readCSV(filename, errorMessage)) {
+      logError() << "Cannot read CSV file '" << filename << "': " << errorMessage;
+      return false;
+    }
+  } else if (parser.isSet("yaml") || ("yaml" == fileinfo.suffix())) {
+    ErrorStack err;
+    if (! config.readYAML(fileinfo.canonicalFilePath(), err)) {
+      logError() << "Cannot parse YAML codeplug '" << fileinfo.fileName() << "': " << err.format();
+      return false;
+    }
+  } else {
+    logError() << "Cannot read codeplug '" << filename << "': Unknown format.";
+    return false;
+  }
+  logDebug() << "Read codeplug from '" << filename << "'.";
+  return true;
+}
+
+
+static bool
+loadFleetCallsignDB(QCommandLineParser &parser, UserDatabase &userdb) {
+  if (! userdb.load(parser.value("database"))) {
+    logError() << "Cannot load user-db from '" << parser.value("database") << "'.";
+    return false;
+  }
+
+  if (parser.isSet("id")) {
+    QSet<unsigned> prefixes;
+    foreach (QString prefix_text, parser.value("id").split(",")) {
+      bool ok=true; uint32_t prefix = prefix_text.toUInt(&ok);
+      if (ok)
+        prefixes.insert(prefix);
+    }
+    if (prefixes.isEmpty()) {
+      logError() << "Please specify a valid DMR ID or a list of DMR prefixes for --id option.";
+      return false;
+    }
+    userdb.sortUsers(prefixes);
+  } else {
+    logWarn() << "No ID is specified, a more or less random set of call-signs will be used "
+              << "if the radios cannot hold the entire call-sign DB of " << userdb.count()
+              << " entries. Specify your DMR ID with --id=YOUR_DMR_ID.";
+  }
+
+  return true;
+}
+
+
+static void
+reportFleet(const QList<FleetDevice *> &devices) {
+  QTextStream out(stdout);
+  unsigned succeeded = 0;
+  out << "Fleet summary:\n";
+  foreach (FleetDevice *dev, devices) {
+    out << "  " << dev->label << ": ";
+    QStringList results;
+    if (! dev->codeplugResult.isEmpty())
+      results.append("codeplug " + dev->codeplugResult);
+    if (! dev->callsignResult.isEmpty())
+      results.append("call-sign DB " + dev->callsignResult);
+    out << results.join(", ");
+    if (dev->duration)
+      out << QString(" (%1s, %2 kB)").arg(double(dev->duration)/1000, 0, 'f', 1)
+             .arg(dev->bytes/1024);
+    out << "\n";
+    if (dev->failed)
+      out << dev->err.format("    ") << "\n";
+    else
+      succeeded++;
+  }
+  out << succeeded << " of " << devices.size() << " radio(s) programmed successfully.\n";
+  out.flush();
+}
+
+
+/** Closes the connections to all radios and deletes the devices. Returns @c true if no task
+ * failed. */
+static bool
+deleteFleet(QList<FleetDevice *> &devices) {
+  bool success = true;
+  foreach (FleetDevice *dev, devices) {
+    success &= (! dev->failed);
+    if (dev->radio)
+      delete dev->radio;
+  }
+  qDeleteAll(devices);
+  devices.clear();
+  return success;
+}
+
+
+int writeFleet(QCommandLineParser &parser, QCoreApplication &app) {
+  Q_UNUSED(app);
+
+  bool writeCodeplug = (2 <= parser.positionalArguments().size());
+  bool writeCallsigns = parser.isSet("database");
+  if ((! writeCodeplug) && (! writeCallsigns))
+    parser.showHelp(-1);
+
+  // Load config and user DB once for all radios
+  Config config;
+  if (writeCodeplug && (! readFleetConfig(parser, parser.positionalArguments().at(1), config)))
+    return -1;
+
+  UserDatabase userdb;
+  if (writeCallsigns && (! loadFleetCallsignDB(parser, userdb)))
+    return -1;
+
+  CallsignDB::Selection selection;
+  if (parser.isSet("limit")) {
+    bool ok=true;
+    selection.setCountLimit(parser.value("limit").toUInt(&ok));
+    if (! ok) {
+      logError() << "Please specify a valid limit for the number of callsign db entries using the -n/--limit option.";
+      return -1;
+    }
+  }
+
+  ErrorStack err;
+  QList<USBDeviceDescriptor> descriptors = fleetDevices(parser, err);
+  if (descriptors.isEmpty()) {
+    logError() << "No radios found: " << err.format();
+    return -1;
+  }
+
+  QList<FleetDevice *> devices;
+  foreach (USBDeviceDescriptor descriptor, descriptors) {
+    FleetDevice *dev = new FleetDevice{descriptor, nullptr, descriptor.deviceHandle(),
+        0, false, false, "", "", 0, 0, ErrorStack()};
+    dev->radio = connectRadio(parser, descriptor, dev->err);
+    if (nullptr == dev->radio) {
+      dev->failed = true;
+      dev->codeplugResult = "not detected";
+      logWarn() << "Cannot connect to " << descriptor.description() << ": " << dev->err.format();
+    } else {
+      dev->label = QString("%1 (%2)").arg(dev->radio->name(), descriptor.deviceHandle());
+    }
+    devices.append(dev);
+  }
+  logInfo() << "Programming " << devices.size() << " radio(s).";
+
+  if (writeCodeplug) {
+    // Pre-process and verify the codeplug once per radio model
+    QHash<QString, Config *> intermediates;
+    bool verified = true;
+    foreach (FleetDevice *dev, devices) {
+      if (dev->failed || intermediates.contains(dev->radio->name()))
+        continue;
+      Config *intermediate = dev->radio->codeplug().preprocess(&config, err);
+      if (nullptr == intermediate) {
+        logError() << "Cannot pre-process codeplug for " << dev->radio->name() << ": " << err.format();
+        qDeleteAll(intermediates);
+        deleteFleet(devices);
+        return -1;
+      }
+      intermediates.insert(dev->radio->name(), intermediate);
+
+      // Each model gets its own context, issues of one model must not affect another
+      RadioLimitContext ctx(parser.isSet("ignore-limits"));
+      dev->radio->limits().verifyConfig(intermediate, ctx);
+      for (int i=0; i<ctx.count(); i++) {
+        switch (ctx.message(i).severity()) {
+        case RadioLimitIssue::Warning:
+          logWarn() << "Verification Issue (" << dev->radio->name() << "): " << ctx.message(i).format();
+          break;
+        case RadioLimitIssue::Critical:
+          logError() << "Verification Issue (" << dev->radio->name() << "): " << ctx.message(i).format();
+          break;
+        default:
+          break;
+        }
+      }
+      if (RadioLimitIssue::Critical == ctx.maxSeverity())
+        verified = false;
+    }
+
+    if (! verified) {
+      logError() << "Cannot upload codeplug to devices: Codeplug cannot be verified with all radios.";
+      qDeleteAll(intermediates);
+      deleteFleet(devices);
+      return -1;
+    }
+
+    Codeplug::Flags flags;
+    if (parser.isSet("init-codeplug"))
+      flags.updateCodePlug = false;
+    if (parser.isSet("auto-enable-gps"))
+      flags.autoEnableGPS = true;
+    if (parser.isSet("auto-enable-roaming"))
+      flags.autoEnableRoaming = true;
+
+    // Each radio takes the ownership of its copy of the pre-processed codeplug
+    runFleet(devices, [&intermediates, &flags](FleetDevice *dev) {
+      ConfigItem *copy = ConfigCopy::copy(intermediates[dev->radio->name()], dev->err);
+      if (nullptr == copy)
+        return false;
+      return dev->radio->startUpload(copy->as<Config>(), false, flags, dev->err);
+    });
+
+    foreach (FleetDevice *dev, devices) {
+      if (nullptr != dev->radio)
+        dev->codeplugResult = dev->failed ? "failed" : "ok";
+    }
+    qDeleteAll(intermediates);
+  }
+
+  if (writeCallsigns) {
+    // Radios close the connection after a task, hence reconnect.
+    foreach (FleetDevice *dev, devices) {
+      if (dev->failed)
+        continue;
+      if (writeCodeplug) {
+        delete dev->radio; dev->radio = nullptr;
+        for (int i=0; (i<RECONNECT_ATTEMPTS) && (nullptr == dev->radio); i++) {
+          if (i)
+            QThread::sleep(1);
+          ErrorStack attempt;
+          dev->radio = connectRadio(parser, dev->descriptor, attempt);
+          if ((nullptr == dev->radio) && ((i+1) == RECONNECT_ATTEMPTS))
+            dev->err.take(attempt);
+        }
+        if (nullptr == dev->radio) {
+          dev->failed = true;
+          dev->callsignResult = "not reconnected";
+          continue;
+        }
+      }
+      if (nullptr == dev->radio->callsignDB()) {
+        dev->callsignResult = "not supported";
+        delete dev->radio; dev->radio = nullptr;
+      }
+    }
+
+    runFleet(devices, [&userdb, &selection](FleetDevice *dev) {
+      return dev->radio->startUploadCallsignDB(&userdb, false, selection, dev->err);
+    });
+
+    foreach (FleetDevice *dev, devices) {
+      if ((nullptr != dev->radio) && dev->callsignResult.isEmpty())
+        dev->callsignResult = dev->failed ? "failed" : "ok";
+    }
+  }
+
+  reportFleet(devices);
+
+  return deleteFleet(devices) ? 0 : -1;
+}
@@ -0,0 +1,12 @@
+#ifndef FLEET_HH
+#define FLEET_HH
+
+class QCoreApplication;
+class QCommandLineParser;
+
+/** Programs all connected radios concurrently. The codeplug is read, pre-processed and verified
+ * once per radio model, the call-sign DB is loaded and sorted once. Then, all radios are written
+ * in parallel. */
+int writeFleet(QCommandLineParser &parser, QCoreApplication &app);
+
+#endif // FLEET_HH
@@ -14,6 +14,8 @@
 #include "encodecallsigndb.hh"
 #include "decodecodeplug.hh"
 #include "infofile.hh"
+#include "fleet.hh"
+#include "encodemulti.hh"
 
 #include "uv390_codeplug.hh"
 
@@ -63,14 +65,17 @@ int main(int argc, char *argv[])
                      {"D","device"},
                      QCoreApplication::translate("main", "Specifies the device to use to talk to "
                      "the radio. If not specified, the dmrconf will try to detect the radio "
-                     "automatically. Please note, that for some radios the device must be specified."),
+                     "automatically. Please note, that for some radios the device must be specified. "
+                     "Use 'sim:RADIO[,latency=MS,bandwidth=BPS,errors=P,image=FILE]' to talk to a "
+                     "simulated radio. May be given several times for the fleet command."),
                      QCoreApplication::translate("main", "DEVICE")
                    });
   parser.addOption({
                      {"R", "radio"},
                      QCoreApplication::translate("main", "Specifies the radio. This option can also "
                      "be used to override the auto-detection of radios. Be careful using this "
-                     "option when writing to the device. A incompatible code-plug might be written."),
+                     "option when writing to the device. A incompatible code-plug might be written. "
+                     "May be given several times for the encode-multi command."),
                      QCoreApplication::translate("main", "RADIO")
                    });
   parser.addOption({
@@ -91,6 +96,13 @@ int main(int argc, char *argv[])
                      "writing the callsign db."),
                      "FILENAME"
                    });
+  parser.addOption({
+                     "stats",
+                     QCoreApplication::translate("main", "Writes the transfer statistics (requests, "
+                     "bytes, latencies, timeouts and retries) of read, write or write-db commands "
+                     "as JSON into the specified file. Use '-' to write to stdout."),
+                     "FILENAME"
+                   });
   parser.addOption(QCommandLineOption(
                      "init-codeplug",
                      QCoreApplication::translate(
@@ -104,6 +116,15 @@ int main(int argc, char *argv[])
                      "auto-enable-roaming",
                      QCoreApplication::translate("main", "Automatically enables roaming if there is a "
                                                          "roaming zone used by any channel.")));
+  parser.addOption(QCommandLineOption(
+                     "cache",
+                     QCoreApplication::translate("main", "Caches encoded codeplugs. If the config, "
+                                                 "radio and flags did not change, the encoding is "
+                                                 "skipped. Can be used with 'encode'.")));
+  parser.addOption(QCommandLineOption(
+                     "verify-cache",
+                     QCoreApplication::translate("main", "Encodes the codeplug and verifies it "
+                                                 "against the cached one. Can be used with 'encode'.")));
   parser.addOption(QCommandLineOption(
                      "ignore-limits",
                      QCoreApplication::translate("main", "Disables some limit checks.")));
@@ -114,14 +135,15 @@ int main(int argc, char *argv[])
   parser.addPositionalArgument(
         "command", QCoreApplication::translate(
           "main", "Specifies the command to perform. Either detect, verify, read, write, "
-          "write-db, encode, encode-db, decode or info. Consult the man-page of dmrconf for a "
+          "write-db, fleet, encode, encode-multi, encode-db, decode or info. Consult the man-page "
+          "of dmrconf for a "
           "detailed description of these commands."),
         QCoreApplication::translate("main", "[command]"));
 
   parser.addPositionalArgument(
         "file", QCoreApplication::translate(
           "main", "The code-plug file. Either binary (extension .dfu), text/csv (extension .conf "
-          "or .csv) or YAML format (extension .yaml). The format can be forced using the --csv, "
+          "or .csv), YAML format (extension .yaml) or the binary config format (extension .qdmr). The format can be forced using the --csv, "
           "--yaml or --binary options."),
         QCoreApplication::translate("main", "[filename]"));
 
@@ -178,8 +200,12 @@ int main(int argc, char *argv[])
     res = writeCodeplug(parser, app);
   else if ("write-db" == command)
     res = writeCallsignDB(parser, app);
+  else if ("fleet" == command)
+    res = writeFleet(parser, app);
   else if ("encode" == command)
     res = encodeCodeplug(parser, app);
+  else if ("encode-multi" == command)
+    res = encodeMulti(parser, app);
   else if ("encode-db" == command)
     res = encodeCallsignDB(parser, app);
   else if ("decode" == command)
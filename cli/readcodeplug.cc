@@ -13,6 +13,7 @@
 #include "codeplug.hh"
 #include "progressbar.hh"
 #include "autodetect.hh"
+#include "statistics.hh"
 
 
 int readCodeplug(QCommandLineParser &parser, QCoreApplication &app)
@@ -35,7 +36,9 @@ int readCodeplug(QCommandLineParser &parser, QCoreApplication &app)
   QObject::connect(radio, &Radio::downloadProgress, updateProgress);
 
   Config config;
-  if (! radio->startDownload(true, err)) {
+  bool success = radio->startDownload(true, err);
+  reportStatistics(parser, radio);
+  if (! success) {
     logError() << "Codeplug download error: " << err.format();
     return -1;
   }
@@ -77,6 +80,29 @@ int readCodeplug(QCommandLineParser &parser, QCoreApplication &app)
     }
     stream.flush();
     file.close();
+  } else if (filename.endsWith(".qdmr")) {
+    // decode codeplug
+    if (! radio->codeplug().decode(&config, err)) {
+      logError() << "Cannot decode codeplug: " << err.format();
+      return -1;
+    }
+    // post-process decoded codeplug
+    if (! radio->codeplug().postprocess(&config, err)) {
+      logError() << "Cannot post-process codeplug: " << err.format();
+      return -1;
+    }
+
+    // try to write binary config
+    QFile file(filename);
+    if (! file.open(QIODevice::WriteOnly)) {
+      logError() << "Cannot write binary config '" << filename << "': " << file.errorString();
+      return -1;
+    }
+    if (! config.toBinary(file, err)) {
+      logError() << "Cannot serialize config to binary file '" << filename << "': " << err.format();
+      return -1;
+    }
+    file.close();
   } else if (parser.isSet("bin") || filename.endsWith(".bin") || filename.endsWith(".dfu")) {
     // otherwise write binary code-plug
     if (! radio->codeplug().write(filename, err)) {
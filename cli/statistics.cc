@@ -0,0 +1,48 @@
+#include "statistics.hh"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "logger.hh"
+#include "radio.hh"
+#include "transferstatistics.hh"
+
+
+bool reportStatistics(QCommandLineParser &parser, const Radio *radio) {
+  if (! parser.isSet("stats"))
+    return true;
+
+  const TransferStatistics *stats = radio->statistics();
+  if (nullptr == stats) {
+    logWarn() << "No transfer statistics available for " << radio->name() << ".";
+    return false;
+  }
+
+  logInfo() << "Transfer statistics: " << stats->format();
+
+  QJsonObject report = stats->toJSON();
+  report.insert("radio", radio->name());
+  report.insert("status", (Radio::StatusError == radio->status()) ? "error" : "ok");
+  QByteArray json = QJsonDocument(report).toJson();
+
+  QString filename = parser.value("stats");
+  QFile file;
+  if ("-" == filename) {
+    if (! file.open(stdout, QIODevice::WriteOnly)) {
+      logError() << "Cannot write transfer statistics to stdout: " << file.errorString();
+      return false;
+    }
+  } else {
+    file.setFileName(filename);
+    if (! file.open(QIODevice::WriteOnly)) {
+      logError() << "Cannot write transfer statistics to '" << filename << "': "
+                 << file.errorString();
+      return false;
+    }
+  }
+
+  file.write(json);
+  file.close();
+  return true;
+}
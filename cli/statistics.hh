@@ -0,0 +1,13 @@
+#ifndef STATISTICS_HH
+#define STATISTICS_HH
+
+#include <QCommandLineParser>
+
+class Radio;
+
+/** Writes the transfer statistics of the given radio as a JSON report, if the --stats option is
+ * set. The report gets written to the file specified by the option or to stdout if "-" is
+ * given. */
+bool reportStatistics(QCommandLineParser &parser, const Radio *radio);
+
+#endif // STATISTICS_HH
@@ -9,6 +9,7 @@
 #include "progressbar.hh"
 #include "callsigndb.hh"
 #include "autodetect.hh"
+#include "statistics.hh"
 
 
 int writeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
@@ -79,7 +80,9 @@ int writeCallsignDB(QCommandLineParser &parser, QCoreApplication &app) {
   showProgress();
   QObject::connect(radio, &Radio::uploadProgress, updateProgress);
 
-  if (! radio->startUploadCallsignDB(&userdb, true, selection, err)) {
+  bool success = radio->startUploadCallsignDB(&userdb, true, selection, err);
+  reportStatistics(parser, radio);
+  if (! success) {
     logError() << "Could not upload call-sign DB to radio: " << err.format();
     return -1;
   }
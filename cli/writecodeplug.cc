@@ -9,6 +9,7 @@
 #include "config.hh"
 #include "progressbar.hh"
 #include "autodetect.hh"
+#include "statistics.hh"
 #include "radiolimits.hh"
 
 
@@ -32,6 +33,12 @@ int writeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
       logError() << "Cannot parse YAML codeplug '" << fileinfo.fileName() << "': " << err.format();
       return -1;
     }
+  } else if ("qdmr" == fileinfo.suffix()) {
+    ErrorStack err;
+    if (! config.readBinary(fileinfo.canonicalFilePath(), err)) {
+      logError() << "Cannot read binary config '" << fileinfo.fileName() << "': " << err.format();
+      return -1;
+    }
   }
   logDebug() << "Read codeplug from '" << filename << "'.";
 
@@ -85,7 +92,9 @@ int writeCodeplug(QCommandLineParser &parser, QCoreApplication &app) {
     flags.autoEnableRoaming = true;
 
   logDebug() << "Start upload to " << radio->name() << ".";
-  if (! radio->startUpload(intermediate, true, flags, err)) {
+  bool success = radio->startUpload(intermediate, true, flags, err);
+  reportStatistics(parser, radio);
+  if (! success) {
     logError() << "Codeplug upload error: " << err.format();
     return -1;
   }
@@ -7,6 +7,10 @@
 #include "intermediaterepresentation.hh"
 #include <QTimeZone>
 #include <QRegularExpression>
+#include <QSharedPointer>
+#include <QtEndian>
+#include <QtAlgorithms>
+#include <algorithm>
 
 #define CUSTOM_CTCSS_TONE 0x33
 
@@ -54,6 +58,59 @@ AnytoneCodeplug::CTCSS::decode(uint8_t num) {
 
 
 
+/** Returns the 64-bit word at the given word index of a bitmap of @c size bytes, such that bit n
+ * is set if entry 64*word+n is enabled. Bytes beyond the end of the bitmap read as disabled. */
+static inline quint64
+bitmapWord(const uint8_t *data, size_t size, size_t word, bool inverted) {
+  size_t offset = 8*word;
+  if (offset+8 <= size) {
+    quint64 bits = qFromLittleEndian<quint64>(data+offset);
+    return inverted ? ~bits : bits;
+  }
+  quint64 bits = 0;
+  for (size_t i=offset; i<size; i++)
+    bits |= quint64(uint8_t(inverted ? ~data[i] : data[i])) << (8*(i-offset));
+  return bits;
+}
+
+/** Returns the number of enabled entries among the first @c n of the given bitmap. */
+static unsigned int
+bitmapCount(const uint8_t *data, size_t size, unsigned int n, bool inverted) {
+  n = std::min(n, unsigned(8*size));
+  unsigned int count = 0;
+  for (size_t w=0; w<n/64; w++)
+    count += qPopulationCount(bitmapWord(data, size, w, inverted));
+  if (n%64)
+    count += qPopulationCount(bitmapWord(data, size, n/64, inverted) & ((quint64(1) << (n%64))-1));
+  return count;
+}
+
+/** Returns the index of the first enabled entry within [idx, n) of the given bitmap or -1. */
+static int
+bitmapNext(const uint8_t *data, size_t size, unsigned int idx, unsigned int n, bool inverted) {
+  n = std::min(n, unsigned(8*size));
+  if (idx >= n)
+    return -1;
+  size_t word = idx/64, last = (n-1)/64;
+  quint64 bits = bitmapWord(data, size, word, inverted) & (~quint64(0) << (idx%64));
+  while (0 == bits) {
+    if (++word > last)
+      return -1;
+    bits = bitmapWord(data, size, word, inverted);
+  }
+  unsigned int found = 64*word + qCountTrailingZeroBits(bits);
+  return (found < n) ? int(found) : -1;
+}
+
+/** Returns a word with bit 7 of each byte set, for which the corresponding byte of the given word
+ * is 0x00 (enabled within an inverted bytemap). */
+static inline quint64
+zeroBytes(quint64 bytes) {
+  const quint64 low7 = 0x7f7f7f7f7f7f7f7fULL;
+  return ~(((bytes & low7) + low7) | bytes | low7);
+}
+
+
 /* ********************************************************************************************* *
  * Implementation of AnytoneCodeplug::BitmapElement
  * ********************************************************************************************* */
@@ -92,6 +149,16 @@ AnytoneCodeplug::BitmapElement::enableFirst(unsigned int n) {
   }
 }
 
+unsigned int
+AnytoneCodeplug::BitmapElement::countEncoded(unsigned int n) const {
+  return bitmapCount(_data, _size, n, false);
+}
+
+int
+AnytoneCodeplug::BitmapElement::nextEncoded(unsigned int idx, unsigned int n) const {
+  return bitmapNext(_data, _size, idx, n, false);
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of AnytoneCodeplug::InvertedBitmapElement
@@ -131,6 +198,16 @@ AnytoneCodeplug::InvertedBitmapElement::enableFirst(unsigned int n) {
   }
 }
 
+unsigned int
+AnytoneCodeplug::InvertedBitmapElement::countEncoded(unsigned int n) const {
+  return bitmapCount(_data, _size, n, true);
+}
+
+int
+AnytoneCodeplug::InvertedBitmapElement::nextEncoded(unsigned int idx, unsigned int n) const {
+  return bitmapNext(_data, _size, idx, n, true);
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of AnytoneCodeplug::InvertedBytemapElement
@@ -165,6 +242,37 @@ AnytoneCodeplug::InvertedBytemapElement::enableFirst(unsigned int n) {
   memset(_data, 0x00, n);
 }
 
+unsigned int
+AnytoneCodeplug::InvertedBytemapElement::countEncoded(unsigned int n) const {
+  n = std::min(n, unsigned(_size));
+  unsigned int count = 0, i = 0;
+  for (; i+8<=n; i+=8)
+    count += qPopulationCount(zeroBytes(qFromLittleEndian<quint64>(_data+i)));
+  for (; i<n; i++)
+    count += (0 == _data[i]) ? 1 : 0;
+  return count;
+}
+
+int
+AnytoneCodeplug::InvertedBytemapElement::nextEncoded(unsigned int idx, unsigned int n) const {
+  n = std::min(n, unsigned(_size));
+  unsigned int i = idx;
+  // Check byte-wise up to the next word boundary, then word-wise
+  for (; (i<n) && (i%8); i++) {
+    if (0 == _data[i])
+      return i;
+  }
+  for (; i+8<=n; i+=8) {
+    if (quint64 zeros = zeroBytes(qFromLittleEndian<quint64>(_data+i)))
+      return i + qCountTrailingZeroBits(zeros)/8;
+  }
+  for (; i<n; i++) {
+    if (0 == _data[i])
+      return i;
+  }
+  return -1;
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of AnytoneCodeplug::ChannelElement
@@ -4481,11 +4589,15 @@ AnytoneCodeplug::AnytoneCodeplug(const QString &label, QObject *parent)
 }
 
 AnytoneCodeplug::~AnytoneCodeplug() {
-  // pass...
+  // Deferred elements are decoded from this codeplug
+  materializeDeferred();
 }
 
 void
 AnytoneCodeplug::clear() {
+  // Binary codeplug gets reset, decode deferred elements first
+  materializeDeferred();
+
   while (this->numImages())
     remImage(0);
 
@@ -4594,6 +4706,15 @@ AnytoneCodeplug::postprocess(Config *config, const ErrorStack &err) const {
     return false;
   }
 
+  // If decoded lazily, merge zones once they are decoded
+  if (! config->isMaterialized()) {
+    config->defer([](Config *config, const ErrorStack &err) {
+      ZoneMergeVisitor merger;
+      return merger.process(config, err);
+    });
+    return true;
+  }
+
   ZoneMergeVisitor merger;
   if (! merger.process(config, err)) {
     errMsg(err) << "Cannot post-process codeplug for anytone device.";
@@ -4606,6 +4727,12 @@ AnytoneCodeplug::postprocess(Config *config, const ErrorStack &err) const {
 
 bool
 AnytoneCodeplug::encode(Config *config, const Flags &flags, const ErrorStack &err) {
+  // Binary codeplug gets altered, decode deferred elements first
+  if (! materializeDeferred(err)) {
+    errMsg(err) << "Cannot encode anytone codeplug.";
+    return false;
+  }
+
   Context ctx(config);
   // Register table for auto-repeater offsets
   ctx.addTable(&AnytoneAutoRepeaterOffset::staticMetaObject);
@@ -4644,5 +4771,20 @@ AnytoneCodeplug::decode(Config *config, const ErrorStack &err) {
   // Register table for FM APRS frequencies
   ctx.addTable(&AnytoneAPRSFrequency::staticMetaObject);
 
-  return this->decodeElements(ctx, err);
+  if (! lazyDecoding())
+    return this->decodeElements(ctx, err);
+
+  // Decode settings only, tables are decoded once the config gets materialized
+  if (! this->decodeSettingsElements(ctx, err))
+    return false;
+  QSharedPointer<Context> deferred(new Context(ctx));
+  deferDecoding(config, [this, deferred](const ErrorStack &err) {
+    return this->decodeTableElements(*deferred, err);
+  });
+  return true;
+}
+
+bool
+AnytoneCodeplug::decodeElements(Context &ctx, const ErrorStack &err) {
+  return this->decodeSettingsElements(ctx, err) && this->decodeTableElements(ctx, err);
 }
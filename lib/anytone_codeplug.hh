@@ -53,6 +53,12 @@ public:
     virtual void setEncoded(unsigned int idx, bool enable);
     /** Enables the first n elements. */
     virtual void enableFirst(unsigned int n);
+
+    /** Returns the number of enabled elements among the first @c n. */
+    unsigned int countEncoded(unsigned int n) const;
+    /** Returns the index of the first enabled element within [idx, n) or -1, if there is none.
+     * Disabled elements are skipped word-wise. */
+    int nextEncoded(unsigned int idx, unsigned int n) const;
   };
 
   /** Represents the base class for inverted bitmaps in all AnyTone codeplugs. */
@@ -72,6 +78,12 @@ public:
     virtual void setEncoded(unsigned int idx, bool enable);
     /** Enables the first n elements. */
     virtual void enableFirst(unsigned int n);
+
+    /** Returns the number of enabled elements among the first @c n. */
+    unsigned int countEncoded(unsigned int n) const;
+    /** Returns the index of the first enabled element within [idx, n) or -1, if there is none.
+     * Disabled elements are skipped word-wise. */
+    int nextEncoded(unsigned int idx, unsigned int n) const;
   };
 
   /** Represents the base class for inverted bytemaps in all AnyTone codeplugs.
@@ -96,6 +108,12 @@ public:
     virtual void setEncoded(unsigned int idx, bool enable);
     /** Enables the first n elements. */
     virtual void enableFirst(unsigned int n);
+
+    /** Returns the number of enabled elements among the first @c n. */
+    unsigned int countEncoded(unsigned int n) const;
+    /** Returns the index of the first enabled element within [idx, n) or -1, if there is none.
+     * Disabled elements are skipped word-wise. */
+    int nextEncoded(unsigned int idx, unsigned int n) const;
   };
 
   /** Represents the base class for channel encodings in all AnyTone codeplugs.
@@ -2989,8 +3007,50 @@ protected:
 
   /** Encodes the given config (via context) to the binary codeplug. */
   virtual bool encodeElements(const Flags &flags, Context &ctx, const ErrorStack &err=ErrorStack()) = 0;
-  /** Decodes the downloaded codeplug. */
-  virtual bool decodeElements(Context &ctx, const ErrorStack &err=ErrorStack()) = 0;
+  /** Decodes the downloaded codeplug. The default implementation decodes the settings and the
+   * tables. */
+  virtual bool decodeElements(Context &ctx, const ErrorStack &err=ErrorStack());
+  /** Decodes the radio IDs, settings and everything else not held in the lists of the config.
+   * @since 0.12.0 */
+  virtual bool decodeSettingsElements(Context &ctx, const ErrorStack &err=ErrorStack()) = 0;
+  /** Decodes contacts, group lists, channels, zones, scan lists, positioning systems and roaming
+   * and links them, including the references of the settings. During a lazy decoding, this step
+   * is deferred until the config gets materialized.
+   * @since 0.12.0 */
+  virtual bool decodeTableElements(Context &ctx, const ErrorStack &err=ErrorStack()) = 0;
+
+  /** Creates the channels of all enabled channel elements in parallel and adds them to the config
+   * and context in the order of their indices. The channel element type as well as the memory
+   * layout of the codeplug (@c Offset and @c Limit) are specified by the template arguments. */
+  template <class ChannelElement, class Offset, class Limit>
+  void createChannelObjs(Context &ctx) {
+    ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
+
+    // Collect enabled channels
+    QVector<uint16_t> indices;
+    QVector<uint8_t *> elements;
+    indices.reserve(channel_bitmap.countEncoded(Limit::numChannels()));
+    elements.reserve(indices.capacity());
+    for (int i=channel_bitmap.nextEncoded(0, Limit::numChannels()); 0<=i;
+         i=channel_bitmap.nextEncoded(i+1, Limit::numChannels())) {
+      uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
+      indices.append(i);
+      elements.append(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
+                           + idx*ChannelElement::size()));
+    }
+
+    // Create channels in parallel
+    QVector<Channel *> channels = createParallel<Channel>(elements.size(), [&elements, &ctx](int i) {
+      return ChannelElement(elements[i]).toChannelObj(ctx);
+    });
+
+    // Add channels in order
+    for (int i=0; i<channels.size(); i++) {
+      if (Channel *obj = channels[i]) {
+        ctx.config()->channelList()->add(obj); ctx.add(obj, indices[i]);
+      }
+    }
+  }
 
 protected:
   /** Holds the image label. */
@@ -105,6 +105,12 @@ AnytoneInterface::AnytoneInterface(const USBDeviceDescriptor &descriptor, const
   }
 }
 
+AnytoneInterface::AnytoneInterface(QObject *parent)
+  : USBSerial(parent), _state(STATE_INITIALIZED), _info()
+{
+  // pass...
+}
+
 AnytoneInterface::~AnytoneInterface() {
   if (isOpen())
     AnytoneInterface::close();
@@ -361,6 +367,8 @@ AnytoneInterface::leave_program_mode(const ErrorStack &err) {
 
 bool
 AnytoneInterface::send_receive(const char *cmd, int clen, char *resp, int rlen, const ErrorStack &err) {
+  TransferStatistics::Request request(&_statistics, clen, rlen);
+
   // Try to write command to device
   if (clen != QSerialPort::write(cmd, clen)) {
     errMsg(err) << "Cannot send command to device.";
@@ -374,6 +382,7 @@ AnytoneInterface::send_receive(const char *cmd, int clen, char *resp, int rlen,
   int len = rlen;
   while (len > 0) {
     if (! waitForReadyRead(1000)) {
+      request.timeout();
       errMsg(err) << "No response from device: Timeout.";
       close();
       _state = STATE_ERROR;
@@ -392,5 +401,6 @@ AnytoneInterface::send_receive(const char *cmd, int clen, char *resp, int rlen,
   }
 
   // done
+  request.completed();
   return true;
 }
@@ -39,6 +39,12 @@ public:
   /** Destructor. */
   virtual ~AnytoneInterface();
 
+protected:
+  /** Constructs an interface without any connection to a device. Used by the simulator. */
+  explicit AnytoneInterface(QObject *parent);
+
+public:
+
   /** Closes the interface to the device. */
   void close();
 
@@ -73,7 +79,7 @@ protected:
   /** Sends a command message to radio to leave program state and reboot. */
   bool leave_program_mode(const ErrorStack &err=ErrorStack());
   /** Internal used method to send messages to and receive responses from radio. */
-  bool send_receive(const char *cmd, int clen, char *resp, int rlen, const ErrorStack &err=ErrorStack());
+  virtual bool send_receive(const char *cmd, int clen, char *resp, int rlen, const ErrorStack &err=ErrorStack());
 
 protected:
   /** Binary representation of a read request to the radio. */
@@ -46,11 +46,24 @@ AnytoneRadio::codeplug() {
   return *_codeplug;
 }
 
+const TransferStatistics *
+AnytoneRadio::statistics() const {
+  if (nullptr == _dev)
+    return nullptr;
+  return &_dev->statistics();
+}
+
 bool
 AnytoneRadio::startDownload(bool blocking, const ErrorStack &err) {
   if (StatusIdle != _task)
     return false;
 
+  // The binary codeplug gets overridden, decode deferred elements first within this thread
+  if ((nullptr != _codeplug) && (! _codeplug->materializeDeferred(err))) {
+    errMsg(err) << "Cannot download codeplug.";
+    return false;
+  }
+
   _task = StatusDownload;
   _errorStack = err;
 
@@ -79,6 +92,12 @@ AnytoneRadio::startUpload(Config *config, bool blocking, const Codeplug::Flags &
   if (nullptr == (_config = config))
     return false;
 
+  // The binary codeplug gets overridden, decode deferred elements first within this thread
+  if ((nullptr != _codeplug) && (! _codeplug->materializeDeferred(err))) {
+    errMsg(err) << "Cannot upload codeplug.";
+    return false;
+  }
+
   _task = StatusUpload;
   _codeplugFlags = flags;
   _errorStack = err;
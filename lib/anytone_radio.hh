@@ -45,6 +45,7 @@ public:
   const QString &name() const;
   const Codeplug &codeplug() const;
   Codeplug &codeplug();
+  const TransferStatistics *statistics() const;
 
 public slots:
   /** Starts the download of the codeplug and derives the generic configuration from it. */
@@ -0,0 +1,132 @@
+#include "anytone_simulator.hh"
+#include "logger.hh"
+#include <QtEndian>
+
+
+/* ********************************************************************************************* *
+ * Implementation of AnytoneSimulator
+ * ********************************************************************************************* */
+AnytoneSimulator::AnytoneSimulator(const USBDeviceDescriptor &descriptor, const ErrorStack &err, QObject *parent)
+  : AnytoneInterface(parent), _device(descriptor, err)
+{
+  if (! _device.isValid()) {
+    errMsg(err) << "Cannot open " << descriptor.description() << ".";
+    _state = STATE_ERROR;
+    return;
+  }
+
+  logDebug() << "Opened " << descriptor.description() << ".";
+  _state = STATE_OPEN;
+
+  // enter program mode
+  if (! this->enter_program_mode(err))
+    return;
+  // identify device
+  if (! this->request_identifier(_info, err)) {
+    _info = RadioVariant();
+    _state = STATE_ERROR;
+  }
+}
+
+AnytoneSimulator::~AnytoneSimulator() {
+  if (isOpen())
+    close();
+}
+
+bool
+AnytoneSimulator::isOpen() const {
+  return (STATE_OPEN == _state) || (STATE_PROGRAM == _state);
+}
+
+void
+AnytoneSimulator::close() {
+  AnytoneInterface::close();
+  if (STATE_OPEN == _state)
+    _state = STATE_CLOSED;
+}
+
+bool
+AnytoneSimulator::send_receive(const char *cmd, int clen, char *resp, int rlen, const ErrorStack &err) {
+  TransferStatistics::Request request(&_statistics, clen, rlen);
+
+  if (! _device.transfer(clen+rlen)) {
+    request.timeout();
+    errMsg(err) << "No response from device: Timeout.";
+    _state = STATE_ERROR;
+    return false;
+  }
+
+  if (! respond(cmd, clen, resp, rlen, err)) {
+    _state = STATE_ERROR;
+    return false;
+  }
+
+  request.completed();
+  return true;
+}
+
+bool
+AnytoneSimulator::respond(const char *cmd, int clen, char *resp, int rlen, const ErrorStack &err) {
+  // Enter program mode
+  if ((7 == clen) && (0 == memcmp(cmd, "PROGRAM", 7)) && (3 == rlen)) {
+    memcpy(resp, "QX\6", 3);
+    return true;
+  }
+
+  // Identify
+  if ((1 == clen) && (2 == cmd[0]) && (int(sizeof(RadioInfoResponse)) == rlen)) {
+    QByteArray model;
+    switch (_device.radio().id()) {
+    case RadioInfo::D868UVE: model = "D868UVE"; break;
+    case RadioInfo::DMR6X2UV: model = "D6X2UV"; break;
+    case RadioInfo::D878UV: model = "D878UV"; break;
+    case RadioInfo::D878UVII: model = "D878UV2"; break;
+    case RadioInfo::D578UV: model = "D578UV"; break;
+    default:
+      errMsg(err) << "Cannot simulate " << _device.radio().name() << ".";
+      return false;
+    }
+    RadioInfoResponse *info = (RadioInfoResponse *)resp;
+    memset(info, 0, sizeof(RadioInfoResponse));
+    info->prefix = 'I';
+    memcpy(info->model, model.constData(), std::min(model.size(), int(sizeof(info->model))));
+    info->bands = 0x00;
+    memcpy(info->version, "V100", 4);
+    info->eot = 0x06;
+    return true;
+  }
+
+  // Leave program mode, persist memory
+  if ((3 == clen) && (0 == memcmp(cmd, "END", 3)) && (1 == rlen)) {
+    resp[0] = 0x06;
+    return _device.save(err);
+  }
+
+  // Read 16 bytes
+  if ((int(sizeof(ReadRequest)) == clen) && ('R' == cmd[0]) && (int(sizeof(ReadResponse)) == rlen)) {
+    const ReadRequest *req = (const ReadRequest *)cmd;
+    ReadResponse *res = (ReadResponse *)resp;
+    res->cmd = 'W';
+    res->addr = req->addr;
+    res->size = req->size;
+    _device.read(0, qFromBigEndian(req->addr), (uint8_t *)res->data, sizeof(res->data));
+    uint8_t sum = 0;
+    const uint8_t *b = (const uint8_t *)res;
+    for (uint8_t i=1; i<(res->size+6); i++)
+      sum += b[i];
+    res->sum = sum;
+    res->ack = 0x06;
+    return true;
+  }
+
+  // Write 16 bytes
+  if ((int(sizeof(WriteRequest)) == clen) && ('W' == cmd[0]) && (1 == rlen)) {
+    const WriteRequest *req = (const WriteRequest *)cmd;
+    _device.write(0, qFromBigEndian(req->addr), (const uint8_t *)req->data, sizeof(req->data));
+    resp[0] = 0x06;
+    return true;
+  }
+
+  errMsg(err) << "Simulated AnyTone device: Unexpected request of " << clen << " bytes.";
+  return false;
+}
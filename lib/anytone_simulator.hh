@@ -0,0 +1,41 @@
+#ifndef ANYTONESIMULATOR_HH
+#define ANYTONESIMULATOR_HH
+
+#include "anytone_interface.hh"
+#include "simulateddevice.hh"
+
+/** Simulates the serial interface of AnyTone radios.
+ *
+ * This class replaces the serial transport of the @c AnytoneInterface by a simulated device,
+ * which implements the device side of the AnyTone protocol. That is, it answers the program-mode,
+ * identification, read and write requests. Hence, the complete codeplug and callsign DB transfer
+ * can be tested and benchmarked without any radio attached. See @c SimulatedDevice for the
+ * device specification.
+ *
+ * @ingroup anytone */
+class AnytoneSimulator: public AnytoneInterface
+{
+  Q_OBJECT
+
+public:
+  /** Constructs a simulated AnyTone device for the given descriptor. If the specification is
+   * valid, @c isOpen returns @c true. */
+  explicit AnytoneSimulator(const USBDeviceDescriptor &descriptor,
+                            const ErrorStack &err=ErrorStack(), QObject *parent=nullptr);
+  /** Destructor. */
+  virtual ~AnytoneSimulator();
+
+  bool isOpen() const;
+  void close();
+
+protected:
+  bool send_receive(const char *cmd, int clen, char *resp, int rlen, const ErrorStack &err=ErrorStack());
+  /** Computes the response of the simulated device to the given command. */
+  bool respond(const char *cmd, int clen, char *resp, int rlen, const ErrorStack &err);
+
+protected:
+  /** The simulated device. */
+  SimulatedDevice _device;
+};
+
+#endif // ANYTONESIMULATOR_HH
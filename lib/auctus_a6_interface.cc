@@ -34,6 +34,7 @@ AuctusA6Interface::send_receive(uint16_t command,
                                 const uint8_t *params, uint8_t plen,
                                 uint8_t *response, uint8_t &rlen, const ErrorStack &err)
 {
+  TransferStatistics::Request request(&_statistics, 6+plen);
   if (! send(command, params, plen, err)) {
     errMsg(err) << "Cannot send command.";
     return false;
@@ -52,6 +53,7 @@ AuctusA6Interface::send_receive(uint16_t command,
     return false;
   }
 
+  request.completed(6+rlen);
   return true;
 }
 
@@ -170,6 +172,7 @@ AuctusA6Interface::read(uint8_t *data, qint64 n, unsigned int timeout_ms, const
   while (n > 0) {
     if (0 == bytesAvailable()) {
       if (! waitForReadyRead(timeout_ms)) {
+        _statistics.addTimeout();
         errMsg(err) << "QSerialPort: " << errorString();
         return false;
       }
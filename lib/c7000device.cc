@@ -1,7 +1,7 @@
 #include "c7000device.hh"
 #include "logger.hh"
 #include <QtEndian>
-#include <QThread>
+#include <QElapsedTimer>
 
 #define C7000_VID 0x1206
 #define C7000_PID 0x0227
@@ -11,66 +11,75 @@
  * Implementation of C7000Device::Packet
  * ********************************************************************************************* */
 C7000Device::Packet::Packet()
-  : _encoded()
+  : _size(0)
 {
-  // pass...
+  memset(_encoded, 0, sizeof(_encoded));
 }
 
-C7000Device::Packet::Packet(uint8_t command, uint8_t sub, uint8_t flags, const QByteArray &payload)
+C7000Device::Packet::Packet(uint8_t command, uint8_t sub, uint8_t flags,
+                            const uint8_t *payload, unsigned int payloadSize)
+  : _size(0)
 {
-  _encoded.resize(9 + payload.size()); _encoded.fill(0);
+  memset(_encoded, 0, sizeof(_encoded));
+  if (payloadSize > MaxPayloadSize)
+    return;
+
+  _size = 9 + payloadSize;
   _encoded[0] = 0x68;
   _encoded[1] = flags;
   _encoded[2] = command;
   _encoded[3] = sub;
-  *((uint16_t *)(_encoded.data()+6)) = qToLittleEndian((uint16_t)payload.size());
-  memcpy(_encoded.data()+8,payload.constData(), payload.size());
-  _encoded[8+payload.size()] = 0x10;
+  qToLittleEndian<uint16_t>(payloadSize, _encoded+6);
+  if (payloadSize)
+    memcpy(_encoded+8, payload, payloadSize);
+  _encoded[8+payloadSize] = 0x10;
 
   uint32_t crc = 0xffff;
-  for (int i=0; i<(_encoded.size()/2); i++) {
-    uint16_t v = qFromLittleEndian(*(uint16_t *)(_encoded.constData()+2*i));
+  for (unsigned int i=0; i<(_size/2); i++) {
+    uint16_t v = qFromLittleEndian<uint16_t>(_encoded+2*i);
     if (crc < v) crc += 0xffff;
     crc -= v;
   }
-  if (_encoded.size()%2) {
-    uint16_t v = _encoded[_encoded.size()-1];
+  if (_size%2) {
+    uint16_t v = _encoded[_size-1];
     if (crc < v) crc += 0xffff;
     crc -= v;
   }
-  *((uint16_t *)(_encoded.data()+4)) = qToLittleEndian((uint16_t)crc);
+  qToLittleEndian<uint16_t>(crc, _encoded+4);
 }
 
-C7000Device::Packet::Packet(const QByteArray &buffer)
-  : _encoded()
+C7000Device::Packet::Packet(uint8_t command, uint8_t sub, uint8_t flags, const QByteArray &payload)
+  : Packet(command, sub, flags, (const uint8_t *)payload.constData(), payload.size())
 {
-  _encoded.append(buffer);
+  // pass...
+}
+
+C7000Device::Packet::Packet(const uint8_t *buffer, unsigned int size)
+  : _size(0)
+{
+  memset(_encoded, 0, sizeof(_encoded));
+  if (size > MaxPacketSize)
+    return;
+  memcpy(_encoded, buffer, size);
+  _size = size;
   if (! isValid())
-    _encoded.clear();
+    _size = 0;
+}
+
+C7000Device::Packet::Packet(const QByteArray &buffer)
+  : Packet((const uint8_t *)buffer.constData(), buffer.size())
+{
+  // pass...
 }
 
 
 bool
 C7000Device::Packet::isValid() const {
-  if (_encoded.size() < 9) return false;
+  if (_size < 9) return false;
   if (0x68 != _encoded[0]) return false;
+  if ((9u+payloadSize()) > _size) return false;
   if (0x10 != _encoded[8+payloadSize()]) return false;
-  int size = _encoded.size(); //9 + payloadSize();
-
-  uint32_t crc = 0xffff;
-  for (int i=0; i<size; i++) {
-    uint16_t v = qFromLittleEndian(*(uint16_t *)(_encoded.constData()+2*i));
-    if (crc < v) crc += 0xffff;
-    crc -= v;
-  }
-  if (size%2) {
-    uint16_t v = _encoded[_encoded.size()-1];
-    if (crc < v) crc += 0xffff;
-    crc -= v;
-  }
-  /*if (crc)
-    return false;*/
-
+  // The checksum of responses is not verified, as it is unclear how the device computes it.
   return true;
 }
 
@@ -91,19 +100,31 @@ C7000Device::Packet::subcommand() const {
 
 uint16_t
 C7000Device::Packet::payloadSize() const {
-  return qFromLittleEndian(*(const uint16_t *)(_encoded.constData()+6));
+  return qFromLittleEndian<uint16_t>(_encoded+6);
 }
 
 QByteArray
 C7000Device::Packet::payload() const {
-  return _encoded.mid(8,payloadSize());
+  if (! isValid())
+    return QByteArray();
+  return QByteArray((const char *)payloadData(), payloadSize());
+}
+
+const uint8_t *
+C7000Device::Packet::payloadData() const {
+  return _encoded+8;
 }
 
-const QByteArray &
-C7000Device::Packet::encoded() const {
+const uint8_t *
+C7000Device::Packet::data() const {
   return _encoded;
 }
 
+unsigned int
+C7000Device::Packet::size() const {
+  return _size;
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of C7000Device::Descriptor
@@ -119,8 +140,13 @@ C7000Device::Descriptor::Descriptor(const USBDeviceInfo &info, uint8_t bus, uint
  * Implementation of C7000Device
  * ********************************************************************************************* */
 C7000Device::C7000Device(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
-  : QObject(parent), _ctx(nullptr), _dev(nullptr)
+  : QObject(parent), _ctx(nullptr), _dev(nullptr), _stats(nullptr), _nextIn(0), _drainIn(false)
 {
+  for (unsigned int i=0; i<NumInTransfers; i++) {
+    _in[i].transfer = nullptr;
+    _in[i].completed = 1;
+  }
+
   if (USBDeviceInfo::Class::C7K != descr.interfaceClass()) {
     errMsg(err) << "Cannot connect to C7000 device using a non C7K descriptor: "
                 << descr.description() << ".";
@@ -198,6 +224,12 @@ C7000Device::C7000Device(const USBDeviceDescriptor &descr, const ErrorStack &err
     return;
   }
 
+  if (! startReceiving(err)) {
+    errMsg(err) << "Cannot start receiving from device " << descr.description() << ".";
+    close();
+    return;
+  }
+
   logDebug() << "Connected to C7000 device " << descr.description() << ".";
 }
 
@@ -262,6 +294,7 @@ void
 C7000Device::close() {
   logDebug() << "Close C7000 interface.";
   if (nullptr != _dev) {
+    stopReceiving();
     libusb_release_interface(_dev, 0);
     libusb_close(_dev);
   }
@@ -273,43 +306,181 @@ C7000Device::close() {
 
 bool
 C7000Device::sendRecv(const Packet &request, Packet &response, const ErrorStack &err) {
+  return transfer(&request, &response, 1, err);
+}
+
+bool
+C7000Device::transfer(const Packet *requests, Packet *responses, unsigned int count, const ErrorStack &err) {
+  for (unsigned int i=0; i<count; i++) {
+    if (! send(requests[i], err))
+      return false;
+
+    TransferStatistics::Request stats(_stats, requests[i].size(), 0);
+    if (! receive(responses[i], stats, err))
+      return false;
+    stats.completed(responses[i].size());
+  }
+
+  return true;
+}
+
+bool
+C7000Device::send(const Packet &request, const ErrorStack &err) {
   if (! request.isValid()) {
     errMsg(err) << "Cannot send invalid request.";
     return false;
   }
 
-  uint8_t buffer[64];
-  int bytes_send, bytes_received;
+  // Discard late responses to previous, failed requests
+  if (_drainIn && (! restartReceiving(err))) {
+    errMsg(err) << "Cannot send command to device: Cannot drain pending responses.";
+    return false;
+  }
 
-  memcpy(buffer, request.encoded().constData(), request.encoded().size());
-  int ret = libusb_bulk_transfer(_dev, 0x02, buffer, request.encoded().size(), &bytes_send, 1000);
+  int bytes_send;
+  int ret = libusb_bulk_transfer(_dev, 0x02, (unsigned char *)request.data(), request.size(),
+                                 &bytes_send, 1000);
   if (ret) {
     errMsg(err) << "Cannot send command to device: " << libusb_error_name(ret) << ".";
     return false;
   }
-  QObject().thread()->usleep(1000);
 
+  return true;
+}
+
+bool
+C7000Device::receive(Packet &response, TransferStatistics::Request &stats, const ErrorStack &err) {
+  QElapsedTimer timer; timer.start();
   unsigned int retry_count = 0;
-retry_receive:
-  ret = libusb_bulk_transfer(_dev, 0x81, buffer, 64, &bytes_received, 1000);
-  if (ret) {
-    errMsg(err) << "Cannot receive response from device: " << libusb_error_name(ret) << ".";
-    return false;
-  }
 
-  if (0x68 != buffer[0]) {
+  while (true) {
+    InTransfer &in = _in[_nextIn];
+
+    // Wait for the next pre-submitted transfer to complete
+    while (! in.completed) {
+      qint64 remaining = 1000 - timer.elapsed();
+      if (remaining <= 0) {
+        // The transfer is still pending, a late response must not be taken as the response to
+        // the next request.
+        _drainIn = true;
+        stats.timeout();
+        errMsg(err) << "Cannot receive response from device: Timeout.";
+        return false;
+      }
+      struct timeval tv;
+      tv.tv_sec  = remaining/1000;
+      tv.tv_usec = (remaining%1000)*1000;
+      int ret = libusb_handle_events_timeout_completed(_ctx, &tv, &in.completed);
+      if ((LIBUSB_SUCCESS != ret) && (LIBUSB_ERROR_INTERRUPTED != ret)) {
+        errMsg(err) << "Cannot receive response from device: " << libusb_error_name(ret) << ".";
+        return false;
+      }
+    }
+
+    if (LIBUSB_TRANSFER_COMPLETED != in.transfer->status) {
+      errMsg(err) << "Cannot receive response from device: transfer status "
+                  << in.transfer->status << ".";
+      resubmit(in, err);
+      return false;
+    }
+
+    response = Packet(in.buffer, in.transfer->actual_length);
+
+    if (! resubmit(in, err))
+      return false;
+
+    if (response.isValid())
+      return true;
+
     if ((++retry_count) > 10) {
       errMsg(err) << "Cannot receive response from device: Retry count of 10 exceeded.";
       return false;
     }
-    goto retry_receive;
+    stats.retry();
   }
 
-  response = Packet(QByteArray((const char *)buffer, bytes_received));
-  if (! response.isValid()) {
-    errMsg(err) << "Invalid response received.";
+  return false;
+}
+
+bool
+C7000Device::startReceiving(const ErrorStack &err) {
+  _nextIn = 0;
+  for (unsigned int i=0; i<NumInTransfers; i++) {
+    if (nullptr == (_in[i].transfer = libusb_alloc_transfer(0))) {
+      errMsg(err) << "Cannot allocate receive transfer.";
+      stopReceiving();
+      return false;
+    }
+    libusb_fill_bulk_transfer(_in[i].transfer, _dev, 0x81, _in[i].buffer, MaxPacketSize,
+                              onTransferCompleted, &_in[i], 0);
+    _in[i].completed = 0;
+    int ret = libusb_submit_transfer(_in[i].transfer);
+    if (LIBUSB_SUCCESS != ret) {
+      _in[i].completed = 1;
+      errMsg(err) << "Cannot submit receive transfer: " << libusb_error_name(ret) << ".";
+      stopReceiving();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool
+C7000Device::resubmit(InTransfer &in, const ErrorStack &err) {
+  _nextIn = (_nextIn+1) % NumInTransfers;
+  in.completed = 0;
+  int ret = libusb_submit_transfer(in.transfer);
+  if (LIBUSB_SUCCESS != ret) {
+    in.completed = 1;
+    // The transfers are completed in order, hence all of them must be re-submitted
+    _drainIn = true;
+    errMsg(err) << "Cannot re-submit receive transfer: " << libusb_error_name(ret) << ".";
     return false;
   }
+  return true;
+}
 
+bool
+C7000Device::restartReceiving(const ErrorStack &err) {
+  logDebug() << "Drain pending responses of C7000 device.";
+  stopReceiving();
+  if (! startReceiving(err))
+    return false;
+  _drainIn = false;
   return true;
 }
+
+void
+C7000Device::stopReceiving() {
+  for (unsigned int i=0; i<NumInTransfers; i++) {
+    if ((nullptr != _in[i].transfer) && (! _in[i].completed))
+      libusb_cancel_transfer(_in[i].transfer);
+  }
+
+  for (unsigned int i=0; i<NumInTransfers; i++) {
+    if (nullptr == _in[i].transfer)
+      continue;
+    // Wait for the cancellation to complete, before the transfer gets freed
+    struct timeval tv = { 1, 0 };
+    while (! _in[i].completed) {
+      if (LIBUSB_SUCCESS != libusb_handle_events_timeout_completed(_ctx, &tv, &_in[i].completed))
+        break;
+    }
+    // Do not free a transfer that might still be in use, leak it instead
+    if (! _in[i].completed) {
+      logWarn() << "Cannot cancel receive transfer.";
+      _in[i].transfer = nullptr;
+      continue;
+    }
+    libusb_free_transfer(_in[i].transfer);
+    _in[i].transfer = nullptr;
+    _in[i].completed = 1;
+  }
+}
+
+void LIBUSB_CALL
+C7000Device::onTransferCompleted(libusb_transfer *transfer) {
+  InTransfer *in = reinterpret_cast<InTransfer *>(transfer->user_data);
+  in->completed = 1;
+}
@@ -8,21 +8,39 @@
 
 /** Base class for all C7000 based radios. This class implements the basic communication protocol
  * to these devices.
+ *
+ * The transport is asynchronous: Several IN transfers are submitted to the device in advance,
+ * such that responses are received as soon as the device sends them. There are no fixed delays
+ * between requests and responses.
+ *
  * @ingroup rif */
 class C7000Device : public QObject
 {
   Q_OBJECT
 
 public:
-  /** Request/response packet. */
+  /** Maximum size of a packet in bytes (the size of a single USB bulk transfer). */
+  static const unsigned int MaxPacketSize = 64;
+  /** Maximum payload size of a packet in bytes. */
+  static const unsigned int MaxPayloadSize = MaxPacketSize-9;
+  /** Number of pre-submitted IN transfers. */
+  static const unsigned int NumInTransfers = 4;
+
+  /** Request/response packet. The packet is stored within a fixed-size buffer, hence no memory
+   * gets allocated on framing or parsing packets. */
   struct Packet {
   public:
     /** Default constructor. */
     Packet();
     /** Copy constructor. */
-    Packet(const Packet &other)  = default ;
+    Packet(const Packet &other) = default;
+    /** Constructs a request/response from commands and payload. */
+    Packet(uint8_t command, uint8_t sub, uint8_t flags=0x0f,
+           const uint8_t *payload=nullptr, unsigned int payloadSize=0);
     /** Constructs a request/response from commands and payload. */
-    Packet(uint8_t command, uint8_t sub, uint8_t flags=0x0f, const QByteArray &payload=QByteArray());
+    Packet(uint8_t command, uint8_t sub, uint8_t flags, const QByteArray &payload);
+    /** Constructs a request/response from the given encoded packet. */
+    Packet(const uint8_t *buffer, unsigned int size);
     /** Constructs a request/response from the given encoded packet. */
     Packet(const QByteArray &buffer);
 
@@ -36,12 +54,20 @@ public:
     uint8_t command() const;
     uint8_t subcommand() const;
     uint16_t payloadSize() const;
+    /** Returns a copy of the payload. */
     QByteArray payload() const;
-    const QByteArray &encoded() const;
+    /** Returns a pointer to the payload. */
+    const uint8_t *payloadData() const;
+    /** Returns a pointer to the encoded packet. */
+    const uint8_t *data() const;
+    /** Returns the size of the encoded packet. */
+    unsigned int size() const;
 
   protected:
+    /** Size of the encoded packet, 0 if invalid. */
+    unsigned int _size;
     /** Holds the encoded packet. */
-    QByteArray _encoded;
+    uint8_t _encoded[MaxPacketSize];
   };
 
 public:
@@ -73,12 +99,56 @@ public:
 protected:
   /** Sends the given request to the device and receives the response. */
   bool sendRecv(const Packet &request, Packet &response, const ErrorStack &err=ErrorStack());
+  /** Sends the @c count requests to the device and receives the responses. Each request is
+   * sent once the response to the previous one has been received. */
+  bool transfer(const Packet *requests, Packet *responses, unsigned int count,
+                const ErrorStack &err=ErrorStack());
+
+  /** Sends a single request. */
+  bool send(const Packet &request, const ErrorStack &err=ErrorStack());
+  /** Receives a single response from the next pre-submitted IN transfer. Timeouts and retries
+   * are recorded with the given request statistics. */
+  bool receive(Packet &response, TransferStatistics::Request &stats,
+               const ErrorStack &err=ErrorStack());
+
+  /** Allocates and submits the IN transfers. */
+  bool startReceiving(const ErrorStack &err=ErrorStack());
+  /** Cancels and frees all IN transfers. */
+  void stopReceiving();
+  /** Cancels all IN transfers, discarding any pending response, and submits them again. */
+  bool restartReceiving(const ErrorStack &err=ErrorStack());
+
+private:
+  /** Callback for completed IN transfers. */
+  static void LIBUSB_CALL onTransferCompleted(libusb_transfer *transfer);
 
 protected:
+  /** A pre-submitted IN transfer. */
+  struct InTransfer {
+    /** The libusb transfer object. */
+    libusb_transfer *transfer;
+    /** Set to non-zero by the callback, once the transfer completed. */
+    int completed;
+    /** The receive buffer. */
+    uint8_t buffer[MaxPacketSize];
+  };
+
+  /** Re-submits the given, completed IN transfer and advances to the next one. */
+  bool resubmit(InTransfer &in, const ErrorStack &err=ErrorStack());
+
   /** USB context. */
   libusb_context *_ctx;
   /** USB device object. */
   libusb_device_handle *_dev;
+  /** A weak reference to the transfer statistics to update, may be @c nullptr. */
+  TransferStatistics *_stats;
+  /** The pre-submitted IN transfers, completed in order. */
+  InTransfer _in[NumInTransfers];
+  /** Index of the next IN transfer to complete. */
+  unsigned int _nextIn;
+  /** If set, pending IN transfers may hold late responses to failed requests. These are
+   * cancelled and re-submitted before the next request gets sent. */
+  bool _drainIn;
 };
 
 #endif // C7000DEVICE_HH
@@ -2,6 +2,7 @@
 #include "contact.hh"
 #include "rxgrouplist.hh"
 #include "config.hh"
+#include "compacttable.hh"
 #include "scanlist.hh"
 #include "logger.hh"
 #include <QPushButton>
@@ -597,17 +598,28 @@ DigitalChannel::DigitalChannel(const DigitalChannel &other, QObject *parent)
 /* ********************************************************************************************* *
  * Implementation of DMRChannel
  * ********************************************************************************************* */
+/** Registers the default tags of DMR channels once. Channels may be created concurrently while
+ * decoding a codeplug, hence the registration relies on the thread-safe initialization of static
+ * locals. */
+static void
+registerDefaultTags() {
+  static bool registered = []() {
+    if (! ConfigItem::Context::hasTag(DMRChannel::staticMetaObject.className(), "roaming", "!default"))
+      ConfigItem::Context::setTag(DMRChannel::staticMetaObject.className(), "roaming", "!default", DefaultRoamingZone::get());
+    if (! ConfigItem::Context::hasTag(DMRChannel::staticMetaObject.className(), "radioId", "!default"))
+      ConfigItem::Context::setTag(DMRChannel::staticMetaObject.className(), "radioId", "!default", DefaultRadioID::get());
+    return true;
+  }();
+  Q_UNUSED(registered);
+}
+
 DMRChannel::DMRChannel(QObject *parent)
   : DigitalChannel(parent), _admit(Admit::Always),
     _colorCode(1), _timeSlot(TimeSlot::TS1),
     _rxGroup(), _txContact(), _posSystem(), _roaming(), _radioId(),
     _commercialExtension(nullptr), _anytoneExtension(nullptr)
 {
-  // Register default tags
-  if (! ConfigItem::Context::hasTag(staticMetaObject.className(), "roaming", "!default"))
-    ConfigItem::Context::setTag(staticMetaObject.className(), "roaming", "!default", DefaultRoamingZone::get());
-  if (! ConfigItem::Context::hasTag(staticMetaObject.className(), "radioId", "!default"))
-    ConfigItem::Context::setTag(staticMetaObject.className(), "radioId", "!default", DefaultRadioID::get());
+  registerDefaultTags();
 
   // Set default DMR Id
   _radioId.set(DefaultRadioID::get());
@@ -624,11 +636,7 @@ DMRChannel::DMRChannel(const DMRChannel &other, QObject *parent)
   : DigitalChannel(parent), _rxGroup(), _txContact(), _posSystem(), _roaming(), _radioId(),
   _commercialExtension(nullptr), _anytoneExtension(nullptr)
 {
-  // Register default tags
-  if (! ConfigItem::Context::hasTag(staticMetaObject.className(), "roaming", "!default"))
-    ConfigItem::Context::setTag(staticMetaObject.className(), "roaming", "!default", DefaultRoamingZone::get());
-  if (! ConfigItem::Context::hasTag(staticMetaObject.className(), "radioId", "!default"))
-    ConfigItem::Context::setTag(staticMetaObject.className(), "radioId", "!default", DefaultRadioID::get());
+  registerDefaultTags();
 
   copy(other);
 
@@ -937,11 +945,16 @@ SelectedChannel::get() {
  * Implementation of ChannelList
  * ********************************************************************************************* */
 ChannelList::ChannelList(QObject *parent)
-  : ConfigObjectList(Channel::staticMetaObject, parent)
+  : ConfigObjectList(Channel::staticMetaObject, parent), _compacted(nullptr), _compactedRows()
 {
   // pass...
 }
 
+ChannelList::~ChannelList() {
+  if (_compacted)
+    delete _compacted;
+}
+
 int
 ChannelList::add(ConfigObject *obj, int row, bool unique) {
   if ((nullptr == obj) || (! obj->is<Channel>())) {
@@ -951,6 +964,68 @@ ChannelList::add(ConfigObject *obj, int row, bool unique) {
   return ConfigObjectList::add(obj, row, unique);
 }
 
+void
+ChannelList::clear() {
+  // Drop compacted channels
+  if (_compacted)
+    delete _compacted;
+  _compacted = nullptr;
+  _compactedRows.clear();
+  ConfigObjectList::clear();
+}
+
+int
+ChannelList::compact(Config *config) {
+  if (_compacted)
+    return 0;
+
+  QVector<Channel *> channels;
+  for (int i=0; i<_items.size(); i++) {
+    Channel *channel = _items.at(i)->as<Channel>();
+    // Referenced and extended channels cannot be re-created from the table
+    if (ConfigObjectRegistry::isObserved(channel->handle()) || channel->openGD77ChannelExtension()
+        || channel->tytChannelExtension())
+      continue;
+    if (FMChannel *fm = channel->as<FMChannel>()) {
+      if (fm->anytoneChannelExtension())
+        continue;
+    } else if (DMRChannel *dmr = channel->as<DMRChannel>()) {
+      if (dmr->anytoneChannelExtension() || dmr->commercialExtension())
+        continue;
+    } else {
+      continue;
+    }
+    channels.append(channel);
+    _compactedRows.append(i);
+  }
+  if (channels.isEmpty())
+    return 0;
+
+  _compacted = new ChannelTable(config, channels);
+  foreach (Channel *channel, channels)
+    del(channel);
+
+  return channels.size();
+}
+
+void
+ChannelList::expand(Config *config) {
+  if (nullptr == _compacted)
+    return;
+  for (int i=0; i<_compacted->count(); i++)
+    add(_compacted->materialize(i, config), _compactedRows.at(i), false);
+  delete _compacted;
+  _compacted = nullptr;
+  _compactedRows.clear();
+}
+
+int
+ChannelList::compactedCount() const {
+  if (nullptr == _compacted)
+    return 0;
+  return _compacted->count();
+}
+
 Channel *
 ChannelList::channel(int idx) const {
   if (ConfigItem *obj = get(idx))
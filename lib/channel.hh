@@ -22,6 +22,7 @@ class APRSSystem;
 class PositioningSystem;
 class RoamingZone;
 class DMRRadioID;
+class ChannelTable;
 
 
 /** The base class of all channels (analog and digital) of a codeplug configuration.
@@ -551,8 +552,11 @@ class ChannelList: public ConfigObjectList
 public:
   /** Constructs an empty channel list. */
 	explicit ChannelList(QObject *parent=nullptr);
+  /** Destructor. */
+  virtual ~ChannelList();
 
   int add(ConfigObject *obj, int row=-1, bool unique=true);
+  void clear();
 
   /** Gets the channel at the specified index. */
   Channel *channel(int idx) const;
@@ -561,8 +565,27 @@ public:
   /** Finds an analog channel with the given frequency. */
   FMChannel *findFMChannelByTxFreq(Frequency freq) const;
 
+  /** Moves all FM and DMR channels, that are neither referenced nor extended, into a compact table
+   * (see @c ChannelTable) and deletes them. The references of the compacted channels are kept as
+   * indices into the lists of the given config. Hence, the channels must be compacted before and
+   * expanded after any other list of the config. Returns the number of compacted channels. This
+   * method is used by @c Config::compact only.
+   * @since 0.12.0 */
+  int compact(Config *config);
+  /** Re-creates all compacted channels at their original position, see @c compact.
+   * @since 0.12.0 */
+  void expand(Config *config);
+  /** Returns the number of compacted channels. */
+  int compactedCount() const;
+
 public:
   ConfigItem *allocateChild(const YAML::Node &node, ConfigItem::Context &ctx, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** The compacted channels or @c nullptr if there are none. */
+  ChannelTable *_compacted;
+  /** The original positions of the compacted channels in ascending order. */
+  QVector<int> _compactedRows;
 };
 
 
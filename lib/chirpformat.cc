@@ -4,8 +4,13 @@
 #include "signaling.hh"
 #include "channel.hh"
 #include "config.hh"
+#include "utils.hh"
 
 #include <QStringList>
+#include <QTextStream>
+
+/** Typical size of a line in a CHIRP CSV file, used to reserve the output buffer. */
+#define CHANNEL_LINE_SIZE 128
 
 
 /* ********************************************************************************************* *
@@ -59,16 +64,47 @@ QHash<QString, ChirpFormat::CrossMode> const ChirpFormat::_crossModes = {
 };
 
 
+/* ********************************************************************************************* *
+ * Implementation of ChirpReader::Columns
+ * ********************************************************************************************* */
+ChirpReader::Columns::Columns(const QStringList &header)
+  : name(header.lastIndexOf("Name")), frequency(header.lastIndexOf("Frequency")),
+    duplex(header.lastIndexOf("Duplex")), offset(header.lastIndexOf("Offset")),
+    mode(header.lastIndexOf("Mode")), tone(header.lastIndexOf("Tone")),
+    rToneFreq(header.lastIndexOf("rToneFreq")), cToneFreq(header.lastIndexOf("cToneFreq")),
+    dtcsCode(header.lastIndexOf("DtcsCode")), rxDtcsCode(header.lastIndexOf("RxDtcsCode")),
+    dtcsPolarity(header.lastIndexOf("DtcsPolarity")), crossMode(header.lastIndexOf("CrossMode")),
+    count(header.size())
+{
+  // pass...
+}
+
+
 /* ********************************************************************************************* *
  * Implementation of ChirpReader
  * ********************************************************************************************* */
 bool
 ChirpReader::read(QTextStream &stream, Config *config, const ErrorStack &err) {
+  // Read the entire file at once, all fields are views into this buffer.
+  QString buffer = stream.readAll();
+  buffer.detach();
+
+  QVector<QPair<int, int>> lines;
+  for (int first=0; first<buffer.size(); ) {
+    int last = buffer.indexOf('\n', first);
+    if (0 > last)
+      last = buffer.size();
+    lines.append({first, last});
+    first = last+1;
+  }
+
   // First read header
   QStringList header;
-  if (! readLine(stream, header, err)) {
-    errMsg(err) << "Cannot read CSV header.";
-    return false;
+  if (! lines.isEmpty()) {
+    QVector<QStringRef> fields;
+    readLine(buffer, lines.first().first, lines.first().second, fields);
+    foreach (const QStringRef &field, fields)
+      header.append(field.toString());
   }
 
   // Some trivial sanity checks for the header
@@ -96,58 +132,84 @@ ChirpReader::read(QTextStream &stream, Config *config, const ErrorStack &err) {
     }
   }
 
-  int line=2;
-  while (! stream.atEnd()) {
-    QStringList entry;
-    if (! readLine(stream, entry, err)) {
-      errMsg(err) << "In CSV file line " << line << ": Cannot read line.";
+  // Process lines in parallel
+  Columns columns(header);
+  int n = lines.size()-1;
+  QVector<Entry> entries(n);
+  QVector<ErrorStack> errors(n);
+  QVector<char> failed(n, 0);
+  const QPair<int, int> *lineSpans = lines.constData()+1;
+  Entry *entry = entries.data();
+  ErrorStack *error = errors.data();
+  char *fail = failed.data();
+  parallel_for(n, [&buffer, &columns, lineSpans, entry, error, fail](int i) {
+    QVector<QStringRef> fields;
+    fields.reserve(columns.count);
+    readLine(buffer, lineSpans[i].first, lineSpans[i].second, fields);
+    fail[i] = ! processLine(columns, fields, entry[i], error[i]);
+  });
+
+  // Create channels in order
+  QVector<ConfigObject *> channels;
+  channels.reserve(n);
+  for (int i=0; i<n; i++) {
+    if (failed[i]) {
+      err.take(errors[i]);
+      errMsg(err) << "In CSV file line " << (i+2) << ": Cannot read line.";
+      qDeleteAll(channels);
       return false;
     }
-    if (! processLine(header, entry, config, err)) {
-      errMsg(err) << "In CSV file line " << line << ": Cannot read line.";
-      return false;
+    channels.append(createChannel(entries[i]));
+  }
+
+  if (channels.size() != config->channelList()->append(channels)) {
+    // Rejected channels are not owned by the list, delete them
+    for (int i=0; i<channels.size(); i++) {
+      if (config->channelList() == channels[i]->parent())
+        continue;
+      errMsg(err) << "In CSV file line " << (i+2) << ": Cannot add channel '"
+                  << channels[i]->name() << "'.";
+      delete channels[i];
     }
-    line++;
+    return false;
   }
 
   return true;
 }
 
 
-bool
-ChirpReader::readLine(QTextStream &stream, QStringList &list, const ErrorStack &err) {
-  Q_UNUSED(err)
+void
+ChirpReader::readLine(QString &buffer, int first, int last, QVector<QStringRef> &fields) {
+  fields.clear();
 
-  list.clear();
-  if (stream.atEnd())
-    return true;
+  // Ignore carriage return of DOS line endings
+  if ((last > first) && (QChar('\r') == buffer.at(last-1)))
+    last--;
 
-  QString token;
-  QChar ch; stream >> ch;
+  QChar *data = buffer.data();
+  int start = first, out = first;
   bool string = false;
-  while ((! stream.atEnd()) && (QChar('\n') != ch)) {
+  for (int i=first; i<last; i++) {
+    QChar ch = data[i];
     if ((!string) && (QChar(',') == ch)) {
-      list.append(token); token.clear();
-    } else if ((! string) && (QChar('"') == ch)) {
-      string = true;
-    } else if (string && (QChar('"') == ch)) {
-      string = false;
+      fields.append(QStringRef(&buffer, start, out-start));
+      start = out = i+1;
+    } else if (QChar('"') == ch) {
+      string = !string;
     } else {
-      token.append(ch);
+      // Unquote in place
+      data[out++] = ch;
     }
-    stream >> ch;
   }
 
-  list.append(token);
-
-  return true;
+  fields.append(QStringRef(&buffer, start, out-start));
 }
 
 
 bool
-ChirpReader::processLine(const QStringList &header, const QStringList &line, Config *config, const ErrorStack &err) {
-  if (header.size() != line.size()) {
-    errMsg(err) << "Malformed line. Expected " << header.size() << " entries, got " << line.size() << ".";
+ChirpReader::processLine(const Columns &columns, const QVector<QStringRef> &line, Entry &entry, const ErrorStack &err) {
+  if (columns.count != line.size()) {
+    errMsg(err) << "Malformed line. Expected " << columns.count << " entries, got " << line.size() << ".";
     return false;
   }
 
@@ -157,67 +219,74 @@ ChirpReader::processLine(const QStringList &header, const QStringList &line, Con
   Duplex duplex = Duplex::None;
   Mode mode = Mode::FM;
   ToneMode toneMode = ToneMode::None;
-  CrossMode crossMode;
+  CrossMode crossMode = CrossMode::ToneTone;
   double txTone = 67.0, rxTone = 67.0;
   int txDTCSCode = 000, rxDTCSCode = 000;
   Polarity txPol = Polarity::Normal, rxPol = Polarity::Normal;
 
-  for (int i=1; i<header.size(); i++) {
-    if ("Name" == header.at(i)) {
-      name = line.at(i).simplified();
-    } else if ("Frequency" == header.at(i)) {
-      rxFrequency = Frequency::fromMHz(line.at(i).toDouble(&ok));
-      if (! ok) {
-        errMsg(err) << "Cannot parse frequency '" << line.at(i) << "': Malformed frequency.";
-        return false;
-      }
-    } else if (("Offset" == header.at(i)) && (! line.at(i).isEmpty())) {
-      txFrequency = Frequency::fromMHz(line.at(i).toDouble(&ok));
-      if (! ok) {
-        errMsg(err) << "Cannot parse offset frequency '" << line.at(i) << "': Malformed frequency.";
-        return false;
-      }
-    } else if ("Duplex" == header.at(i)) {
-      if (! processDuplex(line.at(i), duplex, err))
-        return false;
-    } else if ("Mode" == header.at(i)) {
-      if (! processMode(line.at(i), mode, err))
-        return false;
-    } else if ("Tone" == header.at(i)) {
-      if (! processToneMode(line.at(i), toneMode, err))
-        return false;
-    } else if (("rToneFreq" == header.at(i)) && (! line.at(i).isEmpty())) {
-      txTone = line.at(i).toDouble(&ok);
-      if (! ok) {
-        errMsg(err) << "Cannot parse TX CTCSS tone frequency '" << line.at(i) << "'.";
-        return false;
-      }
-    } else if (("cToneFreq" == header.at(i)) && (! line.at(i).isEmpty())) {
-      rxTone = line.at(i).toDouble(&ok);
-      if (! ok) {
-        errMsg(err) << "Cannot parse RX CTCSS tone frequency '" << line.at(i) << "'.";
-        return false;
-      }
-    } else if (("DtcsCode" == header.at(i)) && (! line.at(i).isEmpty())) {
-      txDTCSCode = line.at(i).toUInt(&ok);
-      if (! ok) {
-        errMsg(err) << "Cannot decode TX DCS code '" << line.at(i) <<"': invalid format.";
-        return false;
-      }
-    } else if (("RxDtcsCode" == header.at(i)) && (! line.at(i).isEmpty())) {
-      rxDTCSCode = line.at(i).toUInt(&ok);
-      if (! ok) {
-        errMsg(err) << "Cannot decode RX DCS code '" << line.at(i) <<"': invalid format.";
-        return false;
-      }
-    } else if ("DtcsPolarity" == header.at(i)) {
-      if (! processPolarity(line.at(i), txPol, rxPol, err))
-        return false;
-    } else if ("CrossMode" == header.at(i)) {
-      if (! processCrossMode(line.at(i), crossMode, err))
-        return false;
+  if (0 < columns.name) {
+    name = line.at(columns.name).toString().simplified();
+  }
+  if (0 < columns.frequency) {
+    const QStringRef &field = line.at(columns.frequency);
+    rxFrequency = Frequency::fromMHz(field.toDouble(&ok));
+    if (! ok) {
+      errMsg(err) << "Cannot parse frequency '" << field.toString() << "': Malformed frequency.";
+      return false;
+    }
+  }
+  if ((0 < columns.offset) && (! line.at(columns.offset).isEmpty())) {
+    const QStringRef &field = line.at(columns.offset);
+    txFrequency = Frequency::fromMHz(field.toDouble(&ok));
+    if (! ok) {
+      errMsg(err) << "Cannot parse offset frequency '" << field.toString() << "': Malformed frequency.";
+      return false;
+    }
+  }
+  if ((0 < columns.duplex) && (! processDuplex(line.at(columns.duplex).toString(), duplex, err)))
+    return false;
+  if ((0 < columns.mode) && (! processMode(line.at(columns.mode).toString(), mode, err)))
+    return false;
+  if ((0 < columns.tone) && (! processToneMode(line.at(columns.tone).toString(), toneMode, err)))
+    return false;
+  if ((0 < columns.rToneFreq) && (! line.at(columns.rToneFreq).isEmpty())) {
+    const QStringRef &field = line.at(columns.rToneFreq);
+    txTone = field.toDouble(&ok);
+    if (! ok) {
+      errMsg(err) << "Cannot parse TX CTCSS tone frequency '" << field.toString() << "'.";
+      return false;
+    }
+  }
+  if ((0 < columns.cToneFreq) && (! line.at(columns.cToneFreq).isEmpty())) {
+    const QStringRef &field = line.at(columns.cToneFreq);
+    rxTone = field.toDouble(&ok);
+    if (! ok) {
+      errMsg(err) << "Cannot parse RX CTCSS tone frequency '" << field.toString() << "'.";
+      return false;
+    }
+  }
+  if ((0 < columns.dtcsCode) && (! line.at(columns.dtcsCode).isEmpty())) {
+    const QStringRef &field = line.at(columns.dtcsCode);
+    txDTCSCode = field.toUInt(&ok);
+    if (! ok) {
+      errMsg(err) << "Cannot decode TX DCS code '" << field.toString() <<"': invalid format.";
+      return false;
     }
   }
+  if ((0 < columns.rxDtcsCode) && (! line.at(columns.rxDtcsCode).isEmpty())) {
+    const QStringRef &field = line.at(columns.rxDtcsCode);
+    rxDTCSCode = field.toUInt(&ok);
+    if (! ok) {
+      errMsg(err) << "Cannot decode RX DCS code '" << field.toString() <<"': invalid format.";
+      return false;
+    }
+  }
+  if ((0 < columns.dtcsPolarity) &&
+      (! processPolarity(line.at(columns.dtcsPolarity).toString(), txPol, rxPol, err)))
+    return false;
+  if ((0 < columns.crossMode) &&
+      (! processCrossMode(line.at(columns.crossMode).toString(), crossMode, err)))
+    return false;
 
   // Some more sanity checks:
   if (name.isEmpty()) {
@@ -225,98 +294,108 @@ ChirpReader::processLine(const QStringList &header, const QStringList &line, Con
     return false;
   }
 
-  if ((Mode::FM == mode) || (Mode::NFM == mode)) {
-    FMChannel *fm = new FMChannel();
+  if ((Mode::FM != mode) && (Mode::NFM != mode)) {
+    errMsg(err) << "Unhandled channel format.";
+    return false;
+  }
 
-    fm->setName(name);
-    fm->setRXFrequency(rxFrequency);
+  entry.name = name;
+  entry.rxFrequency = rxFrequency;
+
+  switch (duplex) {
+  case Duplex::None:
+    entry.txFrequency = rxFrequency;
+    break;
+  case Duplex::Off:
+    entry.txFrequency = rxFrequency;
+    entry.rxOnly = true;
+    break;
+  case Duplex::Split:
+    entry.txFrequency = txFrequency;
+    break;
+  case Duplex::Negative:
+    entry.txFrequency = Frequency::fromHz(rxFrequency.inHz()-txFrequency.inHz());
+    break;
+  case Duplex::Positive:
+    entry.txFrequency = Frequency::fromHz(rxFrequency.inHz()+txFrequency.inHz());
+    break;
+  }
 
-    switch (duplex) {
-    case Duplex::None:
-      fm->setTXFrequency(fm->rxFrequency());
+  switch (toneMode) {
+  case ToneMode::None:
+    entry.txTone = SelectiveCall();
+    entry.rxTone = SelectiveCall();
+    break;
+  case ToneMode::Tone:
+    entry.txTone = SelectiveCall(txTone);
+    entry.rxTone = SelectiveCall();
+    break;
+  case ToneMode::TSQL:
+    entry.txTone = SelectiveCall(rxTone);
+    entry.rxTone = SelectiveCall(rxTone);
+    break;
+  case ToneMode::TSQL_R:
+    errMsg(err) << "Reversed CTCSS not supported.";
+    return false;
+  case ToneMode::DTCS:
+    entry.txTone = SelectiveCall(txDTCSCode, Polarity::Reversed == txPol);
+    entry.rxTone = SelectiveCall(txDTCSCode, Polarity::Reversed == rxPol);
+    break;
+  case ToneMode::DTCS_R:
+    errMsg(err) << "Reversed DCS not supported.";
+    return false;
+  case ToneMode::Cross:
+    switch (crossMode) {
+    case CrossMode::NoneTone:
+      entry.txTone = SelectiveCall();
+      entry.rxTone = SelectiveCall(rxTone);
       break;
-    case Duplex::Off:
-      fm->setTXFrequency(fm->rxFrequency());
-      fm->setRXOnly(true);
+    case CrossMode::NoneDTCS:
+      entry.txTone = SelectiveCall();
+      entry.rxTone = SelectiveCall(rxDTCSCode, Polarity::Reversed == rxPol);
       break;
-    case Duplex::Split:
-      fm->setTXFrequency(txFrequency);
+    case CrossMode::ToneNone:
+      entry.txTone = SelectiveCall(txTone);
+      entry.rxTone = SelectiveCall();
       break;
-    case Duplex::Negative:
-      fm->setTXFrequency(Frequency::fromHz(rxFrequency.inHz()-txFrequency.inHz()));
+    case CrossMode::ToneTone:
+      entry.txTone = SelectiveCall(txTone);
+      entry.rxTone = SelectiveCall(rxTone);
       break;
-    case Duplex::Positive:
-      fm->setTXFrequency(Frequency::fromHz(rxFrequency.inHz()+txFrequency.inHz()));
+    case CrossMode::ToneDTCS:
+      entry.txTone = SelectiveCall(txTone);
+      entry.rxTone = SelectiveCall(rxDTCSCode, Polarity::Reversed == rxPol);
       break;
-    }
-
-    switch (toneMode) {
-    case ToneMode::None:
-      fm->setTXTone(SelectiveCall());
-      fm->setRXTone(SelectiveCall());
-      break;
-    case ToneMode::Tone:
-      fm->setTXTone(SelectiveCall(txTone));
-      fm->setRXTone(SelectiveCall());
+    case CrossMode::DTCSNone:
+      entry.txTone = SelectiveCall(txDTCSCode, Polarity::Reversed == txPol);
+      entry.rxTone = SelectiveCall();
       break;
-    case ToneMode::TSQL:
-      fm->setTXTone(SelectiveCall(rxTone));
-      fm->setRXTone(SelectiveCall(rxTone));
+    case CrossMode::DTCSTone:
+      entry.txTone = SelectiveCall(txDTCSCode, Polarity::Reversed == txPol);
+      entry.rxTone = SelectiveCall(rxTone);
       break;
-    case ToneMode::TSQL_R:
-      errMsg(err) << "Reversed CTCSS not supported.";
-      return false;
-    case ToneMode::DTCS:
-      fm->setTXTone(SelectiveCall(txDTCSCode, Polarity::Reversed == txPol));
-      fm->setRXTone(SelectiveCall(txDTCSCode, Polarity::Reversed == rxPol));
+    case CrossMode::DTCSDTCS:
+      entry.txTone = SelectiveCall(txDTCSCode, Polarity::Reversed == txPol);
+      entry.rxTone = SelectiveCall(rxDTCSCode, Polarity::Reversed == rxPol);
       break;
-    case ToneMode::DTCS_R:
-      errMsg(err) << "Reversed DCS not supported.";
-      return false;
-    case ToneMode::Cross:
-      switch (crossMode) {
-      case CrossMode::NoneTone:
-        fm->setTXTone(SelectiveCall());
-        fm->setRXTone(SelectiveCall(rxTone));
-        break;
-      case CrossMode::NoneDTCS:
-        fm->setTXTone(SelectiveCall());
-        fm->setRXTone(SelectiveCall(rxDTCSCode, Polarity::Reversed == rxPol));
-        break;
-      case CrossMode::ToneNone:
-        fm->setTXTone(SelectiveCall(txTone));
-        fm->setRXTone(SelectiveCall());
-        break;
-      case CrossMode::ToneTone:
-        fm->setTXTone(SelectiveCall(txTone));
-        fm->setRXTone(SelectiveCall(rxTone));
-        break;
-      case CrossMode::ToneDTCS:
-        fm->setTXTone(SelectiveCall(txTone));
-        fm->setRXTone(SelectiveCall(rxDTCSCode, Polarity::Reversed == rxPol));
-        break;
-      case CrossMode::DTCSNone:
-        fm->setTXTone(SelectiveCall(txDTCSCode, Polarity::Reversed == txPol));
-        fm->setRXTone(SelectiveCall());
-        break;
-      case CrossMode::DTCSTone:
-        fm->setTXTone(SelectiveCall(txDTCSCode, Polarity::Reversed == txPol));
-        fm->setRXTone(SelectiveCall(rxTone));
-        break;
-      case CrossMode::DTCSDTCS:
-        fm->setTXTone(SelectiveCall(txDTCSCode, Polarity::Reversed == txPol));
-        fm->setRXTone(SelectiveCall(rxDTCSCode, Polarity::Reversed == rxPol));
-        break;
-      }
     }
-
-    config->channelList()->add(fm);
-    return true;
   }
 
-  errMsg(err) << "Unhandled channel format.";
+  return true;
+}
+
 
-  return false;
+FMChannel *
+ChirpReader::createChannel(const Entry &entry) {
+  FMChannel *fm = new FMChannel();
+  fm->setName(entry.name);
+  fm->setRXFrequency(entry.rxFrequency);
+  fm->setTXFrequency(entry.txFrequency);
+  if (entry.rxOnly)
+    fm->setRXOnly(true);
+  fm->setTXTone(entry.txTone);
+  fm->setRXTone(entry.rxTone);
+  return fm;
 }
 
 
@@ -396,7 +475,18 @@ ChirpReader::processCrossMode(const QString &code, CrossMode &crossMode, const E
  * ********************************************************************************************* */
 bool
 ChirpWriter::write(QTextStream &stream, Config *config, const ErrorStack &err) {
-  if (! writeHeader(stream, err)) {
+  // Assemble the entire file in memory, using the number formatting of the given stream, and write
+  // it at once.
+  QString buffer;
+  buffer.reserve(CHANNEL_LINE_SIZE*(config->channelList()->count()+1));
+  QTextStream out(&buffer, QIODevice::WriteOnly);
+  out.setLocale(stream.locale());
+  out.setNumberFlags(stream.numberFlags());
+  out.setIntegerBase(stream.integerBase());
+  out.setRealNumberNotation(stream.realNumberNotation());
+  out.setRealNumberPrecision(stream.realNumberPrecision());
+
+  if (! writeHeader(out, err)) {
     errMsg(err) << "Cannot write CHIRP CSV file.";
     return false;
   }
@@ -404,7 +494,7 @@ ChirpWriter::write(QTextStream &stream, Config *config, const ErrorStack &err) {
   for (int i=0, j=0; i<config->channelList()->count(); i++) {
     if (! config->channelList()->channel(i)->is<FMChannel>())
       continue;
-    if (! writeChannel(stream, j, config->channelList()->channel(i)->as<FMChannel>(), err)) {
+    if (! writeChannel(out, j, config->channelList()->channel(i)->as<FMChannel>(), err)) {
       errMsg(err) << "Cannot encode FM channel '" << config->channelList()->channel(i)->name()
                   << "'.";
       return false;
@@ -412,6 +502,9 @@ ChirpWriter::write(QTextStream &stream, Config *config, const ErrorStack &err) {
     j++;
   }
 
+  out.flush();
+  stream << buffer;
+
   return true;
 }
 
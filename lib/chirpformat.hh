@@ -9,11 +9,14 @@
 #define CHIRPFORMAT_HH
 
 #include "errorstack.hh"
+#include "frequency.hh"
+#include "signaling.hh"
 #include <QSet>
+#include <QVector>
+#include <QStringList>
 
 class QTextStream;
 class Config;
-class QStringList;
 class FMChannel;
 
 
@@ -99,15 +102,50 @@ public:
   static bool read(QTextStream &stream, Config *config, const ErrorStack &err=ErrorStack());
 
 protected:
-  /** Internal used method to read a line from the given stream.
-   * This method also implements the proper quotation parsing of strings. */
-  static bool readLine(QTextStream &stream, QStringList &list, const ErrorStack &err=ErrorStack());
+  /** Column indices of all known fields, resolved once from the header. Missing columns have
+   * the index -1. */
+  struct Columns {
+    int name;         ///< Index of the "Name" column.
+    int frequency;    ///< Index of the "Frequency" column.
+    int duplex;       ///< Index of the "Duplex" column.
+    int offset;       ///< Index of the "Offset" column.
+    int mode;         ///< Index of the "Mode" column.
+    int tone;         ///< Index of the "Tone" column.
+    int rToneFreq;    ///< Index of the "rToneFreq" column.
+    int cToneFreq;    ///< Index of the "cToneFreq" column.
+    int dtcsCode;     ///< Index of the "DtcsCode" column.
+    int rxDtcsCode;   ///< Index of the "RxDtcsCode" column.
+    int dtcsPolarity; ///< Index of the "DtcsPolarity" column.
+    int crossMode;    ///< Index of the "CrossMode" column.
+    int count;        ///< Total number of columns.
+
+    /** Resolves the column indices from the given header. */
+    explicit Columns(const QStringList &header);
+  };
 
-  /** Line parser, the header must be read before and passed to this method. The parsed channel is
-   * added to the configuration. */
-  static bool processLine(const QStringList &header, const QStringList &line,
-                          Config *config, const ErrorStack &err=ErrorStack());
+  /** The FM channel settings parsed from a single line. */
+  struct Entry {
+    QString name;              ///< Channel name.
+    Frequency rxFrequency;     ///< RX frequency.
+    Frequency txFrequency;     ///< TX frequency.
+    bool rxOnly = false;       ///< RX only flag.
+    SelectiveCall txTone;      ///< TX sub tone.
+    SelectiveCall rxTone;      ///< RX sub tone.
+  };
 
+protected:
+  /** Internal used method to split the line [first, last) of the given buffer into fields.
+   * This method also implements the proper quotation parsing of strings. The quotes are removed
+   * in place, such that all fields are views into the buffer. Hence, the buffer must not be
+   * shared. Different lines of the same buffer can be split concurrently. */
+  static void readLine(QString &buffer, int first, int last, QVector<QStringRef> &fields);
+  /** Line parser, the header must be read before and passed to this method. The parsed channel
+   * settings are stored in @c entry. This method does not modify any shared state and may be
+   * called concurrently. */
+  static bool processLine(const Columns &columns, const QVector<QStringRef> &line,
+                          Entry &entry, const ErrorStack &err=ErrorStack());
+  /** Creates the FM channel for the given entry. */
+  static FMChannel *createChannel(const Entry &entry);
   /** Helper function to parse a duplex column. */
   static bool processDuplex(const QString &code, Duplex &duplex, const ErrorStack &err=ErrorStack());
   /** Helper function to parse a mode column. */
@@ -4,6 +4,10 @@
 #include "logger.hh"
 #include "roamingchannel.hh"
 #include "configcopyvisitor.hh"
+#include "utils.hh"
+
+/** Indices below this limit are stored in dense vectors in the codeplug context. */
+#define MAX_DENSE_INDEX 0x10000
 
 
 /* ********************************************************************************************* *
@@ -652,7 +656,7 @@ Codeplug::Element::writeUnicode(unsigned offset, const QString &txt, unsigned ma
  * Implementation of CodePlug::Context
  * ********************************************************************************************* */
 Codeplug::Context::Context(Config *config)
-  : _config(config), _tables()
+  : _config(config), _tables(), _tableIndices(), _resolved()
 {
   // Add tables for common elements
   addTable(&DMRRadioID::staticMetaObject);
@@ -674,55 +678,85 @@ Codeplug::Context::config() const {
   return _config;
 }
 
-bool
-Codeplug::Context::hasTable(const QMetaObject *obj) const {
-  // Find a matching table
-  if (_tables.contains(obj->className()))
-    return true;
-  else if (obj->superClass())
-    return hasTable(obj->superClass());
-  return false;
+int
+Codeplug::Context::tableIndex(const QMetaObject *type) const {
+  QHash<const QMetaObject *, int>::const_iterator cached = _resolved.constFind(type);
+  if (_resolved.constEnd() != cached)
+    return cached.value();
+
+  // Find a matching table for the type or one of its super classes
+  int table = -1;
+  for (const QMetaObject *t = type; (nullptr != t) && (0 > table); t = t->superClass())
+    table = _tableIndices.value(t, -1);
+
+  _resolved.insert(type, table);
+  return table;
 }
 
-Codeplug::Context::Table &
-Codeplug::Context::getTable(const QMetaObject *obj) {
-  if (_tables.contains(obj->className()))
-    return _tables[obj->className()];
-  return getTable(obj->superClass());
+bool
+Codeplug::Context::hasTable(const QMetaObject *obj) const {
+  return 0 <= tableIndex(obj);
 }
 
 bool
 Codeplug::Context::addTable(const QMetaObject *obj) {
   if (hasTable(obj))
     return false;
-  _tables.insert(obj->className(), Table());
+  _tableIndices.insert(obj, _tables.size());
+  _tables.append(Table());
+  // Types without table may resolve to the new one now
+  _resolved.clear();
   return true;
 }
 
+unsigned int
+Codeplug::Context::count(const QMetaObject *elementType) const {
+  int table = tableIndex(elementType);
+  if (0 > table)
+    return 0;
+  return _tables[table].indices.size();
+}
+
 ConfigItem *
 Codeplug::Context::obj(const QMetaObject *elementType, unsigned idx) {
-  if (! hasTable(elementType))
+  int table = tableIndex(elementType);
+  if (0 > table)
     return nullptr;
-  return getTable(elementType).objects.value(idx, nullptr);
+  const Table &tab = _tables[table];
+  if (idx < unsigned(tab.objects.size()))
+    return tab.objects[idx];
+  return tab.sparse.value(idx, nullptr);
 }
 
 int
 Codeplug::Context::index(ConfigItem *obj) {
   if (nullptr == obj)
     return -1;
-  if (! hasTable(obj->metaObject()))
+  int table = tableIndex(obj->metaObject());
+  if (0 > table)
     return -1;
-  return getTable(obj->metaObject()).indices.value(obj, -1);
+  return _tables[table].indices.value(obj, -1);
 }
 
 bool
 Codeplug::Context::add(ConfigItem *obj, unsigned idx) {
-  if (!hasTable(obj->metaObject()))
+  int table = tableIndex(obj->metaObject());
+  if (0 > table)
     return false;
-  if (! getTable(obj->metaObject()).indices.contains(obj))
-    getTable(obj->metaObject()).indices.insert(obj, idx);
-  if (! getTable(obj->metaObject()).objects.contains(idx))
-    getTable(obj->metaObject()).objects.insert(idx, obj);
+
+  Table &tab = _tables[table];
+  if (! tab.indices.contains(obj))
+    tab.indices.insert(obj, idx);
+
+  if (idx < MAX_DENSE_INDEX) {
+    if (idx >= unsigned(tab.objects.size()))
+      tab.objects.resize(idx+1);
+    if (nullptr == tab.objects[idx])
+      tab.objects[idx] = obj;
+  } else if (! tab.sparse.contains(idx)) {
+    tab.sparse.insert(idx, obj);
+  }
+
   return true;
 }
 
@@ -731,7 +765,7 @@ Codeplug::Context::add(ConfigItem *obj, unsigned idx) {
  * Implementation of CodePlug
  * ********************************************************************************************* */
 Codeplug::Codeplug(QObject *parent)
-  : DFUFile(parent)
+  : DFUFile(parent), _lazy(false), _deferred()
 {
 	// pass...
 }
@@ -742,11 +776,48 @@ Codeplug::~Codeplug() {
 
 Config *
 Codeplug::preprocess(Config *config, const ErrorStack &err) const {
+  if (! config->materialize(err))
+    return nullptr;
   return ConfigCopy::copy(config, err)->as<Config>();
 }
 
+bool
+Codeplug::lazyDecoding() const {
+  return _lazy;
+}
+
+void
+Codeplug::setLazyDecoding(bool enable) {
+  _lazy = enable;
+}
+
+bool
+Codeplug::materializeDeferred(const ErrorStack &err) {
+  if (_deferred.isNull())
+    return true;
+  Config *config = _deferred;
+  _deferred.clear();
+  return config->materialize(err);
+}
+
+void
+Codeplug::deferDecoding(Config *config, const std::function<bool(const ErrorStack &)> &decode) {
+  // Only one config is decoded lazily at a time
+  materializeDeferred();
+  _deferred = config;
+  config->defer([decode](Config *config, const ErrorStack &err) {
+    Q_UNUSED(config);
+    return decode(err);
+  });
+}
+
 bool
 Codeplug::postprocess(Config *config, const ErrorStack &err) const {
   Q_UNUSED(config); Q_UNUSED(err);
   return true;
 }
+
+void
+Codeplug::parallelFor(int n, const std::function<void(int)> &fn) {
+  parallel_for(n, fn);
+}
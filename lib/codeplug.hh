@@ -3,6 +3,10 @@
 
 #include <QObject>
 #include <QHash>
+#include <QVector>
+#include <QThread>
+#include <QPointer>
+#include <functional>
 #include "dfufile.hh"
 
 //#include "userdatabase.hh"
@@ -294,28 +298,38 @@ public:
     /** Returns the number of elements for the specified type. */
     template <class T>
     unsigned int count() {
-      return getTable(&T::staticMetaObject).indices.size();
+      return this->count(&T::staticMetaObject);
     }
 
+    /** Returns the number of elements for the specified type. */
+    unsigned int count(const QMetaObject *elementType) const;
+
   protected:
     /** Internal used table type to associate objects and indices. */
     class Table {
     public:
-      /** The index->object map. */
-      QHash<unsigned, ConfigItem *> objects;
+      /** The index->object map for small indices, unused indices are @c nullptr. */
+      QVector<ConfigItem *> objects;
+      /** The index->object map for large indices. */
+      QHash<unsigned, ConfigItem *> sparse;
       /** The object->index map. */
       QHash<ConfigItem *, unsigned> indices;
     };
 
   protected:
-    /** Returns a reference to the table for the given type. */
-    Table &getTable(const QMetaObject *obj);
+    /** Returns the index of the table for the given type or one of its super classes.
+     * @returns -1 if there is no table for the given type. */
+    int tableIndex(const QMetaObject *type) const;
 
   protected:
     /** A weak reference to the config object. */
     Config *_config;
     /** Table of tables. */
-    QHash<QString, Table> _tables;
+    QVector<Table> _tables;
+    /** Maps the registered types to their table. */
+    QHash<const QMetaObject *, int> _tableIndices;
+    /** Caches the resolved table for every type seen so far, including derived types. */
+    mutable QHash<const QMetaObject *, int> _resolved;
   };
 
 protected:
@@ -345,6 +359,59 @@ public:
   /** Encodes a given abstract configuration (@c config) to the device specific binary code-plug.
    * This must be implemented by the device-specific codeplug. */
   virtual bool encode(Config *config, const Flags &flags=Flags(), const ErrorStack &err=ErrorStack()) = 0;
+
+  /** Returns @c true if the lazy decoding is enabled. */
+  bool lazyDecoding() const;
+  /** Enables or disables the lazy decoding.
+   *
+   * If enabled, only the settings are decoded right away. The lists of the config (e.g., contacts,
+   * channels and zones) stay empty until @c Config::materialize is called, which decodes them from
+   * the binary codeplug. Hence, the codeplug must be kept resident until then. Clearing, encoding
+   * or destroying the codeplug materializes the config first. Codeplugs that do not implement the
+   * lazy decoding, always decode all elements. Only useful if the lists may not be needed at all
+   * or later, e.g., qdmr shows the settings of a downloaded codeplug first.
+   * @since 0.12.0 */
+  void setLazyDecoding(bool enable);
+
+  /** Decodes the deferred elements of the config decoded lazily last, if there are any.
+   * Must be called before the binary codeplug gets altered.
+   * @since 0.12.0 */
+  bool materializeDeferred(const ErrorStack &err=ErrorStack());
+
+protected:
+  /** Defers the decoding of the lists of the given config to the given function, see
+   * @c setLazyDecoding. */
+  void deferDecoding(Config *config, const std::function<bool(const ErrorStack &err)> &decode);
+
+protected:
+  /** Calls @c fn for all indices from 0 to @c n-1. If @c n is large enough, the calls are
+   * distributed over several worker threads. Returns once all calls are finished. */
+  static void parallelFor(int n, const std::function<void(int)> &fn);
+
+  /** Creates @c n config items (e.g., channels or contacts) in parallel using @c create. The
+   * created items are moved to the calling thread and returned in the order of their index, such
+   * that they can be added to the config and context deterministically afterwards. The @c create
+   * function must not modify any shared state, in particular, the pointers to the codeplug
+   * elements must be resolved beforehand. */
+  template <class T>
+  static QVector<T *> createParallel(int n, const std::function<T *(int)> &create) {
+    QVector<T *> items(n, nullptr);
+    T **result = items.data();
+    QThread *thread = QThread::currentThread();
+    parallelFor(n, [result, thread, &create](int i) {
+      if (T *item = create(i)) {
+        item->moveItemToThread(thread);
+        result[i] = item;
+      }
+    });
+    return items;
+  }
+
+protected:
+  /** If @c true, the lazy decoding is enabled. */
+  bool _lazy;
+  /** The config decoded lazily last. */
+  QPointer<Config> _deferred;
 };
 
 #endif // CODEPLUG_HH
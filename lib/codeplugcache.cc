@@ -0,0 +1,165 @@
+#include "codeplugcache.hh"
+#include "config.hh"
+#include "logger.hh"
+
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QDir>
+#include <QFile>
+
+
+/* ********************************************************************************************* *
+ * Implementation of CodeplugCache
+ * ********************************************************************************************* */
+CodeplugCache::CodeplugCache(const QString &path)
+  : _path(path.isEmpty() ? defaultPath() : path)
+{
+  // pass...
+}
+
+const QString &
+CodeplugCache::path() const {
+  return _path;
+}
+
+QString
+CodeplugCache::defaultPath() {
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/codeplugs";
+}
+
+QByteArray
+CodeplugCache::key(Config *config, const QString &radio, const Codeplug::Flags &flags, const ErrorStack &err) {
+  QString yaml;
+  QTextStream stream(&yaml);
+  if (! config->toYAML(stream, err)) {
+    errMsg(err) << "Cannot compute cache key for codeplug.";
+    return QByteArray();
+  }
+  stream.flush();
+
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(radio.toLower().toUtf8());
+  hash.addData(QByteArray(1, 0));
+  hash.addData(QByteArray(1, char(flags.updateCodePlug ? 1 : 0)));
+  hash.addData(QByteArray(1, char(flags.autoEnableGPS ? 1 : 0)));
+  hash.addData(QByteArray(1, char(flags.autoEnableRoaming ? 1 : 0)));
+  hash.addData(yaml.toUtf8());
+  return hash.result().toHex();
+}
+
+bool
+CodeplugCache::isCacheable(const Codeplug::Flags &flags) {
+  return ! flags.updateCodePlug;
+}
+
+bool
+CodeplugCache::contains(const QByteArray &key) const {
+  return (! key.isEmpty()) && QFile::exists(filename(key));
+}
+
+QString
+CodeplugCache::filename(const QByteArray &key) const {
+  return _path + "/" + QString::fromLatin1(key) + ".dfu";
+}
+
+bool
+CodeplugCache::load(const QByteArray &key, const Codeplug::Flags &flags, DFUFile &image, const ErrorStack &err) const {
+  if (! isCacheable(flags)) {
+    errMsg(err) << "Cannot load codeplug from cache: Updated codeplugs are not cached.";
+    return false;
+  }
+
+  if (! contains(key))
+    return false;
+
+  if (! image.read(filename(key), err)) {
+    errMsg(err) << "Cannot read cached codeplug '" << filename(key) << "'.";
+    return false;
+  }
+
+  logDebug() << "Loaded codeplug from cache '" << filename(key) << "'.";
+  return true;
+}
+
+bool
+CodeplugCache::store(const QByteArray &key, const Codeplug::Flags &flags, DFUFile &image, const ErrorStack &err) const {
+  if (! isCacheable(flags)) {
+    errMsg(err) << "Cannot store codeplug in cache: Updated codeplugs depend on the radio.";
+    return false;
+  }
+
+  if (key.isEmpty()) {
+    errMsg(err) << "Cannot store codeplug in cache: Invalid key.";
+    return false;
+  }
+
+  if (! QDir().mkpath(_path)) {
+    errMsg(err) << "Cannot create cache directory '" << _path << "'.";
+    return false;
+  }
+
+  // Write into a temporary file first, to avoid corrupted cache entries
+  QString tmpname = filename(key) + ".tmp";
+  if (! image.write(tmpname, err)) {
+    errMsg(err) << "Cannot store codeplug in cache.";
+    QFile::remove(tmpname);
+    return false;
+  }
+  QFile::remove(filename(key));
+  if (! QFile::rename(tmpname, filename(key))) {
+    errMsg(err) << "Cannot store codeplug in cache: Cannot rename '" << tmpname << "'.";
+    QFile::remove(tmpname);
+    return false;
+  }
+
+  logDebug() << "Stored codeplug in cache '" << filename(key) << "'.";
+  return true;
+}
+
+bool
+CodeplugCache::verify(const QByteArray &key, const DFUFile &image, const ErrorStack &err) const {
+  DFUFile cached;
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  if (! load(key, flags, cached, err)) {
+    errMsg(err) << "Cannot verify codeplug: Not cached.";
+    return false;
+  }
+
+  if (cached.numImages() != image.numImages()) {
+    errMsg(err) << "Cached codeplug differs: Expected " << cached.numImages()
+                << " images, got " << image.numImages() << ".";
+    return false;
+  }
+
+  for (int i=0; i<image.numImages(); i++) {
+    const DFUFile::Image &a = cached.image(i), &b = image.image(i);
+    if (a.numElements() != b.numElements()) {
+      errMsg(err) << "Cached codeplug differs: Expected " << a.numElements()
+                  << " elements in image " << i << ", got " << b.numElements() << ".";
+      return false;
+    }
+    for (int j=0; j<b.numElements(); j++) {
+      if ((a.element(j).address() != b.element(j).address()) ||
+          (a.element(j).data() != b.element(j).data())) {
+        errMsg(err) << "Cached codeplug differs in image " << i << " at element " << j
+                    << " (addr=" << QString::number(b.element(j).address(), 16) << "h).";
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool
+CodeplugCache::clear() const {
+  QDir dir(_path);
+  if (! dir.exists())
+    return true;
+
+  bool success = true;
+  foreach (QString entry, dir.entryList(QStringList() << "*.dfu", QDir::Files))
+    success &= dir.remove(entry);
+  return success;
+}
@@ -0,0 +1,78 @@
+#ifndef CODEPLUGCACHE_HH
+#define CODEPLUGCACHE_HH
+
+#include <QString>
+#include <QByteArray>
+#include "codeplug.hh"
+#include "errorstack.hh"
+
+class Config;
+
+/** An on-disk cache of encoded codeplug images.
+ *
+ * Encoding a large codeplug for a radio is expensive. If neither the configuration nor the radio
+ * model changed, the result of the encoding is the same. This cache stores the encoded images
+ * as DFU files, keyed by a hash over the canonical (YAML) representation of the configuration,
+ * the radio model and the codeplug flags. As the YAML representation contains the version of
+ * the library, any update invalidates the cache.
+ *
+ * @note Only fresh codeplugs (i.e., @c Codeplug::Flags::updateCodePlug is @c false) can be cached,
+ *   as updated codeplugs depend on the contents of the radio.
+ *
+ * @code
+ * CodeplugCache cache;
+ * QByteArray key = cache.key(&config, "d878uv", flags);
+ * if (! cache.load(key, flags, codeplug)) {
+ *   codeplug.encode(&config, flags);
+ *   cache.store(key, flags, codeplug);
+ * }
+ * @endcode
+ *
+ * @ingroup util */
+class CodeplugCache
+{
+public:
+  /** Constructs a cache in the given directory. If empty, the default location is used. */
+  explicit CodeplugCache(const QString &path=QString());
+
+  /** Returns the cache directory. */
+  const QString &path() const;
+  /** Returns the default cache directory. */
+  static QString defaultPath();
+
+  /** Computes the cache key for the given configuration, radio and flags. Returns an empty key
+   * on error. */
+  static QByteArray key(Config *config, const QString &radio, const Codeplug::Flags &flags,
+                        const ErrorStack &err=ErrorStack());
+
+  /** Returns @c true if codeplugs encoded with the given flags can be cached. That is, if they
+   * are encoded from scratch and do not depend on the contents of the radio. */
+  static bool isCacheable(const Codeplug::Flags &flags);
+
+  /** Returns @c true if the cache contains an image for the given key. */
+  bool contains(const QByteArray &key) const;
+  /** Returns the file name of the cached image for the given key. */
+  QString filename(const QByteArray &key) const;
+
+  /** Loads the cached image for the given key into the given codeplug.
+   * @returns @c false if there is no cached image, it cannot be read or the flags are not
+   *   cacheable. */
+  bool load(const QByteArray &key, const Codeplug::Flags &flags, DFUFile &image,
+            const ErrorStack &err=ErrorStack()) const;
+  /** Stores the given image, encoded with the given flags, under the given key.
+   * @returns @c false if the image cannot be written or the flags are not cacheable. */
+  bool store(const QByteArray &key, const Codeplug::Flags &flags, DFUFile &image,
+             const ErrorStack &err=ErrorStack()) const;
+  /** Compares the given image with the cached one.
+   * @returns @c false if there is no cached image or the images differ. */
+  bool verify(const QByteArray &key, const DFUFile &image, const ErrorStack &err=ErrorStack()) const;
+
+  /** Removes all cached images. */
+  bool clear() const;
+
+protected:
+  /** The cache directory. */
+  QString _path;
+};
+
+#endif // CODEPLUGCACHE_HH
@@ -0,0 +1,365 @@
+#include "compacttable.hh"
+#include "config.hh"
+#include <algorithm>
+#include <limits>
+
+
+/** Stores a level with the default value (max unsigned) as the max value of the given type. */
+template <class T>
+static inline T
+packLevel(unsigned value) {
+  if (std::numeric_limits<unsigned>::max() == value)
+    return std::numeric_limits<T>::max();
+  return T(std::min(value, unsigned(std::numeric_limits<T>::max()-1)));
+}
+
+/** Inverse of @c packLevel. */
+template <class T>
+static inline unsigned
+unpackLevel(T value) {
+  if (std::numeric_limits<T>::max() == value)
+    return std::numeric_limits<unsigned>::max();
+  return value;
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of StringPool
+ * ********************************************************************************************* */
+StringPool::StringPool()
+  : _data(), _offsets(1, 0)
+{
+  // pass...
+}
+
+int
+StringPool::count() const {
+  return _offsets.size()-1;
+}
+
+int
+StringPool::append(const QString &str) {
+  _data.append(str.toUtf8());
+  _offsets.append(_data.size());
+  return _offsets.size()-2;
+}
+
+QString
+StringPool::at(int idx) const {
+  if ((0 > idx) || (idx >= count()))
+    return QString();
+  return QString::fromUtf8(_data.constData()+_offsets[idx], _offsets[idx+1]-_offsets[idx]);
+}
+
+void
+StringPool::clear() {
+  _data.clear();
+  _offsets.resize(1);
+}
+
+void
+StringPool::squeeze() {
+  _data.squeeze();
+  _offsets.squeeze();
+}
+
+size_t
+StringPool::memoryUsage() const {
+  return _data.capacity() + _offsets.capacity()*sizeof(quint32);
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of DMRContactTable
+ * ********************************************************************************************* */
+DMRContactTable::DMRContactTable()
+  : _numbers(), _flags(), _names()
+{
+  // pass...
+}
+
+DMRContactTable::DMRContactTable(const ContactList *list)
+  : _numbers(), _flags(), _names()
+{
+  _numbers.reserve(list->digitalCount());
+  _flags.reserve(list->digitalCount());
+  for (int i=0; i<list->count(); i++) {
+    if (list->contact(i)->is<DMRContact>())
+      append(list->contact(i)->as<DMRContact>());
+  }
+  _names.squeeze();
+}
+
+int
+DMRContactTable::count() const {
+  return _numbers.size();
+}
+
+int
+DMRContactTable::append(const DMRContact *contact) {
+  _numbers.append(contact->number());
+  _flags.append(quint8(contact->type() & 0x03) | (contact->ring() ? 0x04 : 0x00));
+  return _names.append(contact->name());
+}
+
+void
+DMRContactTable::clear() {
+  _numbers.clear();
+  _flags.clear();
+  _names.clear();
+}
+
+QString
+DMRContactTable::name(int idx) const {
+  return _names.at(idx);
+}
+
+unsigned int
+DMRContactTable::number(int idx) const {
+  return _numbers.value(idx, 0);
+}
+
+DMRContact::Type
+DMRContactTable::type(int idx) const {
+  return DMRContact::Type(_flags.value(idx, 0) & 0x03);
+}
+
+bool
+DMRContactTable::ring(int idx) const {
+  return _flags.value(idx, 0) & 0x04;
+}
+
+int
+DMRContactTable::find(unsigned int number, DMRContact::Type type) const {
+  // Linear scan over the packed numbers is fast enough for the table sizes in question
+  const quint32 *numbers = _numbers.constData();
+  for (int i=0; i<_numbers.size(); i++) {
+    if ((number == numbers[i]) && (type == this->type(i)))
+      return i;
+  }
+  return -1;
+}
+
+DMRContact *
+DMRContactTable::materialize(int idx, QObject *parent) const {
+  if ((0 > idx) || (idx >= count()))
+    return nullptr;
+  return new DMRContact(type(idx), name(idx), number(idx), ring(idx), parent);
+}
+
+size_t
+DMRContactTable::memoryUsage() const {
+  return _numbers.capacity()*sizeof(quint32) + _flags.capacity()*sizeof(quint8)
+      + _names.memoryUsage();
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of ChannelTable
+ * ********************************************************************************************* */
+ChannelTable::ChannelTable()
+{
+  // pass...
+}
+
+ChannelTable::ChannelTable(const Config *config)
+{
+  QHash<const ConfigObject *, int> indices = referenceIndices(config);
+  for (int i=0; i<config->channelList()->count(); i++) {
+    Channel *channel = config->channelList()->channel(i);
+    if (channel->is<FMChannel>() || channel->is<DMRChannel>())
+      append(channel, indices);
+  }
+  _names.squeeze();
+}
+
+ChannelTable::ChannelTable(const Config *config, const QVector<Channel *> &channels)
+{
+  QHash<const ConfigObject *, int> indices = referenceIndices(config);
+  foreach (Channel *channel, channels) {
+    if (channel->is<FMChannel>() || channel->is<DMRChannel>())
+      append(channel, indices);
+  }
+  _names.squeeze();
+}
+
+QHash<const ConfigObject *, int>
+ChannelTable::referenceIndices(const Config *config) {
+  QHash<const ConfigObject *, int> indices;
+  for (int i=0; i<config->contacts()->count(); i++)
+    indices.insert(config->contacts()->get(i), i);
+  for (int i=0; i<config->rxGroupLists()->count(); i++)
+    indices.insert(config->rxGroupLists()->get(i), i);
+  for (int i=0; i<config->scanlists()->count(); i++)
+    indices.insert(config->scanlists()->get(i), i);
+  for (int i=0; i<config->posSystems()->count(); i++)
+    indices.insert(config->posSystems()->get(i), i);
+  for (int i=0; i<config->radioIDs()->count(); i++)
+    indices.insert(config->radioIDs()->get(i), i);
+  for (int i=0; i<config->roamingZones()->count(); i++)
+    indices.insert(config->roamingZones()->get(i), i);
+  return indices;
+}
+
+int
+ChannelTable::count() const {
+  return _flags.size();
+}
+
+void
+ChannelTable::clear() {
+  _rxFrequencies.clear(); _txFrequencies.clear(); _flags.clear(); _timeouts.clear(); _vox.clear();
+  _levels.clear(); _rxTones.clear(); _txTones.clear(); _scanLists.clear(); _positioning.clear();
+  _groupLists.clear(); _contacts.clear(); _radioIds.clear(); _roamingZones.clear();
+  _names.clear();
+}
+
+QString
+ChannelTable::name(int idx) const {
+  return _names.at(idx);
+}
+
+bool
+ChannelTable::isDMR(int idx) const {
+  return _flags.value(idx, 0) & DMR;
+}
+
+Frequency
+ChannelTable::rxFrequency(int idx) const {
+  return Frequency::fromHz(_rxFrequencies.value(idx, 0));
+}
+
+Frequency
+ChannelTable::txFrequency(int idx) const {
+  return Frequency::fromHz(_txFrequencies.value(idx, 0));
+}
+
+bool
+ChannelTable::rxOnly(int idx) const {
+  return _flags.value(idx, 0) & RXOnly;
+}
+
+void
+ChannelTable::append(const Channel *channel, const QHash<const ConfigObject *, int> &indices) {
+  // Resolves a reference to an index
+  auto ref = [&indices](const ConfigObject *obj) -> qint32 {
+    if (nullptr == obj)
+      return NoRef;
+    if (obj->is<DefaultRadioID>() || obj->is<DefaultRoamingZone>())
+      return DefaultRef;
+    return indices.value(obj, NoRef);
+  };
+
+  quint16 flags = 0;
+  if (channel->rxOnly())
+    flags |= RXOnly;
+  if (channel->defaultPower())
+    flags |= DefaultPower;
+  flags |= (quint16(channel->power()) << PowerShift) & PowerMask;
+
+  _rxFrequencies.append(channel->rxFrequency().inHz());
+  _txFrequencies.append(channel->txFrequency().inHz());
+  _timeouts.append(packLevel<quint16>(channel->timeout()));
+  _vox.append(packLevel<quint8>(channel->vox()));
+  _scanLists.append(ref(channel->scanList()));
+
+  if (const FMChannel *fm = channel->as<FMChannel>()) {
+    if (FMChannel::Bandwidth::Wide == fm->bandwidth())
+      flags |= WideBand;
+    flags |= (quint16(fm->admit()) << AdmitShift) & AdmitMask;
+    _levels.append(packLevel<quint8>(fm->squelch()));
+    _rxTones.append(fm->rxTone());
+    _txTones.append(fm->txTone());
+    _positioning.append(ref(fm->aprsSystem()));
+    _groupLists.append(NoRef);
+    _contacts.append(NoRef);
+    _radioIds.append(NoRef);
+    _roamingZones.append(NoRef);
+  } else {
+    const DMRChannel *dmr = channel->as<DMRChannel>();
+    flags |= DMR;
+    if (DMRChannel::TimeSlot::TS2 == dmr->timeSlot())
+      flags |= TimeSlot2;
+    flags |= (quint16(dmr->admit()) << AdmitShift) & AdmitMask;
+    _levels.append(dmr->colorCode());
+    _rxTones.append(SelectiveCall());
+    _txTones.append(SelectiveCall());
+    _positioning.append(ref(dmr->aprsObj()));
+    _groupLists.append(ref(dmr->groupListObj()));
+    _contacts.append(ref(dmr->txContactObj()));
+    _radioIds.append(ref(dmr->radioIdObj()));
+    _roamingZones.append(ref(dmr->roamingZone()));
+  }
+
+  _flags.append(flags);
+  _names.append(channel->name());
+}
+
+Channel *
+ChannelTable::materialize(int idx, Config *config, QObject *parent) const {
+  if ((0 > idx) || (idx >= count()))
+    return nullptr;
+
+  quint16 flags = _flags[idx];
+  unsigned admit = (flags & AdmitMask) >> AdmitShift;
+
+  Channel *channel = nullptr;
+  if (flags & DMR) {
+    DMRChannel *dmr = new DMRChannel(parent);
+    dmr->setAdmit(DMRChannel::Admit(admit));
+    dmr->setColorCode(_levels[idx]);
+    dmr->setTimeSlot((flags & TimeSlot2) ? DMRChannel::TimeSlot::TS2 : DMRChannel::TimeSlot::TS1);
+    if (0 <= _groupLists[idx])
+      dmr->setGroupListObj(config->rxGroupLists()->list(_groupLists[idx]));
+    if (0 <= _contacts[idx])
+      dmr->setTXContactObj(config->contacts()->contact(_contacts[idx])->as<DMRContact>());
+    if (0 <= _positioning[idx])
+      dmr->setAPRSObj(config->posSystems()->system(_positioning[idx]));
+    if (DefaultRef == _radioIds[idx])
+      dmr->setRadioIdObj(DefaultRadioID::get());
+    else if (0 <= _radioIds[idx])
+      dmr->setRadioIdObj(config->radioIDs()->getId(_radioIds[idx]));
+    if (DefaultRef == _roamingZones[idx])
+      dmr->setRoamingZone(DefaultRoamingZone::get());
+    else if (0 <= _roamingZones[idx])
+      dmr->setRoamingZone(config->roamingZones()->zone(_roamingZones[idx]));
+    channel = dmr;
+  } else {
+    FMChannel *fm = new FMChannel(parent);
+    fm->setAdmit(FMChannel::Admit(admit));
+    fm->setSquelch(unpackLevel(_levels[idx]));
+    fm->setRXTone(_rxTones[idx]);
+    fm->setTXTone(_txTones[idx]);
+    fm->setBandwidth((flags & WideBand) ? FMChannel::Bandwidth::Wide : FMChannel::Bandwidth::Narrow);
+    if (0 <= _positioning[idx])
+      fm->setAPRSSystem(config->posSystems()->system(_positioning[idx])->as<APRSSystem>());
+    channel = fm;
+  }
+
+  channel->setName(name(idx));
+  channel->setRXFrequency(rxFrequency(idx));
+  channel->setTXFrequency(txFrequency(idx));
+  channel->setRXOnly(flags & RXOnly);
+  if (flags & DefaultPower)
+    channel->setDefaultPower();
+  else
+    channel->setPower(Channel::Power((flags & PowerMask) >> PowerShift));
+  channel->setTimeout(unpackLevel(_timeouts[idx]));
+  channel->setVOX(unpackLevel(_vox[idx]));
+  if (0 <= _scanLists[idx])
+    channel->setScanList(config->scanlists()->scanlist(_scanLists[idx]));
+
+  return channel;
+}
+
+size_t
+ChannelTable::memoryUsage() const {
+  return (_rxFrequencies.capacity() + _txFrequencies.capacity())*sizeof(quint64)
+      + (_flags.capacity() + _timeouts.capacity())*sizeof(quint16)
+      + (_vox.capacity() + _levels.capacity())*sizeof(quint8)
+      + (_rxTones.capacity() + _txTones.capacity())*sizeof(SelectiveCall)
+      + (_scanLists.capacity() + _positioning.capacity() + _groupLists.capacity()
+         + _radioIds.capacity() + _roamingZones.capacity())*sizeof(qint16)
+      + _contacts.capacity()*sizeof(qint32)
+      + _names.memoryUsage();
+}
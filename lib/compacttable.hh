@@ -0,0 +1,208 @@
+/** @defgroup compact Compact storage of large tables
+ * @ingroup conf
+ *
+ * Every contact and channel of a config is a @c QObject with its own property system, signal
+ * connections and references. For very large tables (e.g., 10000 contacts and 4000 channels), this
+ * adds up. The classes of this group hold snapshots of these tables in a columnar layout: numbers,
+ * frequencies and flags in packed arrays and all names in a single string pool. The config objects
+ * are materialized on demand from these tables.
+ */
+
+#ifndef COMPACTTABLE_HH
+#define COMPACTTABLE_HH
+
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include "frequency.hh"
+#include "signaling.hh"
+#include "contact.hh"
+#include "channel.hh"
+
+class Config;
+
+
+/** A pool of UTF-8 encoded strings, addressed by their index.
+ *
+ * All strings are stored back-to-back within a single byte array. Hence, a string only needs
+ * 4 bytes for its offset plus its UTF-8 encoding.
+ *
+ * @ingroup compact */
+class StringPool
+{
+public:
+  /** Constructs an empty pool. */
+  StringPool();
+
+  /** Returns the number of strings. */
+  int count() const;
+  /** Appends the given string, returns its index. */
+  int append(const QString &str);
+  /** Returns the string at the given index. */
+  QString at(int idx) const;
+  /** Removes all strings. */
+  void clear();
+  /** Releases unused memory. */
+  void squeeze();
+
+  /** Returns the number of bytes allocated by the pool. */
+  size_t memoryUsage() const;
+
+protected:
+  /** The UTF-8 encoded strings. */
+  QByteArray _data;
+  /** The offset of every string within the data, followed by the end offset. */
+  QVector<quint32> _offsets;
+};
+
+
+/** A compact table of DMR contacts.
+ *
+ * Stores number, call type and ring-tone flag of every contact in packed arrays and the names in
+ * a string pool. The contact extensions are not stored.
+ *
+ * @ingroup compact */
+class DMRContactTable
+{
+public:
+  /** Constructs an empty table. */
+  DMRContactTable();
+  /** Constructs a table from all DMR contacts of the given list. */
+  explicit DMRContactTable(const ContactList *list);
+
+  /** Returns the number of contacts. */
+  int count() const;
+  /** Appends the given contact, returns its index. */
+  int append(const DMRContact *contact);
+  /** Removes all contacts. */
+  void clear();
+
+  /** Returns the name of the contact at the given index. */
+  QString name(int idx) const;
+  /** Returns the DMR number of the contact at the given index. */
+  unsigned int number(int idx) const;
+  /** Returns the call type of the contact at the given index. */
+  DMRContact::Type type(int idx) const;
+  /** Returns the ring-tone flag of the contact at the given index. */
+  bool ring(int idx) const;
+  /** Returns the index of the first contact with the given number and type, or -1. */
+  int find(unsigned int number, DMRContact::Type type) const;
+
+  /** Creates a new contact object for the contact at the given index. The ownership is passed to
+   * the caller. */
+  DMRContact *materialize(int idx, QObject *parent=nullptr) const;
+
+  /** Returns the number of bytes allocated by the table. */
+  size_t memoryUsage() const;
+
+protected:
+  /** The DMR numbers. */
+  QVector<quint32> _numbers;
+  /** The call type (bits 0-1) and ring-tone flag (bit 2). */
+  QVector<quint8> _flags;
+  /** The names. */
+  StringPool _names;
+};
+
+
+/** A compact table of FM and DMR channels.
+ *
+ * Stores the common settings of every channel in packed arrays and the names in a string pool.
+ * References to other objects (e.g., contacts, group lists or scan lists) are stored as indices
+ * into the lists of the config the channels belong to. The channel extensions are not stored.
+ *
+ * @ingroup compact */
+class ChannelTable
+{
+public:
+  /** Constructs an empty table. */
+  ChannelTable();
+  /** Constructs a table from all FM and DMR channels of the given config. */
+  explicit ChannelTable(const Config *config);
+  /** Constructs a table from the given FM and DMR channels of the given config. */
+  ChannelTable(const Config *config, const QVector<Channel *> &channels);
+
+  /** Returns the number of channels. */
+  int count() const;
+  /** Removes all channels. */
+  void clear();
+
+  /** Returns the name of the channel at the given index. */
+  QString name(int idx) const;
+  /** Returns @c true if the channel at the given index is a DMR channel. */
+  bool isDMR(int idx) const;
+  /** Returns the receive frequency of the channel at the given index. */
+  Frequency rxFrequency(int idx) const;
+  /** Returns the transmit frequency of the channel at the given index. */
+  Frequency txFrequency(int idx) const;
+  /** Returns @c true if the channel at the given index is receive only. */
+  bool rxOnly(int idx) const;
+
+  /** Creates a new channel object for the channel at the given index. References are resolved
+   * within the given config, which must be structured like the config the table was created
+   * from. The ownership is passed to the caller. */
+  Channel *materialize(int idx, Config *config, QObject *parent=nullptr) const;
+
+  /** Returns the number of bytes allocated by the table. */
+  size_t memoryUsage() const;
+
+protected:
+  /** Returns the indices of all objects of the given config, that may be referenced by channels. */
+  static QHash<const ConfigObject *, int> referenceIndices(const Config *config);
+  /** Appends the given channel using the given object indices to resolve references. */
+  void append(const Channel *channel, const QHash<const ConfigObject *, int> &indices);
+
+protected:
+  /** Flags of a channel. */
+  enum Flag {
+    DMR           = 0x0001, ///< Channel is a DMR channel.
+    RXOnly        = 0x0002, ///< Channel is RX only.
+    DefaultPower  = 0x0004, ///< Power is set to the default value.
+    PowerMask     = 0x0038, ///< Mask of the power setting.
+    PowerShift    = 3,      ///< Offset of the power setting.
+    WideBand      = 0x0040, ///< FM channel uses wide band.
+    TimeSlot2     = 0x0080, ///< DMR channel uses time slot 2.
+    AdmitMask     = 0x0300, ///< Mask of the admit criterion.
+    AdmitShift    = 8       ///< Offset of the admit criterion.
+  };
+
+  /** Special reference indices. */
+  enum RefIndex {
+    NoRef      = -1,        ///< Reference is not set.
+    DefaultRef = -2         ///< Reference to the default object (e.g., default radio ID).
+  };
+
+  /** The receive frequencies in Hz. */
+  QVector<quint64> _rxFrequencies;
+  /** The transmit frequencies in Hz. */
+  QVector<quint64> _txFrequencies;
+  /** The channel flags. */
+  QVector<quint16> _flags;
+  /** The transmit timeouts in seconds, 0xffff means default. */
+  QVector<quint16> _timeouts;
+  /** VOX level, 0xff means default. */
+  QVector<quint8> _vox;
+  /** Squelch level of FM channels or color code of DMR channels, 0xff means default squelch. */
+  QVector<quint8> _levels;
+  /** RX tones of FM channels. */
+  QVector<SelectiveCall> _rxTones;
+  /** TX tones of FM channels. */
+  QVector<SelectiveCall> _txTones;
+  /** Scan list indices. */
+  QVector<qint16> _scanLists;
+  /** Positioning system indices. */
+  QVector<qint16> _positioning;
+  /** Group list indices of DMR channels. */
+  QVector<qint16> _groupLists;
+  /** TX contact indices of DMR channels. */
+  QVector<qint32> _contacts;
+  /** Radio ID indices of DMR channels. */
+  QVector<qint16> _radioIds;
+  /** Roaming zone indices of DMR channels. */
+  QVector<qint16> _roamingZones;
+  /** The names. */
+  StringPool _names;
+};
+
+#endif // COMPACTTABLE_HH
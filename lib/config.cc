@@ -1,5 +1,6 @@
 #include "config.hh"
 #include "config.h"
+#include "configbinary.hh"
 
 #include "rxgrouplist.hh"
 #include "channel.hh"
@@ -25,7 +26,7 @@ Config::Config(QObject *parent)
     _gpsSystems(new PositioningSystems(this)),
     _roamingChannels(new RoamingChannelList(this)), _roamingZones(new RoamingZoneList(this)),
     _tytExtension(nullptr), _commercialExtension(new CommercialExtension(this)),
-    _smsExtension(new SMSExtension(this))
+    _smsExtension(new SMSExtension(this)), _loaders()
 {
   connect(_settings, SIGNAL(modified(ConfigItem*)), this, SLOT(onConfigModified()));
   connect(_radioIDs, SIGNAL(elementAdded(int)), this, SLOT(onConfigModified()));
@@ -63,7 +64,8 @@ Config::Config(QObject *parent)
 bool
 Config::copy(const ConfigItem &other) {
   const Config *conf = other.as<Config>();
-  if ((nullptr==conf) || (! ConfigItem::copy(other)))
+  // Deferred elements must be materialized explicitly before copying
+  if ((nullptr==conf) || (! conf->isMaterialized()) || (! ConfigItem::copy(other)))
     return false;
 
   _settings->copy(*conf->settings());
@@ -101,6 +103,9 @@ Config::setModified(bool modified) {
 
 bool
 Config::toYAML(QTextStream &stream, const ErrorStack &err) {
+  if (! materialize(err))
+    return false;
+
   ConfigItem::Context context;
   // Label all codeplug elements
   if (! this->label(context, err))
@@ -116,6 +121,11 @@ Config::toYAML(QTextStream &stream, const ErrorStack &err) {
   return true;
 }
 
+bool
+Config::toBinary(QIODevice &device, const ErrorStack &err) {
+  return ConfigBinary::write(this, device, err);
+}
+
 bool
 Config::populate(YAML::Node &node, const Context &context, const ErrorStack &err)
 {
@@ -250,6 +260,11 @@ Config::requiresGPS() const {
 
 void
 Config::clear() {
+  // Drop deferred elements
+  _loaders.clear();
+  foreach (AbstractConfigObjectList *list, deferrableLists())
+    list->setDeferred(false);
+
   ConfigItem::clear();
 
   // Reset lists
@@ -272,6 +287,78 @@ Config::config() const {
   return this;
 }
 
+void
+Config::defer(const Loader &loader) {
+  _loaders.append(loader);
+  foreach (AbstractConfigObjectList *list, deferrableLists())
+    list->setDeferred(true);
+}
+
+bool
+Config::isMaterialized() const {
+  return _loaders.isEmpty();
+}
+
+bool
+Config::materialize(const ErrorStack &err) {
+  if (_loaders.isEmpty())
+    return true;
+
+  QList<Loader> loaders;
+  std::swap(loaders, _loaders);
+  foreach (AbstractConfigObjectList *list, deferrableLists())
+    list->setDeferred(false);
+
+  // The lists emit their signals as usual, such that views pick up the decoded elements. The
+  // decoded elements are not a modification of the config, though.
+  bool wasModified = _modified, wasBlocked = blockSignals(true);
+  bool success = true;
+  foreach (const Loader &loader, loaders) {
+    if (! loader(this, err)) {
+      success = false;
+      break;
+    }
+  }
+  blockSignals(wasBlocked);
+  _modified = wasModified;
+
+  if (! success)
+    errMsg(err) << "Cannot materialize deferred elements.";
+  return success;
+}
+
+int
+Config::compact() {
+  // Do not mix with deferred elements, these may refer to the compacted ones by index
+  if (! isMaterialized())
+    return 0;
+
+  bool wasModified = _modified, wasBlocked = blockSignals(true);
+  // Channels refer to contacts by index, hence they are compacted first and expanded last
+  int count = _channels->compact(this);
+  count += _contacts->compact();
+  blockSignals(wasBlocked);
+  _modified = wasModified;
+
+  if (0 == count)
+    return 0;
+
+  defer([](Config *config, const ErrorStack &err) {
+    Q_UNUSED(err);
+    config->contacts()->expand();
+    config->channelList()->expand(config);
+    return true;
+  });
+
+  return count;
+}
+
+QList<AbstractConfigObjectList *>
+Config::deferrableLists() const {
+  return { _contacts, _rxGroupLists, _channels, _zones, _scanlists, _gpsSystems,
+        _roamingChannels, _roamingZones };
+}
+
 
 CommercialExtension *
 Config::commercialExtension() const {
@@ -360,6 +447,23 @@ Config::readYAML(const QString &filename, const ErrorStack &err) {
   return true;
 }
 
+bool
+Config::readBinary(const QString &filename, const ErrorStack &err) {
+  QFile file(filename);
+  if (! file.open(QIODevice::ReadOnly)) {
+    errMsg(err) << "Cannot open file '" << filename << "': " << file.errorString() << ".";
+    errMsg(err) << "Cannot read binary codeplug from file '" << filename << "'.";
+    return false;
+  }
+
+  if (! ConfigBinary::read(this, file, err)) {
+    errMsg(err) << "Cannot read binary codeplug from file '" << filename << "'.";
+    return false;
+  }
+
+  return true;
+}
+
 bool
 Config::parse(const YAML::Node &node, Context &ctx, const ErrorStack &err)
 {
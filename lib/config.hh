@@ -39,6 +39,7 @@
 #define CONFIG_HH
 
 #include <QTextStream>
+#include <functional>
 
 #include "configobject.hh"
 #include "contact.hh"
@@ -98,6 +99,10 @@ class Config : public ConfigItem
   /** Represents the config extension for TyT devices. */
   Q_PROPERTY(TyTConfigExtension* tytExtension READ tytExtension WRITE setTyTExtension)
 
+public:
+  /** A function decoding deferred elements into the given config. */
+  typedef std::function<bool(Config *config, const ErrorStack &err)> Loader;
+
 public:
   /** Constructs an empty configuration. */
   Q_INVOKABLE explicit Config(QObject *parent = nullptr);
@@ -136,9 +141,30 @@ public:
   /** Returns @c true if one of the channels has a GPS or APRS system assigned. */
   bool requiresGPS() const;
 
-  /** Clears the complete configuration. */
+  /** Clears the complete configuration. Deferred elements are dropped. */
   void clear();
 
+  /** Defers the population of the contacts, group lists, channels, zones, scan lists, positioning
+   * systems and the roaming lists to the given loader. These lists stay empty until
+   * @c materialize is called explicitly. Several loaders are called in the order they were added.
+   * @since 0.12.0 */
+  void defer(const Loader &loader);
+  /** Returns @c true if there are no deferred elements. */
+  bool isMaterialized() const;
+  /** Materializes all deferred elements. The lists emit the usual signals for the added elements,
+   * but the config is not marked as modified. As the references of the settings are resolved
+   * during the materialization too, this must be called before editing, copying or encoding the
+   * config.
+   * @since 0.12.0 */
+  bool materialize(const ErrorStack &err=ErrorStack());
+  /** Releases the memory held by contacts and channels that are neither referenced nor extended.
+   * These get moved into compact tables (see @c DMRContactTable and @c ChannelTable) and are
+   * re-created once the config gets materialized, see @c materialize. Like a lazily decoded config,
+   * a compacted config must be materialized before editing, copying or encoding it. The config is
+   * not marked as modified. Returns the number of compacted elements.
+   * @since 0.12.0 */
+  int compact();
+
   const Config *config() const;
 
   /** Returns the commercial extension. */
@@ -161,6 +187,8 @@ public:
 
   /** Imports a configuration from the given YAML file. */
   bool readYAML(const QString &filename, const ErrorStack &err=ErrorStack());
+  /** Imports a configuration from the given binary file (see @c ConfigBinary). */
+  bool readBinary(const QString &filename, const ErrorStack &err=ErrorStack());
 
   bool parse(const YAML::Node &node, Context &ctx, const ErrorStack &err=ErrorStack());
   bool link(const YAML::Node &node, const Context &ctx, const ErrorStack &err=ErrorStack());
@@ -168,9 +196,14 @@ public:
 public:
   /** Serializes the configuration into the given stream as text. */
   bool toYAML(QTextStream &stream, const ErrorStack &err=ErrorStack());
+  /** Serializes the configuration into the given device in the binary format
+   * (see @c ConfigBinary). */
+  bool toBinary(QIODevice &device, const ErrorStack &err=ErrorStack());
 
 protected:
   bool populate(YAML::Node &node, const Context &context, const ErrorStack &err=ErrorStack());
+  /** Returns the lists, that may be populated by a deferred loader. */
+  QList<AbstractConfigObjectList *> deferrableLists() const;
 
 protected slots:
   /** Iternal callback. */
@@ -205,6 +238,8 @@ protected:
   CommercialExtension *_commercialExtension;
   /** Owns the SMS settings extension. */
   SMSExtension *_smsExtension;
+  /** The loaders of the deferred elements. */
+  QList<Loader> _loaders;
 };
 
 #endif // CONFIG_HH
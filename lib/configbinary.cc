@@ -0,0 +1,1176 @@
+#include "configbinary.hh"
+#include "config.hh"
+#include "config.h"
+#include "logger.hh"
+#include <QIODevice>
+#include <QDataStream>
+#include <QHash>
+#include <QVector>
+#include <QMetaProperty>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cstring>
+
+#define MAGIC      "QDMRCONF"
+#define MAGIC_SIZE 8
+
+/** Marks a reference to the default object of the referenced type, that is the selected channel,
+ * default radio ID or default roaming zone. */
+#define DEFAULT_REF 0xffffffff
+
+
+/** Assembles a section tag from four characters. */
+static constexpr quint32
+sectionTag(const char (&name)[5]) {
+  return quint32(quint8(name[0])) | (quint32(quint8(name[1]))<<8)
+      | (quint32(quint8(name[2]))<<16) | (quint32(quint8(name[3]))<<24);
+}
+
+/** The section tags. */
+enum Section : quint32 {
+  StringSection          = sectionTag("STRS"),   ///< String table.
+  RadioIDSection         = sectionTag("RDID"),   ///< Radio IDs.
+  ContactSection         = sectionTag("CONT"),   ///< Contacts.
+  GroupListSection       = sectionTag("GRPL"),   ///< RX group lists.
+  ChannelSection         = sectionTag("CHAN"),   ///< Channels.
+  ZoneSection            = sectionTag("ZONE"),   ///< Zones.
+  ScanListSection        = sectionTag("SCAN"),   ///< Scan lists.
+  PositioningSection     = sectionTag("POSS"),   ///< Positioning systems.
+  RoamingChannelSection  = sectionTag("RCHN"),   ///< Roaming channels.
+  RoamingZoneSection     = sectionTag("RZON"),   ///< Roaming zones.
+  SettingsSection        = sectionTag("SETT"),   ///< Radio settings.
+  ExtensionSection       = sectionTag("CEXT"),   ///< Config extensions.
+  EndSection             = sectionTag("END ")    ///< Last section.
+};
+
+/** Record types within the sections. */
+enum RecordType : quint8 {
+  DMRRadioIDRecord = 0, DTMFRadioIDRecord = 1,
+  DMRContactRecord = 0, DTMFContactRecord = 1,
+  FMChannelRecord  = 0, DMRChannelRecord  = 1,
+  GPSSystemRecord  = 0, APRSSystemRecord  = 1
+};
+
+/** Sub-tone types. */
+enum ToneType : quint8 {
+  NoTone = 0, CTCSSTone = 1, DCSTone = 2
+};
+
+/** The lists, objects may be referenced in. */
+enum Target {
+  RadioIDs = 0, Contacts, GroupLists, Channels, Zones, ScanLists, Positioning, RoamingChannels,
+  RoamingZones, NumTargets
+};
+
+/** ID prefixes of the objects in every list. These IDs are used to resolve references from
+ * extensions. */
+static const char *targetPrefix[NumTargets] = {
+  "id", "cont", "grp", "ch", "zone", "scan", "pos", "rch", "roam"
+};
+
+/** Returns the list of the given target within the config. */
+static AbstractConfigObjectList *
+targetList(Config *config, Target target) {
+  switch (target) {
+  case RadioIDs: return config->radioIDs();
+  case Contacts: return config->contacts();
+  case GroupLists: return config->rxGroupLists();
+  case Channels: return config->channelList();
+  case Zones: return config->zones();
+  case ScanLists: return config->scanlists();
+  case Positioning: return config->posSystems();
+  case RoamingChannels: return config->roamingChannels();
+  case RoamingZones: return config->roamingZones();
+  default: break;
+  }
+  return nullptr;
+}
+
+/** Returns the names of the extension properties of the given item. */
+static QList<QByteArray>
+extensionProperties(const ConfigItem *item) {
+  QList<QByteArray> names;
+  if (item->is<Config>())
+    names << "commercial" << "sms" << "tytExtension";
+  else if (item->is<RadioSettings>())
+    names << "tyt" << "radioddity" << "anytone";
+  else if (item->is<FMChannel>())
+    names << "openGD77" << "tyt" << "anytone";
+  else if (item->is<DMRChannel>())
+    names << "openGD77" << "tyt" << "commercial" << "anytone";
+  else if (item->is<DMRContact>())
+    names << "anytone" << "openGD77";
+  else if (item->is<Zone>() || item->is<APRSSystem>())
+    names << "anytone";
+  else if (item->is<ScanList>())
+    names << "tyt";
+  return names;
+}
+
+/** Sets up byte order and version of the given stream. */
+static void
+setupStream(QDataStream &stream) {
+  stream.setVersion(QDataStream::Qt_5_0);
+  stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+
+/* ********************************************************************************************* *
+ * Writer
+ * ********************************************************************************************* */
+/** Writes a config into the binary format.
+ * @ingroup conf */
+class ConfigBinaryWriter
+{
+public:
+  /** Constructs a writer for the given config. */
+  explicit ConfigBinaryWriter(Config *config);
+
+  /** Writes the config to the given device. */
+  bool write(QIODevice &device, const ErrorStack &err);
+
+protected:
+  /** Indexes all objects and labels the items owned by the extensions. */
+  bool label(const ErrorStack &err);
+  /** Returns the index of the given string within the string table. */
+  quint32 string(const QString &str);
+  /** Writes a reference to the given object. */
+  bool writeRef(QDataStream &out, const ConfigObject *obj, const ErrorStack &err);
+  /** Writes a list of references. */
+  bool writeRefList(QDataStream &out, const AbstractConfigObjectList *list, const ErrorStack &err);
+  /** Writes a sub tone. */
+  void writeTone(QDataStream &out, const SelectiveCall &tone);
+  /** Writes all extensions of the given item. */
+  bool writeExtensions(QDataStream &out, const ConfigItem *item, const ErrorStack &err);
+
+  /** Writes the radio IDs. */
+  bool writeRadioIDs(QDataStream &out, const ErrorStack &err);
+  /** Writes the contacts. */
+  bool writeContacts(QDataStream &out, const ErrorStack &err);
+  /** Writes the group lists. */
+  bool writeGroupLists(QDataStream &out, const ErrorStack &err);
+  /** Writes the channels. */
+  bool writeChannels(QDataStream &out, const ErrorStack &err);
+  /** Writes the zones. */
+  bool writeZones(QDataStream &out, const ErrorStack &err);
+  /** Writes the scan lists. */
+  bool writeScanLists(QDataStream &out, const ErrorStack &err);
+  /** Writes the positioning systems. */
+  bool writePositioning(QDataStream &out, const ErrorStack &err);
+  /** Writes the roaming channels. */
+  bool writeRoamingChannels(QDataStream &out, const ErrorStack &err);
+  /** Writes the roaming zones. */
+  bool writeRoamingZones(QDataStream &out, const ErrorStack &err);
+  /** Writes the settings. */
+  bool writeSettings(QDataStream &out, const ErrorStack &err);
+  /** Writes the config extensions. */
+  bool writeConfigExtensions(QDataStream &out, const ErrorStack &err);
+
+protected:
+  /** The config to write. */
+  Config *_config;
+  /** The string table. */
+  QList<QByteArray> _strings;
+  /** Maps strings to their index in the table. */
+  QHash<QString, quint32> _stringIndices;
+  /** Maps objects to their 1-based index within their list. */
+  QHash<const ConfigObject *, quint32> _indices;
+  /** IDs of all objects, used to serialize the extensions. */
+  ConfigItem::Context _context;
+};
+
+
+ConfigBinaryWriter::ConfigBinaryWriter(Config *config)
+  : _config(config), _strings(), _stringIndices(), _indices(), _context()
+{
+  // pass...
+}
+
+bool
+ConfigBinaryWriter::write(QIODevice &device, const ErrorStack &err) {
+  if (! _config->materialize(err))
+    return false;
+  if (! label(err))
+    return false;
+
+  typedef bool (ConfigBinaryWriter::*SectionWriter)(QDataStream &, const ErrorStack &);
+  const QList<QPair<quint32, SectionWriter>> writers = {
+    {RadioIDSection, &ConfigBinaryWriter::writeRadioIDs},
+    {ContactSection, &ConfigBinaryWriter::writeContacts},
+    {GroupListSection, &ConfigBinaryWriter::writeGroupLists},
+    {ChannelSection, &ConfigBinaryWriter::writeChannels},
+    {ZoneSection, &ConfigBinaryWriter::writeZones},
+    {ScanListSection, &ConfigBinaryWriter::writeScanLists},
+    {PositioningSection, &ConfigBinaryWriter::writePositioning},
+    {RoamingChannelSection, &ConfigBinaryWriter::writeRoamingChannels},
+    {RoamingZoneSection, &ConfigBinaryWriter::writeRoamingZones},
+    {SettingsSection, &ConfigBinaryWriter::writeSettings},
+    {ExtensionSection, &ConfigBinaryWriter::writeConfigExtensions}
+  };
+
+  // Assemble sections first, as they populate the string table
+  QList<QByteArray> payloads;
+  for (auto writer: writers) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly); setupStream(out);
+    if (! (this->*writer.second)(out, err))
+      return false;
+    payloads.append(payload);
+  }
+
+  QByteArray strings;
+  QDataStream table(&strings, QIODevice::WriteOnly); setupStream(table);
+  table << quint32(_strings.size());
+  foreach (const QByteArray &str, _strings)
+    table << str;
+
+  QDataStream out(&device); setupStream(out);
+  out.writeRawData(MAGIC, MAGIC_SIZE);
+  out << quint16(ConfigBinary::FormatVersion) << QByteArray(VERSION_STRING);
+  out << quint32(StringSection) << strings;
+  for (int i=0; i<writers.size(); i++)
+    out << writers[i].first << payloads[i];
+  out << quint32(EndSection) << QByteArray();
+
+  if (QDataStream::Ok != out.status()) {
+    errMsg(err) << "Cannot write binary config: " << device.errorString() << ".";
+    return false;
+  }
+
+  return true;
+}
+
+bool
+ConfigBinaryWriter::label(const ErrorStack &err) {
+  QList<ConfigItem *> items;
+  items << _config << _config->settings();
+
+  for (int t=0; t<NumTargets; t++) {
+    AbstractConfigObjectList *list = targetList(_config, Target(t));
+    for (int i=0; i<list->count(); i++) {
+      ConfigObject *obj = list->get(i);
+      _indices.insert(obj, i+1);
+      if (! _context.add(QString("%1%2").arg(targetPrefix[t]).arg(i+1), obj)) {
+        errMsg(err) << "Cannot label " << obj->metaObject()->className() << " '"
+                    << obj->name() << "'.";
+        return false;
+      }
+      items.append(obj);
+    }
+  }
+
+  // Label objects owned by extensions
+  foreach (ConfigItem *item, items) {
+    foreach (const QByteArray &name, extensionProperties(item)) {
+      QMetaProperty prop = item->metaObject()->property(item->metaObject()->indexOfProperty(name));
+      ConfigItem *ext = prop.read(item).value<ConfigItem *>();
+      if (ext && (! ext->label(_context, err)))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+quint32
+ConfigBinaryWriter::string(const QString &str) {
+  auto it = _stringIndices.find(str);
+  if (_stringIndices.end() != it)
+    return it.value();
+  quint32 idx = _strings.size();
+  _strings.append(str.toUtf8());
+  _stringIndices.insert(str, idx);
+  return idx;
+}
+
+bool
+ConfigBinaryWriter::writeRef(QDataStream &out, const ConfigObject *obj, const ErrorStack &err) {
+  if (nullptr == obj) {
+    out << quint32(0);
+  } else if (obj->is<SelectedChannel>() || obj->is<DefaultRadioID>() || obj->is<DefaultRoamingZone>()) {
+    out << quint32(DEFAULT_REF);
+  } else if (_indices.contains(obj)) {
+    out << _indices.value(obj);
+  } else {
+    errMsg(err) << "Cannot write reference to " << obj->metaObject()->className() << " '"
+                << obj->name() << "': Object is not part of the config.";
+    return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeRefList(QDataStream &out, const AbstractConfigObjectList *list, const ErrorStack &err) {
+  out << quint32(list->count());
+  for (int i=0; i<list->count(); i++) {
+    if (! writeRef(out, list->get(i), err))
+      return false;
+  }
+  return true;
+}
+
+void
+ConfigBinaryWriter::writeTone(QDataStream &out, const SelectiveCall &tone) {
+  if (tone.isCTCSS())
+    out << quint8(CTCSSTone) << quint16(tone.mHz()/100);
+  else if (tone.isDCS())
+    out << quint8(DCSTone) << quint16(tone.octalCode()) << tone.isInverted();
+  else
+    out << quint8(NoTone);
+}
+
+bool
+ConfigBinaryWriter::writeExtensions(QDataStream &out, const ConfigItem *item, const ErrorStack &err) {
+  QList<QPair<QByteArray, ConfigItem *>> exts;
+  foreach (const QByteArray &name, extensionProperties(item)) {
+    QMetaProperty prop = item->metaObject()->property(item->metaObject()->indexOfProperty(name));
+    if (ConfigItem *ext = prop.read(item).value<ConfigItem *>())
+      exts.append({name, ext});
+  }
+
+  out << quint8(exts.size());
+  for (auto ext: exts) {
+    YAML::Node node = ext.second->serialize(_context, err);
+    YAML::Emitter emitter;
+    if (node.IsNull())
+      emitter << YAML::Flow << YAML::BeginMap << YAML::EndMap;
+    else
+      emitter << node;
+    if (! emitter.good()) {
+      errMsg(err) << "Cannot serialize extension '" << ext.first << "' of "
+                  << item->metaObject()->className() << ": "
+                  << QString::fromStdString(emitter.GetLastError()) << ".";
+      return false;
+    }
+    out << ext.first << QByteArray(ext.second->metaObject()->className())
+        << QByteArray(emitter.c_str());
+  }
+
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeRadioIDs(QDataStream &out, const ErrorStack &err) {
+  RadioIDList *ids = _config->radioIDs();
+  out << quint32(ids->count());
+  for (int i=0; i<ids->count(); i++) {
+    ConfigObject *obj = ids->get(i);
+    if (DMRRadioID *id = obj->as<DMRRadioID>()) {
+      out << quint8(DMRRadioIDRecord) << string(id->name()) << quint32(id->number());
+    } else if (DTMFRadioID *id = obj->as<DTMFRadioID>()) {
+      out << quint8(DTMFRadioIDRecord) << string(id->name()) << string(id->number());
+    } else {
+      errMsg(err) << "Cannot write radio ID of type " << obj->metaObject()->className() << ".";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeContacts(QDataStream &out, const ErrorStack &err) {
+  ContactList *contacts = _config->contacts();
+  out << quint32(contacts->count());
+  for (int i=0; i<contacts->count(); i++) {
+    Contact *contact = contacts->contact(i);
+    if (DMRContact *dmr = contact->as<DMRContact>()) {
+      out << quint8(DMRContactRecord) << string(dmr->name()) << dmr->ring()
+          << quint8(dmr->type()) << quint32(dmr->number());
+    } else if (DTMFContact *dtmf = contact->as<DTMFContact>()) {
+      out << quint8(DTMFContactRecord) << string(dtmf->name()) << dtmf->ring()
+          << string(dtmf->number());
+    } else {
+      errMsg(err) << "Cannot write contact of type " << contact->metaObject()->className() << ".";
+      return false;
+    }
+    if (! writeExtensions(out, contact, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeGroupLists(QDataStream &out, const ErrorStack &err) {
+  RXGroupLists *lists = _config->rxGroupLists();
+  out << quint32(lists->count());
+  for (int i=0; i<lists->count(); i++) {
+    RXGroupList *list = lists->list(i);
+    out << string(list->name());
+    if (! writeRefList(out, list->contacts(), err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeChannels(QDataStream &out, const ErrorStack &err) {
+  ChannelList *channels = _config->channelList();
+  out << quint32(channels->count());
+  for (int i=0; i<channels->count(); i++) {
+    Channel *channel = channels->channel(i);
+    if (! (channel->is<FMChannel>() || channel->is<DMRChannel>())) {
+      errMsg(err) << "Cannot write channel of type " << channel->metaObject()->className() << ".";
+      return false;
+    }
+
+    out << quint8(channel->is<DMRChannel>() ? DMRChannelRecord : FMChannelRecord)
+        << string(channel->name())
+        << quint64(channel->rxFrequency().inHz()) << quint64(channel->txFrequency().inHz())
+        << channel->defaultPower() << quint8(channel->power()) << quint32(channel->timeout())
+        << channel->rxOnly() << quint32(channel->vox());
+    if (! writeRef(out, channel->scanList(), err))
+      return false;
+
+    if (FMChannel *fm = channel->as<FMChannel>()) {
+      out << quint8(fm->admit()) << quint32(fm->squelch());
+      writeTone(out, fm->rxTone());
+      writeTone(out, fm->txTone());
+      out << quint8(fm->bandwidth());
+      if (! writeRef(out, fm->aprsSystem(), err))
+        return false;
+    } else {
+      DMRChannel *dmr = channel->as<DMRChannel>();
+      out << quint8(dmr->admit()) << quint8(dmr->colorCode()) << quint8(dmr->timeSlot());
+      if ((! writeRef(out, dmr->radioId()->as<ConfigObject>(), err))
+          || (! writeRef(out, dmr->groupList()->as<ConfigObject>(), err))
+          || (! writeRef(out, dmr->contact()->as<ConfigObject>(), err))
+          || (! writeRef(out, dmr->aprs()->as<ConfigObject>(), err))
+          || (! writeRef(out, dmr->roaming()->as<ConfigObject>(), err)))
+        return false;
+    }
+
+    if (! writeExtensions(out, channel, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeZones(QDataStream &out, const ErrorStack &err) {
+  ZoneList *zones = _config->zones();
+  out << quint32(zones->count());
+  for (int i=0; i<zones->count(); i++) {
+    Zone *zone = zones->zone(i);
+    out << string(zone->name());
+    if ((! writeRefList(out, zone->A(), err)) || (! writeRefList(out, zone->B(), err))
+        || (! writeExtensions(out, zone, err)))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeScanLists(QDataStream &out, const ErrorStack &err) {
+  ScanLists *lists = _config->scanlists();
+  out << quint32(lists->count());
+  for (int i=0; i<lists->count(); i++) {
+    ScanList *list = lists->scanlist(i);
+    out << string(list->name());
+    if ((! writeRef(out, list->primaryChannel(), err))
+        || (! writeRef(out, list->secondaryChannel(), err))
+        || (! writeRef(out, list->revertChannel(), err))
+        || (! writeRefList(out, list->channels(), err))
+        || (! writeExtensions(out, list, err)))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writePositioning(QDataStream &out, const ErrorStack &err) {
+  PositioningSystems *systems = _config->posSystems();
+  out << quint32(systems->count());
+  for (int i=0; i<systems->count(); i++) {
+    PositioningSystem *sys = systems->system(i);
+    if (GPSSystem *gps = sys->as<GPSSystem>()) {
+      out << quint8(GPSSystemRecord) << string(gps->name()) << quint32(gps->period());
+      if ((! writeRef(out, gps->contactObj(), err)) || (! writeRef(out, gps->revertChannel(), err)))
+        return false;
+    } else if (APRSSystem *aprs = sys->as<APRSSystem>()) {
+      out << quint8(APRSSystemRecord) << string(aprs->name()) << quint32(aprs->period());
+      if (! writeRef(out, aprs->revertChannel(), err))
+        return false;
+      out << string(aprs->destination()) << quint8(aprs->destSSID())
+          << string(aprs->source()) << quint8(aprs->srcSSID())
+          << string(aprs->path()) << quint32(aprs->icon()) << string(aprs->message());
+    } else {
+      errMsg(err) << "Cannot write positioning system of type "
+                  << sys->metaObject()->className() << ".";
+      return false;
+    }
+    if (! writeExtensions(out, sys, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeRoamingChannels(QDataStream &out, const ErrorStack &err) {
+  Q_UNUSED(err);
+  RoamingChannelList *channels = _config->roamingChannels();
+  out << quint32(channels->count());
+  for (int i=0; i<channels->count(); i++) {
+    RoamingChannel *ch = channels->channel(i);
+    out << string(ch->name())
+        << quint64(ch->rxFrequency().inHz()) << quint64(ch->txFrequency().inHz())
+        << ch->colorCodeOverridden() << quint8(ch->colorCode())
+        << ch->timeSlotOverridden() << quint8(ch->timeSlot());
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeRoamingZones(QDataStream &out, const ErrorStack &err) {
+  RoamingZoneList *zones = _config->roamingZones();
+  out << quint32(zones->count());
+  for (int i=0; i<zones->count(); i++) {
+    RoamingZone *zone = zones->zone(i);
+    out << string(zone->name());
+    if (! writeRefList(out, zone->channels(), err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryWriter::writeSettings(QDataStream &out, const ErrorStack &err) {
+  RadioSettings *settings = _config->settings();
+  out << string(settings->introLine1()) << string(settings->introLine2())
+      << quint32(settings->micLevel()) << settings->speech() << quint8(settings->power())
+      << quint32(settings->squelch()) << quint32(settings->vox()) << quint32(settings->tot());
+  if (! writeRef(out, settings->defaultIdRef()->as<ConfigObject>(), err))
+    return false;
+  return writeExtensions(out, settings, err);
+}
+
+bool
+ConfigBinaryWriter::writeConfigExtensions(QDataStream &out, const ErrorStack &err) {
+  return writeExtensions(out, _config, err);
+}
+
+
+/* ********************************************************************************************* *
+ * Reader
+ * ********************************************************************************************* */
+/** Reads a config from the binary format.
+ * @ingroup conf */
+class ConfigBinaryReader
+{
+public:
+  /** Constructs a reader for the given config. */
+  explicit ConfigBinaryReader(Config *config);
+  /** Destructor, deletes all objects not added to the config. */
+  ~ConfigBinaryReader();
+
+  /** Reads the config from the given device. */
+  bool read(QIODevice &device, const ErrorStack &err);
+
+protected:
+  /** Reads the string table. */
+  bool readStrings(QDataStream &in, const ErrorStack &err);
+  /** Reads a string index and returns the string. */
+  QString string(QDataStream &in);
+  /** Reads a reference, resolved once all objects are read. */
+  void readRef(QDataStream &in, ConfigObjectReference *ref, Target target);
+  /** Reads a list of references, resolved once all objects are read. */
+  void readRefList(QDataStream &in, AbstractConfigObjectList *list, Target target);
+  /** Reads a sub tone. */
+  SelectiveCall readTone(QDataStream &in);
+  /** Reads and parses all extensions of the given item. */
+  bool readExtensions(QDataStream &in, ConfigItem *item, const ErrorStack &err);
+  /** Appends an object to the given target list. */
+  void addObject(Target target, ConfigObject *obj);
+
+  /** Reads the radio IDs. */
+  bool readRadioIDs(QDataStream &in, const ErrorStack &err);
+  /** Reads the contacts. */
+  bool readContacts(QDataStream &in, const ErrorStack &err);
+  /** Reads the group lists. */
+  bool readGroupLists(QDataStream &in, const ErrorStack &err);
+  /** Reads the channels. */
+  bool readChannels(QDataStream &in, const ErrorStack &err);
+  /** Reads the zones. */
+  bool readZones(QDataStream &in, const ErrorStack &err);
+  /** Reads the scan lists. */
+  bool readScanLists(QDataStream &in, const ErrorStack &err);
+  /** Reads the positioning systems. */
+  bool readPositioning(QDataStream &in, const ErrorStack &err);
+  /** Reads the roaming channels. */
+  bool readRoamingChannels(QDataStream &in, const ErrorStack &err);
+  /** Reads the roaming zones. */
+  bool readRoamingZones(QDataStream &in, const ErrorStack &err);
+  /** Reads the settings. */
+  bool readSettings(QDataStream &in, const ErrorStack &err);
+  /** Reads the config extensions. */
+  bool readConfigExtensions(QDataStream &in, const ErrorStack &err);
+
+  /** Resolves all references and links the extensions. */
+  bool link(const ErrorStack &err);
+
+protected:
+  /** A reference or reference list to resolve. */
+  struct PendingRef {
+    /** The reference to set, or @c nullptr. */
+    ConfigObjectReference *ref;
+    /** The list to append to, if @c ref is @c nullptr. */
+    AbstractConfigObjectList *list;
+    /** The list of the referenced object. */
+    Target target;
+    /** The 1-based index of the referenced object. */
+    quint32 index;
+  };
+
+  /** An extension to link. */
+  struct PendingExtension {
+    /** The extension. */
+    ConfigItem *extension;
+    /** Its YAML representation. */
+    YAML::Node node;
+  };
+
+  /** The config to read. */
+  Config *_config;
+  /** The string table. */
+  QVector<QString> _strings;
+  /** Gets cleared if an invalid string index is read. */
+  bool _valid;
+  /** All objects read per target. */
+  QVector<ConfigObject *> _objects[NumTargets];
+  /** The references to resolve. */
+  QVector<PendingRef> _refs;
+  /** The extensions to link. */
+  QVector<PendingExtension> _extensions;
+  /** IDs of all objects, used to parse the extensions. */
+  ConfigItem::Context _context;
+};
+
+
+ConfigBinaryReader::ConfigBinaryReader(Config *config)
+  : _config(config), _strings(), _valid(true), _refs(), _extensions(), _context()
+{
+  // pass...
+}
+
+ConfigBinaryReader::~ConfigBinaryReader() {
+  for (int t=0; t<NumTargets; t++) {
+    foreach (ConfigObject *obj, _objects[t]) {
+      if (nullptr == obj->parent())
+        delete obj;
+    }
+  }
+}
+
+bool
+ConfigBinaryReader::read(QIODevice &device, const ErrorStack &err) {
+  QDataStream in(&device); setupStream(in);
+
+  char magic[MAGIC_SIZE];
+  if ((MAGIC_SIZE != in.readRawData(magic, MAGIC_SIZE)) || (0 != memcmp(magic, MAGIC, MAGIC_SIZE))) {
+    errMsg(err) << "Cannot read binary config: Not a binary config.";
+    return false;
+  }
+
+  quint16 format; QByteArray version;
+  in >> format >> version;
+  if (QDataStream::Ok != in.status()) {
+    errMsg(err) << "Cannot read binary config: Truncated header.";
+    return false;
+  }
+  if (ConfigBinary::FormatVersion < format) {
+    errMsg(err) << "Cannot read binary config: Format version " << format
+                << " is newer than the supported version " << ConfigBinary::FormatVersion << ".";
+    return false;
+  }
+  logDebug() << "Read binary config written by qdmr " << QString::fromUtf8(version) << ".";
+  _context.setVersion(QString::fromUtf8(version));
+
+  typedef bool (ConfigBinaryReader::*SectionReader)(QDataStream &, const ErrorStack &);
+  const QHash<quint32, SectionReader> readers = {
+    {StringSection, &ConfigBinaryReader::readStrings},
+    {RadioIDSection, &ConfigBinaryReader::readRadioIDs},
+    {ContactSection, &ConfigBinaryReader::readContacts},
+    {GroupListSection, &ConfigBinaryReader::readGroupLists},
+    {ChannelSection, &ConfigBinaryReader::readChannels},
+    {ZoneSection, &ConfigBinaryReader::readZones},
+    {ScanListSection, &ConfigBinaryReader::readScanLists},
+    {PositioningSection, &ConfigBinaryReader::readPositioning},
+    {RoamingChannelSection, &ConfigBinaryReader::readRoamingChannels},
+    {RoamingZoneSection, &ConfigBinaryReader::readRoamingZones},
+    {SettingsSection, &ConfigBinaryReader::readSettings},
+    {ExtensionSection, &ConfigBinaryReader::readConfigExtensions}
+  };
+
+  _config->clear();
+
+  // Objects must be created before the extensions get parsed, as extensions may refer to them.
+  // Hence, all IDs are assigned up-front, once the counts are known. To this end, the sections
+  // are read in the order they were written.
+  while (true) {
+    quint32 tag; QByteArray payload;
+    in >> tag >> payload;
+    if (QDataStream::Ok != in.status()) {
+      errMsg(err) << "Cannot read binary config: Truncated file.";
+      return false;
+    }
+    if (EndSection == tag)
+      break;
+    if (! readers.contains(tag)) {
+      logDebug() << "Skip unknown section " << QString::number(tag, 16) << ".";
+      continue;
+    }
+
+    QDataStream section(payload); setupStream(section);
+    if (! (this->*readers[tag])(section, err)) {
+      errMsg(err) << "Cannot read binary config.";
+      return false;
+    }
+    if ((QDataStream::Ok != section.status()) || (! _valid)) {
+      errMsg(err) << "Cannot read binary config: Malformed section "
+                  << QString::number(tag, 16) << ".";
+      return false;
+    }
+  }
+
+  return link(err);
+}
+
+bool
+ConfigBinaryReader::readStrings(QDataStream &in, const ErrorStack &err) {
+  quint32 n; in >> n;
+  if (QDataStream::Ok != in.status()) {
+    errMsg(err) << "Cannot read string table.";
+    return false;
+  }
+  _strings.clear();
+  _strings.reserve(std::min(n, quint32(in.device()->size())));
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    QByteArray str; in >> str;
+    _strings.append(QString::fromUtf8(str));
+  }
+  return true;
+}
+
+QString
+ConfigBinaryReader::string(QDataStream &in) {
+  quint32 idx; in >> idx;
+  if ((QDataStream::Ok != in.status()) || (idx >= quint32(_strings.size()))) {
+    _valid = false;
+    return QString();
+  }
+  return _strings[idx];
+}
+
+void
+ConfigBinaryReader::readRef(QDataStream &in, ConfigObjectReference *ref, Target target) {
+  quint32 idx; in >> idx;
+  if (idx)
+    _refs.append({ref, nullptr, target, idx});
+}
+
+void
+ConfigBinaryReader::readRefList(QDataStream &in, AbstractConfigObjectList *list, Target target) {
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    quint32 idx; in >> idx;
+    _refs.append({nullptr, list, target, idx});
+  }
+}
+
+SelectiveCall
+ConfigBinaryReader::readTone(QDataStream &in) {
+  quint8 type; in >> type;
+  if (CTCSSTone == type) {
+    quint16 deciHz; in >> deciHz;
+    return SelectiveCall((deciHz+0.25)/10.0);
+  } else if (DCSTone == type) {
+    quint16 code; bool inverted; in >> code >> inverted;
+    return SelectiveCall(code, inverted);
+  }
+  return SelectiveCall();
+}
+
+bool
+ConfigBinaryReader::readExtensions(QDataStream &in, ConfigItem *item, const ErrorStack &err) {
+  quint8 n; in >> n;
+  for (quint8 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    QByteArray name, className, yaml;
+    in >> name >> className >> yaml;
+    if (QDataStream::Ok != in.status())
+      break;
+
+    const QMetaObject *meta = item->metaObject();
+    int idx = meta->indexOfProperty(name.constData());
+    if (0 > idx) {
+      errMsg(err) << "Cannot read extension '" << name << "' of " << meta->className()
+                  << ": Unknown property.";
+      return false;
+    }
+    QMetaProperty prop = meta->property(idx);
+
+    YAML::Node node;
+    try {
+      node = YAML::Load(yaml.constData());
+    } catch (const YAML::Exception &exc) {
+      errMsg(err) << "Cannot read extension '" << name << "' of " << meta->className()
+                  << ": " << QString::fromStdString(exc.msg) << ".";
+      return false;
+    }
+
+    // If not set and writable -> allocate and set
+    ConfigItem *ext = prop.read(item).value<ConfigItem *>();
+    if ((nullptr == ext) && prop.isWritable()) {
+      if (nullptr == (ext = item->allocateChild(prop, node, _context, err))) {
+        errMsg(err) << "Cannot allocate extension '" << name << "' of " << meta->className() << ".";
+        return false;
+      }
+      if (! prop.write(item, QVariant::fromValue(ext))) {
+        if (nullptr == ext->parent())
+          ext->deleteLater();
+        errMsg(err) << "Cannot set extension '" << name << "' of " << meta->className() << ".";
+        return false;
+      }
+    }
+
+    if ((nullptr == ext) || (className != ext->metaObject()->className())) {
+      errMsg(err) << "Cannot read extension '" << name << "' of " << meta->className()
+                  << ": Expected instance of " << className << ".";
+      return false;
+    }
+    if (! ext->parse(node, _context, err)) {
+      errMsg(err) << "Cannot parse extension '" << name << "' of " << meta->className() << ".";
+      return false;
+    }
+    _extensions.append({ext, node});
+  }
+
+  return true;
+}
+
+void
+ConfigBinaryReader::addObject(Target target, ConfigObject *obj) {
+  _objects[target].append(obj);
+  _context.add(QString("%1%2").arg(targetPrefix[target]).arg(_objects[target].size()), obj);
+}
+
+bool
+ConfigBinaryReader::readRadioIDs(QDataStream &in, const ErrorStack &err) {
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    quint8 type; in >> type;
+    QString name = string(in);
+    if (DMRRadioIDRecord == type) {
+      quint32 number; in >> number;
+      addObject(RadioIDs, new DMRRadioID(name, number));
+    } else if (DTMFRadioIDRecord == type) {
+      addObject(RadioIDs, new DTMFRadioID(name, string(in)));
+    } else {
+      errMsg(err) << "Unknown radio ID type " << unsigned(type) << ".";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readContacts(QDataStream &in, const ErrorStack &err) {
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    quint8 type; bool ring;
+    in >> type;
+    QString name = string(in);
+    in >> ring;
+
+    Contact *contact = nullptr;
+    if (DMRContactRecord == type) {
+      quint8 callType; quint32 number;
+      in >> callType >> number;
+      contact = new DMRContact(DMRContact::Type(callType), name, number, ring);
+    } else if (DTMFContactRecord == type) {
+      contact = new DTMFContact(name, string(in), ring);
+    } else {
+      errMsg(err) << "Unknown contact type " << unsigned(type) << ".";
+      return false;
+    }
+
+    addObject(Contacts, contact);
+    if (! readExtensions(in, contact, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readGroupLists(QDataStream &in, const ErrorStack &err) {
+  Q_UNUSED(err);
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    RXGroupList *list = new RXGroupList(string(in));
+    addObject(GroupLists, list);
+    readRefList(in, list->contacts(), Contacts);
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readChannels(QDataStream &in, const ErrorStack &err) {
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    quint8 type; in >> type;
+    Channel *channel = nullptr;
+    if (FMChannelRecord == type) {
+      channel = new FMChannel();
+    } else if (DMRChannelRecord == type) {
+      channel = new DMRChannel();
+    } else {
+      errMsg(err) << "Unknown channel type " << unsigned(type) << ".";
+      return false;
+    }
+    addObject(Channels, channel);
+
+    quint64 rx, tx; bool defaultPower, rxOnly; quint8 power; quint32 timeout, vox;
+    channel->setName(string(in));
+    in >> rx >> tx >> defaultPower >> power >> timeout >> rxOnly >> vox;
+    channel->setRXFrequency(Frequency::fromHz(rx));
+    channel->setTXFrequency(Frequency::fromHz(tx));
+    if (defaultPower)
+      channel->setDefaultPower();
+    else
+      channel->setPower(Channel::Power(power));
+    channel->setTimeout(timeout);
+    channel->setRXOnly(rxOnly);
+    channel->setVOX(vox);
+    readRef(in, channel->scanListRef(), ScanLists);
+
+    if (FMChannel *fm = channel->as<FMChannel>()) {
+      quint8 admit, bandwidth; quint32 squelch;
+      in >> admit >> squelch;
+      fm->setAdmit(FMChannel::Admit(admit));
+      fm->setSquelch(squelch);
+      fm->setRXTone(readTone(in));
+      fm->setTXTone(readTone(in));
+      in >> bandwidth;
+      fm->setBandwidth(FMChannel::Bandwidth(bandwidth));
+      readRef(in, fm->aprs(), Positioning);
+    } else {
+      DMRChannel *dmr = channel->as<DMRChannel>();
+      quint8 admit, cc, ts;
+      in >> admit >> cc >> ts;
+      dmr->setAdmit(DMRChannel::Admit(admit));
+      dmr->setColorCode(cc);
+      dmr->setTimeSlot(DMRChannel::TimeSlot(ts));
+      readRef(in, dmr->radioId(), RadioIDs);
+      readRef(in, dmr->groupList(), GroupLists);
+      readRef(in, dmr->contact(), Contacts);
+      readRef(in, dmr->aprs(), Positioning);
+      readRef(in, dmr->roaming(), RoamingZones);
+    }
+
+    if (! readExtensions(in, channel, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readZones(QDataStream &in, const ErrorStack &err) {
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    Zone *zone = new Zone(string(in));
+    addObject(Zones, zone);
+    readRefList(in, zone->A(), Channels);
+    readRefList(in, zone->B(), Channels);
+    if (! readExtensions(in, zone, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readScanLists(QDataStream &in, const ErrorStack &err) {
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    ScanList *list = new ScanList(string(in));
+    addObject(ScanLists, list);
+    readRef(in, list->primary(), Channels);
+    readRef(in, list->secondary(), Channels);
+    readRef(in, list->revert(), Channels);
+    readRefList(in, list->channels(), Channels);
+    if (! readExtensions(in, list, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readPositioning(QDataStream &in, const ErrorStack &err) {
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    quint8 type; quint32 period;
+    in >> type;
+    QString name = string(in);
+    in >> period;
+
+    PositioningSystem *sys = nullptr;
+    if (GPSSystemRecord == type) {
+      GPSSystem *gps = new GPSSystem();
+      readRef(in, gps->contact(), Contacts);
+      readRef(in, gps->revert(), Channels);
+      sys = gps;
+    } else if (APRSSystemRecord == type) {
+      APRSSystem *aprs = new APRSSystem();
+      readRef(in, aprs->revert(), Channels);
+      quint8 destSSID, srcSSID; quint32 icon;
+      QString dest = string(in);
+      in >> destSSID;
+      QString src = string(in);
+      in >> srcSSID;
+      aprs->setDestination(dest, destSSID);
+      aprs->setSource(src, srcSSID);
+      aprs->setPath(string(in));
+      in >> icon;
+      aprs->setIcon(APRSSystem::Icon(icon));
+      aprs->setMessage(string(in));
+      sys = aprs;
+    } else {
+      errMsg(err) << "Unknown positioning system type " << unsigned(type) << ".";
+      return false;
+    }
+
+    sys->setName(name);
+    sys->setPeriod(period);
+    addObject(Positioning, sys);
+    if (! readExtensions(in, sys, err))
+      return false;
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readRoamingChannels(QDataStream &in, const ErrorStack &err) {
+  Q_UNUSED(err);
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    RoamingChannel *ch = new RoamingChannel();
+    quint64 rx, tx; bool overrideCC, overrideTS; quint8 cc, ts;
+    ch->setName(string(in));
+    in >> rx >> tx >> overrideCC >> cc >> overrideTS >> ts;
+    ch->setRXFrequency(Frequency::fromHz(rx));
+    ch->setTXFrequency(Frequency::fromHz(tx));
+    ch->setColorCode(cc);
+    ch->overrideColorCode(overrideCC);
+    ch->setTimeSlot(DMRChannel::TimeSlot(ts));
+    ch->overrideTimeSlot(overrideTS);
+    addObject(RoamingChannels, ch);
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readRoamingZones(QDataStream &in, const ErrorStack &err) {
+  Q_UNUSED(err);
+  quint32 n; in >> n;
+  for (quint32 i=0; (i<n) && (QDataStream::Ok == in.status()); i++) {
+    RoamingZone *zone = new RoamingZone(string(in));
+    addObject(RoamingZones, zone);
+    readRefList(in, zone->channels(), RoamingChannels);
+  }
+  return true;
+}
+
+bool
+ConfigBinaryReader::readSettings(QDataStream &in, const ErrorStack &err) {
+  RadioSettings *settings = _config->settings();
+  bool speech; quint8 power; quint32 micLevel, squelch, vox, tot;
+  settings->setIntroLine1(string(in));
+  settings->setIntroLine2(string(in));
+  in >> micLevel >> speech >> power >> squelch >> vox >> tot;
+  settings->setMicLevel(micLevel);
+  settings->enableSpeech(speech);
+  settings->setPower(Channel::Power(power));
+  settings->setSquelch(squelch);
+  settings->setVOX(vox);
+  settings->setTOT(tot);
+  readRef(in, settings->defaultIdRef(), RadioIDs);
+  return readExtensions(in, settings, err);
+}
+
+bool
+ConfigBinaryReader::readConfigExtensions(QDataStream &in, const ErrorStack &err) {
+  return readExtensions(in, _config, err);
+}
+
+bool
+ConfigBinaryReader::link(const ErrorStack &err) {
+  // Add all objects to the config
+  for (int t=0; t<NumTargets; t++) {
+    AbstractConfigObjectList *list = targetList(_config, Target(t));
+    foreach (ConfigObject *obj, _objects[t]) {
+      if (0 > list->add(obj, -1, false)) {
+        errMsg(err) << "Cannot add " << obj->metaObject()->className() << " '" << obj->name()
+                    << "' to config.";
+        return false;
+      }
+    }
+  }
+
+  // Resolve references
+  foreach (const PendingRef &pending, _refs) {
+    ConfigObject *obj = nullptr;
+    if (DEFAULT_REF == pending.index) {
+      if (Channels == pending.target)
+        obj = SelectedChannel::get();
+      else if (RadioIDs == pending.target)
+        obj = DefaultRadioID::get();
+      else if (RoamingZones == pending.target)
+        obj = DefaultRoamingZone::get();
+    } else if ((0 < pending.index) && (pending.index <= quint32(_objects[pending.target].size()))) {
+      obj = _objects[pending.target][pending.index-1];
+    }
+
+    if (nullptr == obj) {
+      errMsg(err) << "Cannot read binary config: Invalid reference " << pending.index
+                  << " into " << targetPrefix[pending.target] << " list.";
+      return false;
+    }
+    if (pending.ref && (! pending.ref->set(obj))) {
+      errMsg(err) << "Cannot read binary config: Cannot set reference to "
+                  << obj->metaObject()->className() << " '" << obj->name() << "'.";
+      return false;
+    } else if (pending.list && (0 > pending.list->add(obj))) {
+      errMsg(err) << "Cannot read binary config: Cannot add "
+                  << obj->metaObject()->className() << " '" << obj->name() << "' to list.";
+      return false;
+    }
+  }
+
+  // Link extensions
+  foreach (const PendingExtension &pending, _extensions) {
+    if (! pending.extension->link(pending.node, _context, err)) {
+      errMsg(err) << "Cannot link extension " << pending.extension->metaObject()->className() << ".";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of ConfigBinary
+ * ********************************************************************************************* */
+bool
+ConfigBinary::write(Config *config, QIODevice &device, const ErrorStack &err) {
+  ConfigBinaryWriter writer(config);
+  return writer.write(device, err);
+}
+
+bool
+ConfigBinary::read(Config *config, QIODevice &device, const ErrorStack &err) {
+  ConfigBinaryReader reader(config);
+  return reader.read(device, err);
+}
+
+bool
+ConfigBinary::isBinary(QIODevice &device) {
+  return MAGIC == device.peek(MAGIC_SIZE);
+}
@@ -0,0 +1,46 @@
+#ifndef CONFIGBINARY_HH
+#define CONFIGBINARY_HH
+
+#include "errorstack.hh"
+
+class Config;
+class QIODevice;
+
+
+/** Reads and writes configs in a compact, versioned binary format.
+ *
+ * YAML remains the interchange format of qdmr. This format is meant to save and load large
+ * configs quickly. The file starts with the magic @c QDMRCONF, the 16-bit format version and the
+ * version of qdmr that wrote the file. It is followed by a sequence of sections, each consisting of
+ * a 32-bit tag and a length-prefixed payload. Unknown sections are skipped. All integers are
+ * stored in little endian.
+ *
+ * The first section holds a string table. All names and texts are stored as indices into this
+ * table. The following sections hold the radio IDs, contacts, group lists, channels, zones, scan
+ * lists, positioning systems, roaming channels, roaming zones and the settings as records. A
+ * reference is stored as the 1-based index of the referenced object within its list, 0 means no
+ * reference. These records are read and written without the property reflection used for YAML.
+ *
+ * Extensions are stored as YAML blobs, keyed by the property and class name of the extension.
+ *
+ * @since 0.12.0
+ * @ingroup conf */
+class ConfigBinary
+{
+public:
+  /** The format version. */
+  enum {
+    FormatVersion = 1          ///< The format version written.
+  };
+
+public:
+  /** Writes the given config to the given device. */
+  static bool write(Config *config, QIODevice &device, const ErrorStack &err=ErrorStack());
+  /** Reads the config from the given device. The config is cleared first. */
+  static bool read(Config *config, QIODevice &device, const ErrorStack &err=ErrorStack());
+  /** Returns @c true if the given device starts with the magic of the binary format. The device
+   * is not consumed. */
+  static bool isBinary(QIODevice &device);
+};
+
+#endif // CONFIGBINARY_HH
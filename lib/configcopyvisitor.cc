@@ -270,12 +270,17 @@ ConfigCloneVisitor::takeResult(const ErrorStack &err) {
  * Implementation of FixReferencesVisitor
  * ********************************************************************************************* */
 FixReferencesVisistor::FixReferencesVisistor(QHash<ConfigObject *, ConfigObject *> &map, bool keepUnknown)
-  : Visitor(), _map(map), _keepUnknown(keepUnknown)
+  : Visitor(), _map(map), _handles(), _keepUnknown(keepUnknown)
 {
   // Populate with default singleton instances.
   map[SelectedChannel::get()] = SelectedChannel::get();
   map[DefaultRadioID::get()]  = DefaultRadioID::get();
   map[DefaultRoamingZone::get()] = DefaultRoamingZone::get();
+
+  // Translate map into handles, used to remap reference lists
+  _handles.reserve(map.size());
+  for (auto it=map.constBegin(); it!=map.constEnd(); it++)
+    _handles.insert(it.key()->handle(), it.value()->handle());
 }
 
 bool
@@ -308,23 +313,20 @@ FixReferencesVisistor::processList(AbstractConfigObjectList *list, const ErrorSt
   if (! Visitor::processList(list, err))
     return false;
   if (ConfigObjectRefList *rlist = dynamic_cast<ConfigObjectRefList*>(list)) {
-    QSet<ConfigObject*> del;
-    // Resolve all references.
-    for (int i=0; i<rlist->count(); i++) {
-      if ((! _keepUnknown) && (! _map.contains(rlist->get(i)))) {
-        errMsg(err) << "Cannot fix refrence to object '" << rlist->get(i)->name()
-                    << "' of type " << rlist->get(i)->metaObject()->className()
+    if (! _keepUnknown) {
+      foreach (ConfigObjectRegistry::Handle handle, rlist->handles()) {
+        if (_handles.contains(handle))
+          continue;
+        ConfigObject *obj = ConfigObjectRegistry::resolve(handle);
+        errMsg(err) << "Cannot fix refrence to object '" << obj->name()
+                    << "' of type " << obj->metaObject()->className()
                     << ": Not mapped/cloned yet.";
         return false;
       }
-      // If the reference cannot be replaced (i.e., the replacement is already in the list):
-      if (_map.contains(rlist->get(i)) && (0 > rlist->replace(_map[rlist->get(i)], i)))
-        del.insert(rlist->get(i));
-    }
-    // Now remove all references that could not be replaced
-    foreach (ConfigObject *obj, del) {
-      rlist->del(obj);
     }
+    // Resolve all references at once, references that cannot be replaced (i.e., the replacement
+    // is already in the list) are removed.
+    rlist->remap(_handles);
   }
 
   return true;
@@ -2,6 +2,8 @@
 #define CONFIGCOPYVISITOR_HH
 
 #include "visitor.hh"
+#include "configobjectregistry.hh"
+#include <QHash>
 
 class ConfigObject;
 
@@ -46,6 +48,8 @@ public:
 protected:
   /** Reference to the translation table origial -> cloned object. */
   QHash<ConfigObject *, ConfigObject*> &_map;
+  /** The same translation table for the handles of the objects. */
+  QHash<ConfigObjectRegistry::Handle, ConfigObjectRegistry::Handle> _handles;
   /** If false, an unmapped reference is an error. */
   bool _keepUnknown;
 };
@@ -8,6 +8,8 @@
 
 #include <QMetaProperty>
 #include <QMetaEnum>
+#include <QThread>
+#include <QSet>
 
 // Helper function to extract key names for a QMetaEnum
 inline QStringList enumKeys(const QMetaEnum &e) {
@@ -947,6 +949,44 @@ ConfigItem::findItemsOfTypes(const QStringList &typeNames, QSet<ConfigItem *> &i
   }
 }
 
+void
+ConfigItem::moveItemToThread(QThread *thread) {
+  // Items can only be pushed from the thread they live in
+  if (QThread::currentThread() != this->thread())
+    return;
+  if (thread != this->thread())
+    moveToThread(thread);
+
+  // Visit all properties
+  const QMetaObject *meta = metaObject();
+  for (int p=QObject::staticMetaObject.propertyCount(); p<meta->propertyCount(); p++) {
+    QMetaProperty prop = meta->property(p);
+    if ((! prop.isValid()) || (! prop.isReadable()))
+      continue;
+    // Only QObject pointers may hold child items, skip all other properties without reading them
+    if ((QMetaType::UnknownType == prop.userType()) ||
+        (! (QMetaType::PointerToQObject & QMetaType(prop.userType()).flags())))
+      continue;
+
+    QObject *value = prop.read(this).value<QObject *>();
+    QObject *member = nullptr;
+    if (ConfigItem *item = qobject_cast<ConfigItem *>(value)) {
+      item->moveItemToThread(thread);
+    } else if (ConfigObjectReference *ref = qobject_cast<ConfigObjectReference *>(value)) {
+      member = ref;
+    } else if (ConfigObjectList *lst = qobject_cast<ConfigObjectList *>(value)) {
+      member = lst;
+      for (int i=0; i<lst->count(); i++)
+        lst->get(i)->moveItemToThread(thread);
+    } else if (ConfigObjectRefList *lst = qobject_cast<ConfigObjectRefList *>(value)) {
+      member = lst;
+    }
+
+    if (member && (QThread::currentThread() == member->thread()) && (thread != member->thread()))
+      member->moveToThread(thread);
+  }
+}
+
 bool
 ConfigItem::hasDescription() const {
   const QMetaObject *meta = metaObject();
@@ -1016,17 +1056,26 @@ ConfigItem::longDescription(const QMetaProperty &prop) const {
  * Implementation of ConfigObject
  * ********************************************************************************************* */
 ConfigObject::ConfigObject(QObject *parent)
-  : ConfigItem(parent), _name()
+  : ConfigItem(parent), _name(), _handle(ConfigObjectRegistry::add(this))
 {
   // pass...
 }
 
 ConfigObject::ConfigObject(const QString &name, QObject *parent)
-  : ConfigItem(parent), _name(name)
+  : ConfigItem(parent), _name(name), _handle(ConfigObjectRegistry::add(this))
 {
   // pass...
 }
 
+ConfigObject::~ConfigObject() {
+  ConfigObjectRegistry::remove(_handle);
+}
+
+ConfigObjectRegistry::Handle
+ConfigObject::handle() const {
+  return _handle;
+}
+
 const QString &
 ConfigObject::name() const {
   return _name;
@@ -1119,13 +1168,13 @@ ConfigExtension::ConfigExtension(QObject *parent)
  * Implementation of AbstractConfigObjectList
  * ********************************************************************************************* */
 AbstractConfigObjectList::AbstractConfigObjectList(const QMetaObject &elementType, QObject *parent)
-  : QObject(parent), _elementTypes(), _items()
+  : QObject(parent), _elementTypes(), _items(), _deferred(false)
 {
   _elementTypes.append(elementType);
 }
 
 AbstractConfigObjectList::AbstractConfigObjectList(const std::initializer_list<QMetaObject> &elementTypes, QObject *parent)
-  : QObject(parent), _elementTypes(elementTypes), _items()
+  : QObject(parent), _elementTypes(elementTypes), _items(), _deferred(false)
 {
   // pass...
 }
@@ -1226,6 +1275,29 @@ AbstractConfigObjectList::add(ConfigObject *obj, int row, bool unique) {
   return row;
 }
 
+int
+AbstractConfigObjectList::append(const QVector<ConfigObject *> &objs, bool unique) {
+  QSet<ConfigObject *> present;
+  if (unique) {
+    present.reserve(_items.size()+objs.size());
+    foreach (ConfigObject *obj, _items)
+      present.insert(obj);
+  }
+
+  _items.reserve(_items.size()+objs.size());
+  int added = 0;
+  foreach (ConfigObject *obj, objs) {
+    if ((nullptr == obj) || (unique && present.contains(obj)))
+      continue;
+    if (0 > add(obj, -1, false))
+      continue;
+    if (unique)
+      present.insert(obj);
+    added++;
+  }
+  return added;
+}
+
 int
 AbstractConfigObjectList::replace(ConfigObject *obj, int row, bool unique) {
   // Ignore nullptr
@@ -1355,10 +1427,20 @@ AbstractConfigObjectList::classNames() const {
   return cls;
 }
 
+bool
+AbstractConfigObjectList::isDeferred() const {
+  return _deferred;
+}
+
+void
+AbstractConfigObjectList::setDeferred(bool deferred) {
+  _deferred = deferred;
+}
+
 void
 AbstractConfigObjectList::onElementModified(ConfigItem *obj) {
   int idx = indexOf(obj->as<ConfigObject>());
-  if (0 >= idx)
+  if (0 <= idx)
     emit elementModified(idx);
 }
 
@@ -1529,17 +1611,36 @@ ConfigObjectList::compare(const ConfigObjectList &other) const {
  * Implementation of ConfigObjectRefList
  * ********************************************************************************************* */
 ConfigObjectRefList::ConfigObjectRefList(const QMetaObject &elementType, QObject *parent)
-  : AbstractConfigObjectList(elementType, parent)
+  : AbstractConfigObjectList(elementType, parent), _handles()
 {
   // pass...
 }
 
 ConfigObjectRefList::ConfigObjectRefList(const std::initializer_list<QMetaObject> &elementTypes, QObject *parent)
-  : AbstractConfigObjectList(elementTypes, parent)
+  : AbstractConfigObjectList(elementTypes, parent), _handles()
 {
   // pass...
 }
 
+ConfigObjectRefList::~ConfigObjectRefList() {
+  foreach (ConfigObjectRegistry::Handle handle, _handles)
+    ConfigObjectRegistry::unobserve(handle, this);
+}
+
+bool
+ConfigObjectRefList::copy(const AbstractConfigObjectList &other) {
+  _elementTypes = other.elementTypes();
+  // Copying from another reference list is a plain copy of the handles
+  if (const ConfigObjectRefList *refs = qobject_cast<const ConfigObjectRefList *>(&other)) {
+    setHandles(refs->handles());
+    return true;
+  }
+  clear();
+  for (int i=0; i<other.count(); i++)
+    add(other.get(i));
+  return true;
+}
+
 bool
 ConfigObjectRefList::label(ConfigItem::Context &context, const ErrorStack &err) {
   Q_UNUSED(context); Q_UNUSED(err);
@@ -1550,7 +1651,8 @@ ConfigObjectRefList::label(ConfigItem::Context &context, const ErrorStack &err)
 YAML::Node
 ConfigObjectRefList::serialize(const ConfigItem::Context &context, const ErrorStack &err) {
   YAML::Node list(YAML::NodeType::Sequence);
-  foreach (ConfigObject *obj, _items) {
+  for (int i=0; i<count(); i++) {
+    ConfigObject *obj = get(i);
     if (! context.contains(obj)) {
       errMsg(err) << "Cannot serialized ref list: Object '" << obj->name() << "' not in context!";
       return YAML::Node();
@@ -1560,6 +1662,214 @@ ConfigObjectRefList::serialize(const ConfigItem::Context &context, const ErrorSt
   return list;
 }
 
+int
+ConfigObjectRefList::count() const {
+  return _handles.count();
+}
+
+int
+ConfigObjectRefList::indexOf(ConfigObject *obj) const {
+  if (nullptr == obj)
+    return -1;
+  return _handles.indexOf(obj->handle());
+}
+
+void
+ConfigObjectRefList::clear() {
+  // All references get removed, hence the objects are disconnected right away. Using detach would
+  // search the remaining references for every element.
+  for (int i=(_handles.count()-1); i>=0; i--) {
+    ConfigObjectRegistry::Handle handle = _handles.takeLast();
+    ConfigObjectRegistry::unobserve(handle, this);
+    if (ConfigObject *obj = ConfigObjectRegistry::resolve(handle))
+      disconnect(obj, SIGNAL(modified(ConfigItem*)), this, SLOT(onElementModified(ConfigItem*)));
+    emit elementRemoved(i);
+  }
+}
+
+void
+ConfigObjectRefList::findItemsOfTypes(const QStringList &typeNames, QSet<ConfigItem *> &items) const {
+  for (int i=0; i<count(); i++) {
+    ConfigObject *obj = get(i);
+    if (isInstanceOf(obj, typeNames))
+      items.insert(obj);
+    obj->findItemsOfTypes(typeNames, items);
+  }
+}
+
+QList<ConfigObject *>
+ConfigObjectRefList::findItemsByName(const QString name) const {
+  QList<ConfigObject *> items;
+  for (int i=0; i<count(); i++) {
+    if (get(i)->name() == name)
+      items.append(get(i));
+  }
+  return items;
+}
+
+ConfigObject *
+ConfigObjectRefList::get(int idx) const {
+  if ((0 > idx) || (idx >= _handles.count()))
+    return nullptr;
+  return ConfigObjectRegistry::resolve(_handles[idx]);
+}
+
+int
+ConfigObjectRefList::add(ConfigObject *obj, int row, bool unique) {
+  // Ignore nullptr
+  if (nullptr == obj)
+    return -1;
+  // If already in list -> ignore
+  if (unique && (0 <= indexOf(obj)))
+    return -1;
+  if (! isElementType(obj))
+    return -1;
+  if (! attach(obj))
+    return -1;
+  if ((0 > row) || (row > _handles.count()))
+    row = _handles.count();
+  _handles.insert(row, obj->handle());
+  emit elementAdded(row);
+  return row;
+}
+
+int
+ConfigObjectRefList::append(const QVector<ConfigObject *> &objs, bool unique) {
+  QSet<ConfigObjectRegistry::Handle> present;
+  if (unique) {
+    present.reserve(_handles.size()+objs.size());
+    foreach (ConfigObjectRegistry::Handle handle, _handles)
+      present.insert(handle);
+  }
+
+  _handles.reserve(_handles.size()+objs.size());
+  int added = 0;
+  foreach (ConfigObject *obj, objs) {
+    if ((nullptr == obj) || (unique && present.contains(obj->handle())))
+      continue;
+    if (0 > add(obj, -1, false))
+      continue;
+    if (unique)
+      present.insert(obj->handle());
+    added++;
+  }
+  return added;
+}
+
+int
+ConfigObjectRefList::replace(ConfigObject *obj, int row, bool unique) {
+  // Ignore nullptr
+  if (nullptr == obj)
+    return -1;
+  // Check index
+  if ((0 > row) || (row >= count()))
+    return -1;
+  // Check if self-replacement
+  if (obj->handle() == _handles[row])
+    return row;
+  // If already in list -> ignore
+  if (unique && (0 <= indexOf(obj)))
+    return -1;
+  if (! isElementType(obj))
+    return -1;
+  if (! attach(obj))
+    return -1;
+
+  ConfigObjectRegistry::Handle old = _handles.takeAt(row);
+  detach(old);
+  emit elementRemoved(row);
+  _handles.insert(row, obj->handle());
+  emit elementAdded(row);
+
+  return row;
+}
+
+bool
+ConfigObjectRefList::take(ConfigObject *obj) {
+  int idx = indexOf(obj);
+  if (0 > idx)
+    return false;
+  detach(_handles.takeAt(idx));
+  emit elementRemoved(idx);
+  return true;
+}
+
+bool
+ConfigObjectRefList::moveUp(int row) {
+  if ((row <= 0) || (row>=count()))
+    return false;
+  std::swap(_handles[row-1], _handles[row]);
+  return true;
+}
+
+bool
+ConfigObjectRefList::moveUp(int first, int last) {
+  if ((first <= 0) || (last>=count()))
+    return false;
+  for (int row=first; row<=last; row++)
+    std::swap(_handles[row-1], _handles[row]);
+  return true;
+}
+
+bool
+ConfigObjectRefList::moveDown(int row) {
+  if ((row >= (count()-1)) || (0 > row))
+    return false;
+  std::swap(_handles[row+1], _handles[row]);
+  return true;
+}
+
+bool
+ConfigObjectRefList::moveDown(int first, int last) {
+  if ((last >= (count()-1)) || (0 > first))
+    return false;
+  for (int row=last; row>=first; row--)
+    std::swap(_handles[row+1], _handles[row]);
+  return true;
+}
+
+bool
+ConfigObjectRefList::move(int source, int count, int destination) {
+  if ((0 == count) || (source == destination))
+    return true;
+  if ((source+count)>this->count())
+    return false;
+  if (source > destination) {
+    // move up
+    for (int take=source, put=destination, i=0; i<count; i++, take++, put++)
+      _handles.insert(put, _handles.takeAt(take));
+  } else {
+    // move down
+    for (int i=0; i<count; i++)
+      _handles.insert(destination-1, _handles.takeAt(source));
+  }
+  return true;
+}
+
+const QVector<ConfigObjectRegistry::Handle> &
+ConfigObjectRefList::handles() const {
+  return _handles;
+}
+
+void
+ConfigObjectRefList::remap(const QHash<ConfigObjectRegistry::Handle, ConfigObjectRegistry::Handle> &map) {
+  QVector<ConfigObjectRegistry::Handle> handles; handles.reserve(_handles.size());
+  QSet<ConfigObjectRegistry::Handle> present; present.reserve(_handles.size());
+  bool changed = false;
+  foreach (ConfigObjectRegistry::Handle handle, _handles) {
+    ConfigObjectRegistry::Handle mapped = map.value(handle, handle);
+    changed |= (mapped != handle);
+    if (present.contains(mapped)) {
+      changed = true;
+      continue;
+    }
+    present.insert(mapped);
+    handles.append(mapped);
+  }
+  if (changed)
+    setHandles(handles);
+}
+
 int
 ConfigObjectRefList::compare(const ConfigObjectRefList &other) const {
   if (count() < other.count()) return -1;
@@ -1571,3 +1881,57 @@ ConfigObjectRefList::compare(const ConfigObjectRefList &other) const {
   return 0;
 }
 
+void
+ConfigObjectRefList::objectRemoved(ConfigObjectRegistry::Handle handle) {
+  // The handle is not observed anymore and the object disconnects itself on destruction.
+  for (int i=(_handles.count()-1); i>=0; i--) {
+    if (handle != _handles[i])
+      continue;
+    _handles.remove(i);
+    emit elementRemoved(i);
+  }
+}
+
+bool
+ConfigObjectRefList::attach(ConfigObject *obj) {
+  if (! ConfigObjectRegistry::observe(obj->handle(), this))
+    return false;
+  connect(obj, SIGNAL(modified(ConfigItem*)), this, SLOT(onElementModified(ConfigItem*)),
+          Qt::UniqueConnection);
+  return true;
+}
+
+void
+ConfigObjectRefList::detach(ConfigObjectRegistry::Handle handle) {
+  ConfigObjectRegistry::unobserve(handle, this);
+  // Keep forwarding modifications while the object is still referenced (non-unique lists).
+  if (_handles.contains(handle))
+    return;
+  if (ConfigObject *obj = ConfigObjectRegistry::resolve(handle))
+    disconnect(obj, SIGNAL(modified(ConfigItem*)), this, SLOT(onElementModified(ConfigItem*)));
+}
+
+bool
+ConfigObjectRefList::isElementType(ConfigObject *obj) const {
+  foreach (const QMetaObject &type, _elementTypes) {
+    if (obj->inherits(type.className()))
+      return true;
+  }
+  logError() << "Cannot add element of type " << obj->metaObject()->className()
+             << " to list, expected instances of " << classNames().join(", ");
+  return false;
+}
+
+void
+ConfigObjectRefList::setHandles(const QVector<ConfigObjectRegistry::Handle> &handles) {
+  clear();
+  _handles.reserve(handles.size());
+  foreach (ConfigObjectRegistry::Handle handle, handles) {
+    // Skip references to destroyed objects
+    ConfigObject *obj = ConfigObjectRegistry::resolve(handle);
+    if ((nullptr == obj) || (! attach(obj)))
+      continue;
+    _handles.append(handle);
+    emit elementAdded(_handles.count()-1);
+  }
+}
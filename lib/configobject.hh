@@ -10,6 +10,7 @@
 #include <yaml-cpp/yaml.h>
 
 #include "errorstack.hh"
+#include "configobjectregistry.hh"
 
 // Forward declaration
 class Config;
@@ -142,6 +143,11 @@ public:
   /** Searches the config tree to find all instances of the given type names. */
   virtual void findItemsOfTypes(const QStringList &typeNames, QSet<ConfigItem*> &items) const;
 
+  /** Moves this item together with all owned items, lists and references to the given thread.
+   * Unlike @c QObject::moveToThread, this also moves members that are not children of this item.
+   * Must be called from the thread the item lives in. */
+  void moveItemToThread(QThread *thread);
+
   /** Returns @c true if this object is of class @c Object. */
   template <class Object>
   bool is() const {
@@ -216,6 +222,12 @@ protected:
   ConfigObject(const QString &name, QObject *parent = nullptr);
 
 public:
+  /** Destructor, unregisters the object. */
+  virtual ~ConfigObject();
+
+  /** Returns the handle of this object within the @c ConfigObjectRegistry. */
+  ConfigObjectRegistry::Handle handle() const;
+
   /** Returns the name of the object. */
   virtual const QString &name() const;
   /** Sets the name of the object. */
@@ -236,6 +248,8 @@ protected:
 protected:
   /** Holds the name of the object. */
   QString _name;
+  /** The handle of this object. */
+  ConfigObjectRegistry::Handle _handle;
 };
 
 
@@ -294,6 +308,10 @@ public:
   virtual ConfigObject *get(int idx) const;
   /** Adds an element to the list. */
   virtual int add(ConfigObject *obj, int row=-1, bool unique=true);
+  /** Appends all given elements to the list in order, using @c add. In contrast to adding the
+   * elements one-by-one, the uniqueness check is performed once for all elements.
+   * @returns The number of elements added. */
+  virtual int append(const QVector<ConfigObject *> &objs, bool unique=true);
   /** Replaces an element in the list. */
   virtual int replace(ConfigObject *obj, int row, bool unique=true);
   /** Removes an element from the list. */
@@ -319,6 +337,15 @@ public:
   /** Returns a list of all class names. */
   QStringList classNames() const;
 
+  /** Returns @c true if the elements of this list are not decoded yet or compacted. The list is
+   * empty or incomplete until the owning config gets materialized explicitly, see
+   * @c Config::materialize and @c Config::compact.
+   * @since 0.12.0 */
+  bool isDeferred() const;
+  /** Marks the elements of this list as deferred. This method is used by @c Config only.
+   * @since 0.12.0 */
+  void setDeferred(bool deferred);
+
 signals:
   /** Gets emitted if an element was added to the list. */
   void elementAdded(int idx);
@@ -338,6 +365,8 @@ protected:
   QList<QMetaObject> _elementTypes;
   /** Holds the list items. */
   QVector<ConfigObject *> _items;
+  /** If @c true, the elements are not decoded yet. */
+  bool _deferred;
 };
 
 
@@ -385,8 +414,13 @@ public:
 /** List class for config objects.
  * This list only references the config objects, see @c ConfigObjectList for a list that owns the
  * config objects.
+ *
+ * The list holds the handles of the referenced objects within the @c ConfigObjectRegistry and
+ * observes them. References to destroyed objects are removed as soon as the object gets removed
+ * from the registry.
+ *
  * @ingroup config */
-class ConfigObjectRefList: public AbstractConfigObjectList
+class ConfigObjectRefList: public AbstractConfigObjectList, public ConfigObjectRegistry::Observer
 {
   Q_OBJECT
 
@@ -397,9 +431,39 @@ protected:
   ConfigObjectRefList(const std::initializer_list<QMetaObject> &elementTypes, QObject *parent=nullptr);
 
 public:
+  /** Destructor. */
+  virtual ~ConfigObjectRefList();
+
+  bool copy(const AbstractConfigObjectList &other);
+
   bool label(ConfigItem::Context &context, const ErrorStack &err=ErrorStack());
   YAML::Node serialize(const ConfigItem::Context &context, const ErrorStack &err=ErrorStack());
 
+  int count() const;
+  int indexOf(ConfigObject *obj) const;
+  void clear();
+
+  void findItemsOfTypes(const QStringList &typeNames, QSet<ConfigItem*> &items) const;
+  QList<ConfigObject *> findItemsByName(const QString name) const;
+
+  ConfigObject *get(int idx) const;
+  int add(ConfigObject *obj, int row=-1, bool unique=true);
+  int append(const QVector<ConfigObject *> &objs, bool unique=true);
+  int replace(ConfigObject *obj, int row, bool unique=true);
+  bool take(ConfigObject *obj);
+
+  bool moveUp(int idx);
+  bool moveUp(int first, int last);
+  bool moveDown(int idx);
+  bool moveDown(int first, int last);
+  bool move(int source, int count, int destination);
+
+  /** Returns the handles of all referenced objects. */
+  const QVector<ConfigObjectRegistry::Handle> &handles() const;
+  /** Replaces all references using the given map of handles. References not in the map are kept.
+   * If several references map to the same object, only the first one is kept. */
+  void remap(const QHash<ConfigObjectRegistry::Handle, ConfigObjectRegistry::Handle> &map);
+
   /** Compares the object ref lists.
    *
    * This method returns 0 if the two lists are equivalent and -1, 1 otherwise. The established
@@ -407,6 +471,25 @@ public:
    *
    * @returns 0 if the two lists are equivalent, -1 or 1 otherwise.*/
   virtual int compare(const ConfigObjectRefList &other) const;
+
+  /** Removes all references to the removed object. */
+  void objectRemoved(ConfigObjectRegistry::Handle handle);
+
+protected:
+  /** Observes the given object and forwards its modifications. Returns @c false if the object is
+   * not registered. */
+  bool attach(ConfigObject *obj);
+  /** Stops observing the given handle. Must be called after the reference has been removed from
+   * the list. */
+  void detach(ConfigObjectRegistry::Handle handle);
+  /** Returns @c true if the given object is an instance of one of the element types. */
+  bool isElementType(ConfigObject *obj) const;
+  /** Replaces all handles and emits the signals for removed and added elements. */
+  void setHandles(const QVector<ConfigObjectRegistry::Handle> &handles);
+
+protected:
+  /** The handles of the referenced objects. */
+  QVector<ConfigObjectRegistry::Handle> _handles;
 };
 
 
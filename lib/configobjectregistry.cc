@@ -0,0 +1,183 @@
+#include "configobjectregistry.hh"
+#include <QMutex>
+#include <QVector>
+#include <QHash>
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+
+/** Number of bits of the slot index addressing a slot within a chunk. */
+#define CHUNK_BITS 12
+/** Number of slots per chunk. */
+#define CHUNK_SIZE (1u<<CHUNK_BITS)
+/** Maximum number of chunks, limits the number of living objects to 16M. */
+#define MAX_CHUNKS 4096
+
+
+/** A slot of the registry. */
+struct RegistrySlot {
+  /** The current generation of the slot, 0 if the slot was never used. */
+  QAtomicInteger<quint32> generation;
+  /** The registered object or @c nullptr for a tombstone. */
+  QAtomicPointer<ConfigObject> object;
+};
+
+/** The shared state of the registry.
+ *
+ * The slots are allocated in chunks that are never moved or freed. Hence, handles can be resolved
+ * without holding the lock. */
+struct RegistryState {
+  /** Guards the allocation of slots, the free list and the observers. */
+  QMutex mutex;
+  /** The slot chunks. */
+  QAtomicPointer<RegistrySlot> chunks[MAX_CHUNKS];
+  /** Number of slots used so far. */
+  quint32 size = 0;
+  /** Indices of all free slots (tombstones). */
+  QVector<quint32> free;
+  /** The observers of handles. */
+  QHash<ConfigObjectRegistry::Handle, QVector<ConfigObjectRegistry::Observer *>> observers;
+};
+
+/** Returns the registry state. The state is never freed, as config objects may get destroyed
+ * during static destruction. */
+static RegistryState *
+registry() {
+  static RegistryState *state = new RegistryState();
+  return state;
+}
+
+static inline quint32
+slotIndex(ConfigObjectRegistry::Handle handle) {
+  return quint32(handle & 0xffffffff);
+}
+
+static inline quint32
+slotGeneration(ConfigObjectRegistry::Handle handle) {
+  return quint32(handle >> 32);
+}
+
+/** Returns the slot with the given index or @c nullptr if the slot does not exist. */
+static inline RegistrySlot *
+slot(RegistryState *state, quint32 idx) {
+  quint32 chunk = idx >> CHUNK_BITS;
+  if (chunk >= MAX_CHUNKS)
+    return nullptr;
+  RegistrySlot *slots = state->chunks[chunk].loadAcquire();
+  if (nullptr == slots)
+    return nullptr;
+  return slots + (idx & (CHUNK_SIZE-1));
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of ConfigObjectRegistry::Observer
+ * ********************************************************************************************* */
+ConfigObjectRegistry::Observer::~Observer() {
+  // pass...
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of ConfigObjectRegistry
+ * ********************************************************************************************* */
+ConfigObjectRegistry::Handle
+ConfigObjectRegistry::add(ConfigObject *obj) {
+  RegistryState *state = registry();
+  QMutexLocker locker(&state->mutex);
+
+  quint32 idx;
+  if (! state->free.isEmpty()) {
+    idx = state->free.takeLast();
+  } else {
+    idx = state->size++;
+    quint32 chunk = idx >> CHUNK_BITS;
+    if (chunk >= MAX_CHUNKS)
+      qFatal("Too many config objects.");
+    if (nullptr == state->chunks[chunk].loadAcquire())
+      state->chunks[chunk].storeRelease(new RegistrySlot[CHUNK_SIZE]);
+    // Generations start at 1, hence a valid handle is never 0.
+    slot(state, idx)->generation.storeRelease(1);
+  }
+
+  RegistrySlot *s = slot(state, idx);
+  s->object.storeRelease(obj);
+  return (Handle(s->generation.loadAcquire()) << 32) | idx;
+}
+
+void
+ConfigObjectRegistry::remove(Handle handle) {
+  RegistryState *state = registry();
+  QVector<Observer *> observers;
+
+  {
+    QMutexLocker locker(&state->mutex);
+    quint32 idx = slotIndex(handle);
+    RegistrySlot *s = slot(state, idx);
+    if ((nullptr == s) || (slotGeneration(handle) != s->generation.loadAcquire()))
+      return;
+
+    // Invalidate all handles first, then release the object. Skip generation 0 on overflow.
+    quint32 generation = slotGeneration(handle) + 1;
+    s->generation.storeRelease(generation ? generation : 1);
+    s->object.storeRelease(nullptr);
+    state->free.append(idx);
+    observers = state->observers.take(handle);
+  }
+
+  // Notify observers outside of the lock, they may modify their handles
+  foreach (Observer *observer, observers)
+    observer->objectRemoved(handle);
+}
+
+ConfigObject *
+ConfigObjectRegistry::resolve(Handle handle) {
+  if (0 == handle)
+    return nullptr;
+
+  RegistrySlot *s = slot(registry(), slotIndex(handle));
+  if (nullptr == s)
+    return nullptr;
+
+  quint32 generation = slotGeneration(handle);
+  if (generation != s->generation.loadAcquire())
+    return nullptr;
+  ConfigObject *obj = s->object.loadAcquire();
+  // The slot may have been released and reused in the meantime
+  if (generation != s->generation.loadAcquire())
+    return nullptr;
+  return obj;
+}
+
+bool
+ConfigObjectRegistry::isValid(Handle handle) {
+  return nullptr != resolve(handle);
+}
+
+bool
+ConfigObjectRegistry::observe(Handle handle, Observer *observer) {
+  RegistryState *state = registry();
+  QMutexLocker locker(&state->mutex);
+  if (! isValid(handle))
+    return false;
+  state->observers[handle].append(observer);
+  return true;
+}
+
+void
+ConfigObjectRegistry::unobserve(Handle handle, Observer *observer) {
+  RegistryState *state = registry();
+  QMutexLocker locker(&state->mutex);
+  auto item = state->observers.find(handle);
+  if (state->observers.end() == item)
+    return;
+  item->removeOne(observer);
+  if (item->isEmpty())
+    state->observers.erase(item);
+}
+
+bool
+ConfigObjectRegistry::isObserved(Handle handle) {
+  RegistryState *state = registry();
+  QMutexLocker locker(&state->mutex);
+  return state->observers.contains(handle);
+}
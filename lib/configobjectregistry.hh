@@ -0,0 +1,69 @@
+#ifndef CONFIGOBJECTREGISTRY_HH
+#define CONFIGOBJECTREGISTRY_HH
+
+#include <QtGlobal>
+
+// Forward declaration
+class ConfigObject;
+
+
+/** Central registry of all living config objects.
+ *
+ * Every config object gets a stable handle assigned on construction. A handle consists of a slot
+ * index within the registry and a generation counter. When the object gets destroyed, its slot is
+ * turned into a tombstone by incrementing the generation. Hence, handles to destroyed objects get
+ * detected whenever they are resolved, even if the slot has been reused in the meantime.
+ *
+ * References to config objects (see @c ConfigObjectReference and @c ConfigObjectRefList) store
+ * these handles instead of pointers. Copying or remapping references becomes a simple operation
+ * on integer arrays. To get notified once a referenced object gets destroyed, references observe
+ * the handles they hold (see @c Observer).
+ *
+ * Resolving a handle is lock-free. Registering and removing objects as well as observing handles
+ * is thread-safe.
+ *
+ * @since 0.12.0
+ * @ingroup conf */
+class ConfigObjectRegistry
+{
+public:
+  /** A handle to a config object. The null handle is 0. */
+  typedef quint64 Handle;
+
+  /** Interface of all classes observing handles. */
+  class Observer
+  {
+  public:
+    /** Destructor. */
+    virtual ~Observer();
+
+    /** Gets called once the object with the given, observed handle gets removed from the
+     * registry. The call is made from the thread destroying the object, the handle is not valid
+     * anymore and it is no longer observed. */
+    virtual void objectRemoved(Handle handle) = 0;
+  };
+
+public:
+  /** Registers the given object and returns its handle. */
+  static Handle add(ConfigObject *obj);
+  /** Unregisters the object with the given handle. Any handle to it becomes invalid and all
+   * observers of the handle get notified. */
+  static void remove(Handle handle);
+
+  /** Returns the object for the given handle or @c nullptr if the handle is null or the object
+   * has been destroyed. */
+  static ConfigObject *resolve(Handle handle);
+  /** Returns @c true if the given handle refers to a living object. */
+  static bool isValid(Handle handle);
+
+  /** Adds the given observer to the handle. An observer may observe the same handle several
+   * times, it then must be removed as many times. Returns @c false if the handle does not refer to
+   * a living object. */
+  static bool observe(Handle handle, Observer *observer);
+  /** Removes the given observer from the handle. */
+  static void unobserve(Handle handle, Observer *observer);
+  /** Returns @c true if the given handle is observed, that is, if the object is referenced. */
+  static bool isObserved(Handle handle);
+};
+
+#endif // CONFIGOBJECTREGISTRY_HH
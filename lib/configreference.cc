@@ -15,32 +15,37 @@
  * Implementation of ConfigObjectReference
  * ********************************************************************************************* */
 ConfigObjectReference::ConfigObjectReference(const QMetaObject &elementType, QObject *parent)
-  : QObject(parent), _elementTypes(), _object(nullptr)
+  : QObject(parent), _elementTypes(), _handle(0)
 {
   _elementTypes.append(elementType.className());
 }
 
+ConfigObjectReference::~ConfigObjectReference() {
+  if (_handle)
+    ConfigObjectRegistry::unobserve(_handle, this);
+}
+
 bool
 ConfigObjectReference::isNull() const {
-  return nullptr == _object;
+  // The handle gets cleared once the referenced object is removed.
+  return 0 == _handle;
 }
 
 void
 ConfigObjectReference::clear() {
-  if (_object) {
-    disconnect(_object, SIGNAL(destroyed(QObject*)), this, SLOT(onReferenceDeleted(QObject*)));
-    emit modified();
-  }
-  _object = nullptr;
+  if (0 == _handle)
+    return;
+  ConfigObjectRegistry::unobserve(_handle, this);
+  _handle = 0;
+  emit modified();
 }
 
 bool
 ConfigObjectReference::set(ConfigObject *object) {
-  if (_object)
-    disconnect(_object, SIGNAL(destroyed(QObject*)), this, SLOT(onReferenceDeleted(QObject*)));
-
   if (nullptr == object) {
-    _object = nullptr;
+    if (_handle)
+      ConfigObjectRegistry::unobserve(_handle, this);
+    _handle = 0;
     return true;
   }
 
@@ -58,10 +63,11 @@ ConfigObjectReference::set(ConfigObject *object) {
     return false;
   }
 
-  _object = object;
-  if (_object)
-    connect(_object, &QObject::destroyed,
-            this, &ConfigObjectReference::onReferenceDeleted, Qt::DirectConnection);
+  if (_handle)
+    ConfigObjectRegistry::unobserve(_handle, this);
+  _handle = object->handle();
+  if (! ConfigObjectRegistry::observe(_handle, this))
+    _handle = 0;
 
   emit modified();
   return true;
@@ -72,18 +78,19 @@ ConfigObjectReference::copy(const ConfigObjectReference *ref) {
   clear();
   if (nullptr == ref)
     return true;
-  return set(ref->_object);
+  return set(ref->as<ConfigObject>());
 }
 
 int
 ConfigObjectReference::compare(const ConfigObjectReference &other) const {
-  if (isNull() && other.isNull())
+  ConfigObject *a = as<ConfigObject>(), *b = other.as<ConfigObject>();
+  if ((nullptr == a) && (nullptr == b))
     return 0;
-  if (!isNull() && other.isNull())
+  if ((nullptr != a) && (nullptr == b))
     return 1;
-  if (isNull() && !other.isNull())
+  if ((nullptr == a) && (nullptr != b))
     return -1;
-  return this->_object->compare(*other._object);
+  return a->compare(*b);
 }
 
 bool
@@ -99,12 +106,11 @@ ConfigObjectReference::elementTypeNames() const {
 }
 
 void
-ConfigObjectReference::onReferenceDeleted(QObject *obj) {
-  // Check if destroyed obj is referenced one.
-  if (_object != reinterpret_cast<ConfigObject*>(obj))
+ConfigObjectReference::objectRemoved(ConfigObjectRegistry::Handle handle) {
+  // Check if removed object is the referenced one.
+  if (_handle != handle)
     return;
-  // If it is
-  _object = nullptr;
+  _handle = 0;
   emit modified();
 }
 
@@ -12,8 +12,13 @@ class EncryptionKey;
 
 /** Implements a reference to a config object.
  * This class is only used to implement the automatic generation/parsing of the YAML codeplug files.
+ *
+ * The reference holds the handle of the referenced object within the @c ConfigObjectRegistry and
+ * observes it. If the referenced object gets destroyed, the reference is cleared and the
+ * @c modified signal is emitted.
+ *
  * @ingroup conf */
-class ConfigObjectReference: public QObject
+class ConfigObjectReference: public QObject, public ConfigObjectRegistry::Observer
 {
   Q_OBJECT
 
@@ -22,6 +27,9 @@ protected:
   ConfigObjectReference(const QMetaObject &elementType=ConfigObject::staticMetaObject, QObject *parent = nullptr);
 
 public:
+  /** Destructor. */
+  virtual ~ConfigObjectReference();
+
   /** Returns @c true if the reference is null.
    * That is, if there is no object referenced. */
   bool isNull() const;
@@ -43,36 +51,37 @@ public:
   /** Returns the reference as the specified type. */
   template <class Type>
   Type *as() const {
-    if (nullptr == _object)
+    ConfigObject *obj = ConfigObjectRegistry::resolve(_handle);
+    if (nullptr == obj)
       return nullptr;
-    return _object->as<Type>();
+    return obj->as<Type>();
   }
 
   /** Returns @c true if the reference is of the specified type. */
   template <class Type>
   bool is() const {
-    if (nullptr == _object)
+    ConfigObject *obj = ConfigObjectRegistry::resolve(_handle);
+    if (nullptr == obj)
       return false;
-    return _object->is<Type>();
+    return obj->is<Type>();
   }
 
   /** Compares the references. */
   int compare(const ConfigObjectReference &other) const;
 
+  /** Clears the reference, once the referenced object gets removed from the registry. */
+  void objectRemoved(ConfigObjectRegistry::Handle handle);
+
 signals:
   /** Gets emitted if the reference is changed.
    * This signal is not emitted if the referenced object is modified. */
   void modified();
 
-protected slots:
-  /** Internal call back whenever the referenced object gets deleted. */
-  void onReferenceDeleted(QObject *obj);
-
 protected:
   /** Holds the static QMetaObject of the possible element types. */
   QStringList _elementTypes;
-  /** The reference to the object. */
-  ConfigObject *_object;
+  /** The handle of the referenced object. */
+  ConfigObjectRegistry::Handle _handle;
 };
 
 
@@ -1,5 +1,6 @@
 #include "contact.hh"
 #include "config.hh"
+#include "compacttable.hh"
 #include "utils.hh"
 #include "logger.hh"
 
@@ -256,11 +257,16 @@ DMRContact::setAnytoneExtension(AnytoneContactExtension *ext) {
  * Implementation of ContactList
  * ********************************************************************************************* */
 ContactList::ContactList(QObject *parent)
-  : ConfigObjectList(Contact::staticMetaObject, parent)
+  : ConfigObjectList(Contact::staticMetaObject, parent), _compacted(nullptr), _compactedRows()
 {
   // pass...
 }
 
+ContactList::~ContactList() {
+  if (_compacted)
+    delete _compacted;
+}
+
 int
 ContactList::add(ConfigObject *obj, int row, bool unique) {
   if ((nullptr == obj) || (! obj->is<Contact>()))
@@ -268,6 +274,63 @@ ContactList::add(ConfigObject *obj, int row, bool unique) {
   return ConfigObjectList::add(obj, row, unique);
 }
 
+void
+ContactList::clear() {
+  // Drop compacted contacts
+  if (_compacted)
+    delete _compacted;
+  _compacted = nullptr;
+  _compactedRows.clear();
+  ConfigObjectList::clear();
+}
+
+int
+ContactList::compact() {
+  if (_compacted)
+    return 0;
+
+  QVector<DMRContact *> contacts;
+  for (int i=0; i<_items.size(); i++) {
+    if (! _items.at(i)->is<DMRContact>())
+      continue;
+    DMRContact *contact = _items.at(i)->as<DMRContact>();
+    // Referenced and extended contacts cannot be re-created from the table
+    if (ConfigObjectRegistry::isObserved(contact->handle()) || contact->anytoneExtension()
+        || contact->openGD77ContactExtension())
+      continue;
+    contacts.append(contact);
+    _compactedRows.append(i);
+  }
+  if (contacts.isEmpty())
+    return 0;
+
+  _compacted = new DMRContactTable();
+  foreach (DMRContact *contact, contacts)
+    _compacted->append(contact);
+  foreach (DMRContact *contact, contacts)
+    del(contact);
+
+  return contacts.size();
+}
+
+void
+ContactList::expand() {
+  if (nullptr == _compacted)
+    return;
+  for (int i=0; i<_compacted->count(); i++)
+    add(_compacted->materialize(i), _compactedRows.at(i), false);
+  delete _compacted;
+  _compacted = nullptr;
+  _compactedRows.clear();
+}
+
+int
+ContactList::compactedCount() const {
+  if (nullptr == _compacted)
+    return 0;
+  return _compacted->count();
+}
+
 int
 ContactList::digitalCount() const {
   int c=0;
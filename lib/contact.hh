@@ -9,6 +9,7 @@
 #include "opengd77_extension.hh"
 
 class Config;
+class DMRContactTable;
 
 
 /** Represents the base-class for all contact types, analog (DTMF) or digital (DMR, M17).
@@ -226,8 +227,11 @@ class ContactList: public ConfigObjectList
 public:
   /** Constructs an empty contact list. */
 	explicit ContactList(QObject *parent=nullptr);
+  /** Destructor. */
+  virtual ~ContactList();
 
   int add(ConfigObject *obj, int row=-1, bool unique=true);
+  void clear();
 
   /** Returns the number of digital contacts. */
 	int digitalCount() const;
@@ -243,8 +247,26 @@ public:
   /** Returns the DTMF contact at index @c idx among DTMF contacts. */
   DTMFContact *dtmfContact(int idx) const;
 
+  /** Moves all DMR contacts, that are neither referenced nor extended, into a compact table (see
+   * @c DMRContactTable) and deletes them. Usually, these are the majority of the contacts of large
+   * configs. The compacted contacts get re-created at their original position by @c expand.
+   * Returns the number of compacted contacts. This method is used by @c Config::compact only.
+   * @since 0.12.0 */
+  int compact();
+  /** Re-creates all compacted contacts, see @c compact.
+   * @since 0.12.0 */
+  void expand();
+  /** Returns the number of compacted contacts. */
+  int compactedCount() const;
+
 public:
   ConfigItem *allocateChild(const YAML::Node &node, ConfigItem::Context &ctx, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** The compacted contacts or @c nullptr if there are none. */
+  DMRContactTable *_compacted;
+  /** The original positions of the compacted contacts in ascending order. */
+  QVector<int> _compactedRows;
 };
 
 #endif // CONTACT_HH
@@ -1921,21 +1921,7 @@ D578UVCodeplug::encodeChannels(const Flags &flags, Context &ctx, const ErrorStac
 bool
 D578UVCodeplug::createChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
-
-  ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
-
-  // Create channels
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // Check if channel is enabled:
-    uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
-    if (! channel_bitmap.isEncoded(i))
-      continue;
-    ChannelElement ch(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
-                           + idx*ChannelElement::size()));
-    if (Channel *obj = ch.toChannelObj(ctx)) {
-      ctx.config()->channelList()->add(obj); ctx.add(obj, i);
-    }
-  }
+  createChannelObjs<ChannelElement, Offset, Limit>(ctx);
   return true;
 }
 
@@ -1946,11 +1932,9 @@ D578UVCodeplug::linkChannels(Context &ctx, const ErrorStack &err) {
   ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
 
   // Link channel objects
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // Check if channel is enabled:
+  for (int i=channel_bitmap.nextEncoded(0, Limit::numChannels()); 0<=i;
+       i=channel_bitmap.nextEncoded(i+1, Limit::numChannels())) {
     uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
-    if (! channel_bitmap.isEncoded(i))
-      continue;
     ChannelElement ch(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
                            + idx*ChannelElement::size()));
     if (ctx.has<Channel>(i))
@@ -1965,9 +1949,8 @@ D578UVCodeplug::allocateContacts() {
   /* Allocate contacts */
   ContactBitmapElement contact_bitmap(data(Offset::contactBitmap()));
   unsigned contactCount=0;
-  for (uint16_t i=0; i<Limit::numContacts(); i++) {
-    if (! contact_bitmap.isEncoded(i))
-      continue;
+  for (int i=contact_bitmap.nextEncoded(0, Limit::numContacts()); 0<=i;
+       i=contact_bitmap.nextEncoded(i+1, Limit::numContacts())) {
     contactCount++;
     uint32_t bank_addr = Offset::contactBanks() + (i/Limit::contactsPerBank())*Offset::betweenContactBanks();
     uint32_t addr = bank_addr + (i%Limit::contactsPerBank())*Offset::betweenContactBlocks();
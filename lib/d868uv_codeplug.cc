@@ -1399,7 +1399,7 @@ D868UVCodeplug::encodeElements(const Flags &flags, Context &ctx, const ErrorStac
 }
 
 bool
-D868UVCodeplug::decodeElements(Context &ctx, const ErrorStack &err)
+D868UVCodeplug::decodeSettingsElements(Context &ctx, const ErrorStack &err)
 {
   if (! this->setRadioID(ctx, err))
     return false;
@@ -1416,6 +1416,12 @@ D868UVCodeplug::decodeElements(Context &ctx, const ErrorStack &err)
   if (! this->decodeBootSettings(ctx, err))
     return false;
 
+  return true;
+}
+
+bool
+D868UVCodeplug::decodeTableElements(Context &ctx, const ErrorStack &err)
+{
   if (! this->createChannels(ctx, err))
     return false;
 
@@ -1464,10 +1470,8 @@ void
 D868UVCodeplug::allocateChannels() {
   /* Allocate channels */
   ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // if disabled -> skip
-    if (! channel_bitmap.isEncoded(i))
-      continue;
+  for (int i=channel_bitmap.nextEncoded(0, Limit::numChannels()); 0<=i;
+       i=channel_bitmap.nextEncoded(i+1, Limit::numChannels())) {
     // compute address for channel
     uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
     uint32_t addr = Offset::channelBanks() +
@@ -1498,20 +1502,7 @@ D868UVCodeplug::encodeChannels(const Flags &flags, Context &ctx, const ErrorStac
 bool
 D868UVCodeplug::createChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
-  ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
-
-  // Create channels
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // Check if channel is enabled:
-    uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
-    if (! channel_bitmap.isEncoded(i))
-      continue;
-    ChannelElement ch(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
-                           + idx*ChannelElement::size()));
-    if (Channel *obj = ch.toChannelObj(ctx)) {
-      ctx.config()->channelList()->add(obj); ctx.add(obj, i);
-    }
-  }
+  createChannelObjs<ChannelElement, Offset, Limit>(ctx);
   return true;
 }
 
@@ -1520,10 +1511,8 @@ D868UVCodeplug::linkChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
   ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
   // Link channel objects
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // Check if channel is enabled:
-    if (! channel_bitmap.isEncoded(i))
-      continue;
+  for (int i=channel_bitmap.nextEncoded(0, Limit::numChannels()); 0<=i;
+       i=channel_bitmap.nextEncoded(i+1, Limit::numChannels())) {
     uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
     ChannelElement ch(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
                            + idx*ChannelElement::size()));
@@ -1547,12 +1536,11 @@ void
 D868UVCodeplug::allocateContacts() {
   /* Allocate contacts */
   ContactBitmapElement contact_bitmap(data(Offset::contactBitmap()));
-  unsigned contactCount=0;
-  for (uint16_t i=0; i<Limit::numContacts(); i++) {
-    // enabled if false (ass hole)
-    if (! contact_bitmap.isEncoded(i))
-      continue;
-    contactCount++;
+  unsigned contactCount = contact_bitmap.countEncoded(Limit::numContacts());
+  // Blocks do not cross banks, hence continue with the first enabled contact of the next block
+  for (int i=contact_bitmap.nextEncoded(0, Limit::numContacts()); 0<=i;
+       i=contact_bitmap.nextEncoded((i/Limit::contactsPerBlock()+1)*Limit::contactsPerBlock(),
+                                    Limit::numContacts())) {
     uint32_t bank_addr = Offset::contactBanks() + (i/Limit::contactsPerBank())*Offset::betweenContactBanks();
     uint32_t addr = bank_addr + ((i%Limit::contactsPerBank())/Limit::contactsPerBlock())*Offset::betweenContactBlocks();
     if (!isAllocated(addr, 0)) {
@@ -1602,17 +1590,29 @@ bool
 D868UVCodeplug::createContacts(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
-  // Create digital contacts
+  // Collect enabled digital contacts
   ContactBitmapElement contact_bitmap(data(Offset::contactBitmap()));
-  for (uint16_t i=0; i<Limit::numContacts(); i++) {
-    // Check if contact is enabled:
-    if (! contact_bitmap.isEncoded(i))
-      continue;
+  QVector<uint16_t> indices;
+  QVector<uint8_t *> elements;
+  indices.reserve(contact_bitmap.countEncoded(Limit::numContacts()));
+  elements.reserve(indices.capacity());
+  for (int i=contact_bitmap.nextEncoded(0, Limit::numContacts()); 0<=i;
+       i=contact_bitmap.nextEncoded(i+1, Limit::numContacts())) {
     uint32_t bank_addr = Offset::contactBanks() + (i/Limit::contactsPerBank())*Offset::betweenContactBanks();
     uint32_t addr = bank_addr + (i%Limit::contactsPerBank())*ContactElement::size();
-    ContactElement con(data(addr));
-    if (DMRContact *obj = con.toContactObj(ctx)) {
-      ctx.config()->contacts()->add(obj); ctx.add(obj, i);
+    indices.append(i);
+    elements.append(data(addr));
+  }
+
+  // Create digital contacts in parallel
+  QVector<DMRContact *> contacts = createParallel<DMRContact>(elements.size(), [&elements, &ctx](int i) {
+    return ContactElement(elements[i]).toContactObj(ctx);
+  });
+
+  // Add contacts in order
+  for (int i=0; i<contacts.size(); i++) {
+    if (DMRContact *obj = contacts[i]) {
+      ctx.config()->contacts()->add(obj); ctx.add(obj, indices[i]);
     }
   }
   return true;
@@ -1623,10 +1623,8 @@ void
 D868UVCodeplug::allocateAnalogContacts() {
   /* Allocate analog contacts */
   DTMFContactBytemapElement analog_contact_bytemap(data(Offset::dtmfContactBytemap()));
-  for (uint8_t i=0; i<Limit::numDTMFContacts(); i++) {
-    // if disabled -> skip
-    if (! analog_contact_bytemap.isEncoded(i))
-      continue;
+  for (int i=analog_contact_bytemap.nextEncoded(0, Limit::numDTMFContacts()); 0<=i;
+       i=analog_contact_bytemap.nextEncoded(i+1, Limit::numDTMFContacts())) {
     uint32_t bank_addr = Offset::dtmfContacts() + (i/2)*(2*DTMFContactElement::size());
     if (! isAllocated(bank_addr, 0)) {
       image(0).addElement(bank_addr, 2*DTMFContactElement::size());
@@ -1654,10 +1652,8 @@ D868UVCodeplug::createAnalogContacts(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
   DTMFContactBytemapElement analog_contact_bytemap(data(Offset::dtmfContactBytemap()));
-  for (unsigned int i=0; i<Limit::numDTMFContacts(); i++) {
-    // if disabled -> skip
-    if (! analog_contact_bytemap.isEncoded(i))
-      continue;
+  for (int i=analog_contact_bytemap.nextEncoded(0, Limit::numDTMFContacts()); 0<=i;
+       i=analog_contact_bytemap.nextEncoded(i+1, Limit::numDTMFContacts())) {
     DTMFContactElement cont(data(Offset::dtmfContacts() + i*DTMFContactElement::size()));
     if (DTMFContact *dtmf = cont.toContact()) {
       ctx.config()->contacts()->add(dtmf);
@@ -1673,10 +1669,8 @@ void
 D868UVCodeplug::allocateRadioIDs() {
   /* Allocate radio IDs */
   RadioIDBitmapElement radioid_bitmap(data(Offset::radioIDBitmap()));
-  for (uint8_t i=0; i<Limit::numRadioIDs(); i++) {
-    // if disabled -> skip
-    if (! radioid_bitmap.isEncoded(i))
-      continue;
+  for (int i=radioid_bitmap.nextEncoded(0, Limit::numRadioIDs()); 0<=i;
+       i=radioid_bitmap.nextEncoded(i+1, Limit::numRadioIDs())) {
     // Allocate radio IDs individually
     uint32_t addr = Offset::radioIDs() + i*RadioIDElement::size();
     if (! isAllocated(addr, 0)) {
@@ -1703,9 +1697,8 @@ D868UVCodeplug::setRadioID(Context &ctx, const ErrorStack &err) {
 
   // Find a valid RadioID
   RadioIDBitmapElement radio_id_bitmap(data(Offset::radioIDBitmap()));
-  for (uint16_t i=0; i<Limit::numRadioIDs(); i++) {
-    if (! radio_id_bitmap.isEncoded(i))
-      continue;
+  for (int i=radio_id_bitmap.nextEncoded(0, Limit::numRadioIDs()); 0<=i;
+       i=radio_id_bitmap.nextEncoded(i+1, Limit::numRadioIDs())) {
     RadioIDElement id(data(Offset::radioIDs() + i*RadioIDElement::size()));
     if (DMRRadioID *rid = id.toRadioID()) {
       ctx.config()->radioIDs()->add(rid);  ctx.add(rid, i);
@@ -1721,10 +1714,8 @@ D868UVCodeplug::allocateRXGroupLists() {
    * Allocate group lists
    */
   GroupListBitmapElement grouplist_bitmap(data(Offset::groupListBitmap()));
-  for (uint16_t i=0; i<Limit::numGroupLists(); i++) {
-    // if disabled -> skip
-    if (! grouplist_bitmap.isEncoded(i))
-      continue;
+  for (int i=grouplist_bitmap.nextEncoded(0, Limit::numGroupLists()); 0<=i;
+       i=grouplist_bitmap.nextEncoded(i+1, Limit::numGroupLists())) {
     // Allocate RX group lists indivitually
     uint32_t addr = Offset::groupLists() + i*Offset::betweenGroupLists();
     if (! isAllocated(addr, 0)) {
@@ -1754,10 +1745,8 @@ D868UVCodeplug::createRXGroupLists(Context &ctx, const ErrorStack &err) {
 
   // Create RX group lists
   GroupListBitmapElement grouplist_bitmap(data(Offset::groupListBitmap()));
-  for (uint16_t i=0; i<Limit::numGroupLists(); i++) {
-    // check if group list is enabled
-    if (! grouplist_bitmap.isEncoded(i))
-      continue;
+  for (int i=grouplist_bitmap.nextEncoded(0, Limit::numGroupLists()); 0<=i;
+       i=grouplist_bitmap.nextEncoded(i+1, Limit::numGroupLists())) {
     // construct RXGroupList from definition
     GroupListElement grp(data(Offset::groupLists() + i*Offset::betweenGroupLists()));
     if (RXGroupList *obj = grp.toGroupListObj()) {
@@ -1772,10 +1761,8 @@ D868UVCodeplug::linkRXGroupLists(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
   GroupListBitmapElement grouplist_bitmap(data(Offset::groupListBitmap()));
-  for (uint16_t i=0; i<Limit::numGroupLists(); i++) {
-    // check if group list is enabled
-    if (! grouplist_bitmap.isEncoded(i))
-      continue;
+  for (int i=grouplist_bitmap.nextEncoded(0, Limit::numGroupLists()); 0<=i;
+       i=grouplist_bitmap.nextEncoded(i+1, Limit::numGroupLists())) {
 
     // link group list
     GroupListElement grp(data(Offset::groupLists() + i*Offset::betweenGroupLists()));
@@ -1792,10 +1779,8 @@ D868UVCodeplug::linkRXGroupLists(Context &ctx, const ErrorStack &err) {
 void
 D868UVCodeplug::allocateZones() {
   ZoneBitmapElement zone_bitmap(data(Offset::zoneBitmap()));
-  for (uint16_t i=0; i<Limit::numZones(); i++) {
-    // if invalid -> skip
-    if (! zone_bitmap.isEncoded(i))
-      continue;
+  for (int i=zone_bitmap.nextEncoded(0, Limit::numZones()); 0<=i;
+       i=zone_bitmap.nextEncoded(i+1, Limit::numZones())) {
     // Allocate zone itself
     image(0).addElement(Offset::zoneChannels()+i*Offset::betweenZoneChannels(), Size::zoneChannels());
     image(0).addElement(Offset::zoneNames()+i*Offset::betweenZoneNames(), Size::zoneName());
@@ -1838,10 +1823,8 @@ D868UVCodeplug::createZones(Context &ctx, const ErrorStack &err) {
 
   // Create zones
   ZoneBitmapElement zone_bitmap(data(Offset::zoneBitmap()));
-  for (uint16_t i=0; i<Limit::numZones(); i++) {
-    // Check if zone is enabled:
-    if (! zone_bitmap.isEncoded(i))
-      continue;
+  for (int i=zone_bitmap.nextEncoded(0, Limit::numZones()); 0<=i;
+       i=zone_bitmap.nextEncoded(i+1, Limit::numZones())) {
     // Determine whether this zone should be combined with the previous one
     QString zonename = decode_ascii(
           data(Offset::zoneNames()+i*Offset::betweenZoneNames()),
@@ -1869,10 +1852,8 @@ D868UVCodeplug::linkZones(Context &ctx, const ErrorStack &err) {
 
   // Create zones
   ZoneBitmapElement zone_bitmap(data(Offset::zoneBitmap()));
-  for (uint16_t i=0; i<Limit::numZones(); i++) {
-    // Check if zone is enabled:
-    if (! zone_bitmap.isEncoded(i))
-      continue;
+  for (int i=zone_bitmap.nextEncoded(0, Limit::numZones()); 0<=i;
+       i=zone_bitmap.nextEncoded(i+1, Limit::numZones())) {
     Zone *zone = ctx.get<Zone>(i);
 
     // link zone
@@ -1903,10 +1884,8 @@ D868UVCodeplug::linkZone(int i, Zone *zone, bool isB, Context &ctx, const ErrorS
 void
 D868UVCodeplug::allocateScanLists() {
   ScanListBitmapElement scanlist_bitmap(data(Offset::scanListBitmap()));
-  for (uint8_t i=0; i<Limit::numScanLists(); i++) {
-    // if disabled -> skip
-    if (! scanlist_bitmap.isEncoded(i))
-      continue;
+  for (int i=scanlist_bitmap.nextEncoded(0, Limit::numScanLists()); 0<=i;
+       i=scanlist_bitmap.nextEncoded(i+1, Limit::numScanLists())) {
     // Allocate scan lists indivitually
     uint8_t bank = (i/Limit::numScanListsPerBank()), bank_idx = (i%Limit::numScanListsPerBank());
     uint32_t addr = Offset::scanListBanks() + bank*Offset::betweenScanListBanks()
@@ -1939,9 +1918,8 @@ D868UVCodeplug::createScanLists(Context &ctx, const ErrorStack &err) {
 
   // Create scan lists
   ScanListBitmapElement scanlist_bitmap(data(Offset::scanListBitmap()));
-  for (unsigned int i=0; i<Limit::numScanLists(); i++) {
-    if (! scanlist_bitmap.isEncoded(i))
-      continue;
+  for (int i=scanlist_bitmap.nextEncoded(0, Limit::numScanLists()); 0<=i;
+       i=scanlist_bitmap.nextEncoded(i+1, Limit::numScanLists())) {
     uint8_t bank = i/Limit::numScanListsPerBank(), bank_idx = i%Limit::numScanListsPerBank();
     uint32_t addr = Offset::scanListBanks() + bank*Offset::betweenScanListBanks()
         + bank_idx*Offset::betweenScanLists();
@@ -1958,9 +1936,8 @@ D868UVCodeplug::linkScanLists(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
 
   ScanListBitmapElement scanlist_bitmap(data(Offset::scanListBitmap()));
-  for (unsigned i=0; i<Limit::numScanLists(); i++) {
-    if (! scanlist_bitmap.isEncoded(i))
-      continue;
+  for (int i=scanlist_bitmap.nextEncoded(0, Limit::numScanLists()); 0<=i;
+       i=scanlist_bitmap.nextEncoded(i+1, Limit::numScanLists())) {
     uint8_t bank = i/Limit::numScanListsPerBank(), bank_idx = i%Limit::numScanListsPerBank();
     uint32_t addr = Offset::scanListBanks() + bank*Offset::betweenScanListBanks()
         + bank_idx*Offset::betweenScanLists();
@@ -2052,11 +2029,9 @@ D868UVCodeplug::createGPSSystems(Context &ctx, const ErrorStack &err) {
   // First find all GPS systems linked, that is referenced by any channel
   // Create channels
   ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // Check if channel is enabled:
+  for (int i=channel_bitmap.nextEncoded(0, Limit::numChannels()); 0<=i;
+       i=channel_bitmap.nextEncoded(i+1, Limit::numChannels())) {
     uint16_t  bank = i/128, idx = i%128;
-    if (! channel_bitmap.isEncoded(i))
-      continue;
     if (ctx.get<Channel>(i)->is<FMChannel>())
       continue;
     ChannelElement ch(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
@@ -2091,9 +2066,8 @@ D868UVCodeplug::allocateSMSMessages() {
   // Prefab. SMS messages
   MessageBytemapElement messages_bytemap(data(Offset::messageBytemap()));
   unsigned message_count = 0;
-  for (uint8_t i=0; i<Limit::numMessages(); i++) {
-    if (! messages_bytemap.isEncoded(i))
-      continue;
+  for (int i=messages_bytemap.nextEncoded(0, Limit::numMessages()); 0<=i;
+       i=messages_bytemap.nextEncoded(i+1, Limit::numMessages())) {
     message_count++;
     uint32_t addr = Offset::messageBanks() + (i/Limit::numMessagePerBank())*Offset::betweenMessageBanks();
     if (!isAllocated(addr, 0)) {
@@ -2128,9 +2102,8 @@ bool
 D868UVCodeplug::createSMSMessages(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
   MessageBytemapElement messages_bytemap(data(Offset::messageBytemap()));
-  for (unsigned int i=0; i<Limit::numMessages(); i++) {
-    if (! messages_bytemap.isEncoded(i))
-      continue;
+  for (int i=messages_bytemap.nextEncoded(0, Limit::numMessages()); 0<=i;
+       i=messages_bytemap.nextEncoded(i+1, Limit::numMessages())) {
     unsigned int bank = i/Limit::numMessagePerBank(), msg_idx = i % Limit::numMessagePerBank();
     unsigned int addr = Offset::messageBanks() + bank*Offset::betweenMessageBanks() + msg_idx*MessageElement::size();
     MessageElement message(data(addr));
@@ -2228,9 +2201,8 @@ void
 D868UVCodeplug::allocate5ToneIDs() {
   // Allocate 5-tone functions
   FiveToneIDBitmapElement bitmap(data(Offset::fiveToneIdBitmap()));
-  for (uint8_t i=0; i<FiveToneIDListElement::Limit::numEntries(); i++) {
-    if (! bitmap.isEncoded(i))
-      continue;
+  for (int i=bitmap.nextEncoded(0, FiveToneIDListElement::Limit::numEntries()); 0<=i;
+       i=bitmap.nextEncoded(i+1, FiveToneIDListElement::Limit::numEntries())) {
     image(0).addElement(Offset::fiveToneIdList() + i*FiveToneIDElement::size(), FiveToneIDElement::size());
   }
 }
@@ -2249,9 +2221,8 @@ void
 D868UVCodeplug::allocate2ToneIDs() {
   // Allocate 2-tone encoding
   TwoToneIDBitmapElement enc_bitmap(data(Offset::twoToneIdBitmap()));
-  for (uint8_t i=0; i<Limit::numTwoToneIDs(); i++) {
-    if (! enc_bitmap.isEncoded(i))
-      continue;
+  for (int i=enc_bitmap.nextEncoded(0, Limit::numTwoToneIDs()); 0<=i;
+       i=enc_bitmap.nextEncoded(i+1, Limit::numTwoToneIDs())) {
     image(0).addElement(Offset::twoToneIdList() + i*TwoToneIDElement::size(), TwoToneIDElement::size());
   }
 }
@@ -2261,9 +2232,8 @@ void
 D868UVCodeplug::allocate2ToneFunctions() {
   // Allocate 2-tone decoding
   TwoToneFunctionBitmapElement dec_bitmap(data(Offset::twoToneFunctionBitmap()));
-  for (uint8_t i=0; i<Limit::numTwoToneFunctions(); i++) {
-    if (! dec_bitmap.isEncoded(i))
-      continue;
+  for (int i=dec_bitmap.nextEncoded(0, Limit::numTwoToneFunctions()); 0<=i;
+       i=dec_bitmap.nextEncoded(i+1, Limit::numTwoToneFunctions())) {
     image(0).addElement(Offset::twoToneFunctionList() + i*TwoToneFunctionElement::size(),
                         TwoToneFunctionElement::size());
   }
@@ -640,7 +640,8 @@ protected:
   virtual void allocateForEncoding();
 
   virtual bool encodeElements(const Flags &flags, Context &ctx, const ErrorStack &err=ErrorStack());
-  virtual bool decodeElements(Context &ctx, const ErrorStack &err=ErrorStack());
+  virtual bool decodeSettingsElements(Context &ctx, const ErrorStack &err=ErrorStack());
+  virtual bool decodeTableElements(Context &ctx, const ErrorStack &err=ErrorStack());
 
   /** Allocate channels from bitmap. */
   virtual void allocateChannels();
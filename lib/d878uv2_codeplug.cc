@@ -34,10 +34,8 @@ D878UV2Codeplug::allocateContacts() {
   /* Allocate contacts */
   ContactBitmapElement contact_bitmap(data(Offset::contactBitmap()));
   unsigned contactCount=0;
-  for (uint16_t i=0; i<Limit::numContacts(); i++) {
-    // enabled if false (ass hole)
-    if (! contact_bitmap.isEncoded(i))
-      continue;
+  for (int i=contact_bitmap.nextEncoded(0, Limit::numContacts()); 0<=i;
+       i=contact_bitmap.nextEncoded(i+1, Limit::numContacts())) {
     contactCount++;
     uint32_t bank_addr = Offset::contactBanks() + (contactCount/Limit::contactsPerBank())*Offset::betweenContactBanks();
     uint32_t addr = bank_addr + ((i%Limit::contactsPerBank())/Limit::contactsPerBlock())*Offset::betweenContactBlocks();
@@ -3446,10 +3446,10 @@ D878UVCodeplug::encodeElements(const Flags &flags, Context &ctx, const ErrorStac
 
 
 bool
-D878UVCodeplug::decodeElements(Context &ctx, const ErrorStack &err)
+D878UVCodeplug::decodeTableElements(Context &ctx, const ErrorStack &err)
 {
   // Decode everything commong between d868uv and d878uv codeplugs.
-  if (! D868UVCodeplug::decodeElements(ctx, err))
+  if (! D868UVCodeplug::decodeTableElements(ctx, err))
     return false;
 
   if (! this->createRoaming(ctx, err))
@@ -3465,10 +3465,8 @@ void
 D878UVCodeplug::allocateChannels() {
   /* Allocate channels */
   ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // if disabled -> skip
-    if (! channel_bitmap.isEncoded(i))
-      continue;
+  for (int i=channel_bitmap.nextEncoded(0, Limit::numChannels()); 0<=i;
+       i=channel_bitmap.nextEncoded(i+1, Limit::numChannels())) {
     // compute address for channel
     uint16_t bank = i/Limit::channelsPerBank(), idx=i%Limit::channelsPerBank();
     uint32_t addr = Offset::channelBanks() + bank*Offset::betweenChannelBanks()
@@ -3500,20 +3498,7 @@ D878UVCodeplug::encodeChannels(const Flags &flags, Context &ctx, const ErrorStac
 bool
 D878UVCodeplug::createChannels(Context &ctx, const ErrorStack &err) {
   Q_UNUSED(err)
-
-  // Create channels
-  ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // Check if channel is enabled:
-    uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
-    if (! channel_bitmap.isEncoded(i))
-      continue;
-    ChannelElement ch(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
-                           + idx*ChannelElement::size()));
-    if (Channel *obj = ch.toChannelObj(ctx)) {
-      ctx.config()->channelList()->add(obj); ctx.add(obj, i);
-    }
-  }
+  createChannelObjs<ChannelElement, Offset, Limit>(ctx);
   return true;
 }
 
@@ -3523,11 +3508,9 @@ D878UVCodeplug::linkChannels(Context &ctx, const ErrorStack &err) {
   ChannelBitmapElement channel_bitmap(data(Offset::channelBitmap()));
 
   // Link channel objects
-  for (uint16_t i=0; i<Limit::numChannels(); i++) {
-    // Check if channel is enabled:
+  for (int i=channel_bitmap.nextEncoded(0, Limit::numChannels()); 0<=i;
+       i=channel_bitmap.nextEncoded(i+1, Limit::numChannels())) {
     uint16_t bank = i/Limit::channelsPerBank(), idx = i%Limit::channelsPerBank();
-    if (! channel_bitmap.isEncoded(i))
-      continue;
     ChannelElement ch(data(Offset::channelBanks() + bank*Offset::betweenChannelBanks()
                            + idx*ChannelElement::size()));
     if (ctx.has<Channel>(i))
@@ -3720,11 +3703,8 @@ void
 D878UVCodeplug::allocateRoaming() {
   /* Allocate roaming channels */
   RoamingChannelBitmapElement roaming_channel_bitmap(data(Offset::roamingChannelBitmap()));
-  for (uint8_t i=0; i<Limit::roamingChannels(); i++) {
-    // Get byte and bit for roaming channel
-    // if disabled -> skip
-    if (! roaming_channel_bitmap.isEncoded(i))
-      continue;
+  for (int i=roaming_channel_bitmap.nextEncoded(0, Limit::roamingChannels()); 0<=i;
+       i=roaming_channel_bitmap.nextEncoded(i+1, Limit::roamingChannels())) {
     // Allocate roaming channel
     uint32_t addr = Offset::roamingChannels() + i*RoamingChannelElement::size();
     if (!isAllocated(addr, 0)) {
@@ -3735,11 +3715,8 @@ D878UVCodeplug::allocateRoaming() {
 
   /* Allocate roaming zones. */
   RoamingZoneBitmapElement roaming_zone_bitmap(data(Offset::roamingZoneBitmap()));
-  for (uint8_t i=0; i<Limit::roamingZones(); i++) {
-    // Get byte and bit for radio ID
-    // if disabled -> skip
-    if (! roaming_zone_bitmap.isEncoded(i))
-      continue;
+  for (int i=roaming_zone_bitmap.nextEncoded(0, Limit::roamingZones()); 0<=i;
+       i=roaming_zone_bitmap.nextEncoded(i+1, Limit::roamingZones())) {
     // Allocate roaming zone
     uint32_t addr = Offset::roamingZones() + i*RoamingZoneElement::size();
     if (!isAllocated(addr, 0)) {
@@ -3789,9 +3766,8 @@ D878UVCodeplug::createRoaming(Context &ctx, const ErrorStack &err) {
 
   // Create or find roaming channels
   RoamingChannelBitmapElement roaming_channel_bitmap(data(Offset::roamingChannelBitmap()));
-  for (unsigned int i=0; i<Limit::roamingChannels(); i++) {
-    if (! roaming_channel_bitmap.isEncoded(i))
-      continue;
+  for (int i=roaming_channel_bitmap.nextEncoded(0, Limit::roamingChannels()); 0<=i;
+       i=roaming_channel_bitmap.nextEncoded(i+1, Limit::roamingChannels())) {
     uint32_t addr = Offset::roamingChannels() + i*RoamingChannelElement::size();
     RoamingChannelElement ch(data(addr));
     RoamingChannel *digi = ch.toChannel(ctx);
@@ -3800,9 +3776,8 @@ D878UVCodeplug::createRoaming(Context &ctx, const ErrorStack &err) {
 
   // Create and link roaming zones
   RoamingZoneBitmapElement roaming_zone_bitmap(data(Offset::roamingZoneBitmap()));
-  for (unsigned int i=0; i<Limit::roamingZones(); i++) {
-    if (! roaming_zone_bitmap.isEncoded(i))
-      continue;
+  for (int i=roaming_zone_bitmap.nextEncoded(0, Limit::roamingZones()); 0<=i;
+       i=roaming_zone_bitmap.nextEncoded(i+1, Limit::roamingZones())) {
     uint32_t addr = Offset::roamingZones() + i*RoamingZoneElement::size();
     RoamingZoneElement z(data(addr));
     RoamingZone *zone = z.toRoamingZone(ctx, err);
@@ -1892,7 +1892,7 @@ protected:
   void allocateUpdated();
   void allocateForEncoding();
 
-  bool decodeElements(Context &ctx, const ErrorStack &err=ErrorStack());
+  bool decodeTableElements(Context &ctx, const ErrorStack &err=ErrorStack());
   bool encodeElements(const Flags &flags, Context &ctx, const ErrorStack &err=ErrorStack());
 
   void allocateChannels();
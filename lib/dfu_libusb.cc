@@ -1,37 +1,10 @@
 #include "dfu_libusb.hh"
 #include <unistd.h>
+#include <QElapsedTimer>
 #include "logger.hh"
 #include "utils.hh"
 
 
-// USB request types.
-#define REQUEST_TYPE_TO_HOST    0xA1
-#define REQUEST_TYPE_TO_DEVICE  0x21
-
-enum {
-    REQUEST_DETACH      = 0,
-    REQUEST_DNLOAD      = 1,
-    REQUEST_UPLOAD      = 2,
-    REQUEST_GETSTATUS   = 3,
-    REQUEST_CLRSTATUS   = 4,
-    REQUEST_GETSTATE    = 5,
-    REQUEST_ABORT       = 6,
-};
-
-enum {
-    appIDLE                 = 0,
-    appDETACH               = 1,
-    dfuIDLE                 = 2,
-    dfuDNLOAD_SYNC          = 3,
-    dfuDNBUSY               = 4,
-    dfuDNLOAD_IDLE          = 5,
-    dfuMANIFEST_SYNC        = 6,
-    dfuMANIFEST             = 7,
-    dfuMANIFEST_WAIT_RESET  = 8,
-    dfuUPLOAD_IDLE          = 9,
-    dfuERROR                = 10,
-};
-
 
 /* ********************************************************************************************* *
  * Implementation of DFUDevice::Descriptor
@@ -47,7 +20,7 @@ DFUDevice::Descriptor::Descriptor(const USBDeviceInfo &info, uint8_t bus, uint8_
  * Implementation of DFUDevice
  * ********************************************************************************************* */
 DFUDevice::DFUDevice(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
-  : QObject(parent), _ctx(nullptr), _dev(nullptr)
+  : QObject(parent), _ctx(nullptr), _dev(nullptr), _stats(nullptr)
 {
   if (USBDeviceInfo::Class::DFU != descr.interfaceClass()) {
     errMsg(err) << "Cannot connect to DFU device using a non DFU descriptor: "
@@ -129,6 +102,12 @@ DFUDevice::DFUDevice(const USBDeviceDescriptor &descr, const ErrorStack &err, QO
   logDebug() << "Connected to DFU device " << descr.description() << ".";
 }
 
+DFUDevice::DFUDevice(QObject *parent)
+  : QObject(parent), _ctx(nullptr), _dev(nullptr), _stats(nullptr)
+{
+  // pass...
+}
+
 DFUDevice::~DFUDevice() {
   close();
 }
@@ -191,38 +170,147 @@ DFUDevice::close() {
   _dev = nullptr;
 }
 
+int
+DFUDevice::control_transfer(uint8_t requestType, uint8_t request, uint16_t value,
+                            uint8_t *data, uint16_t len)
+{
+  return libusb_control_transfer(_dev, requestType, request, value, 0, data, len, 0);
+}
 
 int
-DFUDevice::download(unsigned block, uint8_t *data, unsigned len, const ErrorStack &err) {
-  int error = libusb_control_transfer(
-        _dev, REQUEST_TYPE_TO_DEVICE, REQUEST_DNLOAD, block, 0, data, len, 0);
+DFUDevice::download(unsigned block, const uint8_t *data, unsigned len, const ErrorStack &err) {
+  TransferStatistics::Request request(_stats, len, sizeof(status_t));
+  // Host-to-device transfers only read the buffer, libusb just lacks a const variant.
+  int error = control_transfer(
+        REQUEST_TYPE_TO_DEVICE, REQUEST_DNLOAD, block, const_cast<uint8_t *>(data), len);
 
   if (error < 0) {
+    if (LIBUSB_ERROR_TIMEOUT == error)
+      request.timeout();
     errMsg(err) << "Cannot write to device: " << libusb_strerror((enum libusb_error) error) << ".";
     return error;
   }
 
-  return get_status();
+  if (0 == (error = get_status()))
+    request.completed();
+  return error;
 }
 
 int
 DFUDevice::upload(unsigned block, uint8_t *data, unsigned len, const ErrorStack &err) {
-  int error = libusb_control_transfer(
-        _dev, REQUEST_TYPE_TO_HOST, REQUEST_UPLOAD, block, 0, data, len, 0);
+  TransferStatistics::Request request(_stats, 0, len+sizeof(status_t));
+  int error = control_transfer(
+        REQUEST_TYPE_TO_HOST, REQUEST_UPLOAD, block, data, len);
 
   if (error < 0) {
+    if (LIBUSB_ERROR_TIMEOUT == error)
+      request.timeout();
     errMsg(err) << "Cannot read block: " << libusb_strerror((enum libusb_error) error) << ".";
     return error;
   }
 
-  return get_status();
+  if (0 == (error = get_status()))
+    request.completed();
+  return error;
+}
+
+/** Returns @c true if the given block only contains 0xff. */
+static bool
+isErasedBlock(const uint8_t *data, unsigned len) {
+  for (unsigned i=0; i<len; i++) {
+    if (0xff != data[i])
+      return false;
+  }
+  return true;
+}
+
+bool
+DFUDevice::downloadBlocks(unsigned block, const uint8_t *data, unsigned blocksize, unsigned count,
+                          bool skipErased, void (*progress)(unsigned, void *), void *ctx,
+                          const ErrorStack &err)
+{
+  // Find first block to send
+  unsigned next = 0;
+  while (skipErased && (next < count) && isErasedBlock(data+next*blocksize, blocksize))
+    next++;
+
+  while (next < count) {
+    unsigned i = next;
+    TransferStatistics::Request request(_stats, blocksize, sizeof(status_t));
+    // Host-to-device transfers only read the buffer, libusb just lacks a const variant.
+    int error = control_transfer(
+          REQUEST_TYPE_TO_DEVICE, REQUEST_DNLOAD, block+i, const_cast<uint8_t *>(data+i*blocksize),
+          blocksize);
+    if (error < 0) {
+      if (LIBUSB_ERROR_TIMEOUT == error)
+        request.timeout();
+      errMsg(err) << "Cannot write block " << (block+i) << ": "
+                  << libusb_strerror((enum libusb_error) error) << ".";
+      return false;
+    }
+    if (0 > get_status(err)) {
+      errMsg(err) << "Cannot write block " << (block+i) << ".";
+      return false;
+    }
+
+    // Prepare next block, while the device is busy
+    QElapsedTimer timer; timer.start();
+    next = i+1;
+    while (skipErased && (next < count) && isErasedBlock(data+next*blocksize, blocksize))
+      next++;
+    if (progress)
+      progress(next*blocksize, ctx);
+
+    if (wait_download(timer.nsecsElapsed(), err)) {
+      errMsg(err) << "Cannot write block " << (block+i) << ".";
+      return false;
+    }
+    request.completed();
+  }
+
+  return true;
+}
+
+bool
+DFUDevice::uploadBlocks(unsigned block, uint8_t *data, unsigned blocksize, unsigned count,
+                        void (*progress)(unsigned, void *), void *ctx, const ErrorStack &err)
+{
+  for (unsigned i=0; i<count; i++) {
+    TransferStatistics::Request request(_stats, 0, blocksize);
+    int error = control_transfer(
+          REQUEST_TYPE_TO_HOST, REQUEST_UPLOAD, block+i, data+i*blocksize, blocksize);
+    if (error < 0) {
+      if (LIBUSB_ERROR_TIMEOUT == error)
+        request.timeout();
+      errMsg(err) << "Cannot read block " << (block+i) << ": "
+                  << libusb_strerror((enum libusb_error) error) << ".";
+      return false;
+    }
+    request.completed();
+    if (progress)
+      progress((i+1)*blocksize, ctx);
+  }
+
+  // Check status once for the entire range
+  if (0 > get_status(err)) {
+    errMsg(err) << "Cannot read blocks " << block << "-" << (block+count-1) << ".";
+    return false;
+  }
+  if (dfuERROR == _status.state) {
+    errMsg(err) << "Cannot read blocks " << block << "-" << (block+count-1)
+                << ": Device error " << _status.status << ".";
+    clear_status();
+    return false;
+  }
+
+  return true;
 }
 
 int
 DFUDevice::detach(int timeout, const ErrorStack &err)
 {
-  int error = libusb_control_transfer(
-        _dev, REQUEST_TYPE_TO_DEVICE, REQUEST_DETACH, timeout, 0, nullptr, 0, 0);
+  int error = control_transfer(
+        REQUEST_TYPE_TO_DEVICE, REQUEST_DETACH, timeout, nullptr, 0);
   if (0 > error) {
     errMsg(err) << "Cannot detach device: " << libusb_strerror((enum libusb_error) error) << ".";
     return error;
@@ -233,8 +321,8 @@ DFUDevice::detach(int timeout, const ErrorStack &err)
 int
 DFUDevice::get_status(const ErrorStack &err)
 {
-  int error = libusb_control_transfer(
-        _dev, REQUEST_TYPE_TO_HOST, REQUEST_GETSTATUS, 0, 0, (unsigned char*)&_status, 6, 0);
+  int error = control_transfer(
+        REQUEST_TYPE_TO_HOST, REQUEST_GETSTATUS, 0, (unsigned char*)&_status, 6);
   if (0 > error) {
     errMsg(err) << "Cannot get status: " << libusb_strerror((enum libusb_error) error) << ".";
     return error;
@@ -245,8 +333,8 @@ DFUDevice::get_status(const ErrorStack &err)
 int
 DFUDevice::clear_status(const ErrorStack &err)
 {
-  int error = libusb_control_transfer(
-        _dev, REQUEST_TYPE_TO_DEVICE, REQUEST_CLRSTATUS, 0, 0, NULL, 0, 0);
+  int error = control_transfer(
+        REQUEST_TYPE_TO_DEVICE, REQUEST_CLRSTATUS, 0, NULL, 0);
   if (0 > error) {
     errMsg(err) << "Cannot clear status: " << libusb_strerror((enum libusb_error) error) << ".";
     return error;
@@ -259,8 +347,8 @@ DFUDevice::get_state(int &pstate, const ErrorStack &err)
 {
   unsigned char state;
 
-  int error = libusb_control_transfer(
-        _dev, REQUEST_TYPE_TO_HOST, REQUEST_GETSTATE, 0, 0, &state, 1, 0);
+  int error = control_transfer(
+        REQUEST_TYPE_TO_HOST, REQUEST_GETSTATE, 0, &state, 1);
   pstate = state;
   if (error < 0) {
     errMsg(err) << "Cannot get state: " << libusb_strerror((enum libusb_error) error) << ".";
@@ -272,8 +360,8 @@ DFUDevice::get_state(int &pstate, const ErrorStack &err)
 int
 DFUDevice::abort(const ErrorStack &err)
 {
-  int error = libusb_control_transfer(
-        _dev, REQUEST_TYPE_TO_DEVICE, REQUEST_ABORT, 0, 0, NULL, 0, 0);
+  int error = control_transfer(
+        REQUEST_TYPE_TO_DEVICE, REQUEST_ABORT, 0, NULL, 0);
   if (error < 0) {
     errMsg(err) << "Cannot abort: " << libusb_strerror((enum libusb_error) error) << ".";
     return error;
@@ -307,6 +395,8 @@ DFUDevice::wait_idle(const ErrorStack &err)
       case dfuDNBUSY:
       case dfuMANIFEST_WAIT_RESET:
         usleep(100000);
+        if (_stats)
+          _stats->addWait(100000000);
         continue;
 
       default:
@@ -319,6 +409,43 @@ DFUDevice::wait_idle(const ErrorStack &err)
   }
 }
 
+int
+DFUDevice::wait_download(qint64 elapsed, const ErrorStack &err)
+{
+  for (;;) {
+    switch (_status.state) {
+    case dfuIDLE:
+    case dfuDNLOAD_IDLE:
+      return 0;
+
+    case dfuDNLOAD_SYNC:
+    case dfuDNBUSY:
+      break;
+
+    case dfuERROR:
+      errMsg(err) << "Device error " << _status.status << ".";
+      clear_status(err);
+      return 1;
+
+    default:
+      // Unexpected state, fall-back to generic handling
+      return wait_idle(err);
+    }
+
+    // Honor the poll timeout of the device, less the time already spent
+    qint64 timeout = qint64(_status.poll_timeout)*1000000 - elapsed;
+    if (timeout > 0) {
+      usleep(timeout/1000);
+      if (_stats)
+        _stats->addWait(timeout);
+    }
+    elapsed = 0;
+
+    if (0 > get_status(err))
+      return 1;
+  }
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of DFUSEDevice
@@ -329,6 +456,12 @@ DFUSEDevice::DFUSEDevice(const USBDeviceDescriptor &descr, const ErrorStack &err
   // pass...
 }
 
+DFUSEDevice::DFUSEDevice(uint16_t blocksize, QObject *parent)
+  : DFUDevice(parent), _blocksize(blocksize)
+{
+  // pass...
+}
+
 void
 DFUSEDevice::close() {
   leaveDFU();
@@ -365,7 +498,7 @@ DFUSEDevice::readBlock(unsigned block, uint8_t *data, const ErrorStack &err) {
 
 bool
 DFUSEDevice::writeBlock(unsigned block, const uint8_t *data, const ErrorStack &err) {
-  if (download(block+2, (uint8_t *)data, _blocksize, err)) {
+  if (download(block+2, data, _blocksize, err)) {
     return false;
   }
 
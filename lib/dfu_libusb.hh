@@ -26,6 +26,39 @@ private:
 		unsigned  string_index : 8;
   };
 
+protected:
+  /** USB request types. */
+  enum RequestType {
+    REQUEST_TYPE_TO_HOST    = 0xA1,
+    REQUEST_TYPE_TO_DEVICE  = 0x21
+  };
+
+  /** DFU class-specific requests. */
+  enum Request {
+    REQUEST_DETACH      = 0,
+    REQUEST_DNLOAD      = 1,
+    REQUEST_UPLOAD      = 2,
+    REQUEST_GETSTATUS   = 3,
+    REQUEST_CLRSTATUS   = 4,
+    REQUEST_GETSTATE    = 5,
+    REQUEST_ABORT       = 6
+  };
+
+  /** DFU device states. */
+  enum DeviceState {
+    appIDLE                 = 0,
+    appDETACH               = 1,
+    dfuIDLE                 = 2,
+    dfuDNLOAD_SYNC          = 3,
+    dfuDNBUSY               = 4,
+    dfuDNLOAD_IDLE          = 5,
+    dfuMANIFEST_SYNC        = 6,
+    dfuMANIFEST             = 7,
+    dfuMANIFEST_WAIT_RESET  = 8,
+    dfuUPLOAD_IDLE          = 9,
+    dfuERROR                = 10
+  };
+
 public:
   /** Specialization to address a DFU device uniquely. */
   class Descriptor: public USBDeviceDescriptor
@@ -47,15 +80,42 @@ public:
   void close();
 
   /** Downloads some data to the device. */
-  int download(unsigned block, uint8_t *data, unsigned len, const ErrorStack &err=ErrorStack());
+  int download(unsigned block, const uint8_t *data, unsigned len, const ErrorStack &err=ErrorStack());
   /** Uploads some data from the device. */
   int upload(unsigned block, uint8_t *data, unsigned len, const ErrorStack &err=ErrorStack());
 
+  /** Downloads @c count consecutive blocks of size @c blocksize to the device, starting at the
+   * DFU block number @c block.
+   *
+   * Unlike calling @c download repeatedly, this method honors the poll timeout reported by the
+   * device instead of polling the device state at fixed intervals. While the device is busy
+   * writing a block, the next block is prepared. If @c skipErased is @c true, blocks that only
+   * contain 0xff are not sent at all. This is only safe if the memory has been erased before.
+   *
+   * The optional @c progress callback gets called with the number of bytes processed so far. */
+  bool downloadBlocks(unsigned block, const uint8_t *data, unsigned blocksize, unsigned count,
+                      bool skipErased=false, void (*progress)(unsigned, void *)=nullptr,
+                      void *ctx=nullptr, const ErrorStack &err=ErrorStack());
+  /** Uploads @c count consecutive blocks of size @c blocksize from the device, starting at the
+   * DFU block number @c block. The device status is only checked once after the last block.
+   *
+   * The optional @c progress callback gets called with the number of bytes processed so far. */
+  bool uploadBlocks(unsigned block, uint8_t *data, unsigned blocksize, unsigned count,
+                    void (*progress)(unsigned, void *)=nullptr, void *ctx=nullptr,
+                    const ErrorStack &err=ErrorStack());
+
 public:
   /** Finds all DFU interfaces with the specified VID/PID combination. */
   static QList<USBDeviceDescriptor> detect(uint16_t vid, uint16_t pid);
 
 protected:
+  /** Constructs a DFU device without any connection to a device. Used by simulated devices. */
+  explicit DFUDevice(QObject *parent);
+
+  /** Performs a single control transfer on the DFU interface. Returns the number of bytes
+   * transferred or a negative libusb error code. Simulated devices re-implement this method. */
+  virtual int control_transfer(uint8_t requestType, uint8_t request, uint16_t value,
+                               uint8_t *data, uint16_t len);
   /** Internal used function to detach the device. */
   int detach(int timeout, const ErrorStack &err=ErrorStack());
   /** Internal used function to read the current status. */
@@ -68,6 +128,9 @@ protected:
   int abort(const ErrorStack &err=ErrorStack());
   /** Internal used function to busy-wait for a response from the device. */
   int wait_idle(const ErrorStack &err=ErrorStack());
+  /** Internal used function to wait for the completion of a download. Honors the poll timeout of
+   * the last status, reduced by the time already elapsed (in ns) since the status was read. */
+  int wait_download(qint64 elapsed=0, const ErrorStack &err=ErrorStack());
 
 protected:
   /** USB context. */
@@ -76,6 +139,8 @@ protected:
 	libusb_device_handle *_dev;
   /** Device status. */
 	status_t _status;
+  /** A weak reference to the transfer statistics to update, may be @c nullptr. */
+  TransferStatistics *_stats;
 };
 
 
@@ -116,6 +181,10 @@ public:
   /** Leaves the DFU mode, may boot into the application code. */
   bool leaveDFU(const ErrorStack &err=ErrorStack());
 
+protected:
+  /** Constructs a DfuSe device without any connection to a device. Used by simulated devices. */
+  DFUSEDevice(uint16_t blocksize, QObject *parent);
+
 protected:
   /** Holds the block size in bytes. */
   uint16_t _blocksize;
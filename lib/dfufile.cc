@@ -1,6 +1,14 @@
 #include "dfufile.hh"
 #include <QFile>
 #include <QtEndian>
+#ifdef Q_OS_UNIX
+#include <sys/uio.h>
+#include <limits.h>
+#include <errno.h>
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+#endif
 
 #include "crc32.hh"
 #include "logger.hh"
@@ -39,6 +47,77 @@ typedef struct __attribute((packed)) {
 } element_prefix_t;
 
 
+/** A chunk of data to be written. */
+typedef struct {
+  const char *data;          ///< Pointer to the data.
+  size_t size;               ///< Size of the data.
+} write_chunk_t;
+
+/** Writes all chunks to the given file. If supported, the chunks are written using vectored I/O.
+ * Returns @c false on error. */
+static bool
+writeChunks(QFile &file, const QVector<write_chunk_t> &chunks) {
+#ifdef Q_OS_UNIX
+  if (file.flush() && (0 <= file.handle())) {
+    int fd = file.handle();
+    qint64 written = 0;
+    QVector<struct iovec> iov(chunks.size());
+    for (int i=0; i<chunks.size(); i++) {
+      iov[i].iov_base = const_cast<char *>(chunks[i].data);
+      iov[i].iov_len  = chunks[i].size;
+    }
+    int first = 0;
+    while (first < iov.size()) {
+      int n = std::min(iov.size()-first, IOV_MAX);
+      ssize_t res = ::writev(fd, iov.data()+first, n);
+      if ((0 > res) && (EINTR == errno))
+        continue;
+      if (0 > res)
+        return false;
+      written += res;
+      // Skip completely written chunks and advance into partially written one
+      size_t left = res;
+      while ((first < iov.size()) && (left >= iov[first].iov_len))
+        left -= iov[first++].iov_len;
+      if (first < iov.size()) {
+        iov[first].iov_base = ((char *)iov[first].iov_base) + left;
+        iov[first].iov_len -= left;
+      }
+    }
+    // Sync file position
+    return file.seek(file.pos() + written);
+  }
+#endif
+  foreach (const write_chunk_t &chunk, chunks) {
+    if (qint64(chunk.size) != file.write(chunk.data, chunk.size))
+      return false;
+  }
+  return true;
+}
+
+/** Encodes the prefix of the given image. */
+static void
+encodeImagePrefix(const DFUFile::Image &image, image_prefix_t &prefix) {
+  memcpy(prefix.signature, "Target", 6);
+  prefix.alternate_setting = image.alternateSettings();
+  prefix.is_named = qToLittleEndian(uint32_t(image.isNamed() ? 1 : 0));
+  memset(prefix.name, 0, 255);
+  if (image.isNamed()) {
+    QByteArray name = image.name().toLocal8Bit();
+    memcpy(prefix.name, name.constData(), std::min(255, name.size()));
+  }
+  prefix.size = qToLittleEndian(uint32_t(image.size()-sizeof(image_prefix_t)));
+  prefix.n_elements = qToLittleEndian(uint32_t(image.numElements()));
+}
+
+/** Encodes the prefix of the given element. */
+static void
+encodeElementPrefix(const DFUFile::Element &element, element_prefix_t &prefix) {
+  prefix.address = qToLittleEndian(element.address());
+  prefix.size = qToLittleEndian(uint32_t(element.memSize()));
+}
+
+
 /* ********************************************************************************************* *
  * Implementation of DFUFile
  * ********************************************************************************************* */
@@ -106,15 +185,24 @@ DFUFile::isAligned(unsigned blocksize) const {
 
 bool
 DFUFile::read(const QString &filename, const ErrorStack &err) {
-  QFile file(filename);
+  QSharedPointer<QFile> file(new QFile(filename));
 
-  if (! file.open(QIODevice::ReadOnly)) {
-    errMsg(err) << "Cannot read DFU file '" << filename << "': " << file.errorString() << ".";
+  if (! file->open(QIODevice::ReadOnly)) {
+    errMsg(err) << "Cannot read DFU file '" << filename << "': " << file->errorString() << ".";
     return false;
   }
 
-  if (! read(file, err)) {
-    file.close();
+  // Try to map the file, the mapping is kept alive by the elements referring to it.
+  const uchar *data = nullptr;
+  if (0 < file->size())
+    data = file->map(0, file->size());
+  if (nullptr != data)
+    return read(data, file->size(), file, err);
+
+  logDebug() << "Cannot map DFU file '" << filename << "': " << file->errorString()
+             << ". Read file instead.";
+  if (! read(*file, err)) {
+    file->close();
     return false;
   }
 
@@ -188,6 +276,76 @@ DFUFile::read(QFile &file, const ErrorStack &err)
   return true;
 }
 
+bool
+DFUFile::read(const uchar *data, qint64 size, const QSharedPointer<QFile> &mapping, const ErrorStack &err)
+{
+  CRC32 crc;
+  const uchar *ptr = data, *end = data+size;
+
+  _images.clear();
+
+  file_prefix_t prefix;
+  if (qint64(sizeof(file_prefix_t)) > (end-ptr)) {
+    errMsg(err) << "Cannot read prefix: Unexpected end of file.";
+    errMsg(err) << "Cannot read DFU file '" << mapping->fileName() << "'.";
+    return false;
+  }
+  memcpy(&prefix, ptr, sizeof(file_prefix_t));
+  crc.update(ptr, sizeof(file_prefix_t));
+  ptr += sizeof(file_prefix_t);
+
+  if (memcmp(prefix.signature, "DfuSe", 5)) {
+    errMsg(err) << "Invalid DFU file signature. Not a DFU file?";
+    errMsg(err) << "Cannot read DFU file '" << mapping->fileName() << "'.";
+    return false;
+  }
+
+  uint32_t filesize = qFromLittleEndian(prefix.image_size);
+  uint8_t  n_images = prefix.n_targets;
+
+  _images.reserve(n_images);
+  for (uint8_t i=0; i<n_images; i++) {
+    Image img; QString errorMessage;
+    if (! img.read(ptr, end, mapping, crc, errorMessage)) {
+      errMsg(err) << errorMessage;
+      return false;
+    }
+    _images.append(img);
+  }
+
+  file_suffix_t suffix;
+  if (qint64(sizeof(file_suffix_t)) > (end-ptr)) {
+    errMsg(err) << "Cannot read suffix: Unexpected end of file.";
+    errMsg(err) << "Cannot read DFU file '" << mapping->fileName() << "'.";
+    return false;
+  }
+  memcpy(&suffix, ptr, sizeof(file_suffix_t));
+
+  // Update CRC with suffix excl. CRC itself
+  crc.update(ptr, sizeof(file_suffix_t)-4);
+
+  if (filesize != (this->size()-sizeof(file_suffix_t))) {
+    errMsg(err) << "Filesize " << (this->size()-sizeof(file_suffix_t))
+                << " does not match declared content " << filesize << ".";
+    errMsg(err) << "Cannot read DFU file '" << mapping->fileName() << "'.";
+    return false;
+  }
+
+  if (memcmp(suffix.signature, "UFD", 3)) {
+    errMsg(err) << "Invalid suffix signature.";
+    errMsg(err) << "Cannot read DFU file '" << mapping->fileName() << "'.";
+    return false;
+  }
+
+  if (crc.get() != suffix.crc) {
+    errMsg(err) << "Invalid checksum got " << QString::number(unsigned(suffix.crc),16)
+                << " expected " << QString::number(unsigned(crc.get())) << ".";
+    errMsg(err) << "Cannot read DFU file '" << mapping->fileName() << "'.";
+    return false;
+  }
+  return true;
+}
+
 bool
 DFUFile::write(const QString &filename, const ErrorStack &err) {
   QFile file(filename);
@@ -204,26 +362,38 @@ DFUFile::write(const QString &filename, const ErrorStack &err) {
 
 bool
 DFUFile::write(QFile &file, const ErrorStack &err) {
+  // Assemble all prefixes first, the element data is written directly from the elements.
+  unsigned n_elements = 0;
+  foreach (const Image &img, _images)
+    n_elements += img.numElements();
+
   file_prefix_t prefix;
   memcpy(prefix.signature, "DfuSe", 5);
   prefix.version = 0x01;
   prefix.image_size = qToLittleEndian(uint32_t(size()-sizeof(file_suffix_t)));
   prefix.n_targets = _images.size();
 
-  if (sizeof(file_prefix_t) != file.write((char *)&prefix, sizeof(file_prefix_t))) {
-    errMsg(err) << "Cannot write DFU prefix to '" << file.fileName()
-                << "': " << file.errorString() << ".";
-    return false;
-  }
+  QVector<image_prefix_t> imagePrefixes(_images.size());
+  QVector<element_prefix_t> elementPrefixes(n_elements);
+  QVector<write_chunk_t> chunks;
+  chunks.reserve(2 + _images.size() + 2*n_elements);
 
   CRC32 crc;
   crc.update((uint8_t *)&prefix, sizeof(file_prefix_t));
-
-  foreach (const Image &i, _images) {
-    QString errorMessage;
-    if (! i.write(file, crc, errorMessage)) {
-      errMsg(err) << errorMessage;
-      return false;
+  chunks.append({(const char *)&prefix, sizeof(file_prefix_t)});
+
+  for (int i=0, e=0; i<_images.size(); i++) {
+    const Image &img = _images[i];
+    encodeImagePrefix(img, imagePrefixes[i]);
+    crc.update((uint8_t *)&imagePrefixes[i], sizeof(image_prefix_t));
+    chunks.append({(const char *)&imagePrefixes[i], sizeof(image_prefix_t)});
+    for (int j=0; j<img.numElements(); j++, e++) {
+      const Element &el = img.element(j);
+      encodeElementPrefix(el, elementPrefixes[e]);
+      crc.update((uint8_t *)&elementPrefixes[e], sizeof(element_prefix_t));
+      crc.update(el.data());
+      chunks.append({(const char *)&elementPrefixes[e], sizeof(element_prefix_t)});
+      chunks.append({el.data().constData(), size_t(el.data().size())});
     }
   }
 
@@ -238,9 +408,10 @@ DFUFile::write(QFile &file, const ErrorStack &err) {
 
   crc.update((uint8_t *) &suffix, sizeof(file_suffix_t)-4);
   suffix.crc = qToLittleEndian(crc.get());
+  chunks.append({(const char *)&suffix, sizeof(file_suffix_t)});
 
-  if (sizeof(file_suffix_t) != file.write((char *)&suffix, sizeof(file_suffix_t))) {
-    errMsg(err) << "Cannot write DFU suffix to '" << file.fileName()
+  if (! writeChunks(file, chunks)) {
+    errMsg(err) << "Cannot write DFU file '" << file.fileName()
                 << "': " << file.errorString() << ".";
     return false;
   }
@@ -282,19 +453,19 @@ DFUFile::dump(QTextStream &stream) const {
  * Implementation of DFUFile::Element
  * ********************************************************************************************* */
 DFUFile::Element::Element()
-  : _address(0), _data()
+  : _address(0), _data(), _mapping()
 {
   // pass...
 }
 
 DFUFile::Element::Element(uint32_t addr, uint32_t size)
-  : _address(addr), _data(size, 0x00)
+  : _address(addr), _data(size, 0x00), _mapping()
 {
   // pass...
 }
 
 DFUFile::Element::Element(const Element &other)
-  : _address(other._address), _data(other._data)
+  : _address(other._address), _data(other._data), _mapping(other._mapping)
 {
   // pass...
 }
@@ -303,6 +474,7 @@ DFUFile::Element &
 DFUFile::Element::operator=(const Element &other) {
   _address = other._address;
   _data = other._data;
+  _mapping = other._mapping;
   return *this;
 }
 
@@ -338,9 +510,19 @@ DFUFile::Element::data() const {
 
 QByteArray &
 DFUFile::Element::data() {
+  // Copy data from mapping before it gets modified
+  if (! _mapping.isNull()) {
+    _data.detach();
+    _mapping.reset();
+  }
   return _data;
 }
 
+bool
+DFUFile::Element::isMapped() const {
+  return ! _mapping.isNull();
+}
+
 bool
 DFUFile::Element::read(QFile &file, CRC32 &crc, QString &errorMessage)
 {
@@ -369,11 +551,41 @@ DFUFile::Element::read(QFile &file, CRC32 &crc, QString &errorMessage)
   return true;
 }
 
+bool
+DFUFile::Element::read(const uchar *&ptr, const uchar *end, const QSharedPointer<QFile> &mapping,
+                       CRC32 &crc, QString &errorMessage)
+{
+  // Read Element prefix:
+  element_prefix_t prefix;
+  if (qint64(sizeof(element_prefix_t)) > (end-ptr)) {
+    errorMessage = tr("Cannot read DFU file '%1': Cannot read element prefix: Unexpected end of file.").arg(mapping->fileName());
+    return false;
+  }
+  memcpy(&prefix, ptr, sizeof(element_prefix_t));
+  crc.update(ptr, sizeof(element_prefix_t));
+  ptr += sizeof(element_prefix_t);
+
+  _address = qFromLittleEndian(prefix.address);
+  uint32_t size = qFromLittleEndian(prefix.size);
+
+  if (qint64(size) > (end-ptr)) {
+    errorMessage = tr("Cannot read DFU file '%1': Cannot read element data: Unexpected end of file.").arg(mapping->fileName());
+    return false;
+  }
+
+  // Data is a view into the mapping
+  _data = QByteArray::fromRawData((const char *)ptr, size);
+  _mapping = mapping;
+  crc.update(ptr, size);
+  ptr += size;
+
+  return true;
+}
+
 bool
 DFUFile::Element::write(QFile &file, CRC32 &crc, QString &errorMessage) const {
   element_prefix_t prefix;
-  prefix.address = qToLittleEndian(_address);
-  prefix.size = qToLittleEndian(uint32_t(_data.size()));
+  encodeElementPrefix(*this, prefix);
 
   crc.update((uint8_t *) &prefix, sizeof(element_prefix_t));
 
@@ -599,17 +811,55 @@ DFUFile::Image::read(QFile &file, CRC32 &crc, QString &errorMessage)
   return true;
 }
 
+bool
+DFUFile::Image::read(const uchar *&ptr, const uchar *end, const QSharedPointer<QFile> &mapping,
+                     CRC32 &crc, QString &errorMessage)
+{
+  image_prefix_t prefix;
+  if (qint64(sizeof(image_prefix_t)) > (end-ptr)) {
+    errorMessage = tr("Cannot read DFU file '%1': Cannot read image: Unexpected end of file.").arg(mapping->fileName());
+    return false;
+  }
+  memcpy(&prefix, ptr, sizeof(image_prefix_t));
+  crc.update(ptr, sizeof(image_prefix_t));
+  ptr += sizeof(image_prefix_t);
+
+  if (memcmp(prefix.signature, "Target", 6)) {
+    errorMessage = tr("Cannot read DFU file '%1': Invalid image signature value.").arg(mapping->fileName());
+    return false;
+  }
+
+  _alternate_settings = prefix.alternate_setting;
+  if (0x01 ==qFromLittleEndian(prefix.is_named)) {
+    char tmp[256]; tmp[255]=0;
+    memcpy(tmp, prefix.name, 255);
+    _name = tmp;
+  }
+
+  uint32_t size = qFromLittleEndian(prefix.size);
+  uint32_t n_elements = qFromLittleEndian(prefix.n_elements);
+  // Each element needs at least its prefix, do not trust the element count blindly.
+  _elements.reserve(std::min(qint64(n_elements), (end-ptr)/qint64(sizeof(element_prefix_t))));
+  for (uint32_t i=0; i<n_elements; i++) {
+    Element element;
+    if (! element.read(ptr, end, mapping, crc, errorMessage))
+      return false;
+    this->addElement(element);
+  }
+
+  // verify size:
+  if (size != (this->size()-sizeof(image_prefix_t))) {
+    errorMessage = tr("Cannot read DFU file '%1': Invalid image size %2b specified, expected %3b.")
+        .arg(mapping->fileName()).arg(size).arg(this->size()-sizeof(image_prefix_t));
+    return false;
+  }
+  return true;
+}
+
 bool
 DFUFile::Image::write(QFile &file, CRC32 &crc, QString &errorMessage) const {
   image_prefix_t prefix;
-  memcpy(prefix.signature, "Target", 6);
-  prefix.alternate_setting = _alternate_settings;
-  prefix.is_named = qToLittleEndian(uint32_t(_name.isEmpty() ? 0 : 1));
-  memset(prefix.name, 0, 255);
-  if (! _name.isEmpty())
-    memcpy(prefix.name, _name.toLocal8Bit().constData(), std::min(255, _name.size()));
-  prefix.size = qToLittleEndian(uint32_t(size()-sizeof(image_prefix_t)));
-  prefix.n_elements = qToLittleEndian(uint32_t(_elements.size()));
+  encodeImagePrefix(*this, prefix);
 
   crc.update((uint8_t *)&prefix, sizeof(image_prefix_t));
 
@@ -4,6 +4,7 @@
 #include <QFile>
 #include <QVector>
 #include <QByteArray>
+#include <QSharedPointer>
 #include <QString>
 #include <QTextStream>
 
@@ -67,6 +68,11 @@ class CRC32;
  * +---+---+---+---+---+---+---+---+---+...+---+
  * @endcode
  *
+ * When reading a DFU file by name, the file gets memory mapped if possible. Then, the element data
+ * are views into the mapping and the file is not copied into memory. The data of an element gets
+ * copied only once it is accessed for modification (see @c Element::data). When writing a DFU file,
+ * all prefixes and element data are written using vectored I/O, if supported by the platform.
+ *
  * @ingroup util
  */
 class DFUFile: public QObject
@@ -98,11 +104,18 @@ public:
     bool isAligned(unsigned blocksize) const;
     /** Returns a reference to the data. */
 		const QByteArray &data() const;
-    /** Returns a reference to the data. */
+    /** Returns a reference to the data.
+     * If the data is a view into a mapped file, the data gets copied first. */
 		QByteArray &data();
+    /** Returns @c true if the element data is a view into a mapped file. */
+    bool isMapped() const;
 
     /** Reads an element from the given file and updates the CRC. */
 		bool read(QFile &file, CRC32 &crc, QString &errorMessage);
+    /** Reads an element from the given mapped file at @c ptr and updates the CRC. The element data
+     * is a view into the mapping. On success, @c ptr points to the end of the element. */
+    bool read(const uchar *&ptr, const uchar *end, const QSharedPointer<QFile> &mapping,
+              CRC32 &crc, QString &errorMessage);
     /** Writes an element to the given file and updates the CRC. */
 		bool write(QFile &file, CRC32 &crc, QString &errorMessage) const;
 
@@ -114,6 +127,8 @@ public:
 		uint32_t _address;
     /** The data of the element. */
 		QByteArray _data;
+    /** The mapped file, the data is a view into. Keeps the mapping alive. */
+    QSharedPointer<QFile> _mapping;
 	};
 
   /** Represents a single image within a @c DFUFile. */
@@ -165,6 +180,10 @@ public:
 
     /** Reads an image from the given file and updates the CRC. */
 		bool read(QFile &file, CRC32 &crc, QString &errorMessage);
+    /** Reads an image from the given mapped file at @c ptr and updates the CRC. On success, @c ptr
+     * points to the end of the image. */
+    bool read(const uchar *&ptr, const uchar *end, const QSharedPointer<QFile> &mapping,
+              CRC32 &crc, QString &errorMessage);
     /** Writes this image to the given file and updates the CRC. */
 		bool write(QFile &file, CRC32 &crc, QString &errorMessage) const;
 
@@ -243,6 +262,12 @@ public:
   /** Returns a const pointer to the encoded raw data at the specified offset. */
   virtual const unsigned char *data(uint32_t offset, uint32_t img=0) const;
 
+protected:
+  /** Reads the DFU file from the given mapping of @c size bytes.
+   * @returns @c false on error. */
+  bool read(const uchar *data, qint64 size, const QSharedPointer<QFile> &mapping,
+            const ErrorStack &err=ErrorStack());
+
 protected:
   /// The list of images.
 	QVector<Image> _images;
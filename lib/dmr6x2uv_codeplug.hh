@@ -1169,7 +1169,7 @@ protected:
   void allocateForDecoding();
   void allocateForEncoding();
 
-  bool decodeElements(Context &ctx, const ErrorStack &err=ErrorStack());
+  bool decodeTableElements(Context &ctx, const ErrorStack &err=ErrorStack());
   bool encodeElements(const Flags &flags, Context &ctx, const ErrorStack &err=ErrorStack());
 
   void allocateGeneralSettings();
@@ -0,0 +1,220 @@
+#include "dmrcompletionmodel.hh"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#define MAX_ID_DIGITS 10
+
+
+/* ********************************************************************************************* *
+ * Implementation of DMRCompletionModel
+ * ********************************************************************************************* */
+DMRCompletionModel::DMRCompletionModel(QObject *parent)
+  : QAbstractListModel(parent), _entries(), _keys(), _texts(), _byKey(), _byId(),
+    _maxResults(50), _prefix(), _matches()
+{
+  // pass...
+}
+
+void
+DMRCompletionModel::clear() {
+  beginResetModel();
+  _entries.clear();
+  _keys.clear();
+  _texts.clear();
+  _byKey.clear();
+  _byId.clear();
+  _matches.clear();
+  endResetModel();
+}
+
+void
+DMRCompletionModel::add(unsigned id, const QString &text, const QString &display) {
+  QByteArray key = text.toUpper().toUtf8().left(0xffff);
+  QByteArray txt = text.toUtf8().left(0xffff);
+  QByteArray dsp;
+  if ((! display.isEmpty()) && (display != text))
+    dsp = display.toUtf8().left(0xffff);
+
+  Entry entry;
+  entry.id = id;
+  entry.key = _keys.size();
+  entry.keyLength = key.size();
+  entry.text = _texts.size();
+  entry.textLength = txt.size();
+  entry.displayLength = dsp.size();
+  _keys.append(key);
+  _texts.append(txt);
+  _texts.append(dsp);
+  _entries.append(entry);
+}
+
+void
+DMRCompletionModel::build() {
+  beginResetModel();
+  _matches.clear();
+
+  _byKey.resize(_entries.size());
+  _byId.resize(_entries.size());
+  for (int i=0; i<_entries.size(); i++)
+    _byKey[i] = _byId[i] = i;
+
+  std::sort(_byKey.begin(), _byKey.end(), [this](quint32 a, quint32 b) {
+    const Entry &ea = _entries[a], &eb = _entries[b];
+    int cmp = memcmp(_keys.constData()+ea.key, _keys.constData()+eb.key,
+                     std::min(ea.keyLength, eb.keyLength));
+    if (0 != cmp)
+      return cmp < 0;
+    if (ea.keyLength != eb.keyLength)
+      return ea.keyLength < eb.keyLength;
+    return ea.id < eb.id;
+  });
+  std::sort(_byId.begin(), _byId.end(), [this](quint32 a, quint32 b) {
+    return _entries[a].id < _entries[b].id;
+  });
+
+  endResetModel();
+
+  // Update matches
+  if (! _prefix.isEmpty())
+    setPrefix(_prefix);
+}
+
+int
+DMRCompletionModel::count() const {
+  return _entries.size();
+}
+
+int
+DMRCompletionModel::maxResults() const {
+  return _maxResults;
+}
+
+void
+DMRCompletionModel::setMaxResults(int n) {
+  _maxResults = std::max(1, n);
+}
+
+const QString &
+DMRCompletionModel::prefix() const {
+  return _prefix;
+}
+
+void
+DMRCompletionModel::setPrefix(const QString &prefix) {
+  beginResetModel();
+  _prefix = prefix;
+  _matches.clear();
+
+  QString trimmed = prefix.trimmed();
+  if (! trimmed.isEmpty()) {
+    bool digits = std::all_of(trimmed.begin(), trimmed.end(), [](const QChar &c) { return c.isDigit(); });
+    if (digits)
+      matchId(trimmed);
+    matchText(trimmed.toUpper().toUtf8());
+  }
+
+  endResetModel();
+}
+
+unsigned
+DMRCompletionModel::id(int row) const {
+  if ((0 > row) || (row >= _matches.size()))
+    return 0;
+  return _entries[_matches[row]].id;
+}
+
+QString
+DMRCompletionModel::text(int row) const {
+  if ((0 > row) || (row >= _matches.size()))
+    return QString();
+  const Entry &entry = _entries[_matches[row]];
+  return QString::fromUtf8(_texts.constData()+entry.text, entry.textLength);
+}
+
+QString
+DMRCompletionModel::display(int row) const {
+  if ((0 > row) || (row >= _matches.size()))
+    return QString();
+  const Entry &entry = _entries[_matches[row]];
+  if (0 == entry.displayLength)
+    return text(row);
+  return QString::fromUtf8(_texts.constData()+entry.text+entry.textLength, entry.displayLength);
+}
+
+int
+DMRCompletionModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return _matches.size();
+}
+
+QVariant
+DMRCompletionModel::data(const QModelIndex &index, int role) const {
+  if ((! index.isValid()) || (index.row() >= _matches.size()))
+    return QVariant();
+
+  if (Qt::DisplayRole == role)
+    return display(index.row());
+  else if (Qt::EditRole == role)
+    return text(index.row());
+  else if (IdRole == role)
+    return id(index.row());
+
+  return QVariant();
+}
+
+void
+DMRCompletionModel::matchText(const QByteArray &key) {
+  // Find first entry not less than the key
+  QVector<quint32>::const_iterator it = std::lower_bound(
+        _byKey.constBegin(), _byKey.constEnd(), key, [this](quint32 entry, const QByteArray &k) {
+    return compareKey(entry, k, false) < 0;
+  });
+  // Collect all entries starting with key
+  for (; (it != _byKey.constEnd()) && (_matches.size() < _maxResults); it++) {
+    if (0 != compareKey(*it, key, true))
+      break;
+    addMatch(*it);
+  }
+}
+
+void
+DMRCompletionModel::matchId(const QString &digits) {
+  // DMR IDs have no leading zeros
+  if ((digits.size() > MAX_ID_DIGITS) || digits.startsWith('0'))
+    return;
+
+  quint64 prefix = digits.toULongLong();
+  quint64 scale  = 1;
+  // Search all IDs starting with the given digits, shortest IDs first.
+  for (int n=digits.size(); (n<=MAX_ID_DIGITS) && (_matches.size() < _maxResults); n++, scale*=10) {
+    quint64 lower = prefix*scale, upper = (prefix+1)*scale;
+    if (lower > std::numeric_limits<quint32>::max())
+      break;
+    QVector<quint32>::const_iterator it = std::lower_bound(
+          _byId.constBegin(), _byId.constEnd(), lower, [this](quint32 entry, quint64 id) {
+      return _entries[entry].id < id;
+    });
+    for (; (it != _byId.constEnd()) && (_entries[*it].id < upper) && (_matches.size() < _maxResults); it++)
+      addMatch(*it);
+  }
+}
+
+void
+DMRCompletionModel::addMatch(quint32 entry) {
+  if (! _matches.contains(entry))
+    _matches.append(entry);
+}
+
+int
+DMRCompletionModel::compareKey(quint32 entry, const QByteArray &key, bool prefix) const {
+  const Entry &e = _entries[entry];
+  int n = std::min(int(e.keyLength), key.size());
+  int cmp = memcmp(_keys.constData()+e.key, key.constData(), n);
+  if ((0 != cmp) || prefix)
+    return (0 != cmp) ? cmp : ((e.keyLength < key.size()) ? -1 : 0);
+  if (e.keyLength == key.size())
+    return 0;
+  return (e.keyLength < key.size()) ? -1 : 1;
+}
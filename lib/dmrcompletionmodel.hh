@@ -0,0 +1,116 @@
+#ifndef DMRCOMPLETIONMODEL_HH
+#define DMRCOMPLETIONMODEL_HH
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QByteArray>
+
+/** A compact, indexed completion model for DMR IDs (e.g., users and talk groups).
+ *
+ * Unlike the table models of @c UserDatabase and @c TalkGroupDatabase, this model only contains
+ * the matches for the current prefix (see @c setPrefix), limited to @c maxResults entries. All
+ * entries are held in a compact string pool and are indexed by their upper-case text (e.g.,
+ * call-sign or talk group name) and by their ID. A prefix look-up is then a binary search over
+ * these indices. Hence, the model can be used with a @c QCompleter in
+ * @c QCompleter::UnfilteredPopupCompletion mode, even for very large databases.
+ *
+ * Entries are added using @c add. Once all entries are added, the indices must be build by
+ * calling @c build.
+ *
+ * @ingroup util */
+class DMRCompletionModel: public QAbstractListModel
+{
+  Q_OBJECT
+
+public:
+  /** Additional data roles. */
+  enum Role {
+    IdRole = Qt::UserRole   ///< Returns the DMR ID of the entry.
+  };
+
+public:
+  /** Constructs an empty completion model. */
+  explicit DMRCompletionModel(QObject *parent=nullptr);
+
+  /** Removes all entries and matches. */
+  void clear();
+  /** Adds an entry to the model. The @c text is the completion text and also used to find the
+   * entry. The @c display text is shown in the completion popup. If empty, the @c text is used.
+   * The entry is not found before @c build is called. */
+  void add(unsigned id, const QString &text, const QString &display=QString());
+  /** Builds the indices. */
+  void build();
+
+  /** Returns the number of entries. */
+  int count() const;
+
+  /** Returns the maximum number of matches. */
+  int maxResults() const;
+  /** Sets the maximum number of matches. */
+  void setMaxResults(int n);
+
+  /** Returns the current prefix. */
+  const QString &prefix() const;
+  /** Updates the matches for the given prefix. Entries are matched case-insensitive by their
+   * text. If the prefix consists of digits only, entries are also matched by their ID. */
+  void setPrefix(const QString &prefix);
+
+  /** Returns the DMR ID of the match at the given row. */
+  unsigned id(int row) const;
+  /** Returns the completion text of the match at the given row. */
+  QString text(int row) const;
+  /** Returns the display text of the match at the given row. */
+  QString display(int row) const;
+
+  int rowCount(const QModelIndex &parent=QModelIndex()) const;
+  QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
+
+protected:
+  /** Appends up to @c maxResults matches by text. */
+  void matchText(const QByteArray &key);
+  /** Appends up to @c maxResults matches by ID. */
+  void matchId(const QString &digits);
+  /** Appends the given entry to the matches, if not present yet. */
+  void addMatch(quint32 entry);
+
+  /** Compares the key of the given entry with the given key (prefix). */
+  int compareKey(quint32 entry, const QByteArray &key, bool prefix) const;
+
+protected:
+  /** A single entry in the string pool. */
+  struct Entry {
+    /** The DMR ID. */
+    quint32 id;
+    /** Offset of the upper-case key within the key pool. */
+    quint32 key;
+    /** Offset of the completion text within the text pool. The display text follows the
+     * completion text immediately. */
+    quint32 text;
+    /** Length of the key in bytes. */
+    quint16 keyLength;
+    /** Length of the completion text in bytes. */
+    quint16 textLength;
+    /** Length of the display text in bytes, 0 if the display text equals the completion text. */
+    quint16 displayLength;
+  };
+
+  /** All entries. */
+  QVector<Entry> _entries;
+  /** Pool of all upper-case keys in UTF-8. */
+  QByteArray _keys;
+  /** Pool of all completion and display texts in UTF-8. */
+  QByteArray _texts;
+  /** Entry indices sorted by key. */
+  QVector<quint32> _byKey;
+  /** Entry indices sorted by ID. */
+  QVector<quint32> _byId;
+
+  /** The maximum number of matches. */
+  int _maxResults;
+  /** The current prefix. */
+  QString _prefix;
+  /** The current matches (entry indices). */
+  QVector<quint32> _matches;
+};
+
+#endif // DMRCOMPLETIONMODEL_HH
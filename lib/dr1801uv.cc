@@ -45,6 +45,13 @@ DR1801UV::limits() const {
   return *_limits;
 }
 
+const TransferStatistics *
+DR1801UV::statistics() const {
+  if (nullptr == _device)
+    return nullptr;
+  return &_device->statistics();
+}
+
 bool
 DR1801UV::startDownload(bool blocking, const ErrorStack &err) {
   if (StatusIdle != _task)
@@ -34,6 +34,7 @@ public:
 
   const Codeplug &codeplug() const;
   Codeplug &codeplug();
+  const TransferStatistics *statistics() const;
 
   bool startDownload(bool blocking, const ErrorStack &err);
   bool startUpload(Config *config, bool blocking, const Codeplug::Flags &flags, const ErrorStack &err);
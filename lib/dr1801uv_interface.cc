@@ -159,11 +159,13 @@ DR1801UVInterface::readCodeplug(
   unsigned int offset = 0;
   while (bytesToTransfer) {
     unsigned n = std::min(256U, bytesToTransfer);
+    TransferStatistics::Request request(&_statistics, 0, n);
     if (! AuctusA6Interface::read(codeplug.image(0).data(offset), n, 2000, err)) {
       errMsg(err) << "Cannot read from device '" << portName() << "'.";
       _state = ERROR;
       return false;
     }
+    request.completed();
     offset += n; bytesToTransfer -= n;
     if (progress)
       progress(offset, total);
@@ -223,6 +225,7 @@ DR1801UVInterface::writeCodeplug(
   logDebug() << "Write codeplug...";
   while (bytesToTransfer) {
     uint32_t n = std::min(200U, bytesToTransfer);
+    TransferStatistics::Request request(&_statistics, n, 0);
     if (! QSerialPort::write((char*)codeplug.data(offset), n)) {
       errMsg(err) << "Cannot write codeplug to device.";
       return false;
@@ -230,6 +233,7 @@ DR1801UVInterface::writeCodeplug(
     // Wait for bytes written
     while (bytesToWrite()) {
       if (! waitForBytesWritten(2000)) {
+        request.timeout();
         errMsg(err) << errorString();
         errMsg(err) << "Cannot write codeplug to the device.";
         _state = ERROR;
@@ -241,6 +245,7 @@ DR1801UVInterface::writeCodeplug(
       logDebug() << "Oops";
       logDebug() << "Unexpected data " << readAll().toHex() << ".";
     }
+    request.completed();
 
     offset += n; bytesToTransfer -= n;
     if (progress)
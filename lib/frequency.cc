@@ -1,6 +1,8 @@
 #include "frequency.hh"
 #include "logger.hh"
-#include <QRegularExpression>
+#include "utils.hh"
+#include <limits>
+
 
 Frequency::Frequency(unsigned long long Hz)
   : _frequency(Hz)
@@ -51,51 +53,57 @@ Frequency::format(Format f) const {
 
 bool
 Frequency::parse(const QString &value) {
-  QRegularExpression re(R"(\s*([0-9]+)(?:\.([0-9]*)|)\s*([kMG]?Hz|)\s*)");
-  QRegularExpressionMatch match = re.match(value);
-  if (! match.isValid())
-    return false;
+  // Searches for the pattern "\s*([0-9]+)(?:\.([0-9]*)|)\s*([kMG]?Hz|)\s*".
+  const QChar *c = value.constData(), *end = c + value.size();
+  while ((c < end) && (! is_decimal_digit(*c)))
+    c++;
+
+  // Parse leading digits
+  unsigned long long leading = 0;
+  bool overflow = false;
+  for (; (c < end) && is_decimal_digit(*c); c++) {
+    leading = leading*10ULL + (c->unicode()-'0');
+    overflow |= (leading > std::numeric_limits<unsigned int>::max());
+  }
+  if (overflow)
+    leading = 0;
+
+  // Decimals
+  const QChar *decimals = c;
+  int numDecimals = 0;
+  if ((c < end) && (QLatin1Char('.') == *c)) {
+    decimals = ++c;
+    for (; (c < end) && is_decimal_digit(*c); c++)
+      numDecimals++;
+  }
 
-  bool hasUnit = match.capturedLength(3);
-  QString unit = match.captured(3);
-  QString decimals = match.captured(2);
-  QString leading = match.captured(1);
-  _frequency = leading.toUInt();
+  // Unit
+  while ((c < end) && c->isSpace())
+    c++;
+  int exponent = 6;
+  if (has_prefix(c, end, "Hz"))
+    exponent = 0;
+  else if (has_prefix(c, end, "kHz"))
+    exponent = 3;
+  else if (has_prefix(c, end, "GHz"))
+    exponent = 9;
 
-  if ("Hz" == unit)
+  _frequency = leading;
+  if (0 == exponent)
     return true;
 
-  if ("kHz" == unit) {
-    _frequency *= 1000ULL;
-    unsigned long long factor = 100ULL;
-    for (int i=0; i<std::min(3, decimals.size()); i++) {
-      _frequency += decimals[i].digitValue()*factor;
-      factor /= 10;
-    }
-    // Rounding to proper Hz
-    if ((decimals.size()>3) && (decimals[3].digitValue()>=5))
-      _frequency+=1;
-  } else if (("MHz"==unit) || (!hasUnit)) {
-    _frequency *= 1000000ULL;
-    unsigned long long factor = 100000ULL;
-    for (int i=0; i<std::min(6, decimals.size()); i++) {
-      _frequency += decimals[i].digitValue()*factor;
-      factor /= 10;
-    }
-    // Rounding to proper Hz
-    if ((decimals.size()>6) && (decimals[6].digitValue()>=5))
-      _frequency+=1;
-  } else if ("GHz"==unit) {
-    _frequency *= 1000000000ULL;
-    unsigned long long factor = 100000000;
-    for (int i=0; i<std::min(9, decimals.size()); i++) {
-      _frequency += decimals[i].digitValue()*factor;
-      factor /= 10;
-    }
-    // Rounding to proper Hz
-    if ((decimals.size()>9) && (decimals[9].digitValue()>=5))
-      _frequency+=1;
+  unsigned long long factor = 1ULL;
+  for (int i=0; i<exponent; i++)
+    factor *= 10ULL;
+  _frequency *= factor;
+  factor /= 10ULL;
+  for (int i=0; i<std::min(exponent, numDecimals); i++) {
+    _frequency += (decimals[i].unicode()-'0')*factor;
+    factor /= 10ULL;
   }
+  // Rounding to proper Hz
+  if ((numDecimals > exponent) && ((decimals[exponent].unicode()-'0') >= 5))
+    _frequency += 1;
 
   return true;
 }
@@ -6,6 +6,7 @@
 
 
 #define BSIZE           0x35
+#define NCHUNK          16                  // Number of blocks per read/write call
 
 RadioLimits * GD73::_limits = nullptr;
 
@@ -46,6 +47,13 @@ GD73::defaultRadioInfo() {
         RadioInfo::GD73, "gd73", "GD-73", "Radioddity", GD73Interface::interfaceInfo());
 }
 
+const TransferStatistics *
+GD73::statistics() const {
+  if (nullptr == _dev)
+    return nullptr;
+  return &_dev->statistics();
+}
+
 bool
 GD73::startDownload(bool blocking, const ErrorStack &err) {
   if (StatusIdle != _task)
@@ -172,12 +180,14 @@ GD73::download() {
   for (int n=0; n<codeplug().image(0).numElements(); n++) {
     int b0 = codeplug().image(0).element(n).address()/BSIZE;
     int nb = codeplug().image(0).element(n).data().size()/BSIZE;
-    for (int i=0; i<nb; i++, bcount++) {
-      // read
-      if (! _dev->read(0, (b0+i)*BSIZE, codeplug().data((b0+i)*BSIZE), BSIZE, _errorStack)) {
+    for (int i=0; i<nb; i+=NCHUNK) {
+      // read chunk of blocks
+      int n = std::min(NCHUNK, nb-i);
+      if (! _dev->read(0, (b0+i)*BSIZE, codeplug().data((b0+i)*BSIZE), n*BSIZE, _errorStack)) {
         errMsg(_errorStack) << "Cannot download codeplug.";
         return false;
       }
+      bcount += n;
       emit downloadProgress(float(bcount*100)/btot);
     }
   }
@@ -204,13 +214,15 @@ GD73::upload() {
     for (int n=0; n<codeplug().image(0).numElements(); n++) {
       int b0 = codeplug().image(0).element(n).address()/BSIZE;
       int nb = codeplug().image(0).element(n).data().size()/BSIZE;
-      for (int i=0; i<nb; i++, bcount++) {
+      for (int i=0; i<nb; i+=NCHUNK) {
         uint32_t addr = (b0+i)*BSIZE;
-        // read
-        if (! _dev->read(0, addr, codeplug().data(addr), BSIZE, _errorStack)) {
+        int n = std::min(NCHUNK, nb-i);
+        // read chunk of blocks
+        if (! _dev->read(0, addr, codeplug().data(addr), n*BSIZE, _errorStack)) {
           errMsg(_errorStack) << "Cannot upload codeplug.";
           return false;
         }
+        bcount += n;
         emit uploadProgress(float(bcount*50)/btot);
       }
     }
@@ -232,14 +244,15 @@ GD73::upload() {
   for (int n=0; n<codeplug().image(0).numElements(); n++) {
     int b0 = codeplug().image(0).element(n).address()/BSIZE;
     int nb = codeplug().image(0).element(n).data().size()/BSIZE;
-    for (int i=0; i<nb; i++, bcount++) {
-      // Select bank by addr
+    for (int i=0; i<nb; i+=NCHUNK) {
       uint32_t addr = (b0+i)*BSIZE;
-      // write block
-      if (! _dev->write(0, addr, codeplug().data(addr), BSIZE, _errorStack)) {
+      int n = std::min(NCHUNK, nb-i);
+      // write chunk of blocks
+      if (! _dev->write(0, addr, codeplug().data(addr), n*BSIZE, _errorStack)) {
         errMsg(_errorStack) << "Cannot upload codeplug.";
         return false;
       }
+      bcount += n;
       emit uploadProgress(50+float(bcount*50)/btot);
     }
   }
@@ -3,10 +3,14 @@
 #include <QtEndian>
 
 #define BLOCK_SIZE 0x35
+#define CHUNK_SIZE 16
 
 GD73Interface::GD73Interface(const USBDeviceDescriptor &descriptor, const ErrorStack &err, QObject *parent)
   : C7000Device(descriptor, err, parent), RadioInterface()
 {
+  // Record C7000 transfers within the statistics of this interface
+  _stats = &_statistics;
+
   Packet request, response;
   if (nullptr == _dev) {
     errMsg(err) << "Cannot initialize GD73 interface: C7000 interface not open.";
@@ -47,19 +51,26 @@ bool
 GD73Interface::write(uint32_t bank, uint32_t addr, uint8_t *data, int nbytes, const ErrorStack &err) {
   Q_UNUSED(bank);
 
-  if ((addr%BLOCK_SIZE) || (nbytes!=BLOCK_SIZE)) {
+  if ((addr%BLOCK_SIZE) || (0 == nbytes) || (nbytes%BLOCK_SIZE)) {
     errMsg(err) << "Address and size must align with block size of 35h";
     return false;
   }
 
-  C7000Device::Packet request, response;
-  QByteArray payload; payload.resize(2);
-  *((uint16_t *)payload.data()) = qToLittleEndian((uint16_t)(addr/BLOCK_SIZE));
-  payload.append((char *)data, nbytes);
-  request = C7000Device::Packet(0x01, 0x00, 0x0f, payload);
-  if (! sendRecv(request, response, err)) {
-    errMsg(err) << "Cannot send write command.";
-    return false;
+  // Process blocks in chunks, all requests of a chunk are framed in advance.
+  C7000Device::Packet requests[CHUNK_SIZE], responses[CHUNK_SIZE];
+  unsigned int nblocks = nbytes/BLOCK_SIZE;
+  for (unsigned int b0=0; b0<nblocks; b0+=CHUNK_SIZE) {
+    unsigned int n = std::min(nblocks-b0, (unsigned int)CHUNK_SIZE);
+    for (unsigned int i=0; i<n; i++) {
+      uint8_t payload[2+BLOCK_SIZE];
+      qToLittleEndian<uint16_t>(addr/BLOCK_SIZE+b0+i, payload);
+      memcpy(payload+2, data+(b0+i)*BLOCK_SIZE, BLOCK_SIZE);
+      requests[i] = C7000Device::Packet(0x01, 0x00, 0x0f, payload, sizeof(payload));
+    }
+    if (! transfer(requests, responses, n, err)) {
+      errMsg(err) << "Cannot send write command.";
+      return false;
+    }
   }
 
   return true;
@@ -83,7 +94,7 @@ bool
 GD73Interface::read(uint32_t bank, uint32_t addr, uint8_t *data, int nbytes, const ErrorStack &err) {
   Q_UNUSED(bank);
 
-  if ((addr%BLOCK_SIZE) || (nbytes!=BLOCK_SIZE)) {
+  if ((addr%BLOCK_SIZE) || (0 == nbytes) || (nbytes%BLOCK_SIZE)) {
     errMsg(err) << "Address and size must align with block size of 35h";
     return false;
   }
@@ -97,23 +108,45 @@ GD73Interface::read(uint32_t bank, uint32_t addr, uint8_t *data, int nbytes, con
     return false;
   }
 
-  C7000Device::Packet request, response;
-  if (0xffff == _lastSequence) {
-    // Request start-of-read
-    request = C7000Device::Packet(0x01, 0x02);
-  } else {
-    QByteArray payload(2,0); *((uint16_t *)payload.data()) = qToLittleEndian(_lastSequence);
-    request = C7000Device::Packet(0x04, 0x01, 0x0f, payload);
-  }
-
-  if (! sendRecv(request, response, err)) {
-    errMsg(err) << "Cannot read codeplug from device.";
-    return false;
+  // Process blocks in chunks. Each request acknowledges the previous sequence number, as
+  // the device sends the blocks in sequence, all requests of a chunk are framed in advance.
+  C7000Device::Packet requests[CHUNK_SIZE], responses[CHUNK_SIZE];
+  unsigned int nblocks = nbytes/BLOCK_SIZE;
+  for (unsigned int b0=0; b0<nblocks; b0+=CHUNK_SIZE) {
+    unsigned int n = std::min(nblocks-b0, (unsigned int)CHUNK_SIZE);
+    for (unsigned int i=0; i<n; i++) {
+      uint16_t last = seqNum+b0+i-1;
+      if (0xffff == last) {
+        // Request start-of-read
+        requests[i] = C7000Device::Packet(0x01, 0x02);
+      } else {
+        uint8_t payload[2]; qToLittleEndian<uint16_t>(last, payload);
+        requests[i] = C7000Device::Packet(0x04, 0x01, 0x0f, payload, sizeof(payload));
+      }
+    }
+
+    if (! transfer(requests, responses, n, err)) {
+      errMsg(err) << "Cannot read codeplug from device.";
+      return false;
+    }
+
+    for (unsigned int i=0; i<n; i++) {
+      if (responses[i].payloadSize() < (2+BLOCK_SIZE)) {
+        errMsg(err) << "Cannot read codeplug from device: Short response of "
+                    << responses[i].payloadSize() << " bytes.";
+        return false;
+      }
+      uint16_t received = qFromLittleEndian<uint16_t>(responses[i].payloadData());
+      if (uint16_t(seqNum+b0+i) != received) {
+        errMsg(err) << "Cannot read codeplug from device: Expected seqnr. "
+                    << uint16_t(seqNum+b0+i) << " got " << received << ".";
+        return false;
+      }
+      _lastSequence = received;
+      memcpy(data+(b0+i)*BLOCK_SIZE, responses[i].payloadData()+2, BLOCK_SIZE);
+    }
   }
 
-  _lastSequence = qFromLittleEndian(*(uint16_t *)response.payload().data());
-  memcpy(data, response.payload().data()+2, nbytes);
-
   return true;
 }
 
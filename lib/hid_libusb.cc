@@ -19,7 +19,7 @@ HIDevice::Descriptor::Descriptor(const USBDeviceInfo &info, uint8_t bus, uint8_t
  * Implementation of HIDevice
  * ********************************************************************************************* */
 HIDevice::HIDevice(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
-  : QObject(parent), _ctx(nullptr), _dev(nullptr), _transfer(nullptr)
+  : QObject(parent), _ctx(nullptr), _dev(nullptr), _transfer(nullptr), _stats(nullptr)
 {
   if (USBDeviceInfo::Class::HID != descr.interfaceClass()) {
     errMsg(err) << "Cannot connect to HID device using a non HID descriptor: "
@@ -101,6 +101,12 @@ HIDevice::HIDevice(const USBDeviceDescriptor &descr, const ErrorStack &err, QObj
   }
 }
 
+HIDevice::HIDevice(QObject *parent)
+  : QObject(parent), _ctx(nullptr), _dev(nullptr), _transfer(nullptr), _stats(nullptr)
+{
+  // pass...
+}
+
 HIDevice::~HIDevice() {
   close();
 }
@@ -229,6 +235,7 @@ HIDevice::write_read(const unsigned char *data, unsigned length,
         LIBUSB_RECIPIENT_INTERFACE | LIBUSB_ENDPOINT_IN,
         reply, rlength, read_callback, this, TIMEOUT_MSEC);
 
+  TransferStatistics::Request request(_stats, length, rlength);
   size_t nretry = 0;
 again:
   _nbytes_received = 0;
@@ -268,12 +275,18 @@ again:
   if ((_nbytes_received == LIBUSB_ERROR_TIMEOUT) && (nretry < MAX_RETRY)) {
     if (0 == nretry)
       logDebug() << "HID (libusb): timeout. Retry...";
+    if (_stats)
+      _stats->addTimeout();
+    request.retry();
     nretry++;
     goto again;
   } else if (nretry >= MAX_RETRY) {
     logError() << "HID (libusb): Retry limit of " << MAX_RETRY << " exceeded.";
   }
 
+  if (_nbytes_received > 0)
+    request.completed();
+
   return _nbytes_received;
 }
 
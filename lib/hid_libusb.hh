@@ -36,12 +36,16 @@ public:
    * @param rdata Pointer to receive buffer.
    * @param rlength Size of receive buffer.
    * @param err Passes an error stack to put error messages on. */
-  bool hid_send_recv(const unsigned char *data, unsigned nbytes,
+  virtual bool hid_send_recv(const unsigned char *data, unsigned nbytes,
                      unsigned char *rdata, unsigned rlength, const ErrorStack &err=ErrorStack());
 
   /** Close connection to device. */
 	void close();
 
+protected:
+  /** Constructs a HID device without any connection to a device. Used by simulated devices. */
+  explicit HIDevice(QObject *parent);
+
 public:
   /** Finds all HID interfaces with the specified VID/PID combination. */
   static QList<USBDeviceDescriptor> detect(uint16_t vid, uint16_t pid);
@@ -66,6 +70,8 @@ protected:
 	volatile int _nbytes_received;
   /** Internal used error stack for the static callback function. */
   ErrorStack _cbError;
+  /** A weak reference to the transfer statistics to update, may be @c nullptr. */
+  TransferStatistics *_stats;
 };
 
 #endif // HID_MACOS_HH
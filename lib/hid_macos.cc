@@ -21,7 +21,7 @@ HIDevice::Descriptor::Descriptor(const USBDeviceInfo &info, uint32_t locationId,
  * Implementation of HIDevice
  * ********************************************************************************************* */
 HIDevice::HIDevice(const USBDeviceDescriptor &desc, const ErrorStack &err, QObject *parent)
-  : QObject(parent), _dev(nullptr)
+  : QObject(parent), _dev(nullptr), _stats(nullptr)
 {
   // Create the USB HID Manager.
   _HIDManager = IOHIDManagerCreate(kCFAllocatorDefault,
@@ -71,6 +71,12 @@ HIDevice::HIDevice(const USBDeviceDescriptor &desc, const ErrorStack &err, QObje
   _HIDManager = nullptr;
 }
 
+HIDevice::HIDevice(QObject *parent)
+  : QObject(parent), _HIDManager(nullptr), _dev(nullptr), _stats(nullptr)
+{
+  // pass...
+}
+
 HIDevice::~HIDevice() {
   if (_dev)
     close();
@@ -182,6 +188,7 @@ HIDevice::hid_send_recv(const unsigned char *data, unsigned nbytes,
   _nbytes_received = 0;
   memset(_receive_buf, 0, sizeof(_receive_buf));
 
+  TransferStatistics::Request request(_stats, sizeof(buf), rlength);
   uint retrycount = 0;
 again:
   // Write to HID device.
@@ -197,9 +204,13 @@ again:
     usleep(100);
     CFRunLoopRunInMode(kCFRunLoopDefaultMode, 0, 0);
     if (k >= 1000) {
+      if (_stats)
+        _stats->addTimeout();
       retrycount++;
-      if (retrycount<100)
+      if (retrycount<100) {
+        request.retry();
         goto again;
+      }
       errMsg(err) << "HID IO error: Exceeded max. retry count.";
       return false;
     }
@@ -225,6 +236,7 @@ again:
   }
 
   memcpy(rdata, _receive_buf+4, rlength);
+  request.completed();
 
   return true;
 }
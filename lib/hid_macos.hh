@@ -36,13 +36,17 @@ public:
    * @param rdata Pointer to receive buffer.
    * @param rlength Size of receive buffer.
    * @param err The stack to put error messages on. */
-	bool hid_send_recv(const unsigned char *data, unsigned nbytes,
+	virtual bool hid_send_recv(const unsigned char *data, unsigned nbytes,
                      unsigned char *rdata, unsigned rlength,
                      const ErrorStack &err=ErrorStack());
 
   /** Close connection to device. */
 	void close();
 
+protected:
+  /** Constructs a HID device without any connection to a device. Used by simulated devices. */
+  explicit HIDevice(QObject *parent);
+
 public:
   /** Finds all HID interfaces with the specified VID/PID combination. */
   static QList<USBDeviceDescriptor> detect(uint16_t vid, uint16_t pid);
@@ -67,6 +71,8 @@ protected:
 	unsigned char _receive_buf[42];
 	/** Receive result. */
 	volatile int _nbytes_received = 0;
+  /** A weak reference to the transfer statistics to update, may be @c nullptr. */
+  TransferStatistics *_stats;
 };
 
 #endif // HID_MACOS_HH
@@ -1,5 +1,7 @@
 #include "interval.hh"
-#include <QRegularExpression>
+#include "utils.hh"
+#include <limits>
+
 
 QString
 Interval::format(Format f) const {
@@ -24,21 +26,29 @@ Interval::format(Format f) const {
 
 bool
 Interval::parse(const QString &value) {
-  QRegularExpression ex(R"(\s*([0-9]+)\s*(min|s|ms|)\s*)");
-  QRegularExpressionMatch match = ex.match(value);
-  if (! match.isValid())
-    return false;
+  // Searches for the pattern "\s*([0-9]+)\s*(min|s|ms|)\s*".
+  const QChar *c = value.constData(), *end = c + value.size();
+  while ((c < end) && (! is_decimal_digit(*c)))
+    c++;
+
+  unsigned long long dur = 0;
+  bool overflow = false;
+  for (; (c < end) && is_decimal_digit(*c); c++) {
+    unsigned digit = c->unicode()-'0';
+    overflow |= (dur > (std::numeric_limits<unsigned long long>::max()-digit)/10ULL);
+    dur = dur*10ULL + digit;
+  }
+  if (overflow)
+    dur = 0;
 
-  bool hasUnit = match.capturedLength(2);
-  QString unit = match.captured(2);
-  QString dur = match.captured(1);
+  while ((c < end) && c->isSpace())
+    c++;
 
-  if (hasUnit && ("s"==unit))
-    _duration = dur.toULongLong()*1000ULL;
-  else if (hasUnit && ("min"==unit))
-    _duration = dur.toULongLong()*60000ULL;
+  if (has_prefix(c, end, "min"))
+    _duration = dur*60000ULL;
+  else if (has_prefix(c, end, "s"))
+    _duration = dur*1000ULL;
   else
-    _duration = dur.toULongLong();
+    _duration = dur;
   return true;
 }
-
@@ -6,6 +6,7 @@
 #include <QFile>
 #include <QTextStream>
 #include <QList>
+#include <QMutex>
 
 /** Constructs a debug message. */
 #define logDebug() LogMessage(LogMessage::DEBUG, __FILE__, __LINE__)
@@ -103,7 +104,7 @@ public:
   /** Destructor. */
   virtual ~Logger();
 
-  /** Logs a message. */
+  /** Logs a message. This method is thread-safe. */
   void log(const LogMessage &msg);
   /** Adds a log-handler to the logger. The ownership is transferred to the logger. */
   void addHandler(LogHandler *handler);
@@ -123,6 +124,8 @@ protected:
   static Logger *_instance;
   /** The list of registered log-handler. */
   QList<LogHandler *> _handler;
+  /** Serializes messages logged from several threads. */
+  QMutex _mutex;
 };
 
 
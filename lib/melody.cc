@@ -1,7 +1,6 @@
 #include "melody.hh"
 #include "logger.hh"
-
-#include <QRegularExpression>
+#include "utils.hh"
 
 
 /* ********************************************************************************************* *
@@ -163,58 +162,58 @@ Melody::Note::Note()
 
 bool
 Melody::Note::fromLilypond(const QString &note, Duration currentDuration) {
-  QRegularExpression note_pattern("^(c|cis|des|d|dis|ees|e|f|fis|ges|g|gis|aes|a|ais|bes|b)([,]+|[']+|)(1|2|4|8|16|)(\\.|)$");
-  QRegularExpression rest_pattern("^r(1|2|4|8|16|)(\\.|)$");
-  QRegularExpressionMatch note_match = note_pattern.match(note);
-
-  if (note_match.isValid()) {
-    if ("c" == note_match.captured(1)) tone=Tone::C;
-    else if (("cis" == note_match.captured(1)) || ("des" == note_match.captured(1))) tone=Tone::Cis;
-    else if ("d" == note_match.captured(1)) tone=Tone::D;
-    else if (("dis" == note_match.captured(1)) || ("ees" == note_match.captured(1))) tone=Tone::Dis;
-    else if ("e" == note_match.captured(1)) tone=Tone::E;
-    else if ("f" == note_match.captured(1)) tone=Tone::F;
-    else if (("fis" == note_match.captured(1)) || ("ges" == note_match.captured(1))) tone=Tone::Fis;
-    else if ("g" == note_match.captured(1)) tone=Tone::G;
-    else if (("gis" == note_match.captured(1)) || ("aes" == note_match.captured(1))) tone=Tone::Gis;
-    else if ("a" == note_match.captured(1)) tone=Tone::A;
-    else if (("ais" == note_match.captured(1)) || ("bes" == note_match.captured(1))) tone=Tone::Ais;
-    else if ("b" == note_match.captured(1)) tone=Tone::B;
-    else return false;
-
-    if (0 == note_match.capturedLength(2)) octave = 0;
-    else if ('\'' == note_match.captured(2).at(0)) octave = note_match.capturedLength(3);
-    else if (','  == note_match.captured(2).at(0)) octave = -note_match.capturedLength(3);
-    else return false;
-
-    if (0 == note_match.capturedLength(3)) duration = currentDuration;
-    else if ("1" == note_match.captured(3)) duration = Duration::Whole;
-    else if ("2" == note_match.captured(3)) duration = Duration::Half;
-    else if ("4" == note_match.captured(3)) duration = Duration::Quarter;
-    else if ("8" == note_match.captured(3)) duration = Duration::Eighth;
-    else if ("16" == note_match.captured(3)) duration = Duration::Sixteenth;
-    else return false;
-
-    dotted = (1 == note_match.capturedLength(4));
-
-    return true;
-  }
+  // Matches "^(c|cis|des|d|dis|ees|e|f|fis|ges|g|gis|aes|a|ais|bes|b)([,]+|[']+|)(1|2|4|8|16|)(\.|)$"
+  // or "^r(1|2|4|8|16|)(\.|)$".
+  const QChar *c = note.constData(), *end = c + note.size();
+  if (c >= end)
+    return false;
 
-  QRegularExpressionMatch rest_match = rest_pattern.match(note);
-  if (rest_match.isValid()) {
-    tone = Tone::Rest;
-    if (0 == note_match.capturedLength(1)) duration = currentDuration;
-    else if ("1" == note_match.captured(1)) duration = Duration::Whole;
-    else if ("2" == note_match.captured(1)) duration = Duration::Half;
-    else if ("4" == note_match.captured(1)) duration = Duration::Quarter;
-    else if ("8" == note_match.captured(1)) duration = Duration::Eighth;
-    else if ("16" == note_match.captured(1)) duration = Duration::Sixteenth;
-    else return false;
-    dotted = (1 == note_match.capturedLength(2));
-    return true;
+  Tone t = Tone::Rest;
+  bool sharp = has_prefix(c+1, end, "is"), flat = has_prefix(c+1, end, "es");
+  switch (c->unicode()) {
+  case 'c': t = sharp ? Tone::Cis : Tone::C; flat = false; break;
+  case 'd': t = sharp ? Tone::Dis : (flat ? Tone::Cis : Tone::D); break;
+  case 'e': t = flat ? Tone::Dis : Tone::E; sharp = false; break;
+  case 'f': t = sharp ? Tone::Fis : Tone::F; flat = false; break;
+  case 'g': t = sharp ? Tone::Gis : (flat ? Tone::Fis : Tone::G); break;
+  case 'a': t = sharp ? Tone::Ais : (flat ? Tone::Gis : Tone::A); break;
+  case 'b': t = flat ? Tone::Ais : Tone::B; sharp = false; break;
+  case 'r': sharp = flat = false; break;
+  default: return false;
+  }
+  c += ((sharp || flat) ? 3 : 1);
+
+  // Octave, rests have none
+  int o = 0;
+  if (Tone::Rest != t) {
+    if ((c < end) && (QLatin1Char('\'') == *c)) {
+      for (; (c < end) && (QLatin1Char('\'') == *c); c++)
+        o++;
+    } else if ((c < end) && (QLatin1Char(',') == *c)) {
+      for (; (c < end) && (QLatin1Char(',') == *c); c++)
+        o--;
+    }
   }
 
-  return false;
+  // Duration
+  Duration d = currentDuration;
+  if (has_prefix(c, end, "16")) { d = Duration::Sixteenth; c += 2; }
+  else if (has_prefix(c, end, "1")) { d = Duration::Whole; c++; }
+  else if (has_prefix(c, end, "2")) { d = Duration::Half; c++; }
+  else if (has_prefix(c, end, "4")) { d = Duration::Quarter; c++; }
+  else if (has_prefix(c, end, "8")) { d = Duration::Eighth; c++; }
+
+  // Dotted
+  bool dot = has_prefix(c, end, ".");
+  if (dot)
+    c++;
+
+  // Must be at the end of the note
+  if (c != end)
+    return false;
+
+  tone = t; octave = o; duration = d; dotted = dot;
+  return true;
 }
 
 QString
@@ -56,6 +56,13 @@ OpenGD77::defaultRadioInfo() {
 }
 
 
+const TransferStatistics *
+OpenGD77::statistics() const {
+  if (nullptr == _dev)
+    return nullptr;
+  return &_dev->statistics();
+}
+
 bool
 OpenGD77::startDownload(bool blocking, const ErrorStack &err) {
   if (StatusIdle != _task) {
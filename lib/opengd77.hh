@@ -27,6 +27,7 @@ public:
   const RadioLimits &limits() const;
   const Codeplug &codeplug() const;
   Codeplug &codeplug();
+  const TransferStatistics *statistics() const;
 
   /** Returns the default radio information. The actual instance may have different properties
    * due to variants of the same radio. */
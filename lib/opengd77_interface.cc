@@ -168,7 +168,8 @@ OpenGD77Interface::CommandRequest::initCommand(Option option) {
  * Implementation of OpenGD77Interface
  * ********************************************************************************************* */
 OpenGD77Interface::OpenGD77Interface(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
-  : USBSerial(descr, QSerialPort::Baud115200, err, parent), _sector(-1)
+  : USBSerial(descr, QSerialPort::Baud115200, err, parent), _sector(-1), _sectorDiff(true),
+    _sectorData(SECTOR_SIZE, 0), _sectorWritten(SECTOR_SIZE/BLOCK_SIZE), _flashCache()
 {
   // pass...
 }
@@ -190,6 +191,8 @@ OpenGD77Interface::detect(bool saveOnly) {
 
 void
 OpenGD77Interface::close() {
+  _sector = -1;
+  _flashCache.clear();
   if (isOpen())
     USBSerial::close();
 }
@@ -206,6 +209,8 @@ OpenGD77Interface::identifier(const ErrorStack &err) {
 bool
 OpenGD77Interface::write_start(uint32_t bank, uint32_t addr, const ErrorStack &err)
 {
+  Q_UNUSED(bank); Q_UNUSED(addr);
+
   logDebug() << "Send enter prog mode ...";
   if (! sendShowCPSScreen(err))
     return false;
@@ -229,59 +234,44 @@ OpenGD77Interface::write_start(uint32_t bank, uint32_t addr, const ErrorStack &e
   if (! sendCommand(CommandRequest::SAVE_SETTINGS_AND_VFOS, err))
     return false;
 
-  if (EEPROM == bank) {
-    if (_sector >= 0) {
-      if (! finishWriteFlash(err))
-        return false;
-    }
-    _sector = -1;
-  } else if (FLASH == bank) {
-    int32_t sector = addr/SECTOR_SIZE;
-    if ((-1 != _sector) && (_sector != sector)) {
-      if (! finishWriteFlash(err))
-        return false;
-    }
-  }
-  return true;
+  // Finish any pending sector
+  return flushSector(err);
 }
 
 bool
 OpenGD77Interface::write(uint32_t bank, uint32_t addr, uint8_t *data, int nbytes, const ErrorStack &err)
 {
   if (EEPROM == bank) {
-    if ((0 <= _sector) && (! finishWriteFlash(err)))
+    if (! flushSector(err))
       return false;
     for (int i=0; i<nbytes; i+=BLOCK_SIZE) {
-      if (! writeEEPROM(addr+i, data+i, BLOCK_SIZE, err)) {
-        _sector = -1;
+      if (! writeEEPROM(addr+i, data+i, BLOCK_SIZE, err))
         return false;
-      }
     }
     return true;
   }
 
-start:
-  int32_t sector = addr/SECTOR_SIZE;
-
-  if (0 > _sector) {
-    if (! setFlashSector(addr))
+  for (int i=0; i<nbytes; i+=BLOCK_SIZE) {
+    int32_t sector = (addr+i)/SECTOR_SIZE;
+    if ((0 <= _sector) && (sector != _sector) && (! flushSector(err)))
       return false;
-    _sector = sector;
-  }
 
-  if (sector == _sector) {
-    for (int i=0; i<nbytes; i+=BLOCK_SIZE) {
-      if (! writeFlash(addr+i, data+i, BLOCK_SIZE)) {
-        _sector = -1;
+    if (0 > _sector) {
+      if ((! _sectorDiff) && (! setFlashSector(addr+i, err)))
         return false;
-      }
+      _sector = sector;
+      _sectorWritten.fill(false);
     }
-  } else {
-    _sector = -1;
-    if (! finishWriteFlash()) {
+
+    if (_sectorDiff) {
+      // Just buffer the block, the sector gets written once complete
+      unsigned int offset = (addr+i) % SECTOR_SIZE;
+      memcpy(_sectorData.data()+offset, data+i, BLOCK_SIZE);
+      _sectorWritten.setBit(offset/BLOCK_SIZE);
+    } else if (! writeFlash(addr+i, data+i, BLOCK_SIZE, err)) {
+      _sector = -1;
       return false;
     }
-    goto start;
   }
 
   return true;
@@ -289,15 +279,57 @@ start:
 
 bool
 OpenGD77Interface::write_finish(const ErrorStack &err) {
-  _sector = -1;
+  return flushSector(err);
+}
+
+bool
+OpenGD77Interface::flushSector(const ErrorStack &err) {
   if (0 > _sector)
     return true;
+
+  uint32_t sector = _sector;
   _sector = -1;
-  if (! finishWriteFlash(err))
-    return false;
-  if (! sendCloseScreen(err))
+
+  if (! _sectorDiff) {
+    bool ok = finishWriteFlash(err);
+    _flashCache.remove(sector);
+    return ok;
+  }
+
+  // Compare buffered blocks with device content
+  QBitArray changed(_sectorWritten.size());
+  uint8_t current[BLOCK_SIZE];
+  for (int b=0; b<_sectorWritten.size(); b++) {
+    if (! _sectorWritten.testBit(b))
+      continue;
+    uint32_t addr = sector*SECTOR_SIZE + b*BLOCK_SIZE;
+    if (! readFlashCached(addr, current, err))
+      return false;
+    if (0 != memcmp(current, _sectorData.constData()+b*BLOCK_SIZE, BLOCK_SIZE))
+      changed.setBit(b);
+  }
+  // The cached content of this sector is not needed anymore and becomes invalid once written
+  _flashCache.remove(sector);
+
+  if (0 == changed.count(true)) {
+    logDebug() << "Skip unchanged flash sector " << Qt::hex << sector << "h.";
+    return true;
+  }
+
+  logDebug() << "Write " << changed.count(true) << " changed blocks to flash sector "
+             << Qt::hex << sector << "h.";
+  if (! setFlashSector(sector*SECTOR_SIZE, err))
     return false;
-  return true;
+  for (int b=0; b<changed.size(); b++) {
+    if (! changed.testBit(b))
+      continue;
+    uint32_t addr = sector*SECTOR_SIZE + b*BLOCK_SIZE;
+    const uint8_t *data = (const uint8_t *)_sectorData.constData()+b*BLOCK_SIZE;
+    if (! writeFlash(addr, data, BLOCK_SIZE, err))
+      return false;
+  }
+
+  return finishWriteFlash(err);
 }
 
 bool
@@ -336,7 +368,7 @@ OpenGD77Interface::read(uint32_t bank, uint32_t addr, uint8_t *data, int nbytes,
     if (EEPROM == bank)
       ok = readEEPROM(addr+i, data+i, BLOCK_SIZE, err);
     else if (FLASH == bank)
-      ok = readFlash(addr+i, data+i, BLOCK_SIZE, err);
+      ok = readFlashCached(addr+i, data+i, err);
     else {
       errMsg(err) << "Cannot read from bank " << bank << ": Unknown memory bank.";
       return false;
@@ -366,6 +398,7 @@ OpenGD77Interface::reboot(const ErrorStack &err) {
 bool
 OpenGD77Interface::readEEPROM(uint32_t addr, uint8_t *data, uint16_t len, const ErrorStack &err) {
   Q_UNUSED(len)
+  TransferStatistics::Request request(&_statistics, sizeof(ReadRequest), sizeof(ReadResponse));
 
   if (! isOpen()) {
     errMsg(err) << "Cannot read block: Device not open!";
@@ -379,6 +412,7 @@ OpenGD77Interface::readEEPROM(uint32_t addr, uint8_t *data, uint16_t len, const
   }
 
   if (! waitForReadyRead(1000)) {
+    request.timeout();
     errMsg(err) << "Cannot read from serial port: Timeout!";
     return false;
   }
@@ -406,12 +440,14 @@ OpenGD77Interface::readEEPROM(uint32_t addr, uint8_t *data, uint16_t len, const
   }
 
   memcpy(data, resp.data, qFromBigEndian(resp.length));
+  request.completed();
   return true;
 }
 
 
 bool
 OpenGD77Interface::writeEEPROM(uint32_t addr, const uint8_t *data, uint16_t len, const ErrorStack &err) {
+  TransferStatistics::Request request(&_statistics, 8+len, sizeof(WriteResponse));
   WriteRequest req; req.initWriteEEPROM(addr, data, len);
   WriteResponse resp;
 
@@ -421,6 +457,7 @@ OpenGD77Interface::writeEEPROM(uint32_t addr, const uint8_t *data, uint16_t len,
   }
 
   if (! waitForReadyRead(1000)) {
+    request.timeout();
     errMsg(err) << "Cannot read from serial port: Timeout!";
     return false;
   }
@@ -441,6 +478,7 @@ OpenGD77Interface::writeEEPROM(uint32_t addr, const uint8_t *data, uint16_t len,
     return false;
   }
 
+  request.completed();
   return true;
 }
 
@@ -448,6 +486,7 @@ OpenGD77Interface::writeEEPROM(uint32_t addr, const uint8_t *data, uint16_t len,
 bool
 OpenGD77Interface::readFlash(uint32_t addr, uint8_t *data, uint16_t len, const ErrorStack &err) {
   Q_UNUSED(len)
+  TransferStatistics::Request request(&_statistics, sizeof(ReadRequest), sizeof(ReadResponse));
 
   if (! isOpen()) {
     errMsg(err) << "Cannot read block: Device not open!";
@@ -463,6 +502,7 @@ OpenGD77Interface::readFlash(uint32_t addr, uint8_t *data, uint16_t len, const E
   }
 
   if (! waitForReadyRead(1000)) {
+    request.timeout();
     errMsg(err) << QSerialPort::errorString();
     errMsg(err) << "Cannot read from serial port: Timeout!";
     return false;
@@ -492,11 +532,35 @@ OpenGD77Interface::readFlash(uint32_t addr, uint8_t *data, uint16_t len, const E
   }
 
   memcpy(data, resp.data, qFromBigEndian(resp.length));
+  request.completed();
+  return true;
+}
+
+bool
+OpenGD77Interface::readFlashCached(uint32_t addr, uint8_t *data, const ErrorStack &err) {
+  uint32_t sector = addr/SECTOR_SIZE;
+  unsigned int block = (addr%SECTOR_SIZE)/BLOCK_SIZE;
+
+  auto cached = _flashCache.find(sector);
+  if ((_flashCache.end() != cached) && cached->valid.testBit(block)) {
+    memcpy(data, cached->data.constData()+block*BLOCK_SIZE, BLOCK_SIZE);
+    return true;
+  }
+
+  if (! readFlash(addr, data, BLOCK_SIZE, err))
+    return false;
+
+  if (_flashCache.end() == cached)
+    cached = _flashCache.insert(
+          sector, CachedSector{QByteArray(SECTOR_SIZE, 0), QBitArray(SECTOR_SIZE/BLOCK_SIZE)});
+  memcpy(cached->data.data()+block*BLOCK_SIZE, data, BLOCK_SIZE);
+  cached->valid.setBit(block);
   return true;
 }
 
 bool
 OpenGD77Interface::setFlashSector(uint32_t addr, const ErrorStack &err) {
+  TransferStatistics::Request request(&_statistics, 5, sizeof(WriteResponse));
   WriteRequest req; req.initSetFlashSector(addr);
   WriteResponse resp;
 
@@ -507,6 +571,7 @@ OpenGD77Interface::setFlashSector(uint32_t addr, const ErrorStack &err) {
   }
 
   if (! waitForReadyRead(1000)) {
+    request.timeout();
     errMsg(err) << QSerialPort::errorString();
     errMsg(err) << "Cannot read from serial port: Timeout!";
     return false;
@@ -528,11 +593,13 @@ OpenGD77Interface::setFlashSector(uint32_t addr, const ErrorStack &err) {
     return false;
   }
 
+  request.completed();
   return true;
 }
 
 bool
 OpenGD77Interface::writeFlash(uint32_t addr, const uint8_t *data, uint16_t len, const ErrorStack &err) {
+  TransferStatistics::Request request(&_statistics, 8+len, sizeof(WriteResponse));
   WriteRequest req; req.initWriteFlash(addr, data, len);
   WriteResponse resp;
 
@@ -543,6 +610,7 @@ OpenGD77Interface::writeFlash(uint32_t addr, const uint8_t *data, uint16_t len,
   }
 
   if (! waitForReadyRead(1000)) {
+    request.timeout();
     errMsg(err) << QSerialPort::errorString();
     errMsg(err) << "Cannot read from serial port: Timeout!";
     return false;
@@ -565,11 +633,13 @@ OpenGD77Interface::writeFlash(uint32_t addr, const uint8_t *data, uint16_t len,
     return false;
   }
 
+  request.completed();
   return true;
 }
 
 bool
 OpenGD77Interface::finishWriteFlash(const ErrorStack &err) {
+  TransferStatistics::Request request(&_statistics, 2, sizeof(WriteResponse));
   //logDebug() << "Send finish write flash command ...";
   WriteRequest req;
   req.initFinishWriteFlash();
@@ -581,6 +651,7 @@ OpenGD77Interface::finishWriteFlash(const ErrorStack &err) {
   }
 
   if (! waitForReadyRead(1000)) {
+    request.timeout();
     errMsg(err) << "Cannot read from serial port: Timeout!";
     return false;
   }
@@ -600,9 +671,20 @@ OpenGD77Interface::finishWriteFlash(const ErrorStack &err) {
     return false;
   }
 
+  request.completed();
   return true;
 }
 
+bool
+OpenGD77Interface::sectorDiff() const {
+  return _sectorDiff;
+}
+
+void
+OpenGD77Interface::setSectorDiff(bool enable) {
+  _sectorDiff = enable;
+}
+
 bool
 OpenGD77Interface::sendShowCPSScreen(const ErrorStack &err) {
   CommandRequest req;
@@ -3,6 +3,8 @@
 
 #include "usbserial.hh"
 #include "errorstack.hh"
+#include <QHash>
+#include <QBitArray>
 
 /** Implements the interfact to a radio running the Open GD77 firmware.
  *
@@ -11,6 +13,12 @@
  * needed to access these devices. The user, however, should be a member of the @c dialout group
  * to get access to the serial interfaces.
  *
+ * Writing to the Flash memory is performed sector-wise. Within the sector-diff mode (enabled by
+ * default), all blocks written to a sector are buffered and compared to the current content of
+ * the device. The latter is either taken from blocks read earlier or read back from the device.
+ * Sectors without any changes are skipped entirely, for all others only the changed blocks are
+ * transferred. This reduces the upload time as well as the flash wear.
+ *
  * @ingroup ogd77 */
 class OpenGD77Interface : public USBSerial
 {
@@ -45,6 +53,11 @@ public:
 
   bool reboot(const ErrorStack &err=ErrorStack());
 
+  /** Returns @c true if the sector-diff mode is enabled. */
+  bool sectorDiff() const;
+  /** Enables or disables the sector-diff mode for Flash writes. */
+  void setSectorDiff(bool enable);
+
 public:
   /** Returns some information about this interface. */
   static USBDeviceInfo interfaceInfo();
@@ -224,6 +237,12 @@ protected:
    * the changes are lost. */
   bool finishWriteFlash(const ErrorStack &err=ErrorStack());
 
+  /** Reads a block from the Flash memory, using the cache of blocks read earlier. */
+  bool readFlashCached(uint32_t addr, uint8_t *data, const ErrorStack &err=ErrorStack());
+  /** Writes the changes of the currently buffered sector to the device (sector-diff mode) or
+   * finishes writing the currently selected sector. */
+  bool flushSector(const ErrorStack &err=ErrorStack());
+
   /** Send a "show CPS screen" message. */
   bool sendShowCPSScreen(const ErrorStack &err=ErrorStack());
   /** Send a "clear screen" message. */
@@ -240,6 +259,22 @@ protected:
 protected:
   /** The current Flash sector, set to -1 if none is currently selected. */
   int32_t _sector;
+  /** If @c true, Flash writes are buffered and compared sector-wise. */
+  bool _sectorDiff;
+  /** Buffer holding the blocks written to the current sector in sector-diff mode. */
+  QByteArray _sectorData;
+  /** Marks the blocks of the current sector written in sector-diff mode. */
+  QBitArray _sectorWritten;
+  /** A Flash sector, cached while reading. */
+  struct CachedSector {
+    /** The content of the sector. */
+    QByteArray data;
+    /** Marks the blocks of the sector read so far. */
+    QBitArray valid;
+  };
+  /** Cache of Flash blocks read from the device, indexed by sector number. An entry is dropped
+   * once the sector has been written or skipped. */
+  QHash<uint32_t, CachedSector> _flashCache;
 };
 
 #endif // OPENGD77INTERFACE_HH
@@ -50,6 +50,13 @@ OpenRTX::defaultRadioInfo() {
 }
 
 
+const TransferStatistics *
+OpenRTX::statistics() const {
+  if (nullptr == _dev)
+    return nullptr;
+  return &_dev->statistics();
+}
+
 bool
 OpenRTX::startDownload(bool blocking, const ErrorStack &err) {
   if (StatusIdle != _task) {
@@ -5,6 +5,9 @@
 #include "tyt_interface.hh"
 #include "dr1801uv_interface.hh"
 #include "gd73_interface.hh"
+#include "anytone_simulator.hh"
+#include "radioddity_simulator.hh"
+#include "tyt_simulator.hh"
 
 #include "rd5r.hh"
 #include "gd73.hh"
@@ -24,6 +27,7 @@
 #include "config.hh"
 #include "configcopyvisitor.hh"
 #include "logger.hh"
+#include "usbdeviceregistry.hh"
 
 #include <QSet>
 
@@ -51,6 +55,21 @@ Radio::callsignDB() {
   return nullptr;
 }
 
+const TransferStatistics *
+Radio::statistics() const {
+  return nullptr;
+}
+
+
+/** Queries the identification of the radio connected to the given interface and records it in
+ * the device registry, such that device listings can show the radio. */
+static RadioInfo
+identify(const USBDeviceDescriptor &descr, RadioInterface *iface, const ErrorStack &err) {
+  RadioInfo id = iface->identifier(err);
+  USBDeviceRegistry::instance()->setIdentification(descr, id);
+  return id;
+}
+
 
 Radio *
 Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const ErrorStack &err) {
@@ -61,9 +80,10 @@ Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const Er
   logDebug() << "Try to detect radio at " << descr.description() << ".";
 
   if (AnytoneInterface::interfaceInfo() == descr) {
-    AnytoneInterface *anytone = new AnytoneInterface(descr, err);
+    AnytoneInterface *anytone = descr.isSimulated() ? new AnytoneSimulator(descr, err)
+                                                    : new AnytoneInterface(descr, err);
     if (anytone->isOpen()) {
-      RadioInfo id = anytone->identifier(err);
+      RadioInfo id = identify(descr, anytone, err);
       if ((id.isValid() && (RadioInfo::D868UVE == id.id())) || (force.isValid() && (RadioInfo::D868UVE == force.id()))) {
         return new D868UV(anytone);
       } else if ((id.isValid() && (RadioInfo::D878UV == id.id())) || (force.isValid() && (RadioInfo::D878UV == force.id()))) {
@@ -89,7 +109,7 @@ Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const Er
   } else if (OpenGD77Interface::interfaceInfo() == descr) {
     OpenGD77Interface *ogd77 = new OpenGD77Interface(descr, err);
     if (ogd77->isOpen()) {
-      RadioInfo id = ogd77->identifier();
+      RadioInfo id = identify(descr, ogd77, ErrorStack());
       if ((id.isValid() && (RadioInfo::OpenGD77 == id.id())) || (force.isValid() && (RadioInfo::OpenGD77 == force.id()))) {
         return new OpenGD77(ogd77);
       } else {
@@ -102,9 +122,10 @@ Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const Er
     }
     ogd77->deleteLater();
   } else if (TyTInterface::interfaceInfo() == descr) {
-    TyTInterface *dfu = new TyTInterface(descr, err);
+    TyTInterface *dfu = descr.isSimulated() ? new TyTSimulator(descr, err)
+                                            : new TyTInterface(descr, err);
     if (dfu->isOpen()) {
-      RadioInfo id = dfu->identifier();
+      RadioInfo id = identify(descr, dfu, ErrorStack());
       if ((id.isValid() && (RadioInfo::MD390 == id.id())) || (force.isValid() && (RadioInfo::MD390 == force.id()))) {
         return new MD390(dfu);
       } else if ((id.isValid() && (RadioInfo::UV390 == id.id())) || (force.isValid() && (RadioInfo::UV390 == force.id()))) {
@@ -124,9 +145,10 @@ Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const Er
     }
     dfu->deleteLater();
   } else if (RadioddityInterface::interfaceInfo() == descr) {
-    RadioddityInterface *hid = new RadioddityInterface(descr, err);
+    RadioddityInterface *hid = descr.isSimulated() ? new RadiodditySimulator(descr, err)
+                                                   : new RadioddityInterface(descr, err);
     if (hid->isOpen()) {
-      RadioInfo id = hid->identifier();
+      RadioInfo id = identify(descr, hid, ErrorStack());
       if ((id.isValid() && (RadioInfo::RD5R == id.id())) || (force.isValid() && (RadioInfo::RD5R == force.id()))) {
         return new RD5R(hid);
       } else if ((id.isValid() && (RadioInfo::GD77 == id.id())) || (force.isValid() && (RadioInfo::GD77 == force.id()))) {
@@ -146,7 +168,7 @@ Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const Er
   } else if (DR1801UVInterface::interfaceInfo() == descr) {
     DR1801UVInterface *dif = new DR1801UVInterface(descr, err);
     if (dif->isOpen()) {
-      RadioInfo id = dif->identifier(err);
+      RadioInfo id = identify(descr, dif, err);
       if (((id.isValid()) && (RadioInfo::DR1801UV == id.id())) ||
           (force.isValid() && (RadioInfo::DR1801UV==force.id()))) {
         return new DR1801UV(dif);
@@ -164,7 +186,7 @@ Radio::detect(const USBDeviceDescriptor &descr, const RadioInfo &force, const Er
   } else if (C7000Device::interfaceInfo() == descr) {
     GD73Interface *gdif = new GD73Interface(descr, err);
     if (gdif->isOpen()) {
-      RadioInfo id = gdif->identifier();
+      RadioInfo id = identify(descr, gdif, ErrorStack());
       if ((id.isValid() && (RadioInfo::GD73 == id.id())) ||
           (force.isValid() && (RadioInfo::GD73 == force.id()))) {
         return new GD73(gdif);
@@ -68,6 +68,11 @@ public:
   /** Returns the call-sign DB instance. */
   virtual CallsignDB *callsignDB();
 
+  /** Returns the transfer statistics of the interface to the radio, if available. That is,
+   * the number of requests, bytes transferred, latencies etc. of the last up- or download.
+   * Returns @c nullptr, if the radio is not connected. */
+  virtual const TransferStatistics *statistics() const;
+
   /** Returns the current status. */
   Status status() const;
 
@@ -22,12 +22,22 @@ static const unsigned char CMD_CWB3[]  = "CWB\4\0\3\0\0";
 static const unsigned char CMD_CWB4[]  = "CWB\4\0\4\0\0";
 
 RadioddityInterface::RadioddityInterface(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
-  : HIDevice(descr, err, parent), _current_bank(MEMBANK_NONE), _identifier()
+  : HIDevice(descr, err, parent), RadioInterface(), _current_bank(MEMBANK_NONE), _identifier()
 {
+  // Record HID transfers within the statistics of this interface
+  _stats = &_statistics;
+
   if (isOpen())
     identifier();
 }
 
+RadioddityInterface::RadioddityInterface(QObject *parent)
+  : HIDevice(parent), RadioInterface(), _current_bank(MEMBANK_NONE), _identifier()
+{
+  // Record HID transfers within the statistics of this interface
+  _stats = &_statistics;
+}
+
 RadioddityInterface::~RadioddityInterface() {
   if (isOpen())
     close();
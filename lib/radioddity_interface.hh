@@ -34,6 +34,11 @@ public:
   /** Destructor. */
   virtual ~RadioddityInterface();
 
+protected:
+  /** Constructs an interface without any connection to a device. Used by the simulator. */
+  explicit RadioddityInterface(QObject *parent);
+
+public:
   /** Returns @c true if the connection was established. */
 	bool isOpen() const;
 
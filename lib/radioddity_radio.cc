@@ -24,6 +24,13 @@ RadioddityRadio::~RadioddityRadio() {
   }
 }
 
+const TransferStatistics *
+RadioddityRadio::statistics() const {
+  if (nullptr == _dev)
+    return nullptr;
+  return &_dev->statistics();
+}
+
 bool
 RadioddityRadio::startDownload(bool blocking, const ErrorStack &err) {
   if (StatusIdle != _task)
@@ -0,0 +1,140 @@
+#include "radioddity_simulator.hh"
+#include "logger.hh"
+
+#define MAX_RETRY       20                  // Number of retries
+#define REPORT_SIZE     42                  // Size of the HID reports
+
+
+/* ********************************************************************************************* *
+ * Implementation of RadiodditySimulator
+ * ********************************************************************************************* */
+RadiodditySimulator::RadiodditySimulator(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
+  : RadioddityInterface(parent), _device(descr, err), _open(false), _bank(0), _offset(0)
+{
+  if (! _device.isValid()) {
+    errMsg(err) << "Cannot open " << descr.description() << ".";
+    return;
+  }
+
+  logDebug() << "Opened " << descr.description() << ".";
+  _open = true;
+  identifier(err);
+}
+
+RadiodditySimulator::~RadiodditySimulator() {
+  if (isOpen())
+    close();
+}
+
+bool
+RadiodditySimulator::isOpen() const {
+  return _open;
+}
+
+void
+RadiodditySimulator::close() {
+  RadioddityInterface::close();
+  _open = false;
+}
+
+bool
+RadiodditySimulator::hid_send_recv(const unsigned char *data, unsigned nbytes,
+                                   unsigned char *rdata, unsigned rlength, const ErrorStack &err)
+{
+  if (! isOpen()) {
+    errMsg(err) << "Simulated HID device is not open.";
+    return false;
+  }
+
+  TransferStatistics::Request request(_stats, REPORT_SIZE, REPORT_SIZE);
+  // Every request is sent as a single report and answered by a single report
+  unsigned int nretry = 0;
+  while (! _device.transfer(2*REPORT_SIZE)) {
+    if (0 == nretry)
+      logDebug() << "HID (simulated): timeout. Retry...";
+    if (_stats)
+      _stats->addTimeout();
+    request.retry();
+    if ((++nretry) >= MAX_RETRY) {
+      errMsg(err) << "HID (simulated): Retry limit of " << MAX_RETRY << " exceeded.";
+      return false;
+    }
+  }
+
+  if (! respond(data, nbytes, rdata, rlength, err))
+    return false;
+
+  request.completed();
+  return true;
+}
+
+bool
+RadiodditySimulator::respond(const unsigned char *data, unsigned nbytes,
+                             unsigned char *rdata, unsigned rlength, const ErrorStack &err)
+{
+  // Enter program mode
+  if ((7 == nbytes) && (0 == memcmp(data, "\2PROGRA", 7)) && (1 == rlength)) {
+    rdata[0] = 'A';
+    return true;
+  }
+
+  // Identify
+  if ((2 == nbytes) && (0 == memcmp(data, "M\2", 2)) && (16 == rlength)) {
+    QByteArray name;
+    switch (_device.radio().id()) {
+    case RadioInfo::RD5R: name = "BF-5R"; break;
+    case RadioInfo::GD77: name = "MD-760P"; break;
+    default:
+      errMsg(err) << "Cannot simulate " << _device.radio().name() << ".";
+      return false;
+    }
+    memset(rdata, 0xff, 16);
+    memcpy(rdata, name.constData(), name.size());
+    memcpy(rdata+8, "V210", 4);
+    return true;
+  }
+
+  // Acknowledge
+  if ((1 == nbytes) && ('A' == data[0]) && (1 == rlength)) {
+    rdata[0] = 'A';
+    return true;
+  }
+
+  // Select memory bank
+  if ((8 == nbytes) && (0 == memcmp(data, "CWB\4\0", 5)) && (1 == rlength)) {
+    uint8_t bank = data[5];
+    _bank   = (3 <= bank) ? 1 : 0;
+    _offset = ((1 == bank) || (4 == bank)) ? 0x10000 : 0;
+    rdata[0] = 'A';
+    return true;
+  }
+
+  // Read block
+  if ((4 == nbytes) && ('R' == data[0]) && ((4u+data[3]) == rlength)) {
+    uint32_t addr = _offset + ((uint32_t(data[1])<<8) | data[2]);
+    memcpy(rdata, data, 4);
+    _device.read(_bank, addr, rdata+4, data[3]);
+    return true;
+  }
+
+  // Write block
+  if ((4 < nbytes) && ('W' == data[0]) && ((4u+data[3]) == nbytes) && (1 == rlength)) {
+    uint32_t addr = _offset + ((uint32_t(data[1])<<8) | data[2]);
+    _device.write(_bank, addr, data+4, data[3]);
+    rdata[0] = 'A';
+    return true;
+  }
+
+  // Leave program mode
+  if ((4 == nbytes) && (0 == memcmp(data, "ENDR", 4)) && (1 == rlength)) {
+    rdata[0] = 'A';
+    return true;
+  }
+  if ((4 == nbytes) && (0 == memcmp(data, "ENDW", 4)) && (1 == rlength)) {
+    rdata[0] = 'A';
+    return _device.save(err);
+  }
+
+  errMsg(err) << "Simulated HID device: Unexpected request of " << nbytes << " bytes.";
+  return false;
+}
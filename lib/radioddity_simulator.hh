@@ -0,0 +1,51 @@
+#ifndef RADIODDITYSIMULATOR_HH
+#define RADIODDITYSIMULATOR_HH
+
+#include "radioddity_interface.hh"
+#include "simulateddevice.hh"
+
+/** Simulates the HID interface of Radioddity radios.
+ *
+ * This class replaces the HID transport of the @c RadioddityInterface by a simulated device,
+ * which implements the device side of the HID protocol. That is, it answers the program-mode,
+ * bank-select, read and write requests. See @c SimulatedDevice for the device specification.
+ *
+ * The simulated memory uses bank 0 for the codeplug and bank 1 for the callsign DB. Within each
+ * bank, the upper memory banks of the radio are mapped to the addresses above 0x10000.
+ *
+ * @ingroup radioddity */
+class RadiodditySimulator: public RadioddityInterface
+{
+  Q_OBJECT
+
+public:
+  /** Constructs a simulated Radioddity device for the given descriptor. If the specification is
+   * valid, @c isOpen returns @c true. */
+  explicit RadiodditySimulator(const USBDeviceDescriptor &descr, const ErrorStack &err=ErrorStack(),
+                               QObject *parent=nullptr);
+  /** Destructor. */
+  virtual ~RadiodditySimulator();
+
+  bool isOpen() const;
+  void close();
+
+  bool hid_send_recv(const unsigned char *data, unsigned nbytes,
+                     unsigned char *rdata, unsigned rlength, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** Computes the response of the simulated device to the given command. */
+  bool respond(const unsigned char *data, unsigned nbytes,
+               unsigned char *rdata, unsigned rlength, const ErrorStack &err);
+
+protected:
+  /** The simulated device. */
+  SimulatedDevice _device;
+  /** If @c true, the simulated device is connected. */
+  bool _open;
+  /** The memory bank of the simulated device selected by the last bank-select command. */
+  uint32_t _bank;
+  /** The address offset selected by the last bank-select command. */
+  uint32_t _offset;
+};
+
+#endif // RADIODDITYSIMULATOR_HH
@@ -8,6 +8,7 @@
 #include "usbdevice.hh"
 #include "radioinfo.hh"
 #include "errorstack.hh"
+#include "transferstatistics.hh"
 
 /** Abstract radio interface.
  * A radion interface must provide means to communicate with the device. That is, open a connection
@@ -90,6 +91,15 @@ public:
    * this function does nothing.
    * @param err Passes an error stack to put error messages on. */
   virtual bool reboot(const ErrorStack &err=ErrorStack());
+
+  /** Returns the transfer statistics collected by this interface. */
+  const TransferStatistics &statistics() const;
+  /** Returns the transfer statistics collected by this interface. */
+  TransferStatistics &statistics();
+
+protected:
+  /** Holds the transfer statistics. */
+  TransferStatistics _statistics;
 };
 
 #endif // RADIOINFERFACE_HH
@@ -1,10 +1,26 @@
 #include "signaling.hh"
+#include "utils.hh"
 
 #include <QHash>
 #include <QVector>
 #include <QObject>
-#include <QRegularExpression>
-#include <QRegularExpressionMatch>
+
+
+/** Returns @c true if the given character is an octal digit [0-7]. */
+static inline bool
+isOctalDigit(const QChar &c) {
+  return (c.unicode() >= '0') && (c.unicode() <= '7');
+}
+
+/** Returns @c true if the given character is a DCS polarity prefix [-iInN]. */
+static inline bool
+isDCSPrefix(const QChar &c) {
+  switch (c.unicode()) {
+  case '-': case 'i': case 'I': case 'n': case 'N': return true;
+  default: break;
+  }
+  return false;
+}
 
 
 /* ********************************************************************************************* *
@@ -147,24 +163,42 @@ SelectiveCall::format() const {
 
 SelectiveCall
 SelectiveCall::parseCTCSS(const QString &text) {
-  QRegularExpression re(R"(([0-9]+(?:\.[0-9]|))\s*(?:Hz|))");
-  QRegularExpressionMatch match = re.match(text);
-  if (! match.isValid())
-    return SelectiveCall();
-  return SelectiveCall(match.captured(1).toDouble());
+  // Searches for the pattern "([0-9]+(?:\.[0-9]|))\s*(?:Hz|)".
+  const QChar *c = text.constData(), *end = c + text.size();
+  while ((c < end) && (! is_decimal_digit(*c)))
+    c++;
+
+  double tenths = 0;
+  for (; (c < end) && is_decimal_digit(*c); c++)
+    tenths = tenths*10 + (c->unicode()-'0');
+  tenths *= 10;
+  if (((c+1) < end) && (QLatin1Char('.') == c[0]) && is_decimal_digit(c[1]))
+    tenths += c[1].unicode()-'0';
+
+  return SelectiveCall(tenths/10);
 }
 
 
 SelectiveCall
 SelectiveCall::parseDCS(const QString &text) {
-  QRegularExpression re(R"(([\-iInN]?)([0-7]{1,3}))");
-  QRegularExpressionMatch match = re.match(text);
-  if (! match.isValid())
-    return SelectiveCall();
+  // Searches for the pattern "([\-iInN]?)([0-7]{1,3})".
+  const QChar *c = text.constData(), *end = c + text.size();
   bool inverted = false;
-  if (("-" == match.captured(1)) || ("i" == match.captured(1)) || ("I" == match.captured(1)))
-    inverted = true;
-  return SelectiveCall(match.captured(2).toUInt(), inverted);
+  for (; c < end; c++) {
+    if (isOctalDigit(*c))
+      break;
+    if (isDCSPrefix(*c) && ((c+1) < end) && isOctalDigit(c[1])) {
+      inverted = (QLatin1Char('-') == c[0]) || (QLatin1Char('i') == c[0]) || (QLatin1Char('I') == c[0]);
+      c++;
+      break;
+    }
+  }
+
+  unsigned int code = 0;
+  for (int i=0; (i<3) && (c < end) && isOctalDigit(*c); i++, c++)
+    code = code*10 + (c->unicode()-'0');
+
+  return SelectiveCall(code, inverted);
 }
 
 SelectiveCall
@@ -0,0 +1,269 @@
+#include "simulateddevice.hh"
+#include <QThread>
+#include <QFileInfo>
+#include "logger.hh"
+#include "dfufile.hh"
+#include "anytone_interface.hh"
+#include "radioddity_interface.hh"
+#include "tyt_interface.hh"
+
+
+/* ********************************************************************************************* *
+ * Implementation of SimulatedDevice::Descriptor
+ * ********************************************************************************************* */
+SimulatedDevice::Descriptor::Descriptor(const USBDeviceInfo &info, const QString &spec)
+  : USBDeviceDescriptor(
+      USBDeviceInfo(info.interfaceClass(), info.vendorId(), info.productId(), true), spec)
+{
+  // pass...
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of SimulatedDevice
+ * ********************************************************************************************* */
+SimulatedDevice::SimulatedDevice(const USBDeviceDescriptor &descr, const ErrorStack &err)
+  : _radio(), _latency(0), _bandwidth(0), _errors(0), _fill(0x00), _image(), _random(0),
+    _memory()
+{
+  if (! descr.isSimulated()) {
+    errMsg(err) << "Cannot create simulated device for " << descr.description() << ".";
+    return;
+  }
+
+  if (! parse(descr.device().toString(), err)) {
+    _radio = RadioInfo();
+    return;
+  }
+
+  if (! load(err)) {
+    _radio = RadioInfo();
+    return;
+  }
+
+  logDebug() << "Simulate " << _radio.name() << " with a latency of " << _latency
+             << "ms, a bandwidth of " << _bandwidth << "b/s and an error rate of "
+             << _errors << ".";
+}
+
+SimulatedDevice::~SimulatedDevice() {
+  // pass...
+}
+
+bool
+SimulatedDevice::isValid() const {
+  return _radio.isValid();
+}
+
+const RadioInfo &
+SimulatedDevice::radio() const {
+  return _radio;
+}
+
+double
+SimulatedDevice::latency() const {
+  return _latency;
+}
+
+double
+SimulatedDevice::bandwidth() const {
+  return _bandwidth;
+}
+
+double
+SimulatedDevice::errorRate() const {
+  return _errors;
+}
+
+bool
+SimulatedDevice::transfer(unsigned int nbytes) {
+  double us = _latency*1e3;
+  if (_bandwidth > 0)
+    us += double(nbytes)*1e6/_bandwidth;
+  if (us >= 1)
+    QThread::usleep(us);
+
+  if ((_errors > 0) && (_random.generateDouble() < _errors))
+    return false;
+  return true;
+}
+
+void
+SimulatedDevice::read(uint32_t bank, uint32_t addr, uint8_t *data, unsigned int n) const {
+  QHash<uint32_t, QMap<uint32_t, QByteArray>>::const_iterator pages = _memory.constFind(bank);
+  while (n) {
+    uint32_t page = addr - (addr % PageSize), offset = addr-page;
+    unsigned int len = std::min(n, PageSize-offset);
+    QMap<uint32_t, QByteArray>::const_iterator item;
+    if ((_memory.constEnd() != pages) && (pages->constEnd() != (item = pages->constFind(page))))
+      memcpy(data, item->constData()+offset, len);
+    else
+      memset(data, _fill, len);
+    addr += len; data += len; n -= len;
+  }
+}
+
+void
+SimulatedDevice::write(uint32_t bank, uint32_t addr, const uint8_t *data, unsigned int n) {
+  QMap<uint32_t, QByteArray> &pages = _memory[bank];
+  while (n) {
+    uint32_t page = addr - (addr % PageSize), offset = addr-page;
+    unsigned int len = std::min(n, PageSize-offset);
+    QMap<uint32_t, QByteArray>::iterator item = pages.find(page);
+    if (pages.end() == item)
+      item = pages.insert(page, QByteArray(PageSize, char(_fill)));
+    memcpy(item->data()+offset, data, len);
+    addr += len; data += len; n -= len;
+  }
+}
+
+void
+SimulatedDevice::erase(uint32_t bank, uint32_t addr, unsigned int n) {
+  QByteArray ones(PageSize, char(0xff));
+  while (n) {
+    unsigned int len = std::min(n, PageSize-(addr % PageSize));
+    write(bank, addr, (const uint8_t *)ones.constData(), len);
+    addr += len; n -= len;
+  }
+}
+
+bool
+SimulatedDevice::save(const ErrorStack &err) {
+  if (_image.isEmpty())
+    return true;
+
+  DFUFile file;
+  uint32_t nbanks = 0;
+  foreach (uint32_t bank, _memory.keys())
+    nbanks = std::max(nbanks, bank+1);
+
+  for (uint32_t bank=0; bank<nbanks; bank++) {
+    file.addImage(QString("Bank %1").arg(bank));
+    const QMap<uint32_t, QByteArray> &pages = _memory[bank];
+    // Merge consecutive pages into elements
+    QMap<uint32_t, QByteArray>::const_iterator item = pages.constBegin();
+    while (pages.constEnd() != item) {
+      uint32_t addr = item.key();
+      QByteArray data = item.value();
+      for (item++; (pages.constEnd() != item) && (item.key() == (addr+data.size())); item++)
+        data.append(item.value());
+      file.image(bank).addElement(addr, data.size());
+      DFUFile::Element &element = file.image(bank).element(file.image(bank).numElements()-1);
+      memcpy(element.data().data(), data.constData(), data.size());
+    }
+  }
+
+  if (! file.write(_image, err)) {
+    errMsg(err) << "Cannot write memory of simulated device to '" << _image << "'.";
+    return false;
+  }
+
+  logDebug() << "Saved memory of simulated device to '" << _image << "'.";
+  return true;
+}
+
+bool
+SimulatedDevice::parse(const QString &spec, const ErrorStack &err) {
+  if (! isSpecification(spec)) {
+    errMsg(err) << "Invalid simulated device '" << spec << "'.";
+    return false;
+  }
+
+  QStringList options = spec.mid(4).split(",");
+  _radio = RadioInfo::byKey(options.takeFirst().simplified().toLower());
+  if (! _radio.isValid()) {
+    errMsg(err) << "Cannot simulate '" << spec << "': Unknown radio.";
+    return false;
+  }
+
+  foreach (QString option, options) {
+    QStringList kv = option.split("=");
+    if (2 != kv.size()) {
+      errMsg(err) << "Cannot simulate '" << spec << "': Invalid option '" << option << "'.";
+      return false;
+    }
+    QString key = kv.at(0).simplified().toLower(), value = kv.at(1).simplified();
+    bool ok = true;
+    if ("latency" == key) {
+      _latency = value.toDouble(&ok);
+      ok &= (_latency >= 0);
+    } else if ("bandwidth" == key) {
+      _bandwidth = value.toDouble(&ok);
+      ok &= (_bandwidth >= 0);
+    } else if ("errors" == key) {
+      _errors = value.toDouble(&ok);
+      ok &= ((_errors >= 0) && (_errors <= 1));
+    } else if ("seed" == key) {
+      _random.seed(value.toUInt(&ok));
+    } else if ("fill" == key) {
+      uint fill = value.toUInt(&ok, 0);
+      ok &= (fill < 256);
+      _fill = fill;
+    } else if ("image" == key) {
+      _image = value;
+    } else {
+      errMsg(err) << "Cannot simulate '" << spec << "': Unknown option '" << key << "'.";
+      return false;
+    }
+    if (! ok) {
+      errMsg(err) << "Cannot simulate '" << spec << "': Invalid value '" << value
+                  << "' for option '" << key << "'.";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool
+SimulatedDevice::load(const ErrorStack &err) {
+  if (_image.isEmpty() || (! QFileInfo::exists(_image)))
+    return true;
+
+  DFUFile file;
+  if (! file.read(_image, err)) {
+    errMsg(err) << "Cannot read memory of simulated device from '" << _image << "'.";
+    return false;
+  }
+
+  for (int i=0; i<file.numImages(); i++) {
+    for (int j=0; j<file.image(i).numElements(); j++) {
+      const DFUFile::Element &element = file.image(i).element(j);
+      write(i, element.address(), (const uint8_t *)element.data().constData(), element.data().size());
+    }
+  }
+
+  logDebug() << "Loaded memory of simulated device from '" << _image << "'.";
+  return true;
+}
+
+bool
+SimulatedDevice::isSpecification(const QString &device) {
+  return device.startsWith("sim:");
+}
+
+USBDeviceDescriptor
+SimulatedDevice::descriptor(const QString &spec, const ErrorStack &err) {
+  if (! isSpecification(spec)) {
+    errMsg(err) << "Invalid simulated device '" << spec << "'.";
+    return USBDeviceDescriptor();
+  }
+
+  QString key = spec.mid(4).section(",", 0, 0).simplified().toLower();
+  RadioInfo radio = RadioInfo::byKey(key);
+  if (! radio.isValid()) {
+    errMsg(err) << "Cannot simulate unknown radio '" << key << "'.";
+    return USBDeviceDescriptor();
+  }
+
+  // Only some protocols are simulated
+  if ((AnytoneInterface::interfaceInfo() != radio.interface()) &&
+      (RadioddityInterface::interfaceInfo() != radio.interface()) &&
+      (TyTInterface::interfaceInfo() != radio.interface())) {
+    errMsg(err) << "Cannot simulate " << radio.manufacturer() << " " << radio.name()
+                << ": Protocol not implemented by the simulator.";
+    return USBDeviceDescriptor();
+  }
+
+  return Descriptor(radio.interface(), spec);
+}
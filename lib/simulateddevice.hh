@@ -0,0 +1,118 @@
+#ifndef SIMULATEDDEVICE_HH
+#define SIMULATEDDEVICE_HH
+
+#include <QMap>
+#include <QHash>
+#include <QByteArray>
+#include <QRandomGenerator>
+#include "usbdevice.hh"
+#include "radioinfo.hh"
+#include "errorstack.hh"
+
+/** Implements the memory and timing model of a simulated radio.
+ *
+ * Simulated devices allow to test and benchmark the complete transfer path (radio, interface and
+ * protocol) without any hardware attached. The protocol-specific parts are implemented by the
+ * simulator classes (i.e., @c AnytoneSimulator, @c RadiodditySimulator and @c TyTSimulator), which
+ * re-implement the lowest transport layer of the respective interface and emulate the device
+ * side of the protocol frame-by-frame. This class holds the memory of the simulated device and
+ * implements the latency, bandwidth and error model.
+ *
+ * A simulated device is specified by a string of the form
+ * @code
+ * sim:RADIO[,OPTION=VALUE]...
+ * @endcode
+ * where @c RADIO is the key of the radio to simulate (see @c RadioInfo::byKey) and the options
+ * are
+ *   - @c latency Round-trip latency of each request in ms (default 0).
+ *   - @c bandwidth Bandwidth of the link in bytes per second, 0 means unlimited (default 0).
+ *   - @c errors Probability of loosing a request, that is, a timeout (default 0).
+ *   - @c seed Seed of the random number generator used for the error injection (default 0).
+ *   - @c fill Value of memory never written (default 0).
+ *   - @c image DFU file backing the memory. The file is read (if it exists) when the device is
+ *     opened and written whenever the radio leaves the program mode. The images of the DFU file
+ *     represent the memory banks of the device. Hence, binary codeplugs read using dmrconf can be
+ *     used directly.
+ *
+ * @ingroup rif */
+class SimulatedDevice
+{
+public:
+  /** Specialization of the device descriptor for simulated devices. The descriptor carries the
+   * interface information of the simulated radio, hence the usual radio detection applies. */
+  class Descriptor: public USBDeviceDescriptor {
+  public:
+    /** Constructor from interface info and device specification. */
+    Descriptor(const USBDeviceInfo &info, const QString &spec);
+  };
+
+public:
+  /** Constructs a simulated device for the given descriptor.
+   * Use @c isValid to check whether the specification was parsed successfully. */
+  explicit SimulatedDevice(const USBDeviceDescriptor &descr, const ErrorStack &err=ErrorStack());
+  /** Destructor. */
+  virtual ~SimulatedDevice();
+
+  /** Returns @c true if the device was set up successfully. */
+  bool isValid() const;
+  /** Returns the simulated radio. */
+  const RadioInfo &radio() const;
+
+  /** Returns the request latency in ms. */
+  double latency() const;
+  /** Returns the bandwidth in bytes per second. */
+  double bandwidth() const;
+  /** Returns the probability of a lost request. */
+  double errorRate() const;
+
+  /** Simulates the transfer of a single request (and its response) of the given total size.
+   * That is, blocks for the configured latency and transmission time. Returns @c false if the
+   * request gets lost due to the error injection. */
+  bool transfer(unsigned int nbytes);
+
+  /** Reads @c n bytes from the specified bank and address. */
+  void read(uint32_t bank, uint32_t addr, uint8_t *data, unsigned int n) const;
+  /** Writes @c n bytes to the specified bank and address. */
+  void write(uint32_t bank, uint32_t addr, const uint8_t *data, unsigned int n);
+  /** Erases @c n bytes at the specified bank and address. That is, sets them to 0xff. */
+  void erase(uint32_t bank, uint32_t addr, unsigned int n);
+
+  /** Writes the memory into the image file, if one is specified. */
+  bool save(const ErrorStack &err=ErrorStack());
+
+public:
+  /** Returns @c true if the given device string specifies a simulated device. */
+  static bool isSpecification(const QString &device);
+  /** Creates a descriptor for the simulated device specified by @c spec. If the specification
+   * is invalid or the radio cannot be simulated, an invalid descriptor is returned. */
+  static USBDeviceDescriptor descriptor(const QString &spec, const ErrorStack &err=ErrorStack());
+
+protected:
+  /** Parses the device specification. */
+  bool parse(const QString &spec, const ErrorStack &err);
+  /** Reads the memory from the image file. */
+  bool load(const ErrorStack &err);
+
+protected:
+  /** Size of the memory pages, the memory is allocated on write with this granularity. */
+  static const uint32_t PageSize = 0x1000;
+
+  /** The simulated radio. */
+  RadioInfo _radio;
+  /** Request latency in ms. */
+  double _latency;
+  /** Bandwidth in bytes per second. */
+  double _bandwidth;
+  /** Probability of loosing a request. */
+  double _errors;
+  /** Value of unwritten memory. */
+  uint8_t _fill;
+  /** The image file, may be empty. */
+  QString _image;
+  /** Random number generator for the error injection. */
+  QRandomGenerator _random;
+  /** The memory, maps bank and page address to the page content. */
+  QHash<uint32_t, QMap<uint32_t, QByteArray>> _memory;
+};
+
+#endif // SIMULATEDDEVICE_HH
@@ -2,6 +2,7 @@
 #include <QStandardPaths>
 #include <QFileInfo>
 #include "logger.hh"
+#include "dmrcompletionmodel.hh"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QNetworkReply>
@@ -28,7 +29,7 @@ TalkGroupDatabase::TalkGroup::TalkGroup(const QString &name, unsigned number)
  * Implementation of TalkGroupDatabase
  * ********************************************************************************************* */
 TalkGroupDatabase::TalkGroupDatabase(unsigned updatePeriodDays, QObject *parent)
-  : QAbstractTableModel(parent), _talkgroups(), _network()
+  : QAbstractTableModel(parent), _talkgroups(), _network(), _completion(nullptr)
 {
   connect(&_network, SIGNAL(finished(QNetworkReply*)),
           this, SLOT(downloadFinished(QNetworkReply*)));
@@ -58,6 +59,23 @@ TalkGroupDatabase::talkgroup(int index) const {
   return _talkgroups[index];
 }
 
+DMRCompletionModel *
+TalkGroupDatabase::completionModel() {
+  if (nullptr == _completion) {
+    _completion = new DMRCompletionModel(this);
+    updateCompletionModel();
+  }
+  return _completion;
+}
+
+void
+TalkGroupDatabase::updateCompletionModel() {
+  _completion->clear();
+  foreach (const TalkGroup &tg, _talkgroups)
+    _completion->add(tg.id, tg.name, tr("%1 (%2)").arg(tg.name).arg(tg.id));
+  _completion->build();
+}
+
 void
 TalkGroupDatabase::download() {
   QUrl url("https://api.brandmeister.network/v2/talkgroup/");
@@ -140,6 +158,9 @@ TalkGroupDatabase::load(const QString &filename) {
   logDebug() << "Loaded talk group database with " << _talkgroups.size()
              << " entries from " << filename << ".";
 
+  if (_completion)
+    updateCompletionModel();
+
   emit loaded();
   return true;
 }
@@ -4,6 +4,8 @@
 #include <QAbstractTableModel>
 #include <QNetworkAccessManager>
 
+class DMRCompletionModel;
+
 /** Downloads, periodically updates and provides a list of talk group IDs and their names.
  *
  * @ingroup utils */
@@ -38,6 +40,10 @@ public:
   /** Returns the talk group entry at the given index. */
   TalkGroup talkgroup(int index) const;
 
+  /** Returns a completion model for the names and IDs of all talk groups. The model is created on
+   * first use and updated whenever the database gets loaded. */
+  DMRCompletionModel *completionModel();
+
   /** Loads all entries from the downloaded talk group db. */
   bool load();
   /** Loads all entries from the talk group db at the specified location. */
@@ -64,11 +70,17 @@ private slots:
   /** Gets called whenever the download is complete. */
   void downloadFinished(QNetworkReply *reply);
 
+protected:
+  /** Fills the completion model with all talk groups. */
+  void updateCompletionModel();
+
 protected:
   /** Holds all talk groups as id->name table. */
   QVector<TalkGroup>    _talkgroups;
   /** The network access used for downloading. */
   QNetworkAccessManager _network;
+  /** The completion model, created on demand. */
+  DMRCompletionModel   *_completion;
 };
 
 #endif // TALKGROUPDATABASE_HH
@@ -0,0 +1,252 @@
+#include "transferstatistics.hh"
+#include <QJsonArray>
+
+
+/* ********************************************************************************************* *
+ * Implementation of TransferStatistics::Request
+ * ********************************************************************************************* */
+TransferStatistics::Request::Request(TransferStatistics *stats, unsigned int sent, unsigned int received)
+  : _stats(stats), _sent(sent), _received(received), _timer(), _done(false)
+{
+  if (nullptr == _stats)
+    return;
+  _stats->started();
+  _timer.start();
+}
+
+TransferStatistics::Request::~Request() {
+  if (_done || (nullptr == _stats))
+    return;
+  _stats->addError();
+}
+
+void
+TransferStatistics::Request::completed() {
+  if (_done || (nullptr == _stats))
+    return;
+  _done = true;
+  _stats->addRequest(_sent, _received, _timer.nsecsElapsed());
+}
+
+void
+TransferStatistics::Request::completed(unsigned int received) {
+  _received = received;
+  completed();
+}
+
+void
+TransferStatistics::Request::timeout() {
+  if (_done || (nullptr == _stats))
+    return;
+  _done = true;
+  _stats->addTimeout();
+}
+
+void
+TransferStatistics::Request::retry() {
+  if (nullptr == _stats)
+    return;
+  _stats->addRetry();
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of TransferStatistics
+ * ********************************************************************************************* */
+TransferStatistics::TransferStatistics()
+{
+  reset();
+}
+
+void
+TransferStatistics::reset() {
+  _requests = 0;
+  _bytesSent = _bytesReceived = 0;
+  _timeouts = _retries = _errors = 0;
+  _waitTime = _busyTime = 0;
+  _minLatency = _maxLatency = 0;
+  _timer.invalidate();
+  _duration = 0;
+  for (unsigned int i=0; i<HistogramBins; i++)
+    _histogram[i] = 0;
+}
+
+void
+TransferStatistics::started() {
+  if (! _timer.isValid())
+    _timer.start();
+}
+
+void
+TransferStatistics::addRequest(unsigned int sent, unsigned int received, qint64 ns) {
+  started();
+
+  if ((0 == _requests) || (ns < _minLatency))
+    _minLatency = ns;
+  if ((0 == _requests) || (ns > _maxLatency))
+    _maxLatency = ns;
+
+  _requests++;
+  _bytesSent += sent;
+  _bytesReceived += received;
+  _busyTime += ns;
+  _duration = _timer.nsecsElapsed();
+
+  // Find bin, bin i holds all latencies < 2^i us
+  qint64 us = ns/1000;
+  unsigned int bin = 0;
+  while ((bin < (HistogramBins-1)) && (us >= (qint64(1)<<bin)))
+    bin++;
+  _histogram[bin]++;
+}
+
+void
+TransferStatistics::addTimeout() {
+  _timeouts++;
+  if (_timer.isValid())
+    _duration = _timer.nsecsElapsed();
+}
+
+void
+TransferStatistics::addRetry() {
+  _retries++;
+}
+
+void
+TransferStatistics::addError() {
+  _errors++;
+  if (_timer.isValid())
+    _duration = _timer.nsecsElapsed();
+}
+
+void
+TransferStatistics::addWait(qint64 ns) {
+  _waitTime += ns;
+}
+
+unsigned int
+TransferStatistics::requests() const {
+  return _requests;
+}
+
+quint64
+TransferStatistics::bytesSent() const {
+  return _bytesSent;
+}
+
+quint64
+TransferStatistics::bytesReceived() const {
+  return _bytesReceived;
+}
+
+unsigned int
+TransferStatistics::timeouts() const {
+  return _timeouts;
+}
+
+unsigned int
+TransferStatistics::retries() const {
+  return _retries;
+}
+
+unsigned int
+TransferStatistics::errors() const {
+  return _errors;
+}
+
+qint64
+TransferStatistics::waitTime() const {
+  return _waitTime;
+}
+
+qint64
+TransferStatistics::duration() const {
+  return _duration;
+}
+
+qint64
+TransferStatistics::busyTime() const {
+  return _busyTime;
+}
+
+qint64
+TransferStatistics::minLatency() const {
+  return _minLatency;
+}
+
+qint64
+TransferStatistics::maxLatency() const {
+  return _maxLatency;
+}
+
+qint64
+TransferStatistics::meanLatency() const {
+  if (0 == _requests)
+    return 0;
+  return _busyTime/_requests;
+}
+
+double
+TransferStatistics::throughput() const {
+  if (0 == _duration)
+    return 0;
+  return double(_bytesSent+_bytesReceived)/(double(_duration)/1e9);
+}
+
+unsigned int
+TransferStatistics::histogram(unsigned int i) const {
+  if (i >= HistogramBins)
+    return 0;
+  return _histogram[i];
+}
+
+QJsonObject
+TransferStatistics::toJSON() const {
+  QJsonObject obj;
+  obj.insert("requests", qint64(_requests));
+  obj.insert("bytes_sent", qint64(_bytesSent));
+  obj.insert("bytes_received", qint64(_bytesReceived));
+  obj.insert("timeouts", qint64(_timeouts));
+  obj.insert("retries", qint64(_retries));
+  obj.insert("errors", qint64(_errors));
+  obj.insert("duration_us", _duration/1000);
+  obj.insert("busy_us", _busyTime/1000);
+  obj.insert("wait_us", _waitTime/1000);
+  obj.insert("throughput_bps", throughput());
+
+  QJsonObject latency;
+  latency.insert("min_us", _minLatency/1000);
+  latency.insert("mean_us", meanLatency()/1000);
+  latency.insert("max_us", _maxLatency/1000);
+
+  QJsonArray hist;
+  for (unsigned int i=0; i<HistogramBins; i++) {
+    if (0 == _histogram[i])
+      continue;
+    QJsonObject bin;
+    if (i < (HistogramBins-1))
+      bin.insert("below_us", qint64(1)<<i);
+    else
+      bin.insert("above_us", qint64(1)<<(i-1));
+    bin.insert("count", qint64(_histogram[i]));
+    hist.append(bin);
+  }
+  latency.insert("histogram", hist);
+  obj.insert("latency", latency);
+
+  return obj;
+}
+
+QString
+TransferStatistics::format() const {
+  return QString("%1 requests, %2 bytes in %3 s (%4 kB/s), latency %5/%6/%7 ms (min/mean/max), "
+                 "%8 timeouts, %9 retries, %10 errors")
+      .arg(_requests)
+      .arg(_bytesSent+_bytesReceived)
+      .arg(double(_duration)/1e9, 0, 'f', 2)
+      .arg(throughput()/1e3, 0, 'f', 2)
+      .arg(double(_minLatency)/1e6, 0, 'f', 2)
+      .arg(double(meanLatency())/1e6, 0, 'f', 2)
+      .arg(double(_maxLatency)/1e6, 0, 'f', 2)
+      .arg(_timeouts).arg(_retries).arg(_errors);
+}
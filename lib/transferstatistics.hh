@@ -0,0 +1,165 @@
+#ifndef TRANSFERSTATISTICS_HH
+#define TRANSFERSTATISTICS_HH
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+
+/** Collects statistics about the transfers performed through a @c RadioInterface.
+ *
+ * Every request sent to the device (e.g., a single read or write command and its response) gets
+ * recorded with the number of bytes send and received as well as the round-trip time. The
+ * latencies are collected within a logarithmic histogram. Additionally, timeouts, retries, errors
+ * and the time spent waiting for the device (e.g., polling the DFU state) are counted.
+ *
+ * The statistics can be serialized into a JSON object using @c toJSON or summarized in a short
+ * human-readable string using @c format.
+ *
+ * @ingroup rif */
+class TransferStatistics
+{
+public:
+  /** Number of latency histogram bins. Bin @c i contains all requests with a round-trip time
+   * below 2^i micro seconds (and above 2^(i-1)). The last bin contains all remaining requests. */
+  static const unsigned int HistogramBins = 24;
+
+  /** Helper to time a single request.
+   *
+   * The request gets recorded, once @c completed is called. If the instance gets destroyed
+   * before the request completed, the request is counted as failed.
+   * @code
+   * TransferStatistics::Request request(&_statistics, sizeof(req), sizeof(resp));
+   * if (! send(req))
+   *   return false;      // <- recorded as error
+   * if (! waitForResponse()) {
+   *   request.timeout(); // <- recorded as timeout
+   *   return false;
+   * }
+   * request.completed(); // <- recorded as successful request
+   * @endcode */
+  class Request
+  {
+  public:
+    /** Starts timing a request.
+     * @param stats Specifies the statistics to update, may be @c nullptr.
+     * @param sent Specifies the number of bytes sent with this request.
+     * @param received Specifies the number of bytes expected to receive. */
+    Request(TransferStatistics *stats, unsigned int sent=0, unsigned int received=0);
+    /** Destructor, records an error if the request was not completed. */
+    ~Request();
+
+    /** Marks the request as being completed successfully. */
+    void completed();
+    /** Marks the request as being completed successfully, having received the specified number
+     * of bytes. */
+    void completed(unsigned int received);
+    /** Marks the request as being timed out. */
+    void timeout();
+    /** Records a retry of this request. */
+    void retry();
+
+  protected:
+    /** A weak reference to the statistics. */
+    TransferStatistics *_stats;
+    /** Bytes sent. */
+    unsigned int _sent;
+    /** Bytes received. */
+    unsigned int _received;
+    /** Measures the round-trip time. */
+    QElapsedTimer _timer;
+    /** If @c true, the request has been recorded already. */
+    bool _done;
+  };
+
+public:
+  /** Empty constructor. */
+  TransferStatistics();
+
+  /** Resets all statistics. */
+  void reset();
+
+  /** Records a completed request.
+   * @param sent Number of bytes sent to the device.
+   * @param received Number of bytes received from the device.
+   * @param ns The round-trip time in nano seconds. */
+  void addRequest(unsigned int sent, unsigned int received, qint64 ns);
+  /** Records a timeout. */
+  void addTimeout();
+  /** Records a retry. */
+  void addRetry();
+  /** Records a failed request. */
+  void addError();
+  /** Records the time spent waiting for the device in nano seconds (e.g., sleeps or polling the
+   * device state). */
+  void addWait(qint64 ns);
+
+  /** Returns the number of completed requests. */
+  unsigned int requests() const;
+  /** Returns the number of bytes sent. */
+  quint64 bytesSent() const;
+  /** Returns the number of bytes received. */
+  quint64 bytesReceived() const;
+  /** Returns the number of timeouts. */
+  unsigned int timeouts() const;
+  /** Returns the number of retries. */
+  unsigned int retries() const;
+  /** Returns the number of failed requests. */
+  unsigned int errors() const;
+  /** Returns the time spent waiting for the device in nano seconds. */
+  qint64 waitTime() const;
+
+  /** Returns the time in nano seconds between the start of the first and the end of the last
+   * request. */
+  qint64 duration() const;
+  /** Returns the accumulated round-trip times of all requests in nano seconds. */
+  qint64 busyTime() const;
+  /** Returns the minimum round-trip time in nano seconds. */
+  qint64 minLatency() const;
+  /** Returns the maximum round-trip time in nano seconds. */
+  qint64 maxLatency() const;
+  /** Returns the mean round-trip time in nano seconds. */
+  qint64 meanLatency() const;
+  /** Returns the throughput in bytes per second (sent and received). */
+  double throughput() const;
+  /** Returns the number of requests in the i-th latency bin. */
+  unsigned int histogram(unsigned int i) const;
+
+  /** Serializes the statistics into a JSON object. */
+  QJsonObject toJSON() const;
+  /** Returns a brief human-readable summary. */
+  QString format() const;
+
+protected:
+  /** Marks the start of a request, used to measure the total duration. */
+  void started();
+
+protected:
+  /** Number of completed requests. */
+  unsigned int _requests;
+  /** Bytes sent. */
+  quint64 _bytesSent;
+  /** Bytes received. */
+  quint64 _bytesReceived;
+  /** Number of timeouts. */
+  unsigned int _timeouts;
+  /** Number of retries. */
+  unsigned int _retries;
+  /** Number of failed requests. */
+  unsigned int _errors;
+  /** Time spent waiting in ns. */
+  qint64 _waitTime;
+  /** Sum over all round-trip times in ns. */
+  qint64 _busyTime;
+  /** Minimum round-trip time in ns. */
+  qint64 _minLatency;
+  /** Maximum round-trip time in ns. */
+  qint64 _maxLatency;
+  /** Timer started with the first request. */
+  QElapsedTimer _timer;
+  /** End of the last request relative to the start of the first in ns. */
+  qint64 _duration;
+  /** Latency histogram. */
+  unsigned int _histogram[HistogramBins];
+};
+
+#endif // TRANSFERSTATISTICS_HH
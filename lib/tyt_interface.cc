@@ -6,16 +6,37 @@
 
 #define USB_VID 0x0483
 #define USB_PID 0xdf11
+#define BSIZE   1024
 
 
 TyTInterface::TyTInterface(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
   : DFUSEDevice(descr, err, 16, parent), RadioInterface()
 {
+  // Record DFU transfers within the statistics of this interface
+  _stats = &_statistics;
+
   if (! DFUDevice::isOpen()) {
     errMsg(err) << "Cannot open TyTInterface.";
     return;
   }
 
+  initialize(descr, err);
+}
+
+TyTInterface::TyTInterface(QObject *parent)
+  : DFUSEDevice(16, parent), RadioInterface()
+{
+  // Record DFU transfers within the statistics of this interface
+  _stats = &_statistics;
+}
+
+TyTInterface::~TyTInterface() {
+  if (isOpen())
+    close();
+}
+
+void
+TyTInterface::initialize(const USBDeviceDescriptor &descr, const ErrorStack &err) {
   // Enter Programming Mode.
   if (wait_idle()) {
     errMsg(err) << "Device not ready. Close device.";
@@ -57,11 +78,6 @@ TyTInterface::TyTInterface(const USBDeviceDescriptor &descr, const ErrorStack &e
              << " at " << descr.description() << ".";
 }
 
-TyTInterface::~TyTInterface() {
-  if (isOpen())
-    close();
-}
-
 USBDeviceInfo
 TyTInterface::interfaceInfo() {
   return USBDeviceInfo(USBDeviceInfo::Class::DFU, USB_VID, USB_PID);
@@ -101,6 +117,7 @@ TyTInterface::md380_command(uint8_t a, uint8_t b, const ErrorStack &err)
     return error;
 
   usleep(100000);
+  _statistics.addWait(100000000);
   return wait_idle();
 }
 
@@ -135,7 +152,11 @@ TyTInterface::erase_block(uint32_t address, const ErrorStack &err)
   if (int error = download(0, cmd, 5, err))
     return error;
 
-  wait_idle();
+  // Wait for the erase to finish, reports an error if the device failed to erase the block
+  if (int error = wait_download(0, err)) {
+    errMsg(err) << "Cannot erase block at " << QString::number(address, 16) << "h.";
+    return error;
+  }
 
   return 0;
 }
@@ -172,7 +193,8 @@ TyTInterface::erase(unsigned start, unsigned size, void(*progress)(unsigned, voi
   size = end-start;
 
   for (unsigned i=0; i<size; i+=0x10000) {
-    erase_block(start+i, err);
+    if (erase_block(start+i, err))
+      return false;
     if (progress)
       progress((i*100)/size, ctx);
   }
@@ -238,6 +260,40 @@ TyTInterface::write_finish(const ErrorStack &err) {
   return true;
 }
 
+bool
+TyTInterface::readRange(uint32_t addr, uint8_t *data, unsigned nbytes,
+                        void (*progress)(unsigned, void *), void *ctx, const ErrorStack &err)
+{
+  if (nullptr == data) {
+    errMsg(err) << "Cannot write data into nullptr!";
+    return false;
+  }
+  if ((addr % BSIZE) || (nbytes % BSIZE)) {
+    errMsg(err) << "Cannot read range " << QString::number(addr, 16) << "h of size "
+                << nbytes << ": Not aligned with block size " << BSIZE << ".";
+    return false;
+  }
+
+  return uploadBlocks(addr/BSIZE+2, data, BSIZE, nbytes/BSIZE, progress, ctx, err);
+}
+
+bool
+TyTInterface::writeRange(uint32_t addr, const uint8_t *data, unsigned nbytes, bool skipErased,
+                         void (*progress)(unsigned, void *), void *ctx, const ErrorStack &err)
+{
+  if (nullptr == data) {
+    errMsg(err) << "Cannot read data from nullptr!";
+    return false;
+  }
+  if ((addr % BSIZE) || (nbytes % BSIZE)) {
+    errMsg(err) << "Cannot write range " << QString::number(addr, 16) << "h of size "
+                << nbytes << ": Not aligned with block size " << BSIZE << ".";
+    return false;
+  }
+
+  return downloadBlocks(addr/BSIZE+2, data, BSIZE, nbytes/BSIZE, skipErased, progress, ctx, err);
+}
+
 
 bool
 TyTInterface::reboot(const ErrorStack &err) {
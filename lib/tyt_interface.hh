@@ -71,6 +71,13 @@ public:
   /** Destructor. */
   ~TyTInterface();
 
+protected:
+  /** Constructs an interface without any connection to a device. Used by the simulator. */
+  explicit TyTInterface(QObject *parent);
+  /** Enters the program mode and identifies the connected radio. */
+  void initialize(const USBDeviceDescriptor &descr, const ErrorStack &err);
+
+public:
   bool isOpen() const;
   RadioInfo identifier(const ErrorStack &err=ErrorStack());
   void close();
@@ -86,6 +93,20 @@ public:
   /** Erases a memory section at @c start of size @c size. */
   bool erase(unsigned start, unsigned size, void (*progress)(unsigned, void *)=nullptr, void *ctx=nullptr, const ErrorStack &err=ErrorStack());
 
+  /** Reads a memory range at @c addr of size @c nbytes. Address and size must be aligned with
+   * the block size of 1024 bytes. The optional @c progress callback gets called with the number
+   * of bytes read so far. */
+  bool readRange(uint32_t addr, uint8_t *data, unsigned nbytes,
+                 void (*progress)(unsigned, void *)=nullptr, void *ctx=nullptr,
+                 const ErrorStack &err=ErrorStack());
+  /** Writes a memory range at @c addr of size @c nbytes. Address and size must be aligned with
+   * the block size of 1024 bytes. If @c skipErased is @c true, blocks only containing 0xff are
+   * skipped. This is only safe, if the memory range has been erased before. The optional
+   * @c progress callback gets called with the number of bytes processed so far. */
+  bool writeRange(uint32_t addr, const uint8_t *data, unsigned nbytes, bool skipErased=false,
+                  void (*progress)(unsigned, void *)=nullptr, void *ctx=nullptr,
+                  const ErrorStack &err=ErrorStack());
+
 public:
   /** Returns some information about the interface. */
   static USBDeviceInfo interfaceInfo();
@@ -5,6 +5,26 @@
 
 #define BSIZE 1024
 
+/** Context of the progress callback for bulk transfers. */
+struct TransferProgress {
+  TyTRadio *radio;  ///< The radio emitting the progress signals.
+  bool upload;      ///< If @c true, emits upload progress, otherwise download progress.
+  size_t done;      ///< Bytes transferred before the current range.
+  size_t total;     ///< Total bytes to transfer.
+  unsigned offset;  ///< Progress offset in percent.
+  unsigned scale;   ///< Progress scale in percent.
+};
+
+static void
+reportProgress(unsigned nbytes, void *ctx) {
+  TransferProgress *progress = (TransferProgress *)ctx;
+  int percent = progress->offset + float((progress->done+nbytes)*progress->scale)/progress->total;
+  if (progress->upload)
+    emit progress->radio->uploadProgress(percent);
+  else
+    emit progress->radio->downloadProgress(percent);
+}
+
 
 TyTRadio::TyTRadio(TyTInterface *device, QObject *parent)
   : Radio(parent), _dev(device), _codeplugFlags(), _config(nullptr)
@@ -26,6 +46,13 @@ TyTRadio::~TyTRadio() {
   logDebug() << "Destructed TyT radio.";
 }
 
+const TransferStatistics *
+TyTRadio::statistics() const {
+  if (nullptr == _dev)
+    return nullptr;
+  return &_dev->statistics();
+}
+
 bool
 TyTRadio::startDownload(bool blocking, const ErrorStack &err) {
   if (StatusIdle != _task)
@@ -171,18 +198,15 @@ TyTRadio::download() {
   }
 
   // Then download codeplug
-  size_t bcount = 0;
+  TransferProgress progress = {this, false, 0, totb*BSIZE, 0, 100};
   for (int n=0; n<codeplug().image(0).numElements(); n++) {
     unsigned addr = codeplug().image(0).element(n).address();
     unsigned size = codeplug().image(0).element(n).data().size();
-    unsigned b0 = addr/BSIZE, nb = size/BSIZE;
-    for (unsigned b=0; b<nb; b++, bcount++) {
-      if (! _dev->read(0, (b0+b)*BSIZE, codeplug().data((b0+b)*BSIZE), BSIZE, _errorStack)) {
-        errMsg(_errorStack) << "Cannot download codeplug.";
-        return false;
-      }
-      emit downloadProgress(float(bcount*100)/totb);
+    if (! _dev->readRange(addr, codeplug().data(addr), size, reportProgress, &progress, _errorStack)) {
+      errMsg(_errorStack) << "Cannot download codeplug.";
+      return false;
     }
+    progress.done += size;
   }
 
   return true;
@@ -201,20 +225,17 @@ TyTRadio::upload() {
 
   size_t totb = codeplug().memSize();
 
-  size_t bcount = 0;
   // If codeplug gets updated, download codeplug from device first:
   if (_codeplugFlags.updateCodePlug) {
+    TransferProgress progress = {this, true, 0, totb, 0, 50};
     for (int n=0; n<codeplug().image(0).numElements(); n++) {
       unsigned addr = codeplug().image(0).element(n).address();
       unsigned size = codeplug().image(0).element(n).data().size();
-      unsigned b0 = addr/BSIZE, nb = size/BSIZE;
-      for (unsigned b=0; b<nb; b++, bcount+=BSIZE) {
-        if (! _dev->read(0, (b0+b)*BSIZE, codeplug().data((b0+b)*BSIZE), BSIZE, _errorStack)) {
-          errMsg(_errorStack) << "Cannot upload codeplug.";
-          return false;
-        }
-        emit uploadProgress(float(bcount*50)/totb);
+      if (! _dev->readRange(addr, codeplug().data(addr), size, reportProgress, &progress, _errorStack)) {
+        errMsg(_errorStack) << "Cannot upload codeplug.";
+        return false;
       }
+      progress.done += size;
     }
   }
 
@@ -223,24 +244,25 @@ TyTRadio::upload() {
   codeplug().encode(_config, _codeplugFlags);
 
   // then erase memory
-  for (int i=0; i<codeplug().image(0).numElements(); i++)
-    _dev->erase(codeplug().image(0).element(i).address(), codeplug().image(0).element(i).memSize(),
-                nullptr, nullptr, _errorStack);
+  for (int i=0; i<codeplug().image(0).numElements(); i++) {
+    if (! _dev->erase(codeplug().image(0).element(i).address(), codeplug().image(0).element(i).memSize(),
+                      nullptr, nullptr, _errorStack)) {
+      errMsg(_errorStack) << "Cannot upload codeplug: Cannot erase memory.";
+      return false;
+    }
+  }
 
   logDebug() << "Upload " << codeplug().image(0).numElements() << " elements.";
-  // then, upload modified codeplug
-  bcount = 0;
+  // then, upload modified codeplug, the memory has been erased, hence erased blocks are skipped
+  TransferProgress progress = {this, true, 0, totb, 50, 50};
   for (int n=0; n<codeplug().image(0).numElements(); n++) {
     unsigned addr = codeplug().image(0).element(n).address();
     unsigned size = codeplug().image(0).element(n).memSize();
-    unsigned b0 = addr/BSIZE, nb = size/BSIZE;
-    for (size_t b=0; b<nb; b++,bcount+=BSIZE) {
-      if (! _dev->write(0, (b0+b)*BSIZE, codeplug().data((b0+b)*BSIZE), BSIZE, _errorStack)) {
-        errMsg(_errorStack) << "Cannot upload codeplug.";
-        return false;
-      }
-      emit uploadProgress(50+float(bcount*50)/totb);
+    if (! _dev->writeRange(addr, codeplug().data(addr), size, true, reportProgress, &progress, _errorStack)) {
+      errMsg(_errorStack) << "Cannot upload codeplug.";
+      return false;
     }
+    progress.done += size;
   }
 
   return true;
@@ -260,10 +282,13 @@ TyTRadio::uploadCallsigns() {
 
   // then erase memory
   logDebug() << "Erase memory section for call-sign DB.";
-  _dev->erase(callsignDB()->image(0).element(0).address(),
-              callsignDB()->image(0).element(0).memSize(),
-              [](unsigned percent, void *ctx) { emit ((TyTRadio *)ctx)->uploadProgress(percent/2); },
-              this, _errorStack);
+  if (! _dev->erase(callsignDB()->image(0).element(0).address(),
+                    callsignDB()->image(0).element(0).memSize(),
+                    [](unsigned percent, void *ctx) { emit ((TyTRadio *)ctx)->uploadProgress(percent/2); },
+                    this, _errorStack)) {
+    errMsg(_errorStack) << "Cannot upload callsign db: Cannot erase memory.";
+    return false;
+  }
 
   logDebug() << "Upload " << callsignDB()->image(0).numElements() << " elements.";
   // Total amount of data to transfer
@@ -271,13 +296,10 @@ TyTRadio::uploadCallsigns() {
   // Upload callsign DB
   unsigned addr = callsignDB()->image(0).element(0).address();
   unsigned size = callsignDB()->image(0).element(0).memSize();
-  unsigned b0 = addr/BSIZE, nb = size/BSIZE;
-  for (size_t b=0, bcount=0; b<nb; b++,bcount+=BSIZE) {
-    if (! _dev->write(0, (b0+b)*BSIZE, callsignDB()->data((b0+b)*BSIZE), BSIZE, _errorStack)) {
-      errMsg(_errorStack) << "Cannot upload codeplug.";
-      return false;
-    }
-    emit uploadProgress(50+float(bcount*50)/totb);
+  TransferProgress progress = {this, true, 0, totb, 50, 50};
+  if (! _dev->writeRange(addr, callsignDB()->data(addr), size, true, reportProgress, &progress, _errorStack)) {
+    errMsg(_errorStack) << "Cannot upload codeplug.";
+    return false;
   }
 
   return true;
@@ -21,6 +21,8 @@ public:
 
   virtual ~TyTRadio();
 
+  const TransferStatistics *statistics() const;
+
 public slots:
   /** Starts the download of the codeplug and derives the generic configuration from it. */
   bool startDownload(bool blocking=false, const ErrorStack &err=ErrorStack());
@@ -0,0 +1,152 @@
+#include "tyt_simulator.hh"
+#include "logger.hh"
+#include <QtEndian>
+
+
+/* ********************************************************************************************* *
+ * Implementation of TyTSimulator
+ * ********************************************************************************************* */
+TyTSimulator::TyTSimulator(const USBDeviceDescriptor &descr, const ErrorStack &err, QObject *parent)
+  : TyTInterface(parent), _device(descr, err), _open(false), _address(0), _identify(false)
+{
+  if (! _device.isValid()) {
+    errMsg(err) << "Cannot open " << descr.description() << ".";
+    return;
+  }
+
+  _open = true;
+  initialize(descr, err);
+}
+
+TyTSimulator::~TyTSimulator() {
+  if (_open)
+    close();
+}
+
+bool
+TyTSimulator::isOpen() const {
+  return _open && _ident.isValid();
+}
+
+void
+TyTSimulator::close() {
+  if (_open)
+    TyTInterface::close();
+  _open = false;
+}
+
+bool
+TyTSimulator::reboot(const ErrorStack &err) {
+  if (! _open)
+    return false;
+
+  if (wait_idle())
+    return false;
+
+  unsigned char cmd[2] = { 0x91, 0x05 };
+  return 0 == download(0, cmd, 2, err);
+}
+
+int
+TyTSimulator::control_transfer(uint8_t requestType, uint8_t request, uint16_t value,
+                               uint8_t *data, uint16_t len)
+{
+  Q_UNUSED(requestType);
+
+  if (! _open)
+    return LIBUSB_ERROR_NO_DEVICE;
+
+  // Every control transfer consists of the setup packet and the data stage
+  if (! _device.transfer(8+len))
+    return LIBUSB_ERROR_TIMEOUT;
+
+  switch (request) {
+  case REQUEST_DNLOAD:
+    return simulateDownload(value, data, len);
+  case REQUEST_UPLOAD:
+    return simulateUpload(value, data, len);
+  case REQUEST_GETSTATUS:
+    if (6 > len)
+      return LIBUSB_ERROR_OVERFLOW;
+    // status OK, no poll timeout, always idle
+    memset(data, 0, 6);
+    data[4] = dfuIDLE;
+    return 6;
+  case REQUEST_GETSTATE:
+    if (1 > len)
+      return LIBUSB_ERROR_OVERFLOW;
+    data[0] = dfuIDLE;
+    return 1;
+  case REQUEST_DETACH:
+  case REQUEST_CLRSTATUS:
+  case REQUEST_ABORT:
+    return 0;
+  }
+
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int
+TyTSimulator::simulateDownload(uint16_t block, const uint8_t *data, uint16_t len) {
+  if (1 == block)
+    return LIBUSB_ERROR_INVALID_PARAM;
+
+  if (block > 1) {
+    _device.write(0, _address + (block-2)*len, data, len);
+    return len;
+  }
+
+  // Leave DFU mode, persist memory
+  if (0 == len)
+    return _device.save() ? 0 : LIBUSB_ERROR_IO;
+
+  // Commands written to block 0
+  switch (data[0]) {
+  case 0x21:
+    if (5 != len)
+      return LIBUSB_ERROR_INVALID_PARAM;
+    _address = qFromLittleEndian<uint32_t>(data+1);
+    break;
+  case 0x41:
+    // Mass erase (len=1) is not simulated
+    if (5 == len)
+      _device.erase(0, qFromLittleEndian<uint32_t>(data+1), 0x10000);
+    break;
+  case 0xa2:
+    _identify = true;
+    break;
+  default:
+    // Program mode, reboot, etc. are just acknowledged
+    break;
+  }
+
+  return len;
+}
+
+int
+TyTSimulator::simulateUpload(uint16_t block, uint8_t *data, uint16_t len) {
+  if (1 == block)
+    return LIBUSB_ERROR_INVALID_PARAM;
+
+  if (block > 1) {
+    _device.read(0, _address + (block-2)*len, data, len);
+    return len;
+  }
+
+  // Response to the last command
+  memset(data, 0, len);
+  if (_identify) {
+    QByteArray ident;
+    switch (_device.radio().id()) {
+    case RadioInfo::MD390: ident = "MD390"; break;
+    case RadioInfo::UV390: ident = "MD-UV390"; break;
+    case RadioInfo::MD2017: ident = "2017"; break;
+    case RadioInfo::DM1701: ident = "DM-1701"; break;
+    default: break;
+    }
+    memcpy(data, ident.constData(), std::min(int(len)-1, ident.size()));
+    _identify = false;
+  }
+
+  return len;
+}
@@ -0,0 +1,51 @@
+#ifndef TYTSIMULATOR_HH
+#define TYTSIMULATOR_HH
+
+#include "tyt_interface.hh"
+#include "simulateddevice.hh"
+
+/** Simulates the DFU interface of TyT (and Retevis, Baofeng) radios.
+ *
+ * This class replaces the USB control transfers of the @c TyTInterface by a simulated device,
+ * which implements the device side of the (weird) DfuSe protocol used by these radios. That is,
+ * it handles the commands written to block 0 (program mode, identify, set address, erase) and the
+ * reads and writes relative to the selected address. See @c SimulatedDevice for the device
+ * specification.
+ *
+ * @ingroup tyt */
+class TyTSimulator: public TyTInterface
+{
+  Q_OBJECT
+
+public:
+  /** Constructs a simulated TyT device for the given descriptor. If the specification is valid,
+   * @c isOpen returns @c true. */
+  explicit TyTSimulator(const USBDeviceDescriptor &descr, const ErrorStack &err=ErrorStack(),
+                        QObject *parent=nullptr);
+  /** Destructor. */
+  virtual ~TyTSimulator();
+
+  bool isOpen() const;
+  void close();
+  bool reboot(const ErrorStack &err=ErrorStack());
+
+protected:
+  int control_transfer(uint8_t requestType, uint8_t request, uint16_t value,
+                       uint8_t *data, uint16_t len);
+  /** Handles a download (write) request to the simulated device. */
+  int simulateDownload(uint16_t block, const uint8_t *data, uint16_t len);
+  /** Handles an upload (read) request from the simulated device. */
+  int simulateUpload(uint16_t block, uint8_t *data, uint16_t len);
+
+protected:
+  /** The simulated device. */
+  SimulatedDevice _device;
+  /** If @c true, the simulated device is connected. */
+  bool _open;
+  /** The address set by the last set-address command. */
+  uint32_t _address;
+  /** If @c true, the next upload of block 0 returns the device identifier. */
+  bool _identify;
+};
+
+#endif // TYTSIMULATOR_HH
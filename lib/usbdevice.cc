@@ -5,12 +5,7 @@
 #include "logger.hh"
 #include "radioinfo.hh"
 
-#include "anytone_interface.hh"
-#include "radioddity_interface.hh"
-#include "opengd77_interface.hh"
-#include "tyt_interface.hh"
-#include "dr1801uv_interface.hh"
-#include "c7000device.hh"
+#include "usbdeviceregistry.hh"
 
 
 /* ********************************************************************************************* *
@@ -190,6 +185,8 @@ bool
 USBDeviceDescriptor::isValid() const {
   if (! USBDeviceInfo::isValid())
     return false;
+  if (isSimulated())
+    return true;
 
   // dispatch by device class
   switch (_class) {
@@ -269,9 +266,16 @@ USBDeviceDescriptor::validSerial() const {
   return true;
 }
 
+bool
+USBDeviceDescriptor::isSimulated() const {
+  return (QVariant::String == _device.type()) && _device.toString().startsWith("sim:");
+}
+
 QString
 USBDeviceDescriptor::description() const {
-  if (USBDeviceInfo::Class::Serial == _class) {
+  if (isSimulated()) {
+    return QString("Simulated device '%1'").arg(_device.toString());
+  } else if (USBDeviceInfo::Class::Serial == _class) {
     return QString("Serial interface '%1'").arg(_device.toString());
   } else if (USBDeviceInfo::Class::DFU == _class) {
     USBDeviceHandle addr = _device.value<USBDeviceHandle>();
@@ -293,6 +297,9 @@ USBDeviceDescriptor::device() const {
 
 QString
 USBDeviceDescriptor::deviceHandle() const {
+  if (isSimulated())
+    return _device.toString();
+
   switch (_class) {
   case Class::None:
     break;
@@ -310,13 +317,6 @@ USBDeviceDescriptor::deviceHandle() const {
 
 QList<USBDeviceDescriptor>
 USBDeviceDescriptor::detect(bool saveOnly) {
-  QList<USBDeviceDescriptor> res;
-  res.append(AnytoneInterface::detect(saveOnly));
-  res.append(OpenGD77Interface::detect(saveOnly));
-  res.append(RadioddityInterface::detect(saveOnly));
-  res.append(TyTInterface::detect(saveOnly));
-  res.append(DR1801UVInterface::detect(saveOnly));
-  res.append(C7000Device::detect(saveOnly));
-  return res;
+  return USBDeviceRegistry::instance()->devices(saveOnly);
 }
 
@@ -213,6 +213,8 @@ public:
   /** Returns @c true if the descriptor is still valid. That is, if the described device is still
    * connected. */
   bool isValid() const;
+  /** Returns @c true if the descriptor refers to a simulated device (see @c SimulatedDevice). */
+  bool isSimulated() const;
 
   /** Returns a human readable description of the device. */
   QString description() const;
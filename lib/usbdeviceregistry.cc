@@ -0,0 +1,284 @@
+#include "usbdeviceregistry.hh"
+#include <QCoreApplication>
+#include <QSerialPortInfo>
+#include <QSet>
+#include "logger.hh"
+
+#include "anytone_interface.hh"
+#include "radioddity_interface.hh"
+#include "opengd77_interface.hh"
+#include "tyt_interface.hh"
+#include "dr1801uv_interface.hh"
+#include "c7000device.hh"
+
+#define HOTPLUG_POLL_INTERVAL 250 // ms
+#define SERIAL_SCANS          4   // Number of serial port scans after a hotplug event
+
+
+/** Returns a key identifying the given device uniquely. */
+static QString
+deviceKey(const USBDeviceDescriptor &descr) {
+  return QString("%1:%2:%3/%4").arg(int(descr.interfaceClass()))
+      .arg(descr.vendorId()).arg(descr.productId()).arg(descr.deviceHandle());
+}
+
+
+/* ********************************************************************************************* *
+ * Implementation of USBDeviceRegistry
+ * ********************************************************************************************* */
+USBDeviceRegistry *USBDeviceRegistry::_instance = nullptr;
+
+USBDeviceRegistry::USBDeviceRegistry(QObject *parent)
+  : QObject(parent), _ctx(nullptr), _hasHotplug(false), _hotplug(), _timer(),
+    _usbChanged(true), _serialScans(1), _usbDevices(), _serialDevices(), _identified()
+{
+  int error = libusb_init(&_ctx);
+  if (error < 0) {
+    logError() << "Libusb init failed (" << error << "): "
+               << libusb_strerror((enum libusb_error) error) << ".";
+    _ctx = nullptr;
+    return;
+  }
+
+  if (! libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG)) {
+    logDebug() << "Hotplug events are not supported, enumerate devices on every request.";
+    return;
+  }
+
+  error = libusb_hotplug_register_callback(
+        _ctx, libusb_hotplug_event(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED|LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT),
+        libusb_hotplug_flag(0), LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+        LIBUSB_HOTPLUG_MATCH_ANY, onHotplug, this, &_hotplug);
+  if (LIBUSB_SUCCESS != error) {
+    logWarn() << "Cannot register hotplug callback (" << error << "): "
+              << libusb_strerror((enum libusb_error) error) << ".";
+    return;
+  }
+
+  _hasHotplug = true;
+  _timer.setInterval(HOTPLUG_POLL_INTERVAL);
+  connect(&_timer, SIGNAL(timeout()), this, SLOT(processEvents()));
+  _timer.start();
+}
+
+USBDeviceRegistry::~USBDeviceRegistry() {
+  _timer.stop();
+  if (_hasHotplug)
+    libusb_hotplug_deregister_callback(_ctx, _hotplug);
+  if (nullptr != _ctx)
+    libusb_exit(_ctx);
+  if (this == _instance)
+    _instance = nullptr;
+}
+
+USBDeviceRegistry *
+USBDeviceRegistry::instance() {
+  if (nullptr == _instance)
+    _instance = new USBDeviceRegistry(QCoreApplication::instance());
+  return _instance;
+}
+
+bool
+USBDeviceRegistry::hasHotplug() const {
+  return _hasHotplug;
+}
+
+void
+USBDeviceRegistry::invalidate() {
+  _usbChanged = true;
+  _serialScans = std::max(1u, _serialScans);
+}
+
+QList<USBDeviceDescriptor>
+USBDeviceRegistry::devices(bool saveOnly) {
+  if (_hasHotplug)
+    processEvents();
+  else
+    invalidate();
+
+  updateDevices();
+
+  QList<USBDeviceDescriptor> res;
+  foreach (USBDeviceInfo info, knownInterfaces()) {
+    if ((USBDeviceInfo::Class::Serial == info.interfaceClass()) && info.hasVendorID()) {
+      foreach (USBDeviceDescriptor port, _serialDevices) {
+        if ((info.vendorId() == port.vendorId()) && (info.productId() == port.productId()))
+          res.append(USBSerial::Descriptor(port.vendorId(), port.productId(),
+                                           port.device().toString(), info.isSave()));
+      }
+    } else if (USBDeviceInfo::Class::Serial == info.interfaceClass()) {
+      // Generic serial interfaces are never save
+      if (! saveOnly)
+        res.append(_serialDevices);
+#ifdef Q_OS_MACOS
+    } else if (USBDeviceInfo::Class::HID == info.interfaceClass()) {
+      // HID devices are addressed by their location ID on MacOS, hence they are not enumerated
+      // through libusb
+      res.append(HIDevice::detect(info.vendorId(), info.productId()));
+#endif
+    } else {
+      foreach (USBDeviceDescriptor dev, _usbDevices) {
+        if (info == dev)
+          res.append(dev);
+      }
+    }
+  }
+
+  return res;
+}
+
+bool
+USBDeviceRegistry::isIdentified(const USBDeviceDescriptor &descr) const {
+  return _identified.contains(descr.deviceHandle());
+}
+
+RadioInfo
+USBDeviceRegistry::identification(const USBDeviceDescriptor &descr) const {
+  return _identified.value(descr.deviceHandle(), RadioInfo());
+}
+
+void
+USBDeviceRegistry::setIdentification(const USBDeviceDescriptor &descr, const RadioInfo &info) {
+  if (! info.isValid())
+    return;
+  _identified[descr.deviceHandle()] = info;
+}
+
+void
+USBDeviceRegistry::processEvents() {
+  handleHotplugEvents();
+
+  // Only update lists if someone is listening, otherwise defer update to next call to devices().
+  if (0 == receivers(SIGNAL(deviceAttached(USBDeviceDescriptor))) &&
+      0 == receivers(SIGNAL(deviceDetached(USBDeviceDescriptor))))
+    return;
+
+  updateDevices();
+}
+
+void
+USBDeviceRegistry::handleHotplugEvents() {
+  if ((nullptr == _ctx) || (! _hasHotplug))
+    return;
+  struct timeval tv = {0, 0};
+  libusb_handle_events_timeout_completed(_ctx, &tv, nullptr);
+}
+
+void
+USBDeviceRegistry::updateDevices() {
+  if (_usbChanged)
+    enumerateUSB();
+  if (_serialScans)
+    enumerateSerial();
+}
+
+void
+USBDeviceRegistry::enumerateUSB() {
+  _usbChanged = false;
+  if (nullptr == _ctx)
+    return;
+
+  libusb_device **lst;
+  int num = libusb_get_device_list(_ctx, &lst);
+  if (0 > num) {
+    logError() << "Cannot obtain list of USB devices.";
+    return;
+  }
+
+  QList<USBDeviceDescriptor> found;
+  for (int i=0; (i<num)&&(nullptr!=lst[i]); i++) {
+    libusb_device_descriptor descr;
+    if (0 > libusb_get_device_descriptor(lst[i], &descr))
+      continue;
+    uint8_t bus = libusb_get_bus_number(lst[i]), device = libusb_get_device_address(lst[i]);
+    foreach (USBDeviceInfo info, knownInterfaces()) {
+      if ((descr.idVendor != info.vendorId()) || (descr.idProduct != info.productId()))
+        continue;
+      if (USBDeviceInfo::Class::DFU == info.interfaceClass())
+        found.append(DFUDevice::Descriptor(info, bus, device));
+#ifndef Q_OS_MACOS
+      else if (USBDeviceInfo::Class::HID == info.interfaceClass())
+        found.append(HIDevice::Descriptor(info, bus, device));
+#endif
+      else if (USBDeviceInfo::Class::C7K == info.interfaceClass())
+        found.append(C7000Device::Descriptor(info, bus, device));
+    }
+  }
+  libusb_free_device_list(lst, 1);
+
+  update(_usbDevices, found);
+}
+
+void
+USBDeviceRegistry::enumerateSerial() {
+  if (_serialScans)
+    _serialScans--;
+
+  foreach (USBDeviceDescriptor descr, _serialDevices)
+    _identified.remove(descr.deviceHandle());
+
+  QList<USBDeviceDescriptor> found;
+  foreach (QSerialPortInfo port, QSerialPortInfo::availablePorts()) {
+    if (port.hasProductIdentifier() && port.hasVendorIdentifier())
+      found.append(USBSerial::Descriptor(port.vendorIdentifier(), port.productIdentifier(),
+                                         port.portName(), false));
+  }
+
+  update(_serialDevices, found);
+}
+
+void
+USBDeviceRegistry::update(QList<USBDeviceDescriptor> &current, const QList<USBDeviceDescriptor> &found) {
+  QSet<QString> currentKeys, foundKeys;
+  foreach (USBDeviceDescriptor descr, current)
+    currentKeys.insert(deviceKey(descr));
+  foreach (USBDeviceDescriptor descr, found)
+    foundKeys.insert(deviceKey(descr));
+
+  QList<USBDeviceDescriptor> detached;
+  foreach (USBDeviceDescriptor descr, current) {
+    if (! foundKeys.contains(deviceKey(descr)))
+      detached.append(descr);
+  }
+  QList<USBDeviceDescriptor> attached;
+  foreach (USBDeviceDescriptor descr, found) {
+    if (! currentKeys.contains(deviceKey(descr)))
+      attached.append(descr);
+  }
+
+  current = found;
+
+  foreach (USBDeviceDescriptor descr, detached) {
+    logDebug() << "Device detached: " << descr.description() << ".";
+    _identified.remove(descr.deviceHandle());
+    emit deviceDetached(descr);
+  }
+  foreach (USBDeviceDescriptor descr, attached) {
+    logDebug() << "Device attached: " << descr.description() << ".";
+    emit deviceAttached(descr);
+  }
+}
+
+QList<USBDeviceInfo>
+USBDeviceRegistry::knownInterfaces() {
+  return QList<USBDeviceInfo>()
+      << AnytoneInterface::interfaceInfo()
+      << OpenGD77Interface::interfaceInfo()
+      << RadioddityInterface::interfaceInfo()
+      << TyTInterface::interfaceInfo()
+      << DR1801UVInterface::interfaceInfo()
+      << C7000Device::interfaceInfo();
+}
+
+int LIBUSB_CALL
+USBDeviceRegistry::onHotplug(libusb_context *ctx, libusb_device *dev,
+                             libusb_hotplug_event event, void *userData)
+{
+  Q_UNUSED(ctx); Q_UNUSED(dev); Q_UNUSED(event);
+  USBDeviceRegistry *self = reinterpret_cast<USBDeviceRegistry *>(userData);
+  // Just mark lists as changed, they get updated outside of the libusb event handling.
+  self->_usbChanged = true;
+  self->_serialScans = SERIAL_SCANS;
+  // Keep callback registered
+  return 0;
+}
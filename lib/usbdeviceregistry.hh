@@ -0,0 +1,118 @@
+#ifndef USBDEVICEREGISTRY_HH
+#define USBDEVICEREGISTRY_HH
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <libusb.h>
+#include "usbdevice.hh"
+#include "radioinfo.hh"
+
+/** Shared registry of all USB devices and serial ports, that may be connected radios.
+ *
+ * The registry enumerates the USB bus and the serial ports once for all known interfaces and
+ * keeps the result. If supported by the platform, libusb hotplug events are used to keep the
+ * list of devices up-to-date. Then, repeated calls to @c devices are answered from the cache and
+ * the @c deviceAttached and @c deviceDetached signals are emitted whenever a device gets plugged
+ * in or removed. Without hotplug support, the devices are enumerated again on every call to
+ * @c devices.
+ *
+ * Additionally, the registry keeps the identification of radios connected to a specific bus and
+ * device number or serial port, until the device gets unplugged. This is only used to list the
+ * devices. The identification is not used to skip the detection, as all interfaces have to
+ * connect to the radio anyway, which also identifies it.
+ *
+ * The registry is not thread-safe and must be used from the main thread only. Use
+ * @c USBDeviceDescriptor::detect to enumerate all devices.
+ *
+ * @ingroup detect */
+class USBDeviceRegistry: public QObject
+{
+  Q_OBJECT
+
+protected:
+  /** Hidden constructor, use @c instance. */
+  explicit USBDeviceRegistry(QObject *parent=nullptr);
+
+public:
+  /** Destructor. */
+  virtual ~USBDeviceRegistry();
+
+  /** Returns the singleton instance of the registry. */
+  static USBDeviceRegistry *instance();
+
+  /** Returns @c true if the registry gets notified about attached and detached devices. */
+  bool hasHotplug() const;
+
+  /** Returns all known devices. If @c saveOnly is @c false, all serial ports are returned
+   * additionally (see @c USBDeviceDescriptor::detect). */
+  QList<USBDeviceDescriptor> devices(bool saveOnly=true);
+  /** Forces a re-enumeration of all devices with the next call to @c devices. */
+  void invalidate();
+
+  /** Returns @c true, if the radio connected to the given device has been identified. */
+  bool isIdentified(const USBDeviceDescriptor &descr) const;
+  /** Returns the identification of the radio connected to the given device. If not identified
+   * yet, an invalid @c RadioInfo is returned. */
+  RadioInfo identification(const USBDeviceDescriptor &descr) const;
+  /** Stores the identification of the radio connected to the given device. The identification is
+   * kept until the device gets detached. */
+  void setIdentification(const USBDeviceDescriptor &descr, const RadioInfo &info);
+
+signals:
+  /** Gets emitted, once a device is attached. */
+  void deviceAttached(const USBDeviceDescriptor &descr);
+  /** Gets emitted, once a device is detached. */
+  void deviceDetached(const USBDeviceDescriptor &descr);
+
+protected slots:
+  /** Handles pending hotplug events and updates the device lists if needed. */
+  void processEvents();
+
+protected:
+  /** Handles pending hotplug events. */
+  void handleHotplugEvents();
+  /** Updates the device lists, if they have changed. */
+  void updateDevices();
+  /** Enumerates all USB devices matching one of the known raw USB interfaces. */
+  void enumerateUSB();
+  /** Enumerates all serial ports. As a radio may be swapped without the serial port vanishing
+   * from the list, all identifications of serial ports are dropped. */
+  void enumerateSerial();
+  /** Updates the given device list and emits the attach and detach signals. */
+  void update(QList<USBDeviceDescriptor> &current, const QList<USBDeviceDescriptor> &found);
+
+  /** Returns the list of all known interfaces in the order of detection. */
+  static QList<USBDeviceInfo> knownInterfaces();
+
+private:
+  /** Callback for libusb hotplug events. */
+  static int LIBUSB_CALL onHotplug(libusb_context *ctx, libusb_device *dev,
+                                   libusb_hotplug_event event, void *userData);
+
+protected:
+  /** The libusb context used for enumeration and hotplug events. */
+  libusb_context *_ctx;
+  /** If @c true, hotplug events are received. */
+  bool _hasHotplug;
+  /** The hotplug callback handle. */
+  libusb_hotplug_callback_handle _hotplug;
+  /** Timer to poll hotplug events. */
+  QTimer _timer;
+  /** If @c true, the USB devices must be re-enumerated. */
+  bool _usbChanged;
+  /** Number of pending re-enumerations of serial ports. Serial ports appear with some delay after
+   * the USB device got attached, hence they are scanned several times. */
+  unsigned int _serialScans;
+  /** All known raw USB devices found. */
+  QList<USBDeviceDescriptor> _usbDevices;
+  /** All serial ports found. Ports matching a known interface are marked as save. */
+  QList<USBDeviceDescriptor> _serialDevices;
+  /** Identified radios indexed by device handle. */
+  QHash<QString, RadioInfo> _identified;
+
+  /** The singleton instance. */
+  static USBDeviceRegistry *_instance;
+};
+
+#endif // USBDEVICEREGISTRY_HH
@@ -79,6 +79,12 @@ USBSerial::USBSerial(const USBDeviceDescriptor &descriptor, BaudRate rate, const
   connect(this, SIGNAL(requestToSendChanged(bool)), this, SLOT(signalingChanged()));
 }
 
+USBSerial::USBSerial(QObject *parent)
+  : QSerialPort(parent), RadioInterface()
+{
+  // pass...
+}
+
 USBSerial::~USBSerial() {
   if (isOpen())
     close();
@@ -91,7 +97,7 @@ USBSerial::isOpen() const {
 
 void
 USBSerial::close() {
-  if (isOpen())
+  if (QSerialPort::isOpen())
     QSerialPort::close();
 }
 
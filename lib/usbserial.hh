@@ -34,6 +34,9 @@ protected:
   explicit USBSerial(const USBDeviceDescriptor &descriptor,
                      QSerialPort::BaudRate rate=QSerialPort::Baud115200,
                      const ErrorStack &err=ErrorStack(), QObject *parent=nullptr);
+  /** Constructs a serial interface without opening any port. This is used by simulated devices
+   * (see @c SimulatedDevice), which re-implement the transport. */
+  explicit USBSerial(QObject *parent);
 
 public:
   /** Destructor. */
@@ -3,12 +3,22 @@
 #include <QJsonArray>
 #include <QStandardPaths>
 #include <QFile>
+#include <QSaveFile>
 #include <QDir>
+#include <QFileInfo>
+#include <QSet>
 #include <QNetworkReply>
 #include <algorithm>
 #include "logger.hh"
+#include "dmrcompletionmodel.hh"
 #include <cmath>
 
+/** Minimum number of records in the delta log before it gets merged into a new snapshot. */
+#define MIN_DELTA_RECORDS   1000
+/** The delta log gets merged into a new snapshot, once it contains more records than
+ * 1/DELTA_COMPACT_RATIO of the number of users. */
+#define DELTA_COMPACT_RATIO 10
+
 
 /* ********************************************************************************************* *
  * Implementation of User
@@ -44,12 +54,41 @@ UserDatabase::User::distance(unsigned id) const {
   return std::abs(a-b);
 }
 
+bool
+UserDatabase::User::operator==(const User &other) const {
+  return (id == other.id) && (call == other.call) && (name == other.name)
+      && (surname == other.surname) && (city == other.city) && (state == other.state)
+      && (country == other.country) && (comment == other.comment);
+}
+
+QJsonObject
+UserDatabase::User::toJson() const {
+  QJsonObject obj;
+  obj.insert("id", int(id));
+  obj.insert("callsign", call);
+  obj.insert("fname", name);
+  obj.insert("surname", surname);
+  obj.insert("city", city);
+  obj.insert("state", state);
+  obj.insert("country", country);
+  obj.insert("remarks", comment);
+  return obj;
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of UserDatabase
  * ********************************************************************************************* */
 UserDatabase::UserDatabase(unsigned updatePeriodDays, QObject *parent)
-  : QAbstractTableModel(parent), _user(), _network()
+  : UserDatabase(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation),
+                 updatePeriodDays, parent)
+{
+  // pass...
+}
+
+UserDatabase::UserDatabase(const QString &directory, unsigned updatePeriodDays, QObject *parent)
+  : QAbstractTableModel(parent), _directory(directory), _user(), _deltaRecords(0), _network(),
+    _completion(nullptr)
 {
   connect(&_network, SIGNAL(finished(QNetworkReply*)),
           this, SLOT(downloadFinished(QNetworkReply*)));
@@ -65,8 +104,7 @@ UserDatabase::count() const {
 
 bool
 UserDatabase::load() {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  return load(path+"/user.json");
+  return load(databasePath());
 }
 
 const UserDatabase::User &
@@ -74,6 +112,15 @@ UserDatabase::user(int idx) const {
   return _user[idx];
 }
 
+int
+UserDatabase::indexOf(unsigned id) const {
+  auto user = std::lower_bound(_user.begin(), _user.end(), id,
+                               [](const User &user, unsigned id) { return user.id < id; });
+  if ((_user.end() == user) || (id != user->id))
+    return -1;
+  return user - _user.begin();
+}
+
 bool
 UserDatabase::load(const QString &filename) {
   QFile file(filename);
@@ -86,6 +133,195 @@ UserDatabase::load(const QString &filename) {
   QByteArray data = file.readAll();
   file.close();
 
+  QVector<User> users;
+  if (! parse(data, users))
+    return false;
+
+  // Apply changes from delta log, if present
+  QFileInfo info(filename);
+  QString deltaLog = info.absolutePath() + "/" + info.completeBaseName() + ".delta";
+  int records = 0;
+  if (QFileInfo::exists(deltaLog) && (0 > (records = applyDeltaLog(deltaLog, users))))
+    return false;
+
+  // Sort users w.r.t. their IDs
+  std::stable_sort(users.begin(), users.end(), [](const User &a, const User &b){ return a.id < b.id; });
+
+  beginResetModel();
+  _user = users;
+  _deltaRecords = records;
+  endResetModel();
+
+  logDebug() << "Loaded user database with " << _user.size() << " entries from " << filename
+             << " (" << records << " delta records).";
+
+  if (_completion)
+    updateCompletionModel();
+
+  emit loaded();
+  return true;
+}
+
+bool
+UserDatabase::update(const QString &filename) {
+  QFile file(filename);
+  if (! file.open(QIODevice::ReadOnly)) {
+    QString msg = QString("Cannot open user list '%1': %2").arg(filename).arg(file.errorString());
+    logError() << msg;
+    emit error(msg);
+    return false;
+  }
+  return update(file.readAll());
+}
+
+bool
+UserDatabase::update(const QByteArray &data) {
+  QVector<User> users;
+  if (! parse(data, users))
+    return false;
+
+  QHash<unsigned, int> rows;
+  for (int i=0; i<_user.size(); i++)
+    rows.insert(_user[i].id, i);
+
+  // Compare with current users
+  QList<QJsonObject> records;
+  QVector<int> changed, removed;
+  QVector<User> added;
+  QSet<unsigned> present;
+  foreach (const User &user, users) {
+    present.insert(user.id);
+    QHash<unsigned, int>::const_iterator row = rows.constFind(user.id);
+    if (rows.constEnd() == row) {
+      added.append(user);
+      rows.insert(user.id, -1);
+    } else if ((0 <= row.value()) && (! (_user[row.value()] == user))) {
+      _user[row.value()] = user;
+      changed.append(row.value());
+    } else {
+      continue;
+    }
+    QJsonObject record = user.toJson();
+    record.insert("op", "put");
+    records.append(record);
+  }
+  for (int i=0; i<_user.size(); i++) {
+    if (present.contains(_user[i].id))
+      continue;
+    removed.append(i);
+    QJsonObject record;
+    record.insert("op", "del");
+    record.insert("id", int(_user[i].id));
+    records.append(record);
+  }
+
+  // Signal changed rows, contiguous rows are signaled as one range
+  std::sort(changed.begin(), changed.end());
+  for (int i=0; i<changed.size(); i++) {
+    int first = changed[i];
+    while (((i+1) < changed.size()) && (changed[i+1] == (changed[i]+1)))
+      i++;
+    emit dataChanged(index(first, 0), index(changed[i], columnCount()-1));
+  }
+  // Remove rows, starting at the end
+  for (int i=removed.size()-1; i>=0; i--) {
+    int last = removed[i];
+    while ((0 < i) && (removed[i-1] == (removed[i]-1)))
+      i--;
+    beginRemoveRows(QModelIndex(), removed[i], last);
+    _user.remove(removed[i], last-removed[i]+1);
+    endRemoveRows();
+  }
+  // Insert new users w.r.t. their IDs, users inserted at the same row are signaled as one range
+  std::sort(added.begin(), added.end(), [](const User &a, const User &b){ return a.id < b.id; });
+  for (int i=0; i<added.size(); ) {
+    auto next = std::lower_bound(_user.begin(), _user.end(), added[i].id,
+                                 [](const User &user, unsigned id) { return user.id < id; });
+    int row = next - _user.begin(), n = 1;
+    while (((i+n) < added.size()) && ((_user.end() == next) || (added[i+n].id < next->id)))
+      n++;
+    beginInsertRows(QModelIndex(), row, row+n-1);
+    _user.insert(row, n, User());
+    std::copy(added.begin()+i, added.begin()+i+n, _user.begin()+row);
+    endInsertRows();
+    i += n;
+  }
+
+  logDebug() << "Updated user database: " << added.size() << " added, " << changed.size()
+             << " changed and " << removed.size() << " removed.";
+
+  if (_completion && records.size())
+    updateCompletionModel();
+
+  // Mark update in delta log, also if nothing has changed.
+  QJsonObject sync;
+  sync.insert("op", "sync");
+  sync.insert("time", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+  records.append(sync);
+  if (! appendDeltaLog(records))
+    return false;
+
+  if ((! QFileInfo::exists(databasePath())) ||
+      (_deltaRecords > std::max(unsigned(MIN_DELTA_RECORDS), unsigned(_user.size())/DELTA_COMPACT_RATIO)))
+    return compact();
+
+  return true;
+}
+
+bool
+UserDatabase::compact() {
+  QDir directory;
+  if ((! directory.exists(_directory)) && (!directory.mkpath(_directory))) {
+    QString msg = QString("Cannot create path '%1'.").arg(_directory);
+    logError() << msg;
+    emit error(msg);
+    return false;
+  }
+
+  QVector<User> users(_user);
+  std::stable_sort(users.begin(), users.end(), [](const User &a, const User &b){ return a.id < b.id; });
+  QJsonArray array;
+  foreach (const User &user, users)
+    array.append(user.toJson());
+  QJsonObject obj;
+  obj.insert("users", array);
+
+  // Write new snapshot atomically, the old one stays valid until the new one is complete.
+  QSaveFile file(databasePath());
+  if (! file.open(QIODevice::WriteOnly)) {
+    QString msg = QString("Cannot save user database at '%1'.").arg(databasePath());
+    logError() << msg;
+    emit error(msg);
+    return false;
+  }
+  file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+  if (! file.commit()) {
+    QString msg = QString("Cannot save user database at '%1': %2")
+        .arg(databasePath()).arg(file.errorString());
+    logError() << msg;
+    emit error(msg);
+    return false;
+  }
+
+  if (QFileInfo::exists(deltaLogPath()) && (! QFile::remove(deltaLogPath()))) {
+    QString msg = QString("Cannot remove delta log '%1'.").arg(deltaLogPath());
+    logError() << msg;
+    emit error(msg);
+    return false;
+  }
+
+  logDebug() << "Merged " << _deltaRecords << " delta records into user database snapshot.";
+  _deltaRecords = 0;
+  return true;
+}
+
+unsigned
+UserDatabase::deltaRecords() const {
+  return _deltaRecords;
+}
+
+bool
+UserDatabase::parse(const QByteArray &data, QVector<User> &users) {
   QJsonParseError err;
   QJsonDocument doc = QJsonDocument::fromJson(data, &err);
   if (doc.isEmpty()) {
@@ -114,27 +350,132 @@ UserDatabase::load(const QString &filename) {
     return false;
   }
 
-  beginResetModel();
-  _user.clear();
-
   QJsonArray array = doc.object()["users"].toArray();
-  _user.reserve(array.size());
+  users.reserve(array.size());
   for (int i=0; i<array.size(); i++) {
     User user(array.at(i).toObject());
     if (user.isValid())
-      _user.append(user);
+      users.append(user);
   }
-  // Sort repeater w.r.t. their IDs
-  std::stable_sort(_user.begin(), _user.end(), [](const User &a, const User &b){ return a.id < b.id; });
-  // Done.
-  endResetModel();
 
-  logDebug() << "Loaded user database with " << _user.size() << " entries from " << filename << ".";
+  return true;
+}
 
-  emit loaded();
+int
+UserDatabase::applyDeltaLog(const QString &filename, QVector<User> &users) {
+  QFile file(filename);
+  if (! file.open(QIODevice::ReadOnly)) {
+    QString msg = QString("Cannot open delta log '%1': %2").arg(filename).arg(file.errorString());
+    logError() << msg;
+    emit error(msg);
+    return -1;
+  }
+
+  QHash<unsigned, int> index;
+  for (int i=0; i<users.size(); i++)
+    index.insert(users[i].id, i);
+
+  int records = 0;
+  while (! file.atEnd()) {
+    QByteArray line = file.readLine().trimmed();
+    if (line.isEmpty())
+      continue;
+    QJsonDocument doc = QJsonDocument::fromJson(line);
+    if (! doc.isObject()) {
+      // Might be an incomplete last record, if the application was killed during the update
+      logWarn() << "Skip invalid record in delta log '" << filename << "'.";
+      continue;
+    }
+    records++;
+
+    QJsonObject record = doc.object();
+    QString op = record.value("op").toString();
+    if ("put" == op) {
+      User user(record);
+      if (! user.isValid())
+        continue;
+      if (index.contains(user.id)) {
+        users[index[user.id]] = user;
+      } else {
+        index.insert(user.id, users.size());
+        users.append(user);
+      }
+    } else if ("del" == op) {
+      unsigned id = record.value("id").toInt();
+      if (index.contains(id))
+        users[index.take(id)].id = 0;
+    }
+  }
+
+  // Remove deleted users
+  users.erase(std::remove_if(users.begin(), users.end(), [](const User &user) { return ! user.isValid(); }),
+              users.end());
+
+  return records;
+}
+
+bool
+UserDatabase::appendDeltaLog(const QList<QJsonObject> &records) {
+  QDir directory;
+  if ((! directory.exists(_directory)) && (!directory.mkpath(_directory))) {
+    QString msg = QString("Cannot create path '%1'.").arg(_directory);
+    logError() << msg;
+    emit error(msg);
+    return false;
+  }
+
+  QFile file(deltaLogPath());
+  if (! file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    QString msg = QString("Cannot open delta log '%1': %2").arg(deltaLogPath()).arg(file.errorString());
+    logError() << msg;
+    emit error(msg);
+    return false;
+  }
+
+  foreach (const QJsonObject &record, records) {
+    file.write(QJsonDocument(record).toJson(QJsonDocument::Compact));
+    file.write("\n");
+  }
+  file.flush();
+  file.close();
+
+  _deltaRecords += records.size();
   return true;
 }
 
+QString
+UserDatabase::databasePath() const {
+  return _directory + "/user.json";
+}
+
+QString
+UserDatabase::deltaLogPath() const {
+  return _directory + "/user.delta";
+}
+
+DMRCompletionModel *
+UserDatabase::completionModel() {
+  if (nullptr == _completion) {
+    _completion = new DMRCompletionModel(this);
+    updateCompletionModel();
+  }
+  return _completion;
+}
+
+void
+UserDatabase::updateCompletionModel() {
+  _completion->clear();
+  foreach (const User &user, _user) {
+    QString display = user.call;
+    if ((! user.name.isEmpty()) && (! user.surname.isEmpty()))
+      display = tr("%1 (%2, %3)").arg(user.call, user.name, user.surname);
+    else if (! user.name.isEmpty())
+      display = tr("%1 (%2)").arg(user.call, user.name);
+    _completion->add(user.id, user.call, display);
+  }
+  _completion->build();
+}
+
 void
 UserDatabase::sortUsers(unsigned id) {
   // Sort repeater w.r.t. distance to ID
@@ -174,40 +515,24 @@ UserDatabase::downloadFinished(QNetworkReply *reply) {
     QString msg = QString("Cannot download user database: %1").arg(reply->errorString());
     logError() << msg;
     emit error(msg);
+    reply->deleteLater();
     return;
   }
 
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  QFile file(path+"/user.json");
-  QDir directory;
-  if ((! directory.exists(path)) && (!directory.mkpath(path))) {
-    QString msg = QString("Cannot create path '%1'.").arg(path);
-    logError() << msg;
-    emit error(msg);
-    return;
-  }
-  if (! file.open(QIODevice::WriteOnly)) {
-    QString msg = QString("Cannot save user database at '%1'.").arg(path+"/user.json");
-    logError() << msg;
-    emit error(msg);
-    return;
-  }
-
-  file.write(reply->readAll());
-  file.flush();
-  file.close();
-
-  load();
+  update(reply->readAll());
   reply->deleteLater();
 }
 
 unsigned
 UserDatabase::dbAge() const {
-  QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/user.json";
-  QFileInfo info(path);
-  if (! info.exists())
+  QFileInfo snapshot(databasePath()), deltaLog(deltaLogPath());
+  if (! snapshot.exists())
     return -1;
-  return info.lastModified().daysTo(QDateTime::currentDateTime());
+  // The delta log gets touched on every update
+  QDateTime modified = snapshot.lastModified();
+  if (deltaLog.exists() && (deltaLog.lastModified() > modified))
+    modified = deltaLog.lastModified();
+  return modified.daysTo(QDateTime::currentDateTime());
 }
 
 int
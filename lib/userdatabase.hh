@@ -10,6 +10,8 @@
 #include <QSortFilterProxyModel>
 #include <QGeoPositionInfoSource>
 
+class DMRCompletionModel;
+
 /** Auto-updating DMR user database.
  *
  * This class represents the complete DMR user database. The user database gets downloaded from
@@ -18,6 +20,11 @@
  * to help assemble private call contacts and to assemble so-called CSV callsign databases, that
  * are programmable to some DMR radios to resolve the DMR ID to callsigns and names.
  *
+ * The downloaded database is not stored as-is. Instead, each new download is compared against the
+ * local database and only the changes are appended to a delta log (@c user.delta) next to the
+ * last full snapshot (@c user.json). Once the delta log gets too large, it is merged into a new
+ * snapshot. Views are notified about changed, inserted and removed rows instead of a full reset.
+ *
  * @ingroup util */
 class UserDatabase : public QAbstractTableModel
 {
@@ -38,6 +45,11 @@ public:
     /** Returns the "distance" between this user and the given ID. */
     unsigned distance(unsigned id) const;
 
+    /** Returns @c true if all fields of both entries are equal. */
+    bool operator==(const User &other) const;
+    /** Serializes the entry into a JSON object (same format as the downloaded database). */
+    QJsonObject toJson() const;
+
     /** The DMR ID of the user. */
     unsigned id;
     /** The callsign of the user. */
@@ -61,15 +73,31 @@ public:
    * The constructor will download the current user database if it was not downloaded yet or
    * if the downloaded version is older than @c updatePeriodDays days. */
   explicit UserDatabase(unsigned updatePeriodDays=30, QObject *parent=nullptr);
+  /** Constructs the user-database stored in the specified directory.
+   * The constructor will download the current user database if it was not downloaded yet or
+   * if the downloaded version is older than @c updatePeriodDays days. */
+  UserDatabase(const QString &directory, unsigned updatePeriodDays, QObject *parent=nullptr);
 
   /** Returns the number of users. */
   qint64 count() const;
 
   /** Loads all entries from the downloaded user database. */
   bool load();
-  /** Loads all entries from the downloaded user database at the specified location. */
+  /** Loads all entries from the downloaded user database at the specified location. If a delta
+   * log exists next to the database, all changes are applied. */
   bool load(const QString &filename);
 
+  /** Updates the database from the given complete user list (e.g., downloaded from radioid.net).
+   * Only the changes are stored in the delta log and signaled to the views. */
+  bool update(const QByteArray &data);
+  /** Updates the database from the given local file. */
+  bool update(const QString &filename);
+  /** Merges the delta log into a new snapshot of the database. */
+  bool compact();
+
+  /** Returns the number of records in the delta log. */
+  unsigned deltaRecords() const;
+
   /** Sorts users with respect to the distance to the given ID. */
   void sortUsers(unsigned id);
   /** Sorts users with respect to the minimum distance to the given IDs. */
@@ -77,10 +105,17 @@ public:
 
   /** Returns the user with index @c idx. */
   const User &user(int idx) const;
+  /** Returns the index of the user with the given ID or -1 if there is no such user. The users
+   * must be sorted by ID, that is, they must not be sorted by distance using @c sortUsers. */
+  int indexOf(unsigned id) const;
 
   /** Returns the age of the database in days. */
   unsigned dbAge() const;
 
+  /** Returns a completion model for the call-signs and IDs of all users. The model is created on
+   * first use and updated whenever the database gets loaded. */
+  DMRCompletionModel *completionModel();
+
   /** Implements the QAbstractTableModel interface, returns the number of rows (number of entries). */
   int rowCount(const QModelIndex &parent=QModelIndex()) const;
   /** Implements the QAbstractTableModel interface, returns the number of columns. */
@@ -103,10 +138,31 @@ private slots:
   void downloadFinished(QNetworkReply *reply);
 
 private:
-  /** Holds all users sorted by their ID. */
+  /** Fills the completion model with all users. */
+  void updateCompletionModel();
+  /** Parses the given complete user list. */
+  bool parse(const QByteArray &data, QVector<User> &users);
+  /** Applies the delta log at the given location to the given users. Returns the number of
+   * records or -1 on error. */
+  int applyDeltaLog(const QString &filename, QVector<User> &users);
+  /** Appends the given records to the delta log. */
+  bool appendDeltaLog(const QList<QJsonObject> &records);
+  /** Returns the path to the snapshot of the database. */
+  QString databasePath() const;
+  /** Returns the path to the delta log of the database. */
+  QString deltaLogPath() const;
+
+private:
+  /** The directory, the database is stored in. */
+  QString               _directory;
+  /** Holds all users sorted by their ID. Users added by an update are inserted in order. */
   QVector<User>         _user;
+  /** Number of records in the delta log. */
+  unsigned              _deltaRecords;
   /** The network access used for downloading. */
   QNetworkAccessManager _network;
+  /** The completion model, created on demand. */
+  DMRCompletionModel   *_completion;
 };
 
 
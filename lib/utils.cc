@@ -4,8 +4,40 @@
 #include <QHash>
 #include <cmath>
 #include <QRegularExpression>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
 #include <yaml-cpp/yaml.h>
 
+/** Minimum number of elements processed by a single worker. */
+#define MIN_ELEMENTS_PER_TASK 64
+
+
+/** Internal used task, processing a range of elements. */
+class ParallelForTask: public QRunnable
+{
+public:
+  /** Constructs a task calling @c fn for all indices in [first, last). */
+  ParallelForTask(int first, int last, const std::function<void(int)> &fn)
+    : QRunnable(), _first(first), _last(last), _fn(fn)
+  {
+    // pass...
+  }
+
+  void run() {
+    for (int i=_first; i<_last; i++)
+      _fn(i);
+  }
+
+protected:
+  /** The first index. */
+  int _first;
+  /** The index after the last one. */
+  int _last;
+  /** The function to call. */
+  const std::function<void(int)> &_fn;
+};
+
 // Maps APRS icon number to code-char
 static QVector<char> aprsIconCodeTable{
   '!','"','#','$','%','&','\'','(',')','*','+',',','-','.','/','0',
@@ -468,6 +500,20 @@ align_size(uint32_t size, uint32_t block) {
   return (size + (block - (size%block)));
 }
 
+bool
+is_decimal_digit(const QChar &c) {
+  return (c.unicode() >= '0') && (c.unicode() <= '9');
+}
+
+bool
+has_prefix(const QChar *c, const QChar *end, const char *prefix) {
+  for (; *prefix; c++, prefix++) {
+    if ((c >= end) || (*c != QLatin1Char(*prefix)))
+      return false;
+  }
+  return true;
+}
+
 uint32_t
 align_addr(uint32_t addr, uint32_t block) {
   if (0 == (addr % block))
@@ -532,3 +578,20 @@ deg2loc(const QGeoCoordinate &coor) {
 }
 
 
+
+void
+parallel_for(int n, const std::function<void(int)> &fn) {
+  int tasks = std::min(QThread::idealThreadCount(), n/MIN_ELEMENTS_PER_TASK);
+  if (2 > tasks) {
+    for (int i=0; i<n; i++)
+      fn(i);
+    return;
+  }
+
+  // Split elements into contiguous ranges, one per worker
+  QThreadPool pool;
+  pool.setMaxThreadCount(tasks);
+  for (int t=0; t<tasks; t++)
+    pool.start(new ParallelForTask((t*n)/tasks, ((t+1)*n)/tasks, fn));
+  pool.waitForDone();
+}
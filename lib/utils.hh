@@ -8,6 +8,7 @@
 
 #include <QString>
 #include <inttypes.h>
+#include <functional>
 
 #include "signaling.hh"
 #include "gpssystem.hh"
@@ -84,6 +85,12 @@ APRSSystem::Icon code2aprsicon(char table, char icon);
 int levDist(const QString &source, const QString &target,
             Qt::CaseSensitivity cs=Qt::CaseInsensitive);
 
+/** Returns @c true if the given character is a decimal digit [0-9]. */
+bool is_decimal_digit(const QChar &c);
+/** Returns @c true if the text in [c, end) starts with the given ASCII prefix. Used by the
+ * hand-written value parsers instead of regular expressions. */
+bool has_prefix(const QChar *c, const QChar *end, const char *prefix);
+
 /** Increases the given size to be aligned with the given block size. */
 uint32_t align_size(uint32_t size, uint32_t block);
 /** Decreases the address to be aligned with the given block size. */
@@ -92,4 +99,9 @@ uint32_t align_addr(uint32_t addr, uint32_t block);
 QGeoCoordinate loc2deg(const QString &loc);
 QString deg2loc(const QGeoCoordinate &coor);
 
+/** Calls @c fn for all indices from 0 to @c n-1. If @c n is large enough, the calls are
+ * distributed over several worker threads, each processing a contiguous range of indices. Returns
+ * once all calls are finished. */
+void parallel_for(int n, const std::function<void(int)> &fn);
+
 #endif // UTILS_HH
@@ -4,6 +4,7 @@
 #include <QDesktopServices>
 #include <QTranslator>
 #include <QStandardPaths>
+#include <QLabel>
 
 #include "logger.hh"
 #include "radio.hh"
@@ -40,6 +41,7 @@
 #include "chirpformat.hh"
 #include "configmergedialog.hh"
 #include "configmergevisitor.hh"
+#include "usbdeviceregistry.hh"
 
 
 inline QStringList getLanguages() {
@@ -56,7 +58,7 @@ inline QString getLocalePath(const QString &language) {
 
 Application::Application(int &argc, char *argv[])
   : QApplication(argc, argv), _config(nullptr), _mainWindow(nullptr), _translator(nullptr),
-    _repeater(nullptr), _lastDevice()
+    _repeater(nullptr), _lastDevice(), _lazyCodeplug()
 {
   setApplicationName("qdmr");
   setOrganizationName("DM3MAT");
@@ -100,6 +102,11 @@ Application::Application(int &argc, char *argv[])
   // create empty codeplug
   _config     = new Config(this);
 
+  // Forget the last detected device once it gets unplugged, another radio may be connected to the
+  // same port later
+  connect(USBDeviceRegistry::instance(), SIGNAL(deviceDetached(USBDeviceDescriptor)),
+          this, SLOT(onDeviceDetached(USBDeviceDescriptor)));
+
   // Handle args (if there are some)
   if (argc>1) {
     QFileInfo info(argv[1]);
@@ -205,6 +212,11 @@ Application::createMainWindow() {
   _mainWindow->statusBar()->addPermanentWidget(progress);
   progress->setVisible(false);
 
+  QLabel *statistics = new QLabel();
+  statistics->setObjectName("statistics");
+  _mainWindow->statusBar()->addPermanentWidget(statistics);
+  statistics->setVisible(false);
+
   QAction *newCP   = _mainWindow->findChild<QAction*>("actionNewCodeplug");
   QAction *loadCP  = _mainWindow->findChild<QAction*>("actionOpenCodeplug");
   QAction *saveCP  = _mainWindow->findChild<QAction*>("actionSaveCodeplug");
@@ -245,6 +257,8 @@ Application::createMainWindow() {
   connect(upCDB, SIGNAL(triggered()), this, SLOT(uploadCallsignDB()));
 
   QTabWidget *tabs = _mainWindow->findChild<QTabWidget*>("tabs");
+  // The list views need the elements of a lazily decoded codeplug
+  connect(tabs, SIGNAL(currentChanged(int)), this, SLOT(materializeConfig()));
 
   // Wire-up "General Settings" view
   _generalSettings = new GeneralSettingsView(_config);
@@ -327,6 +341,8 @@ Application::newCodeplug() {
 
   _config->clear();
   _config->setModified(false);
+  // Nothing left to decode, just releases the codeplug
+  materializeConfig();
 }
 
 
@@ -383,6 +399,14 @@ Application::loadCodeplug() {
       _config->clear();
     }
   }
+
+  // Config got replaced, nothing left to decode, just releases the codeplug
+  materializeConfig();
+
+  // Only the settings view can be shown without the lists, hold the contacts and channels
+  // compactly until another view is shown.
+  if (_generalSettings == _mainWindow->findChild<QTabWidget*>("tabs")->currentWidget())
+    _config->compact();
 }
 
 
@@ -391,6 +415,8 @@ Application::saveCodeplug() {
   if (! _mainWindow)
     return;
 
+  materializeConfig();
+
   Settings settings;
   QString filename = QFileDialog::getSaveFileName(
         nullptr, tr("Save codeplug"), settings.lastDirectory().absolutePath(),
@@ -438,6 +464,8 @@ Application::exportCodeplugToChirp() {
   if (! _mainWindow)
     return;
 
+  materializeConfig();
+
   Settings settings;
   QString filename = QFileDialog::getSaveFileName(
         nullptr, tr("Export codeplug"), settings.lastDirectory().absolutePath(),
@@ -473,6 +501,8 @@ Application::importCodeplug() {
   if (! _mainWindow)
     return;
 
+  materializeConfig();
+
   Settings settings;
   QString filename = QFileDialog::getOpenFileName(
         nullptr, tr("Import codeplug"), settings.lastDirectory().absolutePath(),
@@ -612,6 +642,8 @@ Application::detectRadio() {
 
 bool
 Application::verifyCodeplug(Radio *radio, bool showSuccess) {
+  materializeConfig();
+
   Radio *myRadio = radio;
 
   // If no radio is given -> try to detect the radio
@@ -682,6 +714,7 @@ Application::downloadCodeplug() {
 
   QProgressBar *progress = _mainWindow->findChild<QProgressBar *>("progress");
   progress->setValue(0); progress->setMaximum(100); progress->setVisible(true);
+  _mainWindow->findChild<QLabel *>("statistics")->setVisible(false);
   connect(radio, SIGNAL(downloadProgress(int)), progress, SLOT(setValue(int)));
   connect(radio, SIGNAL(downloadError(Radio *)), this, SLOT(onCodeplugDownloadError(Radio *)));
   connect(radio, SIGNAL(downloadFinished(Radio *, Codeplug *)), this, SLOT(onCodeplugDownloaded(Radio *, Codeplug *)));
@@ -701,6 +734,7 @@ Application::onCodeplugDownloadError(Radio *radio) {
   _mainWindow->statusBar()->showMessage(tr("Read error"));
   ErrorMessageView(radio->errorStack()).exec();
   _mainWindow->findChild<QProgressBar *>("progress")->setVisible(false);
+  showTransferStatistics(radio);
   _mainWindow->setEnabled(true);
 
   if (radio->wait(250))
@@ -713,7 +747,13 @@ Application::onCodeplugDownloadError(Radio *radio) {
 void
 Application::onCodeplugDownloaded(Radio *radio, Codeplug *codeplug) {
   _config->clear();
+  // Release the codeplug of a previous download, nothing left to decode
+  materializeConfig();
   _mainWindow->setWindowModified(false);
+  showTransferStatistics(radio);
+
+  // Decode settings only, the lists are decoded once they are needed (see materializeConfig)
+  codeplug->setLazyDecoding(true);
 
   ErrorStack err;
   if (codeplug->decode(_config, err)) {
@@ -732,10 +772,32 @@ Application::onCodeplugDownloaded(Radio *radio, Codeplug *codeplug) {
 
   _mainWindow->setEnabled(true);
 
+  // Keep the codeplug until the config gets materialized, but release the radio. Only the settings
+  // view can be shown without the lists.
+  if (! _config->isMaterialized()) {
+    codeplug->setParent(this);
+    _lazyCodeplug = codeplug;
+    if (_generalSettings != _mainWindow->findChild<QTabWidget*>("tabs")->currentWidget())
+      materializeConfig();
+  }
+
   if (radio->wait(250))
     radio->deleteLater();
 }
 
+void
+Application::materializeConfig() {
+  // Decodes the deferred elements of a lazily decoded codeplug or expands a compacted config
+  ErrorStack err;
+  if (! _config->materialize(err)) {
+    ErrorMessageView(err).exec();
+    _config->clear();
+  }
+
+  if (! _lazyCodeplug.isNull())
+    delete _lazyCodeplug;
+}
+
 void
 Application::uploadCodeplug() {
   // Start upload
@@ -757,6 +819,7 @@ Application::uploadCodeplug() {
   progress->setValue(0);
   progress->setMaximum(100);
   progress->setVisible(true);
+  _mainWindow->findChild<QLabel *>("statistics")->setVisible(false);
 
   connect(radio, SIGNAL(uploadProgress(int)), progress, SLOT(setValue(int)));
   connect(radio, SIGNAL(uploadError(Radio *)), this, SLOT(onCodeplugUploadError(Radio *)));
@@ -842,6 +905,7 @@ Application::uploadCallsignDB() {
   QProgressBar *progress = _mainWindow->findChild<QProgressBar *>("progress");
   progress->setRange(0, 100); progress->setValue(0);
   progress->setVisible(true);
+  _mainWindow->findChild<QLabel *>("statistics")->setVisible(false);
 
   connect(radio, SIGNAL(uploadProgress(int)), progress, SLOT(setValue(int)));
   connect(radio, SIGNAL(uploadError(Radio *)), this, SLOT(onCodeplugUploadError(Radio *)));
@@ -864,6 +928,7 @@ Application::onCodeplugUploadError(Radio *radio) {
   _mainWindow->statusBar()->showMessage(tr("Write error"));
   ErrorMessageView(radio->errorStack()).exec();
   _mainWindow->findChild<QProgressBar *>("progress")->setVisible(false);
+  showTransferStatistics(radio);
   _mainWindow->setEnabled(true);
 
   if (radio->wait(250))
@@ -876,6 +941,7 @@ Application::onCodeplugUploaded(Radio *radio) {
   _mainWindow->statusBar()->showMessage(tr("Write complete"));
   _mainWindow->findChild<QProgressBar *>("progress")->setVisible(false);
   _mainWindow->setEnabled(true);
+  showTransferStatistics(radio);
 
   logDebug() << "Write complete.";
 
@@ -884,6 +950,35 @@ Application::onCodeplugUploaded(Radio *radio) {
 }
 
 
+void
+Application::showTransferStatistics(Radio *radio) {
+  QLabel *label = _mainWindow->findChild<QLabel *>("statistics");
+  const TransferStatistics *stats = radio->statistics();
+  if ((nullptr == stats) || (0 == stats->requests())) {
+    label->setVisible(false);
+    return;
+  }
+
+  logInfo() << "Transfer statistics: " << stats->format();
+
+  label->setText(tr("%1 kB/s").arg(stats->throughput()/1e3, 0, 'f', 1));
+  label->setToolTip(
+        tr("<b>Transfer statistics</b><br>"
+           "Requests: %1<br>Bytes sent: %2<br>Bytes received: %3<br>"
+           "Duration: %4 s<br>Throughput: %5 kB/s<br>"
+           "Latency (min/mean/max): %6/%7/%8 ms<br>"
+           "Timeouts: %9<br>Retries: %10<br>Errors: %11")
+        .arg(stats->requests()).arg(stats->bytesSent()).arg(stats->bytesReceived())
+        .arg(double(stats->duration())/1e9, 0, 'f', 2)
+        .arg(stats->throughput()/1e3, 0, 'f', 2)
+        .arg(double(stats->minLatency())/1e6, 0, 'f', 2)
+        .arg(double(stats->meanLatency())/1e6, 0, 'f', 2)
+        .arg(double(stats->maxLatency())/1e6, 0, 'f', 2)
+        .arg(stats->timeouts()).arg(stats->retries()).arg(stats->errors()));
+  label->setVisible(true);
+}
+
+
 void
 Application::showSettings() {
   SettingsDialog dialog;
@@ -996,6 +1091,16 @@ Application::position() const {
   return _currentPosition;
 }
 
+void
+Application::onDeviceDetached(const USBDeviceDescriptor &descr) {
+  if ((USBDeviceInfo::Class::None == _lastDevice.interfaceClass()) ||
+      (descr.interfaceClass() != _lastDevice.interfaceClass()) ||
+      (descr.deviceHandle() != _lastDevice.deviceHandle()))
+    return;
+  logDebug() << "Last device " << _lastDevice.description() << " detached.";
+  _lastDevice = USBDeviceDescriptor();
+}
+
 void
 Application::onPaletteChanged(const QPalette &palette) {
   // Set theme based on UI mode (light vs. dark).
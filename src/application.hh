@@ -4,6 +4,7 @@
 #include <QApplication>
 #include <QGroupBox>
 #include <QIcon>
+#include <QPointer>
 #include "config.hh"
 #include <QGeoPositionInfoSource>
 #include "releasenotes.hh"
@@ -72,6 +73,9 @@ private slots:
 
   void onCodeplugDownloadError(Radio *radio);
   void onCodeplugDownloaded(Radio *radio, Codeplug *codeplug);
+  /** Decodes the deferred elements of a lazily decoded codeplug and releases the codeplug. Also
+   * re-creates the elements of a compacted config. */
+  void materializeConfig();
 
   void onCodeplugUploadError(Radio *radio);
   void onCodeplugUploaded(Radio *radio);
@@ -80,8 +84,14 @@ private slots:
 
   void positionUpdated(const QGeoPositionInfo &info);
 
+  void onDeviceDetached(const USBDeviceDescriptor &descr);
+
   void onPaletteChanged(const QPalette &palette);
 
+protected:
+  /** Shows the transfer statistics of the last up- or download in the status bar. */
+  void showTransferStatistics(Radio *radio);
+
 protected:
   Config *_config;
   QMainWindow *_mainWindow;
@@ -110,6 +120,8 @@ protected:
 
   // Last detected device:
   USBDeviceDescriptor _lastDevice;
+  // Downloaded codeplug, the config was decoded lazily from:
+  QPointer<Codeplug> _lazyCodeplug;
 };
 
 #endif // APPLICATION_HH
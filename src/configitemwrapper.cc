@@ -5,6 +5,7 @@
 #include <QColor>
 #include <QPalette>
 #include <QWidget>
+#include <QEvent>
 
 
 /* ********************************************************************************************* *
@@ -95,7 +96,7 @@ GenericListWrapper::onItemModified(int idx) {
  * Implementation of GenericTableWrapper
  * ********************************************************************************************* */
 GenericTableWrapper::GenericTableWrapper(AbstractConfigObjectList *list, QObject *parent)
-  : QAbstractTableModel(parent), _list(list), _insertRow(-1)
+  : QAbstractTableModel(parent), _list(list), _insertRow(-1), _cache(), _generation(1)
 {
   if (nullptr == _list)
     return;
@@ -104,6 +105,11 @@ GenericTableWrapper::GenericTableWrapper(AbstractConfigObjectList *list, QObject
   connect(_list, SIGNAL(elementAdded(int)), this, SLOT(onItemAdded(int)));
   connect(_list, SIGNAL(elementModified(int)), this, SLOT(onItemModified(int)));
   connect(_list, SIGNAL(elementRemoved(int)), this, SLOT(onItemRemoved(int)));
+  if (const Config *config = _list->config())
+    connect(config, SIGNAL(modified(ConfigItem*)), this, SLOT(onConfigModified()));
+  // Foreground colors are taken from the palette of the parent widget
+  if (QWidget *widget = qobject_cast<QWidget *>(parent))
+    widget->installEventFilter(this);
 }
 
 int
@@ -159,6 +165,7 @@ GenericTableWrapper::moveRows(const QModelIndex &sourceParent, int sourceRow, in
   beginMoveRows(sourceParent, sourceRow, sourceRow+count-1,
                 destinationParent, destinationChild);
   bool success = _list->move(sourceRow, count, destinationChild);
+  invalidateCache();
   endMoveRows();
 
   return success;
@@ -173,16 +180,67 @@ GenericTableWrapper::canDropMimeData(const QMimeData *data, Qt::DropAction actio
   return QAbstractTableModel::canDropMimeData(data, action, row, column, parent);
 }
 
+QVariant
+GenericTableWrapper::data(const QModelIndex &index, int role) const {
+  if ((nullptr == _list) || (! index.isValid()) || (index.row()>=_list->count()))
+    return QVariant();
+
+  if ((Qt::DisplayRole != role) && (Qt::EditRole != role) && (Qt::ForegroundRole != role))
+    return cellData(index, role);
+
+  // Keep cache in sync with the list, usually a no-op.
+  if (_cache.size() != _list->count())
+    _cache.resize(_list->count());
+
+  Row &row = _cache[index.row()];
+  if (_generation != row.generation) {
+    row.display.clear(); row.edit.clear(); row.foreground.clear();
+    row.generation = _generation;
+  }
+
+  QVector<QVariant> &values = ((Qt::DisplayRole == role) ? row.display :
+                               ((Qt::EditRole == role) ? row.edit : row.foreground));
+  if (values.isEmpty()) {
+    // Compute entire row at once, the view will ask for all visible cells anyway
+    int columns = columnCount();
+    values.reserve(columns);
+    for (int c=0; c<columns; c++)
+      values.append(cellData(index.sibling(index.row(), c), role));
+  }
+
+  return values.value(index.column());
+}
+
+void
+GenericTableWrapper::invalidateCache() {
+  // Skip generation 0, it marks invalidated rows
+  if (0 == ++_generation)
+    _generation = 1;
+}
+
+bool
+GenericTableWrapper::eventFilter(QObject *obj, QEvent *event) {
+  if (QEvent::PaletteChange == event->type())
+    invalidateCache();
+  return QAbstractTableModel::eventFilter(obj, event);
+}
+
 void
 GenericTableWrapper::onListDeleted() {
   beginResetModel();
   _list = nullptr;
+  _cache.clear();
   endResetModel();
 }
 
 void
 GenericTableWrapper::onItemAdded(int idx) {
   beginInsertRows(QModelIndex(), idx, idx);
+  // The list already contains the new item. Drop the cache, if it got out of sync.
+  if ((_cache.size()+1) == _list->count())
+    _cache.insert(idx, Row());
+  else
+    _cache.clear();
   endInsertRows();
 }
 
@@ -190,14 +248,25 @@ void
 GenericTableWrapper::onItemRemoved(int idx) {
   beginRemoveRows(QModelIndex(), idx, idx);
   //logDebug() << "Signal removal of item at idx=" << idx;
+  if (_cache.size() == (_list->count()+1))
+    _cache.remove(idx);
+  else
+    _cache.clear();
   endRemoveRows();
 }
 
 void
 GenericTableWrapper::onItemModified(int idx) {
+  if (idx < _cache.size())
+    _cache[idx].generation = 0;
   emit dataChanged(index(idx,0),index(idx,columnCount()-1));
 }
 
+void
+GenericTableWrapper::onConfigModified() {
+  invalidateCache();
+}
+
 
 /* ********************************************************************************************* *
  * Implementation of ChannelListWrapper
@@ -215,7 +284,7 @@ ChannelListWrapper::columnCount(const QModelIndex &index) const {
 }
 
 QVariant
-ChannelListWrapper::data(const QModelIndex &index, int role) const {
+ChannelListWrapper::cellData(const QModelIndex &index, int role) const {
   if (nullptr == _list)
     return QVariant();
 
@@ -492,7 +561,7 @@ RoamingChannelListWrapper::columnCount(const QModelIndex &index) const {
 }
 
 QVariant
-RoamingChannelListWrapper::data(const QModelIndex &index, int role) const {
+RoamingChannelListWrapper::cellData(const QModelIndex &index, int role) const {
   if ((Qt::DisplayRole!=role) || (! index.isValid()) || (index.row() >= _list->count()))
     return QVariant();
 
@@ -588,7 +657,7 @@ ContactListWrapper::columnCount(const QModelIndex &index) const {
 }
 
 QVariant
-ContactListWrapper::data(const QModelIndex &index, int role) const {
+ContactListWrapper::cellData(const QModelIndex &index, int role) const {
   if ((!index.isValid()) || (index.row()>=_list->count()))
     return QVariant();
 
@@ -692,7 +761,7 @@ PositioningSystemListWrapper::columnCount(const QModelIndex &idx) const {
 }
 
 QVariant
-PositioningSystemListWrapper::data(const QModelIndex &index, int role) const {
+PositioningSystemListWrapper::cellData(const QModelIndex &index, int role) const {
   if ((! index.isValid()) || (index.row()>=_list->count()))
     return QVariant();
   if ((Qt::DisplayRole!=role) && (Qt::EditRole!=role))
@@ -874,7 +943,7 @@ RadioIdListWrapper::columnCount(const QModelIndex &idx) const {
 }
 
 QVariant
-RadioIdListWrapper::data(const QModelIndex &index, int role) const {
+RadioIdListWrapper::cellData(const QModelIndex &index, int role) const {
   if ((! index.isValid()) || (index.row()>=_list->count()))
     return QVariant();
   if ((Qt::DisplayRole!=role) && (Qt::EditRole!=role))
@@ -68,10 +68,24 @@ public:
 
   bool canDropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) const;
 
+  /** Implements QAbstractTableModel, returns data at cell. The display, edit and foreground data
+   * is computed once for the entire row and cached until the row or the config gets modified. */
+  QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
+
+  /** Invalidates the cached data of all rows. */
+  void invalidateCache();
+
+  /** Invalidates the cache whenever the palette of the parent widget changes. */
+  bool eventFilter(QObject *obj, QEvent *event);
+
 signals:
   /** Gets emitted once the table has been changed. */
   void modified();
 
+protected:
+  /** Computes the data of the given cell, implemented by the specific wrappers. */
+  virtual QVariant cellData(const QModelIndex &index, int role) const = 0;
+
 protected slots:
   /** Internal used callback on deleted config. */
   void onListDeleted();
@@ -81,12 +95,31 @@ protected slots:
   void onItemRemoved(int idx);
   /** Internal callback on modified channels. */
   void onItemModified(int idx);
+  /** Internal callback on modified config. Cells may show properties of referenced objects
+   * (e.g., names of zones or contacts), hence the entire cache gets invalidated. */
+  void onConfigModified();
 
 protected:
+  /** Cached data of a single row. */
+  struct Row {
+    /** Cache generation, the data was computed for. */
+    unsigned int generation = 0;
+    /** Display data of all columns, empty if not computed yet. */
+    QVector<QVariant> display;
+    /** Edit data of all columns, empty if not computed yet. */
+    QVector<QVariant> edit;
+    /** Foreground data of all columns, empty if not computed yet. */
+    QVector<QVariant> foreground;
+  };
+
   /** Holds a weak reference to the list object. */
   AbstractConfigObjectList *_list;
   /** Insert index for drag & drop move. */
   int _insertRow;
+  /** Per-row cache of the formatted cell data. */
+  mutable QVector<Row> _cache;
+  /** Current cache generation. Rows of an older generation are recomputed. */
+  unsigned int _generation;
 };
 
 
@@ -101,10 +134,12 @@ public:
   // QAbstractTableModel interface
   /** Implements QAbstractTableModel, returns number of columns. */
   int columnCount(const QModelIndex &index) const;
-  /** Implements QAbstractTableModel, returns data at cell. */
-  QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
   /** Implements QAbstractTableModel, returns header at section. */
   QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+
+protected:
+  /** Computes the cell data at given index. */
+  QVariant cellData(const QModelIndex &index, int role) const;
 };
 
 
@@ -135,10 +170,12 @@ public:
   // Implementation of QAbstractTableModel
   /** Returns the number of columns, implements the QAbstractTableModel. */
   int columnCount(const QModelIndex &index) const;
-  /** Returns the cell data at given index, implements the QAbstractTableModel. */
-  QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
   /** Implementation of QAbstractListModel, returns the header data at the given section. */
   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+
+protected:
+  /** Computes the cell data at given index. */
+  QVariant cellData(const QModelIndex &index, int role) const;
 };
 
 
@@ -169,10 +206,12 @@ public:
   // Implementation of QAbstractTableModel
   /** Returns the number of columns, implements the QAbstractTableModel. */
   int columnCount(const QModelIndex &index) const;
-  /** Returns the cell data at given index, implements the QAbstractTableModel. */
-  QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
   /** Returns the header at given section, implements the QAbstractTableModel. */
   QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+
+protected:
+  /** Computes the cell data at given index. */
+  QVariant cellData(const QModelIndex &index, int role) const;
 };
 
 
@@ -203,10 +242,12 @@ public:
   // Implementation of QAbstractTableModel
   /** Returns the number of columns, implements the QAbstractTableModel. */
   int columnCount(const QModelIndex &index) const;
-  /** Returns the cell data at given index, implements the QAbstractTableModel. */
-  QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
   /** Returns the header at given section, implements the QAbstractTableModel. */
   QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+
+protected:
+  /** Computes the cell data at given index. */
+  QVariant cellData(const QModelIndex &index, int role) const;
 };
 
 
@@ -285,10 +326,12 @@ public:
   // Implementation of QAbstractTableModel
   /** Returns the number of columns, implements the QAbstractTableModel. */
   int columnCount(const QModelIndex &index) const;
-  /** Returns the cell data at given index, implements the QAbstractTableModel. */
-  QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
   /** Returns the header at given section, implements the QAbstractTableModel. */
   QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+
+protected:
+  /** Computes the cell data at given index. */
+  QVariant cellData(const QModelIndex &index, int role) const;
 };
 
 
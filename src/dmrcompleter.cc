@@ -0,0 +1,20 @@
+#include "dmrcompleter.hh"
+#include "dmrcompletionmodel.hh"
+
+
+/* ********************************************************************************************* *
+ * Implementation of DMRCompleter
+ * ********************************************************************************************* */
+DMRCompleter::DMRCompleter(DMRCompletionModel *model, QObject *parent)
+  : QCompleter(model, parent), _model(model)
+{
+  // The model holds the matches only, hence there is no need to filter them again
+  setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+  setCaseSensitivity(Qt::CaseInsensitive);
+  setCompletionRole(Qt::EditRole);
+}
+
+void
+DMRCompleter::setPrefix(const QString &prefix) {
+  _model->setPrefix(prefix);
+}
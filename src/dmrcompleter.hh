@@ -0,0 +1,27 @@
+#ifndef DMRCOMPLETER_HH
+#define DMRCOMPLETER_HH
+
+#include <QCompleter>
+
+class DMRCompletionModel;
+
+/** Completer for DMR users and talk groups.
+ * Instead of filtering all rows of a database, the typed prefix is passed to the indexed
+ * @c DMRCompletionModel, which only holds the best matches. Connect the @c textEdited signal of
+ * the line edit to @c setPrefix, to update the matches before the completer shows them. */
+class DMRCompleter: public QCompleter
+{
+  Q_OBJECT
+
+public:
+  DMRCompleter(DMRCompletionModel *model, QObject *parent=nullptr);
+
+public slots:
+  /** Updates the matches of the completion model for the given prefix. */
+  void setPrefix(const QString &prefix);
+
+protected:
+  DMRCompletionModel *_model;
+};
+
+#endif // DMRCOMPLETER_HH
@@ -12,6 +12,8 @@
 #include "contact.hh"
 #include "userdatabase.hh"
 #include "talkgroupdatabase.hh"
+#include "dmrcompletionmodel.hh"
+#include "dmrcompleter.hh"
 #include "settings.hh"
 
 
@@ -22,13 +24,9 @@ DMRContactDialog::DMRContactDialog(UserDatabase *users, TalkGroupDatabase *tgs,
 {
   setWindowTitle(tr("Create DMR Contact"));
 
-  _user_completer = new QCompleter(users, this);
-  _user_completer->setCompletionColumn(0);
-  _user_completer->setCaseSensitivity(Qt::CaseInsensitive);
+  _user_completer = new DMRCompleter(users->completionModel(), this);
 
-  _tg_completer = new QCompleter(tgs, this);
-  _tg_completer->setCompletionColumn(0);
-  _tg_completer->setCaseSensitivity(Qt::CaseInsensitive);
+  _tg_completer = new DMRCompleter(tgs->completionModel(), this);
 
   connect(_user_completer, SIGNAL(activated(QModelIndex)),
           this, SLOT(onCompleterActivated(QModelIndex)));
@@ -46,13 +44,9 @@ DMRContactDialog::DMRContactDialog(DMRContact *contact, UserDatabase *users,
     ui(new Ui::DMRContactDialog)
 {
   setWindowTitle(tr("Edit DMR Contact"));
-  _user_completer = new QCompleter(users, this);
-  _user_completer->setCompletionColumn(0);
-  _user_completer->setCaseSensitivity(Qt::CaseInsensitive);
+  _user_completer = new DMRCompleter(users->completionModel(), this);
 
-  _tg_completer = new QCompleter(tgs, this);
-  _tg_completer->setCompletionColumn(0);
-  _tg_completer->setCaseSensitivity(Qt::CaseInsensitive);
+  _tg_completer = new DMRCompleter(tgs->completionModel(), this);
 
   if (_contact)
     _myContact->copy(*_contact);
@@ -101,6 +95,7 @@ DMRContactDialog::construct() {
     ui->tabWidget->tabBar()->hide();
 
   connect(ui->typeComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(onTypeChanged(int)));
+  connect(ui->nameLineEdit, SIGNAL(textEdited(QString)), this, SLOT(onNameEdited(QString)));
   connect(ui->buttonBox, SIGNAL(accepted()), this, SLOT(accept()));
   connect(ui->buttonBox, SIGNAL(rejected()), this, SLOT(reject()));
 }
@@ -120,33 +115,23 @@ DMRContactDialog::onTypeChanged(int idx) {
     ui->numberLineEdit->setEnabled(false);
     ui->nameLineEdit->setCompleter(nullptr);
   }
+  // Matches of the new completer may refer to an older prefix
+  onNameEdited(ui->nameLineEdit->text());
 }
 
 void
 DMRContactDialog::onCompleterActivated(const QModelIndex &idx) {
-  if (0 == ui->typeComboBox->currentIndex()) { // Private call
-    if (nullptr == _user_completer)
-      return;
-    UserDatabase *db = qobject_cast<UserDatabase *>(_user_completer->model());
-    if (nullptr == db)
-      return;
-    QAbstractProxyModel *model = qobject_cast<QAbstractProxyModel *>(_user_completer->completionModel());
-    if (nullptr == model)
-      return;
-    QModelIndex srcidx = model->mapToSource(idx);
-    ui->numberLineEdit->setText(QString::number(db->user(srcidx.row()).id));
-  } else if (1 == ui->typeComboBox->currentIndex()) { // Group call
-    if (nullptr == _tg_completer)
-      return;
-    TalkGroupDatabase *db = qobject_cast<TalkGroupDatabase *>(_tg_completer->model());
-    if (nullptr == db)
-      return;
-    QAbstractProxyModel *model = qobject_cast<QAbstractProxyModel *>(_tg_completer->completionModel());
-    if (nullptr == model)
-      return;
-    QModelIndex srcidx = model->mapToSource(idx);
-    ui->numberLineEdit->setText(QString::number(db->talkgroup(srcidx.row()).id));
-  }
+  // Index refers to the completer's proxy model, which passes all roles to the completion model
+  unsigned id = idx.data(DMRCompletionModel::IdRole).toUInt();
+  if (id)
+    ui->numberLineEdit->setText(QString::number(id));
+}
+
+void
+DMRContactDialog::onNameEdited(const QString &text) {
+  // Gets emitted before the line edit updates the completer popup
+  if (DMRCompleter *completer = qobject_cast<DMRCompleter *>(ui->nameLineEdit->completer()))
+    completer->setPrefix(text);
 }
 
 DMRContact *
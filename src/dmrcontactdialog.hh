@@ -28,6 +28,7 @@ public:
 protected slots:
   void onTypeChanged(int idx);
   void onCompleterActivated(const QModelIndex &idx);
+  void onNameEdited(const QString &text);
 
 protected:
   void construct();
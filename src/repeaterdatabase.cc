@@ -5,13 +5,57 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QNetworkReply>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
 
 #include "logger.hh"
 #include "utils.hh"
 
 
 
+/** Magic bytes of the binary cache snapshot. */
+#define SNAPSHOT_MAGIC    "QDMRRDB"
+/** Version of the binary cache snapshot format. */
+#define SNAPSHOT_VERSION  1
+/** Marks an unknown location. */
+#define SNAPSHOT_NO_LOCATION std::numeric_limits<int32_t>::min()
+
+/** Internal used header of the binary cache snapshot. All values are little endian. The header is
+ * followed by @c count records and the string pool. */
+struct __attribute__((packed)) snapshot_header {
+  char magic[8];           ///< The magic bytes "QDMRRDB\0".
+  uint32_t version;        ///< The format version.
+  uint32_t count;          ///< The number of records.
+  uint32_t record_size;    ///< The size of each record in bytes.
+  uint32_t pool_offset;    ///< The offset of the string pool.
+  uint32_t pool_size;      ///< The size of the string pool in bytes.
+  uint32_t reserved;       ///< Reserved, set to 0.
+};
+
+/** Internal used fixed-size record of a single entry in the binary cache snapshot. All values
+ * are little endian. */
+struct __attribute__((packed)) snapshot_record {
+  uint8_t type;            ///< The repeater type (RepeaterDatabaseEntry::Type).
+  uint8_t color_code;      ///< The color code of DMR repeaters.
+  uint16_t rx_tone;        ///< The RX tone code, see @c encodeTone.
+  uint16_t tx_tone;        ///< The TX tone code, see @c encodeTone.
+  uint16_t qth_length;     ///< The length of the QTH in bytes, follows the call in the pool.
+  uint64_t rx_frequency;   ///< The RX frequency in Hz.
+  uint64_t tx_frequency;   ///< The TX frequency in Hz.
+  int32_t latitude;        ///< The latitude in 1e-7 degrees or SNAPSHOT_NO_LOCATION.
+  int32_t longitude;       ///< The longitude in 1e-7 degrees.
+  int64_t updated;         ///< The last update in seconds since epoch, 0 if unknown.
+  int64_t loaded;          ///< The time of the download in seconds since epoch, 0 if unknown.
+  uint32_t call_offset;    ///< The offset of the call within the string pool.
+  uint16_t call_length;    ///< The length of the call in bytes.
+  uint16_t reserved;       ///< Reserved, set to 0.
+};
+
+
 /* ********************************************************************************************* *
  * Helper functions
  * ********************************************************************************************* */
@@ -40,6 +84,106 @@ inline QString bandName(const Frequency &rx, const Frequency & tx) {
   return QString("%1/%2").arg(rband,tband);
 }
 
+/** Encodes a selective call as a 16bit code. The upper two bits specify the type (0=none,
+ * 1=CTCSS, 2=DCS, 3=inverted DCS), the lower bits the CTCSS frequency in 0.1Hz or the binary
+ * DCS code. */
+static uint16_t
+encodeTone(const SelectiveCall &tone) {
+  if (tone.isCTCSS())
+    return 0x4000 | ((tone.mHz()/100) & 0x3fff);
+  else if (tone.isDCS())
+    return (tone.isInverted() ? 0xc000 : 0x8000) | (tone.binCode() & 0x3fff);
+  return 0;
+}
+
+/** Decodes a selective call from a 16bit code, see @c encodeTone. */
+static SelectiveCall
+decodeTone(uint16_t code) {
+  switch (code >> 14) {
+  // Half a step offset, as the frequency gets truncated to 0.1Hz
+  case 1: return SelectiveCall(((code & 0x3fff)+0.5)/10);
+  case 2: return SelectiveCall::fromBinaryDCS(code & 0x3fff, false);
+  case 3: return SelectiveCall::fromBinaryDCS(code & 0x3fff, true);
+  default: break;
+  }
+  return SelectiveCall();
+}
+
+static int64_t
+encodeTime(const QDateTime &time) {
+  if (! time.isValid())
+    return 0;
+  return time.toSecsSinceEpoch();
+}
+
+static QDateTime
+decodeTime(int64_t secs) {
+  if (0 == secs)
+    return QDateTime();
+  return QDateTime::fromSecsSinceEpoch(secs);
+}
+
+/** Encodes the entry into the given record and appends the strings to the pool. */
+static void
+encodeRecord(const RepeaterDatabaseEntry &entry, snapshot_record &rec, QByteArray &pool) {
+  QByteArray call = entry.call().toUtf8().left(0xffff), qth = entry.qth().toUtf8().left(0xffff);
+
+  memset(&rec, 0, sizeof(snapshot_record));
+  rec.type = uint8_t(entry.type());
+  rec.color_code = entry.colorCode();
+  rec.rx_tone = qToLittleEndian(encodeTone(entry.rxTone()));
+  rec.tx_tone = qToLittleEndian(encodeTone(entry.txTone()));
+  rec.rx_frequency = qToLittleEndian(uint64_t(entry.rxFrequency().inHz()));
+  rec.tx_frequency = qToLittleEndian(uint64_t(entry.txFrequency().inHz()));
+  if (entry.location().isValid()) {
+    rec.latitude = qToLittleEndian(int32_t(qRound(entry.location().latitude()*1e7)));
+    rec.longitude = qToLittleEndian(int32_t(qRound(entry.location().longitude()*1e7)));
+  } else {
+    rec.latitude = qToLittleEndian(SNAPSHOT_NO_LOCATION);
+  }
+  rec.updated = qToLittleEndian(encodeTime(entry.updated()));
+  rec.loaded = qToLittleEndian(encodeTime(entry.loaded()));
+  rec.call_offset = qToLittleEndian(uint32_t(pool.size()));
+  rec.call_length = qToLittleEndian(uint16_t(call.size()));
+  rec.qth_length = qToLittleEndian(uint16_t(qth.size()));
+  pool.append(call);
+  pool.append(qth);
+}
+
+/** Decodes the entry from the given record. Returns an invalid entry if the record is malformed. */
+static RepeaterDatabaseEntry
+decodeRecord(const snapshot_record &rec, const char *pool, uint32_t poolSize) {
+  uint32_t callOffset = qFromLittleEndian(rec.call_offset);
+  uint16_t callLength = qFromLittleEndian(rec.call_length), qthLength = qFromLittleEndian(rec.qth_length);
+  if ((uint64_t(callOffset) + callLength + qthLength) > poolSize)
+    return RepeaterDatabaseEntry();
+
+  QString call = QString::fromUtf8(pool + callOffset, callLength);
+  QString qth  = QString::fromUtf8(pool + callOffset + callLength, qthLength);
+  Frequency rx = Frequency::fromHz(qFromLittleEndian(rec.rx_frequency));
+  Frequency tx = Frequency::fromHz(qFromLittleEndian(rec.tx_frequency));
+  QGeoCoordinate location;
+  if (SNAPSHOT_NO_LOCATION != int32_t(qFromLittleEndian(rec.latitude)))
+    location = QGeoCoordinate(int32_t(qFromLittleEndian(rec.latitude))/1e7,
+                              int32_t(qFromLittleEndian(rec.longitude))/1e7);
+  QDateTime updated = decodeTime(qFromLittleEndian(rec.updated));
+  QDateTime loaded = decodeTime(qFromLittleEndian(rec.loaded));
+
+  switch (RepeaterDatabaseEntry::Type(rec.type)) {
+  case RepeaterDatabaseEntry::Type::FM:
+    return RepeaterDatabaseEntry::fm(
+          call, rx, tx, location, qth, decodeTone(qFromLittleEndian(rec.rx_tone)),
+          decodeTone(qFromLittleEndian(rec.tx_tone)), updated, loaded);
+  case RepeaterDatabaseEntry::Type::DMR:
+    return RepeaterDatabaseEntry::dmr(
+          call, rx, tx, location, qth, rec.color_code, updated, loaded);
+  default:
+    break;
+  }
+
+  return RepeaterDatabaseEntry();
+}
+
 
 
 /* ********************************************************************************************* *
@@ -339,7 +483,9 @@ CachedRepeaterDatabaseSource::CachedRepeaterDatabaseSource(const QString &filena
     return;
   }
 
-  _cacheFile.setFileName(path + "/" + filename);
+  QFileInfo info(filename);
+  _cacheFile.setFileName(path + "/" + info.completeBaseName() + ".bin");
+  _jsonFile = path + "/" + filename;
 
   loadCache();
 }
@@ -347,25 +493,149 @@ CachedRepeaterDatabaseSource::CachedRepeaterDatabaseSource(const QString &filena
 
 void
 CachedRepeaterDatabaseSource::loadCache() {
+  if (loadSnapshot())
+    return;
+
+  // Migrate JSON cache of previous versions
+  if (QFileInfo::exists(_jsonFile) && importJson(_jsonFile) && saveSnapshot())
+    QFile::remove(_jsonFile);
+}
+
+
+void
+CachedRepeaterDatabaseSource::saveCache() {
+  saveSnapshot();
+}
+
+
+bool
+CachedRepeaterDatabaseSource::loadSnapshot() {
+  if (! _cacheFile.exists())
+    return false;
+
   if (! _cacheFile.open(QIODevice::ReadOnly)) {
     logError() << "Cannot open cache '" << _cacheFile.fileName()
                << "': " << _cacheFile.errorString() << ".";
-    return;
+    return false;
   }
 
-  QJsonParseError error;
-  QJsonDocument doc = QJsonDocument::fromJson(_cacheFile.readAll(), &error);
+  qint64 size = _cacheFile.size();
+  if (size < qint64(sizeof(snapshot_header))) {
+    logError() << "Malformed cache file '" << _cacheFile.fileName() << "': Too small.";
+    _cacheFile.close();
+    return false;
+  }
+
+  const uchar *data = _cacheFile.map(0, size);
+  if (nullptr == data) {
+    logError() << "Cannot mmap cache '" << _cacheFile.fileName()
+               << "': " << _cacheFile.errorString() << ".";
+    _cacheFile.close();
+    return false;
+  }
+
+  const snapshot_header *head = reinterpret_cast<const snapshot_header *>(data);
+  uint32_t count = qFromLittleEndian(head->count);
+  uint32_t poolOffset = qFromLittleEndian(head->pool_offset), poolSize = qFromLittleEndian(head->pool_size);
+  if ((0 != memcmp(head->magic, SNAPSHOT_MAGIC, sizeof(head->magic))) ||
+      (SNAPSHOT_VERSION != qFromLittleEndian(head->version)) ||
+      (sizeof(snapshot_record) != qFromLittleEndian(head->record_size)) ||
+      ((sizeof(snapshot_header) + uint64_t(count)*sizeof(snapshot_record)) > poolOffset) ||
+      ((uint64_t(poolOffset) + poolSize) > uint64_t(size))) {
+    logError() << "Malformed cache file '" << _cacheFile.fileName() << "': Invalid header.";
+    _cacheFile.unmap(const_cast<uchar *>(data));
+    _cacheFile.close();
+    return false;
+  }
+
+  const snapshot_record *records = reinterpret_cast<const snapshot_record *>(data + sizeof(snapshot_header));
+  const char *pool = reinterpret_cast<const char *>(data + poolOffset);
+
+  _cache.clear();
+  _cache.reserve(count);
+  for (uint32_t i=0; i<count; i++) {
+    RepeaterDatabaseEntry entry = decodeRecord(records[i], pool, poolSize);
+    if (! entry.isValid())
+      continue;
+    _cache.append(entry);
+  }
+
+  _cacheFile.unmap(const_cast<uchar *>(data));
   _cacheFile.close();
 
+  for (const RepeaterDatabaseEntry &entry: _cache)
+    emit updated(entry);
+
+  logDebug() << "Loaded " << _cache.size() << " entries from '" << _cacheFile.fileName() << "'.";
+  return true;
+}
+
+
+bool
+CachedRepeaterDatabaseSource::saveSnapshot() {
+  QByteArray records, pool;
+  uint32_t count = 0;
+  records.reserve(_cache.size()*sizeof(snapshot_record));
+  for (const RepeaterDatabaseEntry &entry: _cache) {
+    if (! entry.isValid())
+      continue;
+    snapshot_record rec;
+    encodeRecord(entry, rec, pool);
+    records.append(reinterpret_cast<const char *>(&rec), sizeof(snapshot_record));
+    count++;
+  }
+
+  snapshot_header head;
+  memset(&head, 0, sizeof(snapshot_header));
+  memcpy(head.magic, SNAPSHOT_MAGIC, sizeof(head.magic));
+  head.version = qToLittleEndian(uint32_t(SNAPSHOT_VERSION));
+  head.count = qToLittleEndian(count);
+  head.record_size = qToLittleEndian(uint32_t(sizeof(snapshot_record)));
+  head.pool_offset = qToLittleEndian(uint32_t(sizeof(snapshot_header) + records.size()));
+  head.pool_size = qToLittleEndian(uint32_t(pool.size()));
+
+  // Write atomically, a running instance may still map the old snapshot
+  QSaveFile file(_cacheFile.fileName());
+  if (! file.open(QIODevice::WriteOnly)) {
+    logError() << "Cannot open cache '" << file.fileName()
+               << "': " << file.errorString() << ".";
+    return false;
+  }
+  file.write(reinterpret_cast<const char *>(&head), sizeof(snapshot_header));
+  file.write(records);
+  file.write(pool);
+  if (! file.commit()) {
+    logError() << "Cannot write cache '" << file.fileName()
+               << "': " << file.errorString() << ".";
+    return false;
+  }
+
+  return true;
+}
+
+
+bool
+CachedRepeaterDatabaseSource::importJson(const QString &filename) {
+  QFile file(filename);
+  if (! file.open(QIODevice::ReadOnly)) {
+    logError() << "Cannot open cache '" << filename
+               << "': " << file.errorString() << ".";
+    return false;
+  }
+
+  QJsonParseError error;
+  QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+  file.close();
+
   if (doc.isNull()) {
-    logError() << "Cannot parse cache '" << _cacheFile.fileName()
+    logError() << "Cannot parse cache '" << filename
                << "': " << error.errorString() << ".";
-    return;
+    return false;
   }
 
   if (! doc.isArray()) {
     logError() << "Malformed cache file.";
-    return;
+    return false;
   }
 
   _cache.clear();
@@ -379,27 +649,32 @@ CachedRepeaterDatabaseSource::loadCache() {
     emit updated(entry);
   }
 
-  logDebug() << "Loaded " << _cache.size() << " entries from '" << _cacheFile.fileName() << "'.";
+  logDebug() << "Imported " << _cache.size() << " entries from '" << filename << "'.";
+  return true;
 }
 
 
-void
-CachedRepeaterDatabaseSource::saveCache() {
-  if (! _cacheFile.open(QIODevice::WriteOnly)) {
-    logError() << "Cannot open cache '" << _cacheFile.fileName()
-               << "': " << _cacheFile.errorString() << ".";
-    return;
+bool
+CachedRepeaterDatabaseSource::exportJson(const QString &filename) const {
+  QFile file(filename);
+  if (! file.open(QIODevice::WriteOnly)) {
+    logError() << "Cannot open cache '" << filename
+               << "': " << file.errorString() << ".";
+    return false;
   }
 
   QJsonArray entries;
   for (auto entry: _cache)
     entries.append(entry.toJson());
-  if (! _cacheFile.write(QJsonDocument(entries).toJson())) {
-    logError() << "Cannot write cache '" << _cacheFile.fileName()
-               << "': " << _cacheFile.errorString() << ".";
+  if (! file.write(QJsonDocument(entries).toJson())) {
+    logError() << "Cannot write cache '" << filename
+               << "': " << file.errorString() << ".";
+    file.close();
+    return false;
   }
-  _cacheFile.flush();
-  _cacheFile.close();
+  file.flush();
+  file.close();
+  return true;
 }
 
 
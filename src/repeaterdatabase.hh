@@ -145,7 +145,11 @@ protected:
 
 
 
-/** Base class for all cached database sources. */
+/** Base class for all cached database sources.
+ *
+ * The cache is stored as a versioned binary snapshot of fixed-size records and a string pool,
+ * that gets memory mapped at startup. JSON is only used to import and export the cache. If no
+ * snapshot exists, a JSON cache with the given filename is imported once. */
 class CachedRepeaterDatabaseSource: public RepeaterDatabaseSource
 {
   Q_OBJECT
@@ -159,14 +163,27 @@ public:
 
   bool query(const QString &call, const QGeoCoordinate &pos=QGeoCoordinate());
 
+  /** Imports all entries from the given JSON file. */
+  bool importJson(const QString &filename);
+  /** Exports all entries into the given JSON file. */
+  bool exportJson(const QString &filename) const;
+
 protected:
   void loadCache();
   void cache(const RepeaterDatabaseEntry &entry);
   void saveCache();
 
+  /** Loads the binary snapshot. */
+  bool loadSnapshot();
+  /** Writes the binary snapshot. */
+  bool saveSnapshot();
+
 protected:
   unsigned int _maxAge;
+  /** The binary snapshot. */
   QFile _cacheFile;
+  /** The JSON cache of previous versions. */
+  QString _jsonFile;
   QMap<RepeaterDatabaseEntry, unsigned int> _indices;
   QVector<RepeaterDatabaseEntry> _cache;
 };
@@ -142,6 +142,32 @@ ChirpTest::testReaderCross()
 }
 
 
+void
+ChirpTest::testReaderQuotedLarge() {
+  // Enough lines to be processed in parallel, names are quoted and contain commas
+  QString csv("Location,Name,Frequency,Duplex,Offset,Tone,rToneFreq,cToneFreq,DtcsCode,"
+              "DtcsPolarity,RxDtcsCode,CrossMode,Mode\r\n");
+  const int n = 1000;
+  for (int i=0; i<n; i++)
+    csv.append(QString("%1,\"CH %1, \"\"R\"\"\",%2,+,0.600000,Tone,%3,67.0,023,NN,023,Tone->Tone,FM\r\n")
+               .arg(i).arg(QString::number(double(100+i), 'f', 6)).arg(i%2 ? "88.5" : "67.0"));
+
+  QTextStream stream(&csv);
+  Config config;
+  ErrorStack err;
+  if (! ChirpReader::read(stream, &config, err))
+    QFAIL(QString("Cannot read CHIRP CSV:\n%1").arg(err.format()).toStdString().c_str());
+
+  QCOMPARE(config.channelList()->count(), n);
+  for (int i=0; i<n; i++) {
+    FMChannel *fm = config.channelList()->channel(i)->as<FMChannel>();
+    QCOMPARE(fm->name(), QString("CH %1, R").arg(i));
+    QCOMPARE(fm->rxFrequency(), Frequency::fromHz(100000000ULL+i*1000000ULL));
+    QCOMPARE(fm->txFrequency(), Frequency::fromHz(100600000ULL+i*1000000ULL));
+    QCOMPARE(fm->txTone(), SelectiveCall(i%2 ? 88.5 : 67.0));
+  }
+}
+
 void
 ChirpTest::testWriterBasic() {
   Config orig;
@@ -0,0 +1,395 @@
+#include "codeplugbench.hh"
+#include "config.hh"
+#include "codeplug.hh"
+#include "radiolimits.hh"
+#include "errorstack.hh"
+
+#include "d868uv_codeplug.hh"
+#include "d868uv_limits.hh"
+#include "d878uv_codeplug.hh"
+#include "d878uv_limits.hh"
+#include "d878uv2_codeplug.hh"
+#include "d878uv2_limits.hh"
+#include "d578uv_codeplug.hh"
+#include "d578uv_limits.hh"
+#include "dmr6x2uv_codeplug.hh"
+#include "dmr6x2uv_limits.hh"
+#include "rd5r_codeplug.hh"
+#include "rd5r_limits.hh"
+#include "gd77_codeplug.hh"
+#include "gd77_limits.hh"
+#include "opengd77_codeplug.hh"
+#include "opengd77_limits.hh"
+#include "openrtx_codeplug.hh"
+#include "md390_codeplug.hh"
+#include "md390_limits.hh"
+#include "uv390_codeplug.hh"
+#include "uv390_limits.hh"
+#include "md2017_codeplug.hh"
+#include "md2017_limits.hh"
+#include "dm1701_codeplug.hh"
+#include "dm1701_limits.hh"
+#include "dr1801uv_codeplug.hh"
+#include "dr1801uv_limits.hh"
+#include "gd73_codeplug.hh"
+#include "gd73_limits.hh"
+
+#include <QTest>
+#include <QTemporaryFile>
+#include <QTextStream>
+
+static const QStringList radios = {
+  "d868uve", "d878uv", "d878uv2", "d578uv", "dmr6x2uv",
+  "rd5r", "gd77", "opengd77", "openrtx",
+  "md390", "uv390", "md2017", "dm1701",
+  "dr1801uv", "gd73"
+};
+
+static const QList<QPair<QString, double>> scales = {
+  {"small", 0.1}, {"full", 1.0}
+};
+
+
+CodeplugBench::CodeplugBench(QObject *parent)
+  : QObject(parent)
+{
+  // pass...
+}
+
+void
+CodeplugBench::addRadioRows() {
+  QTest::addColumn<QString>("radio");
+  QTest::addColumn<double>("scale");
+  foreach (QString radio, radios) {
+    for (auto scale: scales)
+      QTest::newRow(QString("%1/%2").arg(radio, scale.first).toLocal8Bit().constData())
+          << radio << scale.second;
+  }
+}
+
+void
+CodeplugBench::addSizeRows() {
+  QTest::addColumn<double>("scale");
+  for (auto scale: scales)
+    QTest::newRow(scale.first.toLocal8Bit().constData()) << scale.second;
+}
+
+SyntheticConfig::Size
+CodeplugBench::radioSize(const QString &radio) {
+  if (("d868uve" == radio) || ("d878uv" == radio) || ("d878uv2" == radio)
+      || ("d578uv" == radio) || ("dmr6x2uv" == radio))
+    return SyntheticConfig::Full;
+  if ("rd5r" == radio)
+    return {1024, 256, 250, 64};
+  if ("gd77" == radio)
+    return {1024, 1024, 250, 76};
+  if ("opengd77" == radio)
+    return {1024, 1024, 68, 76};
+  if ("openrtx" == radio)
+    return {1024, 1024, 250, 64};
+  if ("md390" == radio)
+    return {1000, 10000, 250, 250};
+  if (("uv390" == radio) || ("md2017" == radio) || ("dm1701" == radio))
+    return {3000, 10000, 250, 250};
+  if ("dr1801uv" == radio)
+    return {1024, 1024, 150, 64};
+  if ("gd73" == radio)
+    return {1024, 1024, 64, 16};
+  return SyntheticConfig::Full;
+}
+
+Codeplug *
+CodeplugBench::createCodeplug(const QString &radio) {
+  if ("d868uve" == radio)
+    return new D868UVCodeplug();
+  else if ("d878uv" == radio)
+    return new D878UVCodeplug();
+  else if ("d878uv2" == radio)
+    return new D878UV2Codeplug();
+  else if ("d578uv" == radio)
+    return new D578UVCodeplug();
+  else if ("dmr6x2uv" == radio)
+    return new DMR6X2UVCodeplug();
+  else if ("rd5r" == radio)
+    return new RD5RCodeplug();
+  else if ("gd77" == radio)
+    return new GD77Codeplug();
+  else if ("opengd77" == radio)
+    return new OpenGD77Codeplug();
+  else if ("openrtx" == radio)
+    return new OpenRTXCodeplug();
+  else if ("md390" == radio)
+    return new MD390Codeplug();
+  else if ("uv390" == radio)
+    return new UV390Codeplug();
+  else if ("md2017" == radio)
+    return new MD2017Codeplug();
+  else if ("dm1701" == radio)
+    return new DM1701Codeplug();
+  else if ("dr1801uv" == radio)
+    return new DR1801UVCodeplug();
+  else if ("gd73" == radio)
+    return new GD73Codeplug();
+  return nullptr;
+}
+
+RadioLimits *
+CodeplugBench::createLimits(const QString &radio) {
+  if ("d868uve" == radio)
+    return new D868UVLimits({{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                             {Frequency::fromMHz(400), Frequency::fromMHz(480)}},
+                            {{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                             {Frequency::fromMHz(400), Frequency::fromMHz(480)}}, "");
+  else if ("d878uv" == radio)
+    return new D878UVLimits({{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                             {Frequency::fromMHz(400), Frequency::fromMHz(480)}},
+                            {{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                             {Frequency::fromMHz(400), Frequency::fromMHz(480)}}, "");
+  else if ("d878uv2" == radio)
+    return new D878UV2Limits({{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                              {Frequency::fromMHz(400), Frequency::fromMHz(480)}},
+                             {{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                              {Frequency::fromMHz(400), Frequency::fromMHz(480)}}, "");
+  else if ("d578uv" == radio)
+    return new D578UVLimits({{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                             {Frequency::fromMHz(400), Frequency::fromMHz(480)}},
+                            {{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                             {Frequency::fromMHz(400), Frequency::fromMHz(480)}}, "");
+  else if ("dmr6x2uv" == radio)
+    return new DMR6X2UVLimits({{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                               {Frequency::fromMHz(400), Frequency::fromMHz(480)}},
+                              {{Frequency::fromMHz(136), Frequency::fromMHz(174)},
+                               {Frequency::fromMHz(400), Frequency::fromMHz(480)}}, "");
+  else if ("rd5r" == radio)
+    return new RD5RLimits();
+  else if ("gd77" == radio)
+    return new GD77Limits();
+  else if ("opengd77" == radio)
+    return new OpenGD77Limits();
+  else if ("md390" == radio)
+    return new MD390Limits({{Frequency::fromMHz(400), Frequency::fromMHz(480)}});
+  else if ("uv390" == radio)
+    return new UV390Limits();
+  else if ("md2017" == radio)
+    return new MD2017Limits();
+  else if ("dm1701" == radio)
+    return new DM1701Limits();
+  else if ("dr1801uv" == radio)
+    return new DR1801UVLimits();
+  else if ("gd73" == radio)
+    return new GD73Limits();
+  return nullptr;
+}
+
+
+void
+CodeplugBench::benchmarkPreprocess_data() {
+  addRadioRows();
+}
+
+void
+CodeplugBench::benchmarkPreprocess() {
+  QFETCH(QString, radio);
+  QFETCH(double, scale);
+
+  Config *config = SyntheticConfig::generate(radioSize(radio).scaled(scale), this);
+  Codeplug *codeplug = createCodeplug(radio);
+  QVERIFY(nullptr != codeplug);
+
+  ErrorStack err;
+  QBENCHMARK {
+    Config *intermediate = codeplug->preprocess(config, err);
+    if (nullptr == intermediate)
+      QFAIL(QString("Cannot preprocess config for %1: %2")
+            .arg(radio, err.format()).toLocal8Bit().constData());
+    delete intermediate;
+  }
+
+  delete codeplug;
+  delete config;
+}
+
+
+void
+CodeplugBench::benchmarkEncode_data() {
+  addRadioRows();
+}
+
+void
+CodeplugBench::benchmarkEncode() {
+  QFETCH(QString, radio);
+  QFETCH(double, scale);
+
+  Config *config = SyntheticConfig::generate(radioSize(radio).scaled(scale), this);
+  Codeplug *codeplug = createCodeplug(radio);
+  QVERIFY(nullptr != codeplug);
+
+  ErrorStack err;
+  Config *intermediate = codeplug->preprocess(config, err);
+  if (nullptr == intermediate)
+    QFAIL(QString("Cannot preprocess config for %1: %2")
+          .arg(radio, err.format()).toLocal8Bit().constData());
+
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  QBENCHMARK {
+    if (! codeplug->encode(intermediate, flags, err))
+      QFAIL(QString("Cannot encode config for %1: %2")
+            .arg(radio, err.format()).toLocal8Bit().constData());
+  }
+
+  delete intermediate;
+  delete codeplug;
+  delete config;
+}
+
+
+void
+CodeplugBench::benchmarkDecode_data() {
+  addRadioRows();
+}
+
+void
+CodeplugBench::benchmarkDecode() {
+  QFETCH(QString, radio);
+  QFETCH(double, scale);
+
+  Config *config = SyntheticConfig::generate(radioSize(radio).scaled(scale), this);
+  Codeplug *codeplug = createCodeplug(radio);
+  QVERIFY(nullptr != codeplug);
+
+  ErrorStack err;
+  Config *intermediate = codeplug->preprocess(config, err);
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  if ((nullptr == intermediate) || (! codeplug->encode(intermediate, flags, err)))
+    QFAIL(QString("Cannot encode config for %1: %2")
+          .arg(radio, err.format()).toLocal8Bit().constData());
+  delete intermediate;
+
+  QBENCHMARK {
+    Config decoded;
+    if (! codeplug->decode(&decoded, err))
+      QFAIL(QString("Cannot decode codeplug for %1: %2")
+            .arg(radio, err.format()).toLocal8Bit().constData());
+  }
+
+  delete codeplug;
+  delete config;
+}
+
+
+void
+CodeplugBench::benchmarkPostprocess_data() {
+  addRadioRows();
+}
+
+void
+CodeplugBench::benchmarkPostprocess() {
+  QFETCH(QString, radio);
+  QFETCH(double, scale);
+
+  Config *config = SyntheticConfig::generate(radioSize(radio).scaled(scale), this);
+  Codeplug *codeplug = createCodeplug(radio);
+  QVERIFY(nullptr != codeplug);
+
+  ErrorStack err;
+  Config *intermediate = codeplug->preprocess(config, err);
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  if ((nullptr == intermediate) || (! codeplug->encode(intermediate, flags, err)))
+    QFAIL(QString("Cannot encode config for %1: %2")
+          .arg(radio, err.format()).toLocal8Bit().constData());
+  delete intermediate;
+
+  Config decoded;
+  if (! codeplug->decode(&decoded, err))
+    QFAIL(QString("Cannot decode codeplug for %1: %2")
+          .arg(radio, err.format()).toLocal8Bit().constData());
+
+  // Post-processing is idempotent, hence it can be repeated on the same config
+  QBENCHMARK {
+    if (! codeplug->postprocess(&decoded, err))
+      QFAIL(QString("Cannot postprocess config for %1: %2")
+            .arg(radio, err.format()).toLocal8Bit().constData());
+  }
+
+  delete codeplug;
+  delete config;
+}
+
+
+void
+CodeplugBench::benchmarkVerify_data() {
+  addRadioRows();
+}
+
+void
+CodeplugBench::benchmarkVerify() {
+  QFETCH(QString, radio);
+  QFETCH(double, scale);
+
+  RadioLimits *limits = createLimits(radio);
+  if (nullptr == limits)
+    QSKIP("No limits defined for this radio.");
+
+  Config *config = SyntheticConfig::generate(radioSize(radio).scaled(scale), this);
+  QBENCHMARK {
+    RadioLimitContext ctx(true);
+    limits->verifyConfig(config, ctx);
+  }
+
+  delete limits;
+  delete config;
+}
+
+
+void
+CodeplugBench::benchmarkWriteYAML_data() {
+  addSizeRows();
+}
+
+void
+CodeplugBench::benchmarkWriteYAML() {
+  QFETCH(double, scale);
+
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(scale), this);
+  ErrorStack err;
+  QBENCHMARK {
+    QString buffer;
+    QTextStream stream(&buffer);
+    if (! config->toYAML(stream, err))
+      QFAIL(QString("Cannot serialize config: %1").arg(err.format()).toLocal8Bit().constData());
+  }
+
+  delete config;
+}
+
+
+void
+CodeplugBench::benchmarkReadYAML_data() {
+  addSizeRows();
+}
+
+void
+CodeplugBench::benchmarkReadYAML() {
+  QFETCH(double, scale);
+
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(scale), this);
+  ErrorStack err;
+
+  QTemporaryFile file;
+  QVERIFY(file.open());
+  QTextStream stream(&file);
+  if (! config->toYAML(stream, err))
+    QFAIL(QString("Cannot serialize config: %1").arg(err.format()).toLocal8Bit().constData());
+  stream.flush();
+  file.close();
+  delete config;
+
+  QBENCHMARK {
+    Config parsed;
+    if (! parsed.readYAML(file.fileName(), err))
+      QFAIL(QString("Cannot parse config: %1").arg(err.format()).toLocal8Bit().constData());
+  }
+}
+
+
+QTEST_GUILESS_MAIN(CodeplugBench)
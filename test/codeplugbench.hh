@@ -0,0 +1,57 @@
+#ifndef CODEPLUGBENCH_HH
+#define CODEPLUGBENCH_HH
+
+#include <QObject>
+#include "syntheticconfig.hh"
+
+class Codeplug;
+class RadioLimits;
+
+/** Benchmarks the codeplug encoding and decoding of all radios using synthetic configs.
+ *
+ * Each benchmark is data driven by radio and config size. The full config is sized at the limits
+ * of the radio (e.g., 4000 channels, 10000 contacts, 250 zones and 250 group lists for the AnyTone
+ * radios), the small config is 10% of that. Use the QtTest output options to obtain
+ * machine-readable results, e.g.,
+ * @code
+ * codeplugbench -o results.xml,xml
+ * codeplugbench -csv
+ * @endcode */
+class CodeplugBench : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit CodeplugBench(QObject *parent = nullptr);
+
+private slots:
+  void benchmarkPreprocess_data();
+  void benchmarkPreprocess();
+  void benchmarkEncode_data();
+  void benchmarkEncode();
+  void benchmarkDecode_data();
+  void benchmarkDecode();
+  void benchmarkPostprocess_data();
+  void benchmarkPostprocess();
+  void benchmarkVerify_data();
+  void benchmarkVerify();
+
+  void benchmarkWriteYAML_data();
+  void benchmarkWriteYAML();
+  void benchmarkReadYAML_data();
+  void benchmarkReadYAML();
+
+protected:
+  /** Adds a row for every radio and config size. */
+  void addRadioRows();
+  /** Adds a row for every config size, using the size of the largest radios. */
+  void addSizeRows();
+  /** Returns the size of a config at the limits of the given radio. */
+  static SyntheticConfig::Size radioSize(const QString &radio);
+  /** Creates a codeplug for the given radio key. */
+  static Codeplug *createCodeplug(const QString &radio);
+  /** Creates the limits for the given radio key, may return @c nullptr. */
+  static RadioLimits *createLimits(const QString &radio);
+};
+
+#endif // CODEPLUGBENCH_HH
@@ -0,0 +1,112 @@
+#include "codeplugcachetest.hh"
+#include "codeplugcache.hh"
+#include "rd5r_codeplug.hh"
+#include "errorstack.hh"
+#include <QTemporaryDir>
+#include <QTest>
+
+CodeplugCacheTest::CodeplugCacheTest(QObject *parent)
+  : UnitTestBase(parent)
+{
+  // pass...
+}
+
+void
+CodeplugCacheTest::testKey() {
+  ErrorStack err;
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+
+  QByteArray key = CodeplugCache::key(&_basicConfig, "rd5r", flags, err);
+  if (key.isEmpty())
+    QFAIL(err.format().toLocal8Bit().constData());
+
+  // Same config, radio and flags -> same key
+  QCOMPARE(CodeplugCache::key(&_basicConfig, "rd5r", flags, err), key);
+  // Different radio, flags or config -> different key
+  QVERIFY(key != CodeplugCache::key(&_basicConfig, "gd77", flags, err));
+  flags.autoEnableGPS = true;
+  QVERIFY(key != CodeplugCache::key(&_basicConfig, "rd5r", flags, err));
+  flags.autoEnableGPS = false;
+  QVERIFY(key != CodeplugCache::key(&_channelFrequencyConfig, "rd5r", flags, err));
+}
+
+void
+CodeplugCacheTest::testRoundTrip() {
+  ErrorStack err;
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  CodeplugCache cache(dir.path());
+
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  QByteArray key = CodeplugCache::key(&_basicConfig, "rd5r", flags, err);
+  QVERIFY(! cache.contains(key));
+
+  RD5RCodeplug codeplug;
+  if (! codeplug.encode(&_basicConfig, flags, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  if (! cache.store(key, flags, codeplug, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QVERIFY(cache.contains(key));
+
+  DFUFile cached;
+  if (! cache.load(key, flags, cached, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QCOMPARE(cached.numImages(), codeplug.numImages());
+  QCOMPARE(cached.memSize(), codeplug.memSize());
+
+  QVERIFY(cache.clear());
+  QVERIFY(! cache.contains(key));
+}
+
+void
+CodeplugCacheTest::testVerify() {
+  ErrorStack err;
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  CodeplugCache cache(dir.path());
+
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  QByteArray key = CodeplugCache::key(&_basicConfig, "rd5r", flags, err);
+
+  RD5RCodeplug codeplug;
+  if (! codeplug.encode(&_basicConfig, flags, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QVERIFY(! cache.verify(key, codeplug));
+  QVERIFY(cache.store(key, flags, codeplug, err));
+  if (! cache.verify(key, codeplug, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+
+  // Modify the encoded codeplug
+  codeplug.image(0).element(0).data()[0] = ~codeplug.image(0).element(0).data()[0];
+  QVERIFY(! cache.verify(key, codeplug));
+}
+
+void
+CodeplugCacheTest::testUpdatedNotCached() {
+  ErrorStack err;
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  CodeplugCache cache(dir.path());
+
+  Codeplug::Flags fresh; fresh.updateCodePlug = false;
+  Codeplug::Flags update; update.updateCodePlug = true;
+  QVERIFY(CodeplugCache::isCacheable(fresh));
+  QVERIFY(! CodeplugCache::isCacheable(update));
+
+  RD5RCodeplug codeplug;
+  if (! codeplug.encode(&_basicConfig, fresh, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+
+  // Updated codeplugs are refused
+  QByteArray key = CodeplugCache::key(&_basicConfig, "rd5r", update, err);
+  QVERIFY(! cache.store(key, update, codeplug));
+  QVERIFY(! cache.contains(key));
+
+  // and never looked up, even if there is an entry for the key
+  QVERIFY(cache.store(key, fresh, codeplug, err));
+  DFUFile cached;
+  QVERIFY(! cache.load(key, update, cached));
+  QVERIFY(cache.load(key, fresh, cached, err));
+}
+
+QTEST_GUILESS_MAIN(CodeplugCacheTest)
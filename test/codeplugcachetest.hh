@@ -0,0 +1,20 @@
+#ifndef CODEPLUGCACHETEST_HH
+#define CODEPLUGCACHETEST_HH
+
+#include "libdmrconfigtest.hh"
+
+class CodeplugCacheTest : public UnitTestBase
+{
+  Q_OBJECT
+
+public:
+  explicit CodeplugCacheTest(QObject *parent = nullptr);
+
+private slots:
+  void testKey();
+  void testRoundTrip();
+  void testVerify();
+  void testUpdatedNotCached();
+};
+
+#endif // CODEPLUGCACHETEST_HH
@@ -0,0 +1,121 @@
+#include "compacttabletest.hh"
+#include "compacttable.hh"
+#include "syntheticconfig.hh"
+#include "configcopyvisitor.hh"
+#include <QTest>
+
+CompactTableTest::CompactTableTest(QObject *parent)
+  : UnitTestBase(parent)
+{
+  // pass...
+}
+
+void
+CompactTableTest::testContacts() {
+  DMRContactTable table(_basicConfig.contacts());
+  QCOMPARE(table.count(), _basicConfig.contacts()->digitalCount());
+
+  QCOMPARE(table.name(0), QString("Local"));
+  QCOMPARE(table.number(0), 9U);
+  QCOMPARE(table.type(0), DMRContact::GroupCall);
+  QCOMPARE(table.find(262999, DMRContact::PrivateCall), 4);
+  QCOMPARE(table.find(262999, DMRContact::GroupCall), -1);
+
+  for (int i=0; i<table.count(); i++) {
+    DMRContact *orig = _basicConfig.contacts()->contact(i)->as<DMRContact>();
+    DMRContact *contact = table.materialize(i);
+    QCOMPARE(contact->name(), orig->name());
+    QCOMPARE(contact->number(), orig->number());
+    QCOMPARE(contact->type(), orig->type());
+    QCOMPARE(contact->ring(), orig->ring());
+    delete contact;
+  }
+}
+
+void
+CompactTableTest::testChannels() {
+  // Synthetic config contains FM and DMR channels
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(0.01));
+  ChannelTable table(config);
+  QCOMPARE(table.count(), config->channelList()->count());
+
+  for (int i=0; i<table.count(); i++) {
+    Channel *orig = config->channelList()->channel(i);
+    Channel *channel = table.materialize(i, config);
+    QCOMPARE(channel->name(), orig->name());
+    QCOMPARE(channel->rxFrequency(), orig->rxFrequency());
+    QCOMPARE(channel->txFrequency(), orig->txFrequency());
+    QCOMPARE(channel->rxOnly(), orig->rxOnly());
+    QCOMPARE(channel->defaultPower(), orig->defaultPower());
+    if (! orig->defaultPower())
+      QCOMPARE(channel->power(), orig->power());
+    QCOMPARE(channel->timeout(), orig->timeout());
+    QCOMPARE(channel->vox(), orig->vox());
+    QCOMPARE(channel->scanList(), orig->scanList());
+    QCOMPARE(table.isDMR(i), orig->is<DMRChannel>());
+    if (orig->is<DMRChannel>()) {
+      QVERIFY(channel->is<DMRChannel>());
+      DMRChannel *a = channel->as<DMRChannel>(), *b = orig->as<DMRChannel>();
+      QCOMPARE(a->colorCode(), b->colorCode());
+      QCOMPARE(a->timeSlot(), b->timeSlot());
+      QCOMPARE(a->admit(), b->admit());
+      QCOMPARE(a->groupListObj(), b->groupListObj());
+      QCOMPARE(a->txContactObj(), b->txContactObj());
+      QCOMPARE(a->radioIdObj(), b->radioIdObj());
+      QCOMPARE(a->roamingZone(), b->roamingZone());
+    } else {
+      QVERIFY(channel->is<FMChannel>());
+      FMChannel *a = channel->as<FMChannel>(), *b = orig->as<FMChannel>();
+      QCOMPARE(a->squelch(), b->squelch());
+      QCOMPARE(a->rxTone(), b->rxTone());
+      QCOMPARE(a->txTone(), b->txTone());
+      QCOMPARE(a->bandwidth(), b->bandwidth());
+      QCOMPARE(a->admit(), b->admit());
+    }
+    delete channel;
+  }
+
+  delete config;
+}
+
+void
+CompactTableTest::testCompactConfig() {
+  ErrorStack err;
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(0.01));
+  // A channel outside of any zone, calling a private contact
+  DMRChannel *unlisted = new DMRChannel();
+  unlisted->setName("Unlisted");
+  unlisted->setRXFrequency(Frequency::fromMHz(439.5625));
+  unlisted->setTXFrequency(Frequency::fromMHz(431.9625));
+  unlisted->setTXContactObj(config->contacts()->contact(1)->as<DMRContact>());
+  config->channelList()->add(unlisted);
+  config->setModified(false);
+
+  Config *reference = ConfigCopy::copy(config, err)->as<Config>();
+  if (nullptr == reference)
+    QFAIL(err.format().toStdString().c_str());
+
+  // All private calls are compacted, the group calls are referenced by group lists and channels
+  int contacts = config->contacts()->count(), channels = config->channelList()->count();
+  QVERIFY(0 < config->compact());
+  QCOMPARE(config->channelList()->compactedCount(), 1);
+  QCOMPARE(config->channelList()->count(), channels-1);
+  QCOMPARE(config->contacts()->compactedCount(), contacts - contacts/10);
+  QCOMPARE(config->contacts()->count(), contacts/10);
+  QVERIFY(! config->isMaterialized());
+  QVERIFY(config->contacts()->isDeferred());
+  QVERIFY(! config->isModified());
+
+  QVERIFY(config->materialize(err));
+  QCOMPARE(config->contacts()->compactedCount(), 0);
+  QCOMPARE(config->channelList()->compactedCount(), 0);
+  QCOMPARE(config->channelList()->channel(channels-1)->as<DMRChannel>()->txContactObj(),
+           config->contacts()->contact(1)->as<DMRContact>());
+  QVERIFY(! config->isModified());
+  QCOMPARE(config->compare(*reference), 0);
+
+  delete reference;
+  delete config;
+}
+
+QTEST_GUILESS_MAIN(CompactTableTest)
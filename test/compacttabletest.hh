@@ -0,0 +1,19 @@
+#ifndef COMPACTTABLETEST_HH
+#define COMPACTTABLETEST_HH
+
+#include "libdmrconfigtest.hh"
+
+class CompactTableTest : public UnitTestBase
+{
+  Q_OBJECT
+
+public:
+  explicit CompactTableTest(QObject *parent = nullptr);
+
+private slots:
+  void testContacts();
+  void testChannels();
+  void testCompactConfig();
+};
+
+#endif // COMPACTTABLETEST_HH
@@ -0,0 +1,81 @@
+#include "configbinarytest.hh"
+#include "configbinary.hh"
+#include "syntheticconfig.hh"
+#include <QBuffer>
+#include <QTest>
+
+ConfigBinaryTest::ConfigBinaryTest(QObject *parent)
+  : UnitTestBase(parent)
+{
+  // pass...
+}
+
+bool
+ConfigBinaryTest::roundTrip(Config *config, Config *other, ErrorStack &err) {
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  if (! config->toBinary(buffer, err))
+    return false;
+  buffer.seek(0);
+  if (! ConfigBinary::isBinary(buffer))
+    return false;
+  return ConfigBinary::read(other, buffer, err);
+}
+
+void
+ConfigBinaryTest::testRoundTrip() {
+  ErrorStack err;
+  Config config;
+  if (! roundTrip(&_basicConfig, &config, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QCOMPARE(config.compare(_basicConfig), 0);
+
+  if (! roundTrip(&_channelFrequencyConfig, &config, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QCOMPARE(config.compare(_channelFrequencyConfig), 0);
+}
+
+void
+ConfigBinaryTest::testRoundTripRoaming() {
+  ErrorStack err;
+  Config config;
+  if (! roundTrip(&_roamingConfig, &config, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QCOMPARE(config.compare(_roamingConfig), 0);
+}
+
+void
+ConfigBinaryTest::testRoundTripSynthetic() {
+  ErrorStack err;
+  Config *orig = SyntheticConfig::generate(SyntheticConfig::Full.scaled(0.1));
+  Config config;
+  if (! roundTrip(orig, &config, err))
+    QFAIL(err.format().toLocal8Bit().constData());
+  QCOMPARE(config.compare(*orig), 0);
+  delete orig;
+}
+
+void
+ConfigBinaryTest::testInvalid() {
+  ErrorStack err;
+  Config config;
+
+  // YAML is not a binary config
+  QBuffer yaml;
+  yaml.setData("version: 0.12.0\n");
+  yaml.open(QIODevice::ReadOnly);
+  QVERIFY(! ConfigBinary::isBinary(yaml));
+  QVERIFY(! ConfigBinary::read(&config, yaml, err));
+
+  // Truncated binary config
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  QVERIFY(_basicConfig.toBinary(buffer, err));
+  QBuffer truncated;
+  truncated.setData(buffer.data().left(buffer.size()/2));
+  truncated.open(QIODevice::ReadOnly);
+  QVERIFY(ConfigBinary::isBinary(truncated));
+  QVERIFY(! ConfigBinary::read(&config, truncated, err));
+}
+
+QTEST_GUILESS_MAIN(ConfigBinaryTest)
@@ -0,0 +1,24 @@
+#ifndef CONFIGBINARYTEST_HH
+#define CONFIGBINARYTEST_HH
+
+#include "libdmrconfigtest.hh"
+
+class ConfigBinaryTest : public UnitTestBase
+{
+  Q_OBJECT
+
+public:
+  explicit ConfigBinaryTest(QObject *parent = nullptr);
+
+private slots:
+  void testRoundTrip();
+  void testRoundTripRoaming();
+  void testRoundTripSynthetic();
+  void testInvalid();
+
+protected:
+  /** Writes the given config and reads it back into the other. */
+  static bool roundTrip(Config *config, Config *other, ErrorStack &err);
+};
+
+#endif // CONFIGBINARYTEST_HH
@@ -4,6 +4,7 @@
 #include "melody.hh"
 #include <iostream>
 #include <QTest>
+#include <QSignalSpy>
 #include "logger.hh"
 #include <iostream>
 
@@ -55,6 +56,80 @@ ConfigTest::testImmediateRefInvalidation() {
   QCOMPARE(copy->zones()->get(0)->as<Zone>()->B()->count(), 0);
 }
 
+void
+ConfigTest::testHandleInvalidation() {
+  DMRContact *contact = new DMRContact(DMRContact::GroupCall, "TG 91", 91);
+  ConfigObjectRegistry::Handle handle = contact->handle();
+  QCOMPARE(ConfigObjectRegistry::resolve(handle), contact);
+
+  delete contact;
+  QVERIFY(! ConfigObjectRegistry::isValid(handle));
+
+  // Slot of deleted object gets reused, the old handle must not resolve to the new object
+  DMRContact *other = new DMRContact(DMRContact::GroupCall, "TG 92", 92);
+  QVERIFY(other->handle() != handle);
+  QCOMPARE(ConfigObjectRegistry::resolve(handle), nullptr);
+  QCOMPARE(ConfigObjectRegistry::resolve(other->handle()), other);
+  delete other;
+}
+
+void
+ConfigTest::testCopyRefLists() {
+  ErrorStack err;
+  Config *copy = ConfigCopy::copy(&_basicConfig, err)->as<Config>();
+  if (nullptr == copy)
+    QFAIL(err.format().toLocal8Bit().constData());
+
+  // Zone members must reference the copied channels
+  Zone *zone = copy->zones()->zone(0);
+  QCOMPARE(zone->A()->count(), 3);
+  QCOMPARE(zone->A()->get(0), copy->channelList()->get(0));
+  QCOMPARE(zone->A()->get(2), copy->channelList()->get(3));
+  QCOMPARE(zone->B()->get(0), copy->channelList()->get(2));
+
+  // Group list members must reference the copied contacts
+  RXGroupList *list = copy->rxGroupLists()->list(0);
+  QCOMPARE(list->count(), 3);
+  QCOMPARE(list->contacts()->get(2), copy->contacts()->get(2));
+
+  // Copying a ref list copies the handles
+  RXGroupList other;
+  other.copy(*list);
+  QCOMPARE(other.count(), 3);
+  QCOMPARE(other.contacts()->get(1), copy->contacts()->get(1));
+
+  // Deleting a contact removes it from both lists
+  copy->contacts()->del(copy->contacts()->get(1));
+  QCOMPARE(list->count(), 2);
+  QCOMPARE(other.count(), 2);
+
+  delete copy;
+}
+
+void
+ConfigTest::testRefNotifications() {
+  DMRContact *contact = new DMRContact(DMRContact::GroupCall, "TG 91", 91);
+  DMRChannel channel;
+  RXGroupList list;
+  QVERIFY(channel.setTXContactObj(contact));
+  QVERIFY(0 <= list.addContact(contact));
+
+  // Modifying a member of a ref list is forwarded
+  QSignalSpy listModified(list.contacts(), SIGNAL(elementModified(int)));
+  contact->setNumber(92);
+  QCOMPARE(listModified.count(), 1);
+  QCOMPARE(listModified.at(0).at(0).toInt(), 0);
+
+  // Deleting the member clears the reference and removes it from the list immediately
+  QSignalSpy refModified(channel.contact(), SIGNAL(modified()));
+  QSignalSpy listRemoved(list.contacts(), SIGNAL(elementRemoved(int)));
+  delete contact;
+  QCOMPARE(refModified.count(), 1);
+  QVERIFY(channel.contact()->isNull());
+  QCOMPARE(listRemoved.count(), 1);
+  QCOMPARE(list.count(), 0);
+}
+
 
 void
 ConfigTest::testCloneChannelBasic() {
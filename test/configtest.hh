@@ -17,6 +17,9 @@ private slots:
   void initTestCase();
 
   void testImmediateRefInvalidation();
+  void testHandleInvalidation();
+  void testCopyRefLists();
+  void testRefNotifications();
 
   void testCloneChannelBasic();
   void testCloneChannelCTCSS();
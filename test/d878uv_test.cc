@@ -5,6 +5,7 @@
 #include "errorstack.hh"
 #include <iostream>
 #include <QTest>
+#include <QSignalSpy>
 #include "logger.hh"
 
 D878UVTest::D878UVTest(QObject *parent)
@@ -291,6 +292,103 @@ D878UVTest::testFMAPRSSettings() {
   QCOMPARE(comp_aprs->period(), aprs->period());
 }
 
+void
+D878UVTest::testLazyDecoding() {
+  ErrorStack err;
+  Codeplug::Flags flags; flags.updateCodePlug=false;
+
+  Config config;
+  if (! config.readYAML(":/data/config_test.yaml", err)) {
+    QFAIL(QString("Cannot open codeplug file: %1")
+          .arg(err.format()).toStdString().c_str());
+  }
+
+  D878UVCodeplug codeplug;
+  if (! codeplug.encode(&config, flags, err)) {
+    QFAIL(QString("Cannot encode codeplug for AnyTone AT-D878UV: %1")
+          .arg(err.format()).toStdString().c_str());
+  }
+
+  Config eager;
+  if ((! codeplug.decode(&eager, err)) || (! codeplug.postprocess(&eager, err))) {
+    QFAIL(QString("Cannot decode codeplug for AnyTone AT-D878UV: %1")
+          .arg(err.format()).toStdString().c_str());
+  }
+
+  Config lazy;
+  codeplug.setLazyDecoding(true);
+  if ((! codeplug.decode(&lazy, err)) || (! codeplug.postprocess(&lazy, err))) {
+    QFAIL(QString("Cannot decode codeplug for AnyTone AT-D878UV: %1")
+          .arg(err.format()).toStdString().c_str());
+  }
+
+  // Only the settings are decoded so far
+  QVERIFY(! lazy.isMaterialized());
+  QVERIFY(lazy.channelList()->isDeferred());
+  QVERIFY(0 < lazy.radioIDs()->count());
+
+  // Accessing the lists does not decode them
+  QCOMPARE(lazy.channelList()->count(), 0);
+  QVERIFY(! lazy.isMaterialized());
+
+  // Explicit materialization adds the elements without modifying the config
+  lazy.setModified(false);
+  QSignalSpy added(lazy.zones(), SIGNAL(elementAdded(int)));
+  if (! lazy.materialize(err)) {
+    QFAIL(QString("Cannot materialize codeplug for AnyTone AT-D878UV: %1")
+          .arg(err.format()).toStdString().c_str());
+  }
+  QVERIFY(! lazy.zones()->isDeferred());
+  QCOMPARE(lazy.channelList()->count(), eager.channelList()->count());
+  QVERIFY(0 < added.count());
+  QVERIFY(! lazy.isModified());
+
+  QCOMPARE(lazy.compare(eager), 0);
+}
+
+
+void
+D878UVTest::testBitmaps() {
+  // Channel bitmap: set bit enables channel
+  QByteArray channelData(D878UVCodeplug::ChannelBitmapElement::size(), 0);
+  D878UVCodeplug::ChannelBitmapElement channels((uint8_t *)channelData.data());
+  channels.clear();
+  QCOMPARE(channels.countEncoded(4000), 0U);
+  QCOMPARE(channels.nextEncoded(0, 4000), -1);
+  channels.enableFirst(70);
+  channels.setEncoded(3999, true);
+  channels.setEncoded(4000, true);
+  QCOMPARE(channels.countEncoded(4000), 71U);
+  QCOMPARE(channels.nextEncoded(0, 4000), 0);
+  QCOMPARE(channels.nextEncoded(69, 4000), 69);
+  QCOMPARE(channels.nextEncoded(70, 4000), 3999);
+  QCOMPARE(channels.nextEncoded(4000, 4000), -1);
+
+  // Contact bitmap: cleared bit enables contact
+  QByteArray contactData(D878UVCodeplug::ContactBitmapElement::size(), 0);
+  D878UVCodeplug::ContactBitmapElement contacts((uint8_t *)contactData.data());
+  contacts.clear();
+  QCOMPARE(contacts.countEncoded(10000), 0U);
+  contacts.setEncoded(5, true);
+  contacts.setEncoded(9999, true);
+  QCOMPARE(contacts.countEncoded(10000), 2U);
+  QCOMPARE(contacts.nextEncoded(0, 10000), 5);
+  QCOMPARE(contacts.nextEncoded(6, 10000), 9999);
+  QCOMPARE(contacts.nextEncoded(6, 9999), -1);
+
+  // DTMF contact bytemap: zero byte enables contact
+  QByteArray dtmfData(D878UVCodeplug::DTMFContactBytemapElement::size(), 0);
+  D878UVCodeplug::DTMFContactBytemapElement dtmf((uint8_t *)dtmfData.data());
+  dtmf.clear();
+  QCOMPARE(dtmf.nextEncoded(0, 128), -1);
+  dtmf.setEncoded(3, true);
+  dtmf.setEncoded(17, true);
+  QCOMPARE(dtmf.countEncoded(128), 2U);
+  QCOMPARE(dtmf.nextEncoded(0, 128), 3);
+  QCOMPARE(dtmf.nextEncoded(4, 128), 17);
+  QCOMPARE(dtmf.nextEncoded(18, 128), -1);
+}
+
 
 QTEST_GUILESS_MAIN(D878UVTest)
 
@@ -25,6 +25,9 @@ private slots:
 
   void testFMAPRSSettings();
 
+  void testLazyDecoding();
+  void testBitmaps();
+
 protected:
   Config _micGainConfig;
   QTextStream _stderr;
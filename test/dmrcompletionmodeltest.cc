@@ -0,0 +1,70 @@
+#include "dmrcompletionmodeltest.hh"
+#include "dmrcompletionmodel.hh"
+#include <QTest>
+
+DMRCompletionModelTest::DMRCompletionModelTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+DMRCompletionModelTest::testTextPrefix() {
+  DMRCompletionModel model;
+  model.add(2621370, "DM3MAT", "DM3MAT (Hannes)");
+  model.add(2621371, "DL1ABC");
+  model.add(2621372, "DM3MA");
+  model.build();
+  QCOMPARE(model.count(), 3);
+
+  // Case-insensitive, shorter keys first
+  model.setPrefix("dm3m");
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.text(0), QString("DM3MA"));
+  QCOMPARE(model.text(1), QString("DM3MAT"));
+  QCOMPARE(model.display(1), QString("DM3MAT (Hannes)"));
+  QCOMPARE(model.data(model.index(1), DMRCompletionModel::IdRole).toUInt(), 2621370U);
+
+  model.setPrefix("DX");
+  QCOMPARE(model.rowCount(), 0);
+  model.setPrefix("");
+  QCOMPARE(model.rowCount(), 0);
+}
+
+void
+DMRCompletionModelTest::testIdPrefix() {
+  DMRCompletionModel model;
+  model.add(2621370, "DM3MAT");
+  model.add(262, "Germany");
+  model.add(26200, "Test");
+  model.add(91, "World-wide");
+  model.build();
+
+  // Shortest IDs first
+  model.setPrefix("262");
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.id(0), 262U);
+  QCOMPARE(model.id(1), 26200U);
+  QCOMPARE(model.id(2), 2621370U);
+
+  model.setPrefix("9");
+  QCOMPARE(model.rowCount(), 1);
+  QCOMPARE(model.id(0), 91U);
+}
+
+void
+DMRCompletionModelTest::testMaxResults() {
+  DMRCompletionModel model;
+  for (unsigned i=0; i<1000; i++)
+    model.add(1000+i, QString("CALL%1").arg(i));
+  model.build();
+
+  model.setMaxResults(10);
+  model.setPrefix("call");
+  QCOMPARE(model.rowCount(), 10);
+  model.setPrefix("CALL99");
+  // CALL99, CALL990 ... CALL999
+  QCOMPARE(model.rowCount(), 10);
+  QCOMPARE(model.text(0), QString("CALL99"));
+}
+
+QTEST_GUILESS_MAIN(DMRCompletionModelTest)
@@ -0,0 +1,19 @@
+#ifndef DMRCOMPLETIONMODELTEST_HH
+#define DMRCOMPLETIONMODELTEST_HH
+
+#include <QObject>
+
+class DMRCompletionModelTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit DMRCompletionModelTest(QObject *parent = nullptr);
+
+private slots:
+  void testTextPrefix();
+  void testIdPrefix();
+  void testMaxResults();
+};
+
+#endif // DMRCOMPLETIONMODELTEST_HH
@@ -0,0 +1,143 @@
+#include "memorybench.hh"
+#include "syntheticconfig.hh"
+#include "compacttable.hh"
+#include "config.hh"
+
+#include <QTest>
+#include <QFile>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+static const QList<QPair<QString, double>> scales = {
+  {"small", 0.1}, {"full", 1.0}
+};
+
+
+/** Returns the current resident set size in bytes or 0 if unknown. */
+static qint64
+residentSize() {
+  QFile statm("/proc/self/statm");
+  if (! statm.open(QIODevice::ReadOnly))
+    return 0;
+  QList<QByteArray> fields = statm.readAll().simplified().split(' ');
+  if (2 > fields.size())
+    return 0;
+  return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+}
+
+
+/** Returns the number of bytes allocated on the heap or 0 if unknown. */
+static qint64
+heapSize() {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+
+MemoryBench::MemoryBench(QObject *parent)
+  : QObject(parent)
+{
+  // pass...
+}
+
+void
+MemoryBench::addSizeRows() {
+  QTest::addColumn<double>("scale");
+  for (auto scale: scales)
+    QTest::newRow(scale.first.toLocal8Bit().constData()) << scale.second;
+}
+
+void
+MemoryBench::benchmarkConfigObjects_data() {
+  addSizeRows();
+}
+
+void
+MemoryBench::benchmarkConfigObjects() {
+  QFETCH(double, scale);
+  if (0 == residentSize())
+    QSKIP("Resident set size is not available on this platform.");
+
+  qint64 before = residentSize();
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(scale));
+  qint64 after = residentSize();
+
+  QTest::setBenchmarkResult(after-before, QTest::BytesAllocated);
+  delete config;
+}
+
+void
+MemoryBench::benchmarkCompactTables_data() {
+  addSizeRows();
+}
+
+void
+MemoryBench::benchmarkCompactTables() {
+  QFETCH(double, scale);
+  if (0 == residentSize())
+    QSKIP("Resident set size is not available on this platform.");
+
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(scale));
+  qint64 before = residentSize();
+  DMRContactTable *contacts = new DMRContactTable(config->contacts());
+  ChannelTable *channels = new ChannelTable(config);
+  qint64 after = residentSize();
+
+  qDebug() << "Contacts:" << contacts->count() << "in" << contacts->memoryUsage() << "bytes,"
+           << "channels:" << channels->count() << "in" << channels->memoryUsage() << "bytes.";
+  QTest::setBenchmarkResult(after-before, QTest::BytesAllocated);
+
+  delete channels;
+  delete contacts;
+  delete config;
+}
+
+void
+MemoryBench::benchmarkCompactedConfig_data() {
+  addSizeRows();
+}
+
+void
+MemoryBench::benchmarkCompactedConfig() {
+  QFETCH(double, scale);
+  if (0 == heapSize())
+    QSKIP("Heap usage is not available on this platform.");
+
+  qint64 before = heapSize();
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(scale));
+  qint64 full = heapSize();
+  int count = config->compact();
+  qint64 after = heapSize();
+
+  qDebug() << "Compacted" << count << "elements, heap usage dropped from" << (full-before)
+           << "to" << (after-before) << "bytes.";
+  QTest::setBenchmarkResult(after-before, QTest::BytesAllocated);
+  delete config;
+}
+
+void
+MemoryBench::benchmarkMaterialize_data() {
+  addSizeRows();
+}
+
+void
+MemoryBench::benchmarkMaterialize() {
+  QFETCH(double, scale);
+  Config *config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(scale));
+  ChannelTable channels(config);
+
+  QBENCHMARK {
+    for (int i=0; i<channels.count(); i++)
+      delete channels.materialize(i, config);
+  }
+
+  delete config;
+}
+
+
+QTEST_GUILESS_MAIN(MemoryBench)
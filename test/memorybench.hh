@@ -0,0 +1,37 @@
+#ifndef MEMORYBENCH_HH
+#define MEMORYBENCH_HH
+
+#include <QObject>
+
+/** Compares the memory usage of the contact and channel tables held as config objects with the
+ * compact tables (see @c DMRContactTable and @c ChannelTable). The memory is reported as bytes
+ * allocated, measured by the growth of the resident set size. The memory held by a compacted config
+ * (see @c Config::compact) is measured as the heap usage, as freed memory is usually not returned
+ * to the system. Use the QtTest output options to
+ * obtain machine-readable results, e.g.,
+ * @code
+ * memorybench -csv
+ * @endcode */
+class MemoryBench : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit MemoryBench(QObject *parent = nullptr);
+
+private slots:
+  void benchmarkConfigObjects_data();
+  void benchmarkConfigObjects();
+  void benchmarkCompactTables_data();
+  void benchmarkCompactTables();
+  void benchmarkCompactedConfig_data();
+  void benchmarkCompactedConfig();
+  void benchmarkMaterialize_data();
+  void benchmarkMaterialize();
+
+protected:
+  /** Adds a row for every config size. */
+  void addSizeRows();
+};
+
+#endif // MEMORYBENCH_HH
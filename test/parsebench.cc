@@ -0,0 +1,84 @@
+#include "parsebench.hh"
+#include "frequency.hh"
+#include "interval.hh"
+#include "signaling.hh"
+#include "melody.hh"
+
+#include <QTest>
+
+/** Number of values parsed per benchmark iteration. */
+#define VALUES_PER_ITERATION 1000
+
+
+ParseBench::ParseBench(QObject *parent)
+  : QObject(parent)
+{
+  // pass...
+}
+
+void
+ParseBench::benchmarkFrequency_data() {
+  QTest::addColumn<QString>("value");
+  QTest::newRow("plain") << "145.6125";
+  QTest::newRow("MHz") << "145.6125 MHz";
+  QTest::newRow("kHz") << "12.5 kHz";
+  QTest::newRow("Hz") << "100 Hz";
+}
+
+void
+ParseBench::benchmarkFrequency() {
+  QFETCH(QString, value);
+  Frequency f;
+  QBENCHMARK {
+    for (int i=0; i<VALUES_PER_ITERATION; i++)
+      f.parse(value);
+  }
+  QVERIFY(0 != f.inHz());
+}
+
+void
+ParseBench::benchmarkInterval() {
+  QString value("300 ms");
+  Interval interval;
+  QBENCHMARK {
+    for (int i=0; i<VALUES_PER_ITERATION; i++)
+      interval.parse(value);
+  }
+  QCOMPARE(interval.milliseconds(), 300ULL);
+}
+
+void
+ParseBench::benchmarkCTCSS() {
+  QString value("67.0 Hz");
+  SelectiveCall call;
+  QBENCHMARK {
+    for (int i=0; i<VALUES_PER_ITERATION; i++)
+      call = SelectiveCall::parseCTCSS(value);
+  }
+  QVERIFY(call.isCTCSS());
+}
+
+void
+ParseBench::benchmarkDCS() {
+  QString value("i754");
+  SelectiveCall call;
+  QBENCHMARK {
+    for (int i=0; i<VALUES_PER_ITERATION; i++)
+      call = SelectiveCall::parseDCS(value);
+  }
+  QVERIFY(call.isDCS());
+}
+
+void
+ParseBench::benchmarkMelody() {
+  QString value("c'4 d'8 e'8 f'4 g'2 r4 a'16 b'16 c''2.");
+  Melody melody;
+  QBENCHMARK {
+    for (int i=0; i<VALUES_PER_ITERATION; i++)
+      melody.fromLilypond(value);
+  }
+  QVERIFY(! melody.toLilypond().isEmpty());
+}
+
+
+QTEST_GUILESS_MAIN(ParseBench)
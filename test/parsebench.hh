@@ -0,0 +1,27 @@
+#ifndef PARSEBENCH_HH
+#define PARSEBENCH_HH
+
+#include <QObject>
+
+/** Benchmarks the value parsers used when reading YAML configs (frequencies, intervals, selective
+ * calls and melodies). Use the QtTest output options to obtain machine-readable results, e.g.,
+ * @code
+ * parsebench -csv
+ * @endcode */
+class ParseBench : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ParseBench(QObject *parent = nullptr);
+
+private slots:
+  void benchmarkFrequency_data();
+  void benchmarkFrequency();
+  void benchmarkInterval();
+  void benchmarkCTCSS();
+  void benchmarkDCS();
+  void benchmarkMelody();
+};
+
+#endif // PARSEBENCH_HH
@@ -0,0 +1,82 @@
+#include "simulatorbench.hh"
+#include "simulateddevice.hh"
+#include "syntheticconfig.hh"
+#include "radio.hh"
+#include "config.hh"
+#include "errorstack.hh"
+#include <QTest>
+
+
+SimulatorBench::SimulatorBench(QObject *parent)
+  : QObject(parent), _config(nullptr)
+{
+  // pass...
+}
+
+void
+SimulatorBench::initTestCase() {
+  // Small enough to fit into all simulated radios
+  _config = SyntheticConfig::generate(SyntheticConfig::Full.scaled(0.1), this);
+}
+
+void
+SimulatorBench::cleanupTestCase() {
+  if (_config)
+    delete _config;
+  _config = nullptr;
+}
+
+void
+SimulatorBench::addRadioRows() {
+  QTest::addColumn<QString>("radio");
+  QTest::newRow("AnyTone") << "d878uv";
+  QTest::newRow("Radioddity") << "gd77";
+  QTest::newRow("TyT") << "uv390";
+}
+
+void
+SimulatorBench::benchmarkDownload_data() {
+  addRadioRows();
+}
+
+void
+SimulatorBench::benchmarkDownload() {
+  QFETCH(QString, radio);
+  QBENCHMARK {
+    ErrorStack err;
+    Radio *dev = Radio::detect(SimulatedDevice::descriptor("sim:"+radio, err), RadioInfo(), err);
+    QVERIFY(nullptr != dev);
+    QVERIFY(dev->startDownload(true, err));
+    delete dev;
+  }
+}
+
+void
+SimulatorBench::benchmarkUpload_data() {
+  addRadioRows();
+}
+
+void
+SimulatorBench::benchmarkUpload() {
+  QFETCH(QString, radio);
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  QBENCHMARK {
+    ErrorStack err;
+    Radio *dev = Radio::detect(SimulatedDevice::descriptor("sim:"+radio, err), RadioInfo(), err);
+    QVERIFY(nullptr != dev);
+    Config *intermediate = dev->codeplug().preprocess(_config, err);
+    if (nullptr == intermediate) {
+      delete dev;
+      QFAIL(QString("Cannot pre-process codeplug: %1").arg(err.format()).toStdString().c_str());
+    }
+    if (! dev->startUpload(intermediate, true, flags, err)) {
+      delete dev;
+      QFAIL(QString("Cannot upload codeplug to simulated %1: %2")
+            .arg(radio).arg(err.format()).toStdString().c_str());
+    }
+    delete dev;
+  }
+}
+
+
+QTEST_GUILESS_MAIN(SimulatorBench)
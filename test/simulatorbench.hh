@@ -0,0 +1,38 @@
+#ifndef SIMULATORBENCH_HH
+#define SIMULATORBENCH_HH
+
+#include <QObject>
+
+class Config;
+
+/** Benchmarks codeplug down- and uploads against simulated radios.
+ *
+ * The simulated devices run without latency, hence the benchmark measures the protocol overhead
+ * of the interfaces and the codeplug encoding/decoding. Use the QtTest output options to obtain
+ * machine-readable results, e.g., @code simulatorbench -csv @endcode */
+class SimulatorBench : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit SimulatorBench(QObject *parent = nullptr);
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+
+  void benchmarkDownload_data();
+  void benchmarkDownload();
+  void benchmarkUpload_data();
+  void benchmarkUpload();
+
+protected:
+  /** Adds the radio column and one row per simulated radio family. */
+  void addRadioRows();
+
+protected:
+  /** Config uploaded by the upload benchmark. */
+  Config *_config;
+};
+
+#endif // SIMULATORBENCH_HH
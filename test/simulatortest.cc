@@ -0,0 +1,130 @@
+#include "simulatortest.hh"
+#include "simulateddevice.hh"
+#include "radio.hh"
+#include "config.hh"
+#include "errorstack.hh"
+#include "transferstatistics.hh"
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFileInfo>
+
+SimulatorTest::SimulatorTest(QObject *parent)
+  : UnitTestBase(parent)
+{
+  // pass...
+}
+
+void
+SimulatorTest::testSpecification() {
+  ErrorStack err;
+  QVERIFY(SimulatedDevice::isSpecification("sim:d878uv"));
+  QVERIFY(! SimulatedDevice::isSpecification("/dev/ttyACM0"));
+
+  USBDeviceDescriptor descr = SimulatedDevice::descriptor("sim:d878uv,latency=1", err);
+  QVERIFY(descr.isValid());
+  QVERIFY(descr.isSimulated());
+  QCOMPARE(descr.deviceHandle(), QString("sim:d878uv,latency=1"));
+
+  SimulatedDevice device(descr, err);
+  QVERIFY(device.isValid());
+  QCOMPARE(device.latency(), 1.0);
+
+  // Unknown radio
+  QVERIFY(! SimulatedDevice::descriptor("sim:nonexisting", err).isValid());
+  // Radio not simulated
+  QVERIFY(! SimulatedDevice::descriptor("sim:opengd77", err).isValid());
+  // Invalid options
+  SimulatedDevice invalid(SimulatedDevice::descriptor("sim:gd77,errors=2", err), err);
+  QVERIFY(! invalid.isValid());
+}
+
+void
+SimulatorTest::roundTrip(const QString &radio) {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  QString image = dir.filePath("memory.dfu");
+  QString spec = QString("sim:%1,image=%2").arg(radio).arg(image);
+
+  ErrorStack err;
+  Radio *dev = Radio::detect(SimulatedDevice::descriptor(spec, err), RadioInfo(), err);
+  if (nullptr == dev) {
+    QFAIL(QString("Cannot open simulated %1: %2")
+          .arg(radio).arg(err.format()).toStdString().c_str());
+  }
+
+  Codeplug::Flags flags; flags.updateCodePlug = false;
+  Config *intermediate = dev->codeplug().preprocess(&_basicConfig, err);
+  if (nullptr == intermediate) {
+    delete dev;
+    QFAIL(QString("Cannot pre-process codeplug: %1").arg(err.format()).toStdString().c_str());
+  }
+  if (! dev->startUpload(intermediate, true, flags, err)) {
+    delete dev;
+    QFAIL(QString("Cannot upload codeplug to simulated %1: %2")
+          .arg(radio).arg(err.format()).toStdString().c_str());
+  }
+  QVERIFY(nullptr != dev->statistics());
+  QVERIFY(0 < dev->statistics()->requests());
+  QCOMPARE(dev->statistics()->errors(), 0U);
+  delete dev;
+
+  QVERIFY(QFileInfo::exists(image));
+
+  dev = Radio::detect(SimulatedDevice::descriptor(spec, err), RadioInfo(), err);
+  if (nullptr == dev) {
+    QFAIL(QString("Cannot open simulated %1: %2")
+          .arg(radio).arg(err.format()).toStdString().c_str());
+  }
+  if (! dev->startDownload(true, err)) {
+    delete dev;
+    QFAIL(QString("Cannot download codeplug from simulated %1: %2")
+          .arg(radio).arg(err.format()).toStdString().c_str());
+  }
+
+  Config config;
+  if (! dev->codeplug().decode(&config, err)) {
+    delete dev;
+    QFAIL(QString("Cannot decode codeplug from simulated %1: %2")
+          .arg(radio).arg(err.format()).toStdString().c_str());
+  }
+  delete dev;
+
+  QCOMPARE(config.channelList()->count(), _basicConfig.channelList()->count());
+}
+
+void
+SimulatorTest::testAnytoneRoundTrip() {
+  roundTrip("d878uv");
+}
+
+void
+SimulatorTest::testRadioddityRoundTrip() {
+  roundTrip("gd77");
+}
+
+void
+SimulatorTest::testTyTRoundTrip() {
+  roundTrip("uv390");
+}
+
+void
+SimulatorTest::testErrorInjection() {
+  ErrorStack err;
+  Radio *dev = Radio::detect(
+        SimulatedDevice::descriptor("sim:rd5r,errors=0.01,seed=42", err), RadioInfo(), err);
+  if (nullptr == dev) {
+    QFAIL(QString("Cannot open simulated RD-5R: %1").arg(err.format()).toStdString().c_str());
+  }
+
+  // HID transfers are retried on timeouts
+  if (! dev->startDownload(true, err)) {
+    delete dev;
+    QFAIL(QString("Cannot download codeplug from simulated RD-5R: %1")
+          .arg(err.format()).toStdString().c_str());
+  }
+  QVERIFY(0 < dev->statistics()->timeouts());
+  QCOMPARE(dev->statistics()->retries(), dev->statistics()->timeouts());
+  delete dev;
+}
+
+QTEST_GUILESS_MAIN(SimulatorTest)
@@ -0,0 +1,26 @@
+#ifndef SIMULATORTEST_HH
+#define SIMULATORTEST_HH
+
+#include "libdmrconfigtest.hh"
+
+class Radio;
+
+class SimulatorTest : public UnitTestBase
+{
+  Q_OBJECT
+
+public:
+  explicit SimulatorTest(QObject *parent = nullptr);
+
+private slots:
+  void testSpecification();
+  void testAnytoneRoundTrip();
+  void testRadioddityRoundTrip();
+  void testTyTRoundTrip();
+  void testErrorInjection();
+
+protected:
+  void roundTrip(const QString &radio);
+};
+
+#endif // SIMULATORTEST_HH
@@ -0,0 +1,85 @@
+#include "syntheticconfig.hh"
+#include "radioid.hh"
+#include "contact.hh"
+#include "rxgrouplist.hh"
+#include "channel.hh"
+#include "zone.hh"
+#include <cmath>
+
+const SyntheticConfig::Size SyntheticConfig::Full = {4000, 10000, 250, 250};
+
+SyntheticConfig::Size
+SyntheticConfig::Size::scaled(double factor) const {
+  return Size {
+    std::max(1U, unsigned(std::round(channels*factor))),
+    std::max(1U, unsigned(std::round(contacts*factor))),
+    std::max(1U, unsigned(std::round(zones*factor))),
+    std::max(1U, unsigned(std::round(groupLists*factor)))
+  };
+}
+
+Config *
+SyntheticConfig::generate(const Size &size, QObject *parent) {
+  Config *config = new Config(parent);
+
+  DMRRadioID *id = new DMRRadioID("BENCH", 2621370);
+  config->radioIDs()->add(id);
+  config->settings()->setDefaultId(id);
+
+  // Every 10th contact is a group call
+  QList<DMRContact *> groupCalls;
+  for (unsigned int i=0; i<size.contacts; i++) {
+    DMRContact *contact;
+    if (0 == (i % 10)) {
+      contact = new DMRContact(DMRContact::GroupCall, QString("TG %1").arg(i/10+1), 91+i/10);
+      groupCalls.append(contact);
+    } else {
+      contact = new DMRContact(DMRContact::PrivateCall, QString("Contact %1").arg(i+1), 2620000+i);
+    }
+    config->contacts()->add(contact);
+  }
+
+  // Group lists of up to 16 group calls
+  for (unsigned int i=0; i<size.groupLists; i++) {
+    RXGroupList *list = new RXGroupList(QString("Group list %1").arg(i+1));
+    for (unsigned int j=0; j<16; j++)
+      list->addContact(groupCalls.at((16*i+j) % groupCalls.size()));
+    config->rxGroupLists()->add(list);
+  }
+
+  // Channels within the 70cm band, every 4th channel is an FM channel
+  QList<Channel *> channels;
+  for (unsigned int i=0; i<size.channels; i++) {
+    Channel *channel;
+    if (3 == (i % 4)) {
+      FMChannel *fm = new FMChannel();
+      fm->setBandwidth(FMChannel::Bandwidth::Narrow);
+      fm->setAdmit(FMChannel::Admit::Free);
+      channel = fm;
+    } else {
+      DMRChannel *dmr = new DMRChannel();
+      dmr->setColorCode(i % 16);
+      dmr->setTimeSlot((i % 2) ? DMRChannel::TimeSlot::TS2 : DMRChannel::TimeSlot::TS1);
+      dmr->setAdmit(DMRChannel::Admit::ColorCode);
+      dmr->setGroupListObj(config->rxGroupLists()->list(i % size.groupLists));
+      dmr->setTXContactObj(groupCalls.at(i % groupCalls.size()));
+      channel = dmr;
+    }
+    channel->setName(QString("Channel %1").arg(i+1));
+    channel->setRXFrequency(Frequency::fromkHz(430000 + 12.5*(i % 800)));
+    channel->setTXFrequency(channel->rxFrequency());
+    channel->setPower(Channel::Power::High);
+    config->channelList()->add(channel);
+    channels.append(channel);
+  }
+
+  // Zones of up to 16 channels
+  for (unsigned int i=0; i<size.zones; i++) {
+    Zone *zone = new Zone(QString("Zone %1").arg(i+1));
+    for (unsigned int j=0; j<16; j++)
+      zone->A()->add(channels.at((16*i+j) % channels.size()));
+    config->zones()->add(zone);
+  }
+
+  return config;
+}
@@ -0,0 +1,36 @@
+#ifndef SYNTHETICCONFIG_HH
+#define SYNTHETICCONFIG_HH
+
+#include "config.hh"
+
+/** Generates synthetic configurations of arbitrary size for benchmarks.
+ *
+ * The generated config contains a single radio ID, the given number of contacts (10% group calls,
+ * the rest private calls), group lists of up to 16 group calls each, channels (every fourth
+ * channel is an FM channel) and zones of up to 16 channels each. All DMR channels reference a
+ * group list and a transmit contact. The config is deterministic, hence results are comparable
+ * between runs. */
+class SyntheticConfig
+{
+public:
+  /** Size of the synthetic config. */
+  struct Size {
+    unsigned int channels;   ///< Number of channels.
+    unsigned int contacts;   ///< Number of contacts.
+    unsigned int zones;      ///< Number of zones.
+    unsigned int groupLists; ///< Number of group lists.
+
+    /** Returns a size scaled by the given factor (at least one element each). */
+    Size scaled(double factor) const;
+  };
+
+  /** Size at the limits of the larger radios: 4000 channels, 10000 contacts, 250 zones and
+   * 250 group lists. */
+  static const Size Full;
+
+public:
+  /** Generates a config of the given size. The ownership is passed to the caller. */
+  static Config *generate(const Size &size, QObject *parent=nullptr);
+};
+
+#endif // SYNTHETICCONFIG_HH
@@ -0,0 +1,102 @@
+#include "transferstatisticstest.hh"
+#include "transferstatistics.hh"
+#include <QJsonArray>
+#include <QTest>
+
+TransferStatisticsTest::TransferStatisticsTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+TransferStatisticsTest::testRequests() {
+  TransferStatistics stats;
+  stats.addRequest(16, 64, 2000000);
+  stats.addRequest(16, 0, 4000000);
+
+  QCOMPARE(stats.requests(), 2U);
+  QCOMPARE(stats.bytesSent(), 32ULL);
+  QCOMPARE(stats.bytesReceived(), 64ULL);
+  QCOMPARE(stats.minLatency(), 2000000LL);
+  QCOMPARE(stats.maxLatency(), 4000000LL);
+  QCOMPARE(stats.meanLatency(), 3000000LL);
+  QCOMPARE(stats.busyTime(), 6000000LL);
+
+  stats.reset();
+  QCOMPARE(stats.requests(), 0U);
+  QCOMPARE(stats.bytesSent(), 0ULL);
+  QCOMPARE(stats.meanLatency(), 0LL);
+}
+
+void
+TransferStatisticsTest::testHistogram() {
+  TransferStatistics stats;
+  stats.addRequest(0, 0, 0);          // < 1us
+  stats.addRequest(0, 0, 1500);       // < 2us
+  stats.addRequest(0, 0, 1000000);    // < 1024us
+  stats.addRequest(0, 0, 1000000000); // < 2^20us
+
+  QCOMPARE(stats.histogram(0), 1U);
+  QCOMPARE(stats.histogram(1), 1U);
+  QCOMPARE(stats.histogram(10), 1U);
+  QCOMPARE(stats.histogram(20), 1U);
+  QCOMPARE(stats.histogram(TransferStatistics::HistogramBins), 0U);
+
+  // Overflow bin
+  stats.addRequest(0, 0, 100000000000LL);
+  QCOMPARE(stats.histogram(TransferStatistics::HistogramBins-1), 1U);
+}
+
+void
+TransferStatisticsTest::testFailedRequests() {
+  TransferStatistics stats;
+  {
+    TransferStatistics::Request request(&stats, 8, 8);
+    request.retry();
+    request.completed();
+  }
+  {
+    TransferStatistics::Request request(&stats, 8, 8);
+    request.timeout();
+  }
+  {
+    TransferStatistics::Request request(&stats, 8, 8);
+  }
+  {
+    // Must not crash
+    TransferStatistics::Request request(nullptr, 8, 8);
+    request.retry();
+  }
+
+  QCOMPARE(stats.requests(), 1U);
+  QCOMPARE(stats.bytesSent(), 8ULL);
+  QCOMPARE(stats.bytesReceived(), 8ULL);
+  QCOMPARE(stats.retries(), 1U);
+  QCOMPARE(stats.timeouts(), 1U);
+  QCOMPARE(stats.errors(), 1U);
+}
+
+void
+TransferStatisticsTest::testJSON() {
+  TransferStatistics stats;
+  stats.addRequest(4, 32, 1500000);
+  stats.addTimeout();
+  stats.addWait(2000000);
+
+  QJsonObject obj = stats.toJSON();
+  QCOMPARE(obj.value("requests").toInt(), 1);
+  QCOMPARE(obj.value("bytes_sent").toInt(), 4);
+  QCOMPARE(obj.value("bytes_received").toInt(), 32);
+  QCOMPARE(obj.value("timeouts").toInt(), 1);
+  QCOMPARE(obj.value("wait_us").toInt(), 2000);
+
+  QJsonObject latency = obj.value("latency").toObject();
+  QCOMPARE(latency.value("min_us").toInt(), 1500);
+  QCOMPARE(latency.value("max_us").toInt(), 1500);
+  QJsonArray hist = latency.value("histogram").toArray();
+  QCOMPARE(hist.size(), 1);
+  QCOMPARE(hist.at(0).toObject().value("below_us").toInt(), 2048);
+  QCOMPARE(hist.at(0).toObject().value("count").toInt(), 1);
+}
+
+QTEST_GUILESS_MAIN(TransferStatisticsTest)
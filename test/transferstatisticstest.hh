@@ -0,0 +1,20 @@
+#ifndef TRANSFERSTATISTICSTEST_HH
+#define TRANSFERSTATISTICSTEST_HH
+
+#include <QObject>
+
+class TransferStatisticsTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit TransferStatisticsTest(QObject *parent = nullptr);
+
+private slots:
+  void testRequests();
+  void testHistogram();
+  void testFailedRequests();
+  void testJSON();
+};
+
+#endif // TRANSFERSTATISTICSTEST_HH
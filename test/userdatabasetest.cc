@@ -0,0 +1,136 @@
+#include "userdatabasetest.hh"
+#include "userdatabase.hh"
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <QFile>
+#include <QTest>
+
+static bool
+writeFile(const QString &filename, const QByteArray &content) {
+  QFile file(filename);
+  if (! file.open(QIODevice::WriteOnly))
+    return false;
+  file.write(content);
+  file.close();
+  return true;
+}
+
+static const char *baseUsers =
+    "{\"users\":["
+    "{\"id\":2621370,\"callsign\":\"DM3MAT\",\"fname\":\"Hannes\",\"country\":\"Germany\"},"
+    "{\"id\":2621371,\"callsign\":\"DL1ABC\",\"fname\":\"Max\",\"country\":\"Germany\"},"
+    "{\"id\":2621372,\"callsign\":\"DL2ABC\",\"fname\":\"Erika\",\"country\":\"Germany\"}"
+    "]}";
+
+static const char *updatedUsers =
+    "{\"users\":["
+    "{\"id\":2621370,\"callsign\":\"DM3MAT\",\"fname\":\"Hannes\",\"country\":\"Germany\"},"
+    "{\"id\":2621371,\"callsign\":\"DL1ABC\",\"fname\":\"Moritz\",\"country\":\"Germany\"},"
+    "{\"id\":2621373,\"callsign\":\"DL3ABC\",\"fname\":\"Otto\",\"country\":\"Germany\"}"
+    "]}";
+
+static const char *lowerUsers =
+    "{\"users\":["
+    "{\"id\":1023001,\"callsign\":\"DB1ABC\",\"fname\":\"Anna\",\"country\":\"Germany\"},"
+    "{\"id\":1023002,\"callsign\":\"DB2ABC\",\"fname\":\"Bernd\",\"country\":\"Germany\"},"
+    "{\"id\":2621370,\"callsign\":\"DM3MAT\",\"fname\":\"Hannes\",\"country\":\"Germany\"},"
+    "{\"id\":2621371,\"callsign\":\"DL1ABC\",\"fname\":\"Max\",\"country\":\"Germany\"},"
+    "{\"id\":2621372,\"callsign\":\"DL2ABC\",\"fname\":\"Erika\",\"country\":\"Germany\"},"
+    "{\"id\":2621380,\"callsign\":\"DL4ABC\",\"fname\":\"Paul\",\"country\":\"Germany\"}"
+    "]}";
+
+
+UserDatabaseTest::UserDatabaseTest(QObject *parent) : QObject(parent)
+{
+  // pass...
+}
+
+void
+UserDatabaseTest::testUpdate() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  QVERIFY(writeFile(dir.filePath("user.json"), baseUsers));
+  QVERIFY(writeFile(dir.filePath("update.json"), updatedUsers));
+
+  UserDatabase db(dir.path(), 30);
+  QCOMPARE(db.count(), 3);
+
+  QSignalSpy changed(&db, &UserDatabase::dataChanged);
+  QSignalSpy inserted(&db, &UserDatabase::rowsInserted);
+  QSignalSpy removed(&db, &UserDatabase::rowsRemoved);
+  QSignalSpy reset(&db, &UserDatabase::modelReset);
+  QVERIFY(db.update(dir.filePath("update.json")));
+
+  // One changed, one removed and one added user
+  QCOMPARE(changed.count(), 1);
+  QCOMPARE(removed.count(), 1);
+  QCOMPARE(inserted.count(), 1);
+  QCOMPARE(reset.count(), 0);
+  QCOMPARE(db.count(), 3);
+  // Two put, one delete and one sync record
+  QCOMPARE(db.deltaRecords(), 4U);
+  QVERIFY(QFile::exists(dir.filePath("user.delta")));
+
+  // Reload snapshot and delta log
+  UserDatabase reloaded(dir.path(), 30);
+  QCOMPARE(reloaded.count(), 3);
+  QCOMPARE(reloaded.deltaRecords(), 4U);
+  QCOMPARE(reloaded.user(0).id, 2621370U);
+  QCOMPARE(reloaded.user(1).name, QString("Moritz"));
+  QCOMPARE(reloaded.user(2).call, QString("DL3ABC"));
+
+  // Applying the same update again does not change anything
+  QVERIFY(reloaded.update(dir.filePath("update.json")));
+  QCOMPARE(reloaded.deltaRecords(), 5U);
+}
+
+void
+UserDatabaseTest::testUpdateOrder() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  QVERIFY(writeFile(dir.filePath("user.json"), baseUsers));
+  QVERIFY(writeFile(dir.filePath("update.json"), lowerUsers));
+
+  UserDatabase db(dir.path(), 30);
+  QSignalSpy inserted(&db, &UserDatabase::rowsInserted);
+  QVERIFY(db.update(dir.filePath("update.json")));
+
+  // Two users inserted in front and one appended
+  QCOMPARE(db.count(), 6);
+  QCOMPARE(inserted.count(), 2);
+  QCOMPARE(inserted.at(0).at(1).toInt(), 0);
+  QCOMPARE(inserted.at(0).at(2).toInt(), 1);
+  QCOMPARE(inserted.at(1).at(1).toInt(), 5);
+  QCOMPARE(inserted.at(1).at(2).toInt(), 5);
+
+  // Users added by the update are found, also if their ID is lower than the existing ones
+  QCOMPARE(db.indexOf(1023001), 0);
+  QCOMPARE(db.user(db.indexOf(1023002)).call, QString("DB2ABC"));
+  QCOMPARE(db.indexOf(2621370), 2);
+  QCOMPARE(db.indexOf(2621380), 5);
+  QCOMPARE(db.indexOf(1023000), -1);
+  for (int i=1; i<db.count(); i++)
+    QVERIFY(db.user(i-1).id < db.user(i).id);
+}
+
+void
+UserDatabaseTest::testCompact() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  QVERIFY(writeFile(dir.filePath("user.json"), baseUsers));
+  QVERIFY(writeFile(dir.filePath("update.json"), updatedUsers));
+
+  UserDatabase db(dir.path(), 30);
+  QVERIFY(db.update(dir.filePath("update.json")));
+  QVERIFY(db.compact());
+  QCOMPARE(db.deltaRecords(), 0U);
+  QVERIFY(! QFile::exists(dir.filePath("user.delta")));
+
+  UserDatabase reloaded(dir.path(), 30);
+  QCOMPARE(reloaded.count(), 3);
+  QCOMPARE(reloaded.deltaRecords(), 0U);
+  QCOMPARE(reloaded.user(1).name, QString("Moritz"));
+  QCOMPARE(reloaded.user(2).call, QString("DL3ABC"));
+}
+
+QTEST_GUILESS_MAIN(UserDatabaseTest)
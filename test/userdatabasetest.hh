@@ -0,0 +1,19 @@
+#ifndef USERDATABASETEST_HH
+#define USERDATABASETEST_HH
+
+#include <QObject>
+
+class UserDatabaseTest : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit UserDatabaseTest(QObject *parent = nullptr);
+
+private slots:
+  void testUpdate();
+  void testUpdateOrder();
+  void testCompact();
+};
+
+#endif // USERDATABASETEST_HH
@@ -3,6 +3,9 @@
 #include <QTest>
 #include "utils.hh"
 #include "frequency.hh"
+#include "interval.hh"
+#include "signaling.hh"
+#include "melody.hh"
 #include "chirpformat.hh"
 #include "config.hh"
 
@@ -93,6 +96,66 @@ UtilsTest::testFrequencyParser() {
 
   QCOMPARE(Frequency::fromString("100").inHz(), 100000000ULL);
   QCOMPARE(Frequency::fromString("100.0").inHz(), 100000000ULL);
+
+  QCOMPARE(Frequency::fromString(" 145.6125 MHz ").inHz(), 145612500ULL);
+  QCOMPARE(Frequency::fromString("12.5kHz").inHz(), 12500ULL);
+  QCOMPARE(Frequency::fromString("439.5630005").inHz(), 439563001ULL);
+  QCOMPARE(Frequency::fromString("1.2345678 kHz").inHz(), 1235ULL);
+  QCOMPARE(Frequency::fromString("100 khz").inHz(), 100000000ULL);
+}
+
+void
+UtilsTest::testIntervalParser() {
+  Interval i;
+  QVERIFY(i.parse("100")); QCOMPARE(i.milliseconds(), 100ULL);
+  QVERIFY(i.parse("100 ms")); QCOMPARE(i.milliseconds(), 100ULL);
+  QVERIFY(i.parse("100ms")); QCOMPARE(i.milliseconds(), 100ULL);
+  QVERIFY(i.parse(" 10 s ")); QCOMPARE(i.milliseconds(), 10000ULL);
+  QVERIFY(i.parse("5min")); QCOMPARE(i.milliseconds(), 300000ULL);
+}
+
+void
+UtilsTest::testSelectiveCallParser() {
+  QCOMPARE(SelectiveCall::parseCTCSS("67.0"), SelectiveCall(67.0));
+  QCOMPARE(SelectiveCall::parseCTCSS("71.9 Hz"), SelectiveCall(71.9));
+  QCOMPARE(SelectiveCall::parseCTCSS("100Hz"), SelectiveCall(100.0));
+  QCOMPARE(SelectiveCall::parseCTCSS("250.3").mHz(), 250300U);
+
+  QCOMPARE(SelectiveCall::parseDCS("023"), SelectiveCall(23, false));
+  QCOMPARE(SelectiveCall::parseDCS("n023"), SelectiveCall(23, false));
+  QCOMPARE(SelectiveCall::parseDCS("i754"), SelectiveCall(754, true));
+  QCOMPARE(SelectiveCall::parseDCS("-754"), SelectiveCall(754, true));
+  QCOMPARE(SelectiveCall::parseDCS("I25"), SelectiveCall(25, true));
+}
+
+void
+UtilsTest::testMelodyNoteParser() {
+  Melody::Note note;
+  QVERIFY(note.fromLilypond("cis4", Melody::Note::Duration::Whole));
+  QCOMPARE(note.tone, Melody::Note::Tone::Cis);
+  QCOMPARE(note.duration, Melody::Note::Duration::Quarter);
+  QCOMPARE(note.octave, 0);
+  QVERIFY(! note.dotted);
+
+  QVERIFY(note.fromLilypond("bes''16.", Melody::Note::Duration::Whole));
+  QCOMPARE(note.tone, Melody::Note::Tone::Ais);
+  QCOMPARE(note.duration, Melody::Note::Duration::Sixteenth);
+  QCOMPARE(note.octave, 2);
+  QVERIFY(note.dotted);
+
+  QVERIFY(note.fromLilypond("g,", Melody::Note::Duration::Eighth));
+  QCOMPARE(note.tone, Melody::Note::Tone::G);
+  QCOMPARE(note.duration, Melody::Note::Duration::Eighth);
+  QCOMPARE(note.octave, -1);
+
+  QVERIFY(note.fromLilypond("r2", Melody::Note::Duration::Whole));
+  QCOMPARE(note.tone, Melody::Note::Tone::Rest);
+  QCOMPARE(note.duration, Melody::Note::Duration::Half);
+
+  QVERIFY(! note.fromLilypond("ces", Melody::Note::Duration::Whole));
+  QVERIFY(! note.fromLilypond("c3", Melody::Note::Duration::Whole));
+  QVERIFY(! note.fromLilypond("c',", Melody::Note::Duration::Whole));
+  QVERIFY(! note.fromLilypond("", Melody::Note::Duration::Whole));
 }
 
 QTEST_GUILESS_MAIN(UtilsTest)
@@ -20,6 +20,9 @@ private slots:
   void testDecodeDMRID_bcd();
   void testEncodeDMRID_bcd();
   void testFrequencyParser();
+  void testIntervalParser();
+  void testSelectiveCallParser();
+  void testMelodyNoteParser();
 };
 
 #endif // UTILSTEST_HH